@@ -0,0 +1,356 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Link.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Link.c
+* @brief Implements the framed binary link protocol (message dispatch, acknowledge and retransmission).
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include <string.h>
+#include "Link.h"
+#include "SoftwareTimer.h"
+
+/**@struct Link_SlotType
+ * @brief Container used to store an encoded frame until it was sent (and acknowledged if required).
+ */
+typedef struct Link_SlotTypeTag
+{
+	uint8_t frame[LINKCODEC_MAX_FRAME_SIZE];	/**< Encoded frame. */
+	uint32_t length;							/**< Number of bytes of the encoded frame. */
+	volatile uint8_t isTxPending;				/**< Frame is queued for transmission. */
+	volatile uint8_t isAckPending;				/**< Frame waits for the acknowledge of the peer. */
+	volatile uint8_t isUsed;					/**< Slot is in use. */
+} Link_SlotType;
+
+/**@struct Link_DataType
+ * @brief Container used to store the relevant data of the link.
+ * @details Acknowledged frames use a go-back-N sliding window with 8 bit sequence numbers.
+ */
+typedef struct Link_DataTypeTag
+{
+	mutex_t lock;								/**< Protects the window state against concurrent senders. */
+	LinkCodec_DecoderType decoder;				/**< Frame decoder of the received data. */
+	Link_SlotType slot[LINK_TX_SLOT_NUMBER];	/**< Encoded frame buffers. */
+	uint8_t window[LINK_WINDOW_SIZE];			/**< Slot index of each frame in flight, indexed by sequence number. */
+	uint8_t sendBase;							/**< Sequence number of the oldest unacknowledged frame. */
+	uint8_t nextSeq;							/**< Sequence number of the next acknowledged frame. */
+	uint8_t expectedSeq;						/**< Sequence number of the next frame expected from the peer. */
+	uint8_t isAckDue;							/**< An acknowledge has to be sent to the peer. */
+	uint32_t retransmitElapsed;					/**< Number of MainFunction cycles left until the window is sent again. */
+	uint32_t retransmitReload;					/**< Number of MainFunction cycles configured for the retransmission. */
+	uint32_t rxErrors;							/**< Number of dropped corrupted frames. */
+} Link_DataType;
+
+static uint8_t claimSlot(void);
+static void releaseSlot(const uint8_t idx);
+static uint8_t transmitSlot(const uint8_t idx);
+static void txDone(const UartHndlr_ChannelType channel, void *context);
+static void handleFrame(void);
+static void handleAck(const uint8_t ack);
+
+/**@brief Stores the link data.
+ */
+static Link_DataType Link_Data;
+
+/**@brief Used to initialize the link.
+ * @param[in]	rec	The recurrence of the MainFunction in milliseconds.
+ */
+void Link_Init(const uint32_t rec)
+{
+	memset(&Link_Data, 0u, sizeof(Link_Data));
+	chMtxObjectInit(&Link_Data.lock);
+	LinkCodec_DecoderInit(&Link_Data.decoder);
+	if (rec != 0u)
+	{
+		Link_Data.retransmitReload = LINK_RETRANSMIT_TIME / rec;
+	}
+}
+
+/**@brief Used to decode the received frames, send the due acknowledge and retransmit timed out frames.
+ */
+void Link_MainFunction(void)
+{
+	const uint8_t *data;
+	uint32_t length;
+
+	while ((length = UartHndlr_GetRxData(LINK_CHANNEL, &data)) > 0u)
+	{
+		uint32_t consumed = 0u;
+		const LinkCodec_StatusType status = LinkCodec_Decode(&Link_Data.decoder, data, length, &consumed);
+
+		UartHndlr_ReleaseRxData(LINK_CHANNEL, consumed);
+		if (status == LINKCODEC_STATUS_FRAME)
+		{
+			handleFrame();
+		}
+		else if (status == LINKCODEC_STATUS_ERROR)
+		{
+			Link_Data.rxErrors++;
+		}
+	}
+
+	if (Link_Data.isAckDue)
+	{
+		/* Cleared by Link_Send() once the frame is queued, retried by the next call otherwise. */
+		(void)Link_Send(LINKCODEC_MSG_ID_ACK, NULL, 0u, FALSE);
+	}
+
+	chMtxLock(&Link_Data.lock);
+	if (Link_Data.nextSeq != Link_Data.sendBase)
+	{
+		swTimer_tick(Link_Data.retransmitElapsed);
+		if (swTimer_isElapsed(Link_Data.retransmitElapsed))
+		{
+			uint8_t seq = Link_Data.sendBase;
+
+			while (seq != Link_Data.nextSeq)
+			{
+				const uint8_t idx = Link_Data.window[seq % LINK_WINDOW_SIZE];
+
+				if (Link_Data.slot[idx].isTxPending == FALSE)
+				{
+					(void)transmitSlot(idx);
+				}
+				seq++;
+			}
+			swTimer_set(Link_Data.retransmitElapsed, Link_Data.retransmitReload);
+		}
+	}
+	chMtxUnlock(&Link_Data.lock);
+}
+
+/**@brief Used to send a message to the peer.
+ * @details The message is encoded into a free frame buffer, the caller buffer can be reused when
+ * the function returns. Acknowledged messages are kept until the peer confirms them and are sent
+ * again after LINK_RETRANSMIT_TIME.
+ * @param[in]	msgId		Message identifier.
+ * @param[in]	payload		Message payload, can be NULL if the length is 0.
+ * @param[in]	length		Number of payload bytes, at most LINKCODEC_MAX_PAYLOAD.
+ * @param[in]	isReliable	TRUE if the peer has to acknowledge the message.
+ * @return	TRUE if the message was accepted, FALSE if no frame buffer or window position is free.
+ */
+uint8_t Link_Send(const LinkCodec_MsgIdType msgId, const uint8_t *payload, const uint32_t length, const uint8_t isReliable)
+{
+	uint8_t retVal = FALSE;
+
+	if (length <= LINKCODEC_MAX_PAYLOAD)
+	{
+		chMtxLock(&Link_Data.lock);
+		if ((isReliable == FALSE) || ((uint8_t)(Link_Data.nextSeq - Link_Data.sendBase) < LINK_WINDOW_SIZE))
+		{
+			const uint8_t idx = claimSlot();
+
+			if (idx < LINK_TX_SLOT_NUMBER)
+			{
+				LinkCodec_HeaderType header = {(uint8_t)msgId, LINKCODEC_FLAG_ACK, 0u, (uint8_t)(Link_Data.expectedSeq - 1u)};
+
+				if (isReliable)
+				{
+					header.flags |= LINKCODEC_FLAG_ACK_REQUEST;
+					header.seq = Link_Data.nextSeq;
+					if (Link_Data.nextSeq == Link_Data.sendBase)
+					{
+						swTimer_set(Link_Data.retransmitElapsed, Link_Data.retransmitReload);
+					}
+					Link_Data.window[Link_Data.nextSeq % LINK_WINDOW_SIZE] = idx;
+					Link_Data.slot[idx].isAckPending = TRUE;
+					Link_Data.nextSeq++;
+				}
+				Link_Data.slot[idx].length = LinkCodec_Encode(&header, payload, length, Link_Data.slot[idx].frame);
+
+				if (transmitSlot(idx))
+				{
+					/* The pending acknowledge is carried only by a frame which is actually on the wire. */
+					Link_Data.isAckDue = FALSE;
+					retVal = TRUE;
+				}
+				else if (isReliable == FALSE)
+				{
+					releaseSlot(idx);
+				}
+				else
+				{
+					retVal = TRUE;
+				}
+			}
+		}
+		chMtxUnlock(&Link_Data.lock);
+	}
+
+	return retVal;
+}
+
+/**@brief Used to get the number of dropped corrupted frames.
+ * @return	Number of receive errors.
+ */
+uint32_t Link_GetRxErrors(void)
+{
+	return Link_Data.rxErrors;
+}
+
+/**@brief Used to claim a free frame buffer.
+ * @return	Index of the claimed buffer, LINK_TX_SLOT_NUMBER if none is free.
+ */
+static uint8_t claimSlot(void)
+{
+	uint8_t idx = 0u;
+
+	chSysLock();
+	while ((idx < LINK_TX_SLOT_NUMBER) && (Link_Data.slot[idx].isUsed))
+	{
+		idx++;
+	}
+	if (idx < LINK_TX_SLOT_NUMBER)
+	{
+		Link_Data.slot[idx].isUsed = TRUE;
+		Link_Data.slot[idx].isTxPending = FALSE;
+		Link_Data.slot[idx].isAckPending = FALSE;
+	}
+	chSysUnlock();
+
+	return idx;
+}
+
+/**@brief Used to release a frame buffer which is no longer waiting for an acknowledge.
+ * @details The buffer is freed immediately if it is not queued, otherwise on transmission end.
+ * @param[in]	idx	Index of the frame buffer.
+ */
+static void releaseSlot(const uint8_t idx)
+{
+	chSysLock();
+	Link_Data.slot[idx].isAckPending = FALSE;
+	if (Link_Data.slot[idx].isTxPending == FALSE)
+	{
+		Link_Data.slot[idx].isUsed = FALSE;
+	}
+	chSysUnlock();
+}
+
+/**@brief Used to queue an encoded frame for transmission, directly from its frame buffer.
+ * @param[in]	idx	Index of the frame buffer.
+ * @return	TRUE if the frame was queued, FALSE otherwise.
+ */
+static uint8_t transmitSlot(const uint8_t idx)
+{
+	const UartHndlr_TxSegmentType segment = {Link_Data.slot[idx].frame, Link_Data.slot[idx].length};
+	uint8_t retVal;
+
+	Link_Data.slot[idx].isTxPending = TRUE;
+	retVal = UartHndlr_Transmit(LINK_CHANNEL, &segment, 1u, txDone, &Link_Data.slot[idx]);
+	if (retVal == FALSE)
+	{
+		Link_Data.slot[idx].isTxPending = FALSE;
+	}
+
+	return retVal;
+}
+
+/**@brief Transmission end notification of a frame buffer (ISR context, system locked).
+ * @param[in]	channel	UART channel identifier.
+ * @param[in]	context	Frame buffer.
+ */
+static void txDone(const UartHndlr_ChannelType channel, void *context)
+{
+	Link_SlotType *slot = (Link_SlotType *)context;
+
+	(void)channel;
+	slot->isTxPending = FALSE;
+	if (slot->isAckPending == FALSE)
+	{
+		slot->isUsed = FALSE;
+	}
+}
+
+/**@brief Used to process the frame held by the decoder.
+ */
+static void handleFrame(void)
+{
+	LinkCodec_HeaderType header;
+	const uint8_t *payload;
+	uint32_t length;
+	uint8_t isDeliver = TRUE;
+
+	LinkCodec_GetFrame(&Link_Data.decoder, &header, &payload, &length);
+
+	if (header.flags & LINKCODEC_FLAG_ACK)
+	{
+		handleAck(header.ack);
+	}
+
+	if (header.flags & LINKCODEC_FLAG_ACK_REQUEST)
+	{
+		/* Go-back-N: only the next frame in order is accepted, duplicates and gaps are acknowledged again.
+		 * The lock is released before delivery, the handlers may call Link_Send(). */
+		chMtxLock(&Link_Data.lock);
+		Link_Data.isAckDue = TRUE;
+		if (header.seq == Link_Data.expectedSeq)
+		{
+			Link_Data.expectedSeq++;
+		}
+		else
+		{
+			isDeliver = FALSE;
+		}
+		chMtxUnlock(&Link_Data.lock);
+	}
+
+	if ((isDeliver) && (header.msgId < LINKCODEC_MSG_ID_UNKNOWN) && (Link_RxHandler[header.msgId] != NULL))
+	{
+		Link_RxHandler[header.msgId](payload, length);
+	}
+}
+
+/**@brief Used to release the frames confirmed by a cumulative acknowledge of the peer.
+ * @param[in]	ack	Sequence number of the last frame the peer received in order.
+ */
+static void handleAck(const uint8_t ack)
+{
+	chMtxLock(&Link_Data.lock);
+	{
+		const uint8_t acked = (uint8_t)(ack - Link_Data.sendBase + 1u);
+
+		if ((acked != 0u) && (acked <= (uint8_t)(Link_Data.nextSeq - Link_Data.sendBase)))
+		{
+			uint8_t count = 0u;
+
+			for (count = 0u; count < acked; count++)
+			{
+				releaseSlot(Link_Data.window[Link_Data.sendBase % LINK_WINDOW_SIZE]);
+				Link_Data.sendBase++;
+			}
+			swTimer_set(Link_Data.retransmitElapsed, Link_Data.retransmitReload);
+		}
+	}
+	chMtxUnlock(&Link_Data.lock);
+}
@@ -0,0 +1,50 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Link.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Link.h
+* @brief Implements the header of the framed binary link protocol.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#if !defined(LINK_H)
+#define LINK_H
+
+#include "Link_Cfg.h"
+
+extern void Link_Init(const uint32_t rec);
+extern void Link_MainFunction(void);
+extern uint8_t Link_Send(const LinkCodec_MsgIdType msgId, const uint8_t *payload, const uint32_t length, const uint8_t isReliable);
+extern uint32_t Link_GetRxErrors(void);
+
+#endif /* LINK_H */
@@ -0,0 +1,301 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: LinkCodec.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file LinkCodec.c
+* @brief Implements the link protocol frame encoder and decoder (COBS framing, CRC-16/CCITT).
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include <string.h>
+#include "LinkCodec.h"
+
+/**@struct LinkCodec_EncoderType
+ * @brief Specifies the state of the COBS encoder.
+ */
+typedef struct LinkCodec_EncoderTypeTag
+{
+	uint8_t *frame;		/**< Output frame. */
+	uint32_t codeIdx;	/**< Position of the code byte of the current block. */
+	uint32_t idx;		/**< Position of the next output byte. */
+	uint8_t code;		/**< Code of the current block. */
+	uint16_t crc;		/**< Running CRC over the encoded raw bytes. */
+} LinkCodec_EncoderType;
+
+static void encodeByte(LinkCodec_EncoderType *encoder, const uint8_t value);
+static void decodeByte(LinkCodec_DecoderType *decoder, const uint8_t value);
+
+/**@brief CRC-16/CCITT (polynomial 0x1021, MSB first) lookup table.
+ */
+static const uint16_t LinkCodec_CrcTable[256u] =
+{
+	0x0000u, 0x1021u, 0x2042u, 0x3063u, 0x4084u, 0x50A5u, 0x60C6u, 0x70E7u,
+	0x8108u, 0x9129u, 0xA14Au, 0xB16Bu, 0xC18Cu, 0xD1ADu, 0xE1CEu, 0xF1EFu,
+	0x1231u, 0x0210u, 0x3273u, 0x2252u, 0x52B5u, 0x4294u, 0x72F7u, 0x62D6u,
+	0x9339u, 0x8318u, 0xB37Bu, 0xA35Au, 0xD3BDu, 0xC39Cu, 0xF3FFu, 0xE3DEu,
+	0x2462u, 0x3443u, 0x0420u, 0x1401u, 0x64E6u, 0x74C7u, 0x44A4u, 0x5485u,
+	0xA56Au, 0xB54Bu, 0x8528u, 0x9509u, 0xE5EEu, 0xF5CFu, 0xC5ACu, 0xD58Du,
+	0x3653u, 0x2672u, 0x1611u, 0x0630u, 0x76D7u, 0x66F6u, 0x5695u, 0x46B4u,
+	0xB75Bu, 0xA77Au, 0x9719u, 0x8738u, 0xF7DFu, 0xE7FEu, 0xD79Du, 0xC7BCu,
+	0x48C4u, 0x58E5u, 0x6886u, 0x78A7u, 0x0840u, 0x1861u, 0x2802u, 0x3823u,
+	0xC9CCu, 0xD9EDu, 0xE98Eu, 0xF9AFu, 0x8948u, 0x9969u, 0xA90Au, 0xB92Bu,
+	0x5AF5u, 0x4AD4u, 0x7AB7u, 0x6A96u, 0x1A71u, 0x0A50u, 0x3A33u, 0x2A12u,
+	0xDBFDu, 0xCBDCu, 0xFBBFu, 0xEB9Eu, 0x9B79u, 0x8B58u, 0xBB3Bu, 0xAB1Au,
+	0x6CA6u, 0x7C87u, 0x4CE4u, 0x5CC5u, 0x2C22u, 0x3C03u, 0x0C60u, 0x1C41u,
+	0xEDAEu, 0xFD8Fu, 0xCDECu, 0xDDCDu, 0xAD2Au, 0xBD0Bu, 0x8D68u, 0x9D49u,
+	0x7E97u, 0x6EB6u, 0x5ED5u, 0x4EF4u, 0x3E13u, 0x2E32u, 0x1E51u, 0x0E70u,
+	0xFF9Fu, 0xEFBEu, 0xDFDDu, 0xCFFCu, 0xBF1Bu, 0xAF3Au, 0x9F59u, 0x8F78u,
+	0x9188u, 0x81A9u, 0xB1CAu, 0xA1EBu, 0xD10Cu, 0xC12Du, 0xF14Eu, 0xE16Fu,
+	0x1080u, 0x00A1u, 0x30C2u, 0x20E3u, 0x5004u, 0x4025u, 0x7046u, 0x6067u,
+	0x83B9u, 0x9398u, 0xA3FBu, 0xB3DAu, 0xC33Du, 0xD31Cu, 0xE37Fu, 0xF35Eu,
+	0x02B1u, 0x1290u, 0x22F3u, 0x32D2u, 0x4235u, 0x5214u, 0x6277u, 0x7256u,
+	0xB5EAu, 0xA5CBu, 0x95A8u, 0x8589u, 0xF56Eu, 0xE54Fu, 0xD52Cu, 0xC50Du,
+	0x34E2u, 0x24C3u, 0x14A0u, 0x0481u, 0x7466u, 0x6447u, 0x5424u, 0x4405u,
+	0xA7DBu, 0xB7FAu, 0x8799u, 0x97B8u, 0xE75Fu, 0xF77Eu, 0xC71Du, 0xD73Cu,
+	0x26D3u, 0x36F2u, 0x0691u, 0x16B0u, 0x6657u, 0x7676u, 0x4615u, 0x5634u,
+	0xD94Cu, 0xC96Du, 0xF90Eu, 0xE92Fu, 0x99C8u, 0x89E9u, 0xB98Au, 0xA9ABu,
+	0x5844u, 0x4865u, 0x7806u, 0x6827u, 0x18C0u, 0x08E1u, 0x3882u, 0x28A3u,
+	0xCB7Du, 0xDB5Cu, 0xEB3Fu, 0xFB1Eu, 0x8BF9u, 0x9BD8u, 0xABBBu, 0xBB9Au,
+	0x4A75u, 0x5A54u, 0x6A37u, 0x7A16u, 0x0AF1u, 0x1AD0u, 0x2AB3u, 0x3A92u,
+	0xFD2Eu, 0xED0Fu, 0xDD6Cu, 0xCD4Du, 0xBDAAu, 0xAD8Bu, 0x9DE8u, 0x8DC9u,
+	0x7C26u, 0x6C07u, 0x5C64u, 0x4C45u, 0x3CA2u, 0x2C83u, 0x1CE0u, 0x0CC1u,
+	0xEF1Fu, 0xFF3Eu, 0xCF5Du, 0xDF7Cu, 0xAF9Bu, 0xBFBAu, 0x8FD9u, 0x9FF8u,
+	0x6E17u, 0x7E36u, 0x4E55u, 0x5E74u, 0x2E93u, 0x3EB2u, 0x0ED1u, 0x1EF0u
+};
+
+/**@brief Used to update a CRC-16/CCITT over a block of data.
+ * @details Start with 0xFFFF. A block followed by its CRC in big endian order yields a CRC of 0.
+ * @param[in]	crc		Current CRC value.
+ * @param[in]	data	Data block.
+ * @param[in]	length	Number of bytes in the data block.
+ * @return	Updated CRC value.
+ */
+uint16_t LinkCodec_Crc16(uint16_t crc, const uint8_t *data, uint32_t length)
+{
+	while (length > 0u)
+	{
+		crc = (uint16_t)((crc << 8u) ^ LinkCodec_CrcTable[(uint8_t)(crc >> 8u) ^ *data]);
+		data++;
+		length--;
+	}
+
+	return crc;
+}
+
+/**@brief Used to encode a frame in a single pass (header, payload, CRC, COBS and delimiter).
+ * @param[in]	header	Frame header.
+ * @param[in]	payload	Frame payload, can be NULL if the length is 0.
+ * @param[in]	length	Number of payload bytes, at most LINKCODEC_MAX_PAYLOAD.
+ * @param[out]	frame	Output buffer of at least LINKCODEC_MAX_FRAME_SIZE bytes.
+ * @return	Number of bytes of the encoded frame, 0 if the payload is too long.
+ */
+uint32_t LinkCodec_Encode(const LinkCodec_HeaderType *header, const uint8_t *payload, const uint32_t length, uint8_t *frame)
+{
+	uint32_t retVal = 0u;
+
+	if (length <= LINKCODEC_MAX_PAYLOAD)
+	{
+		LinkCodec_EncoderType encoder = {frame, 0u, 1u, 1u, 0xFFFFu};
+		uint16_t crc;
+		uint32_t idx = 0u;
+
+		encodeByte(&encoder, header->msgId);
+		encodeByte(&encoder, header->flags);
+		encodeByte(&encoder, header->seq);
+		encodeByte(&encoder, header->ack);
+		for (idx = 0u; idx < length; idx++)
+		{
+			encodeByte(&encoder, payload[idx]);
+		}
+		crc = encoder.crc;
+		encodeByte(&encoder, (uint8_t)(crc >> 8u));
+		encodeByte(&encoder, (uint8_t)crc);
+
+		frame[encoder.codeIdx] = encoder.code;
+		frame[encoder.idx] = 0u;
+		retVal = encoder.idx + 1u;
+	}
+
+	return retVal;
+}
+
+/**@brief Used to initialize a streaming frame decoder.
+ * @details The first frame is accepted only after a delimiter, so a decoder started in the middle
+ * of a frame resynchronizes without reporting an error.
+ * @param[out]	decoder	Decoder state.
+ */
+void LinkCodec_DecoderInit(LinkCodec_DecoderType *decoder)
+{
+	memset(decoder, 0u, sizeof(*decoder));
+	decoder->crc = 0xFFFFu;
+	decoder->isDropping = 1u;
+}
+
+/**@brief Used to feed received data to a streaming frame decoder.
+ * @details Returns as soon as a frame ends, the remaining data has to be fed again after the frame
+ * was consumed. Each byte is COBS decoded and added to the CRC when it is received, so a frame is
+ * validated without a second pass.
+ * @param[in,out]	decoder		Decoder state.
+ * @param[in]		data		Received data.
+ * @param[in]		length		Number of received bytes.
+ * @param[out]		consumed	Number of bytes consumed by the decoder.
+ * @return	Decoder status.
+ */
+LinkCodec_StatusType LinkCodec_Decode(LinkCodec_DecoderType *decoder, const uint8_t *data, const uint32_t length, uint32_t *consumed)
+{
+	LinkCodec_StatusType retVal = LINKCODEC_STATUS_PENDING;
+	uint32_t idx = 0u;
+
+	if (decoder->isComplete != 0u)
+	{
+		decoder->length = 0u;
+		decoder->isComplete = 0u;
+	}
+
+	while ((idx < length) && (retVal == LINKCODEC_STATUS_PENDING))
+	{
+		const uint8_t value = data[idx];
+
+		idx++;
+		if (value == 0u)
+		{
+			if (decoder->isDropping == 0u)
+			{
+				if ((decoder->remaining == 0u) && (decoder->length >= (LINKCODEC_HEADER_SIZE + LINKCODEC_CRC_SIZE)) && (decoder->crc == 0u))
+				{
+					retVal = LINKCODEC_STATUS_FRAME;
+				}
+				else if (decoder->length != 0u)
+				{
+					retVal = LINKCODEC_STATUS_ERROR;
+				}
+			}
+			if (retVal == LINKCODEC_STATUS_FRAME)
+			{
+				decoder->isComplete = 1u;
+			}
+			else
+			{
+				decoder->length = 0u;
+			}
+			decoder->crc = 0xFFFFu;
+			decoder->code = 0u;
+			decoder->remaining = 0u;
+			decoder->isDropping = 0u;
+		}
+		else if (decoder->isDropping == 0u)
+		{
+			decodeByte(decoder, value);
+		}
+	}
+
+	*consumed = idx;
+	return retVal;
+}
+
+/**@brief Used to get the fields of the frame held by the decoder.
+ * @details Only valid after LinkCodec_Decode() returned LINKCODEC_STATUS_FRAME, until the next call.
+ * @param[in]	decoder	Decoder state.
+ * @param[out]	header	Frame header.
+ * @param[out]	payload	Frame payload (points into the decoder).
+ * @param[out]	length	Number of payload bytes.
+ */
+void LinkCodec_GetFrame(const LinkCodec_DecoderType *decoder, LinkCodec_HeaderType *header, const uint8_t **payload, uint32_t *length)
+{
+	header->msgId = decoder->buffer[0u];
+	header->flags = decoder->buffer[1u];
+	header->seq = decoder->buffer[2u];
+	header->ack = decoder->buffer[3u];
+	*payload = &decoder->buffer[LINKCODEC_HEADER_SIZE];
+	*length = decoder->length - (LINKCODEC_HEADER_SIZE + LINKCODEC_CRC_SIZE);
+}
+
+/**@brief Used to add one raw byte to the COBS encoder.
+ * @param[in,out]	encoder	Encoder state.
+ * @param[in]		value	Raw byte.
+ */
+static void encodeByte(LinkCodec_EncoderType *encoder, const uint8_t value)
+{
+	encoder->crc = (uint16_t)((encoder->crc << 8u) ^ LinkCodec_CrcTable[(uint8_t)(encoder->crc >> 8u) ^ value]);
+
+	if (value != 0u)
+	{
+		encoder->frame[encoder->idx] = value;
+		encoder->idx++;
+		encoder->code++;
+	}
+	if ((value == 0u) || (encoder->code == 0xFFu))
+	{
+		encoder->frame[encoder->codeIdx] = encoder->code;
+		encoder->codeIdx = encoder->idx;
+		encoder->idx++;
+		encoder->code = 1u;
+	}
+}
+
+/**@brief Used to add one encoded (non delimiter) byte to the decoder.
+ * @param[in,out]	decoder	Decoder state.
+ * @param[in]		value	Encoded byte.
+ */
+static void decodeByte(LinkCodec_DecoderType *decoder, const uint8_t value)
+{
+	uint8_t out = value;
+	uint8_t isOutput = 1u;
+
+	if (decoder->remaining == 0u)
+	{
+		/* Code byte: it stands for the zero which ended the previous block, unless that block was full. */
+		isOutput = ((decoder->code != 0u) && (decoder->code != 0xFFu)) ? 1u : 0u;
+		out = 0u;
+		decoder->code = value;
+		decoder->remaining = (uint8_t)(value - 1u);
+	}
+	else
+	{
+		decoder->remaining--;
+	}
+
+	if (isOutput != 0u)
+	{
+		if (decoder->length < LINKCODEC_MAX_RAW_SIZE)
+		{
+			decoder->buffer[decoder->length] = out;
+			decoder->length++;
+			decoder->crc = (uint16_t)((decoder->crc << 8u) ^ LinkCodec_CrcTable[(uint8_t)(decoder->crc >> 8u) ^ out]);
+		}
+		else
+		{
+			decoder->isDropping = 1u;
+		}
+	}
+}
@@ -0,0 +1,135 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: LinkCodec.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file LinkCodec.h
+* @brief Implements the header of the link protocol frame encoder and decoder.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#if !defined(LINKCODEC_H)
+#define LINKCODEC_H
+
+#include <stdint.h>
+
+/* This header and LinkCodec.c are the single definition of the link protocol. They do not depend
+ * on the OS or the HAL and are compiled unchanged by the host tool.
+ *
+ * Frame layout before COBS encoding (all fields one byte unless noted):
+ *   msgId | flags | seq | ack | payload (0..LINKCODEC_MAX_PAYLOAD) | CRC-16/CCITT (2 bytes, big endian)
+ * The encoded frame is terminated by a single 0x00 delimiter. */
+
+/**@brief Defines the maximum number of payload bytes of a frame.
+ */
+#define LINKCODEC_MAX_PAYLOAD			(128u)
+
+/**@brief Defines the number of header bytes of a frame.
+ */
+#define LINKCODEC_HEADER_SIZE			(4u)
+
+/**@brief Defines the number of CRC bytes of a frame.
+ */
+#define LINKCODEC_CRC_SIZE				(2u)
+
+/**@brief Defines the maximum size of a decoded frame (header, payload and CRC).
+ */
+#define LINKCODEC_MAX_RAW_SIZE			(LINKCODEC_HEADER_SIZE + LINKCODEC_MAX_PAYLOAD + LINKCODEC_CRC_SIZE)
+
+/**@brief Defines the maximum size of an encoded frame (COBS overhead and delimiter included).
+ */
+#define LINKCODEC_MAX_FRAME_SIZE		(LINKCODEC_MAX_RAW_SIZE + (LINKCODEC_MAX_RAW_SIZE / 254u) + 2u)
+
+/**@brief Frame flag: the receiver has to acknowledge the frame.
+ */
+#define LINKCODEC_FLAG_ACK_REQUEST		(0x01u)
+
+/**@brief Frame flag: the ack field of the frame is valid.
+ */
+#define LINKCODEC_FLAG_ACK				(0x02u)
+
+/**@enum LinkCodec_MsgIdTypeTag
+ * @brief Specifies the message identifiers of the link protocol.
+ */
+typedef enum LinkCodec_MsgIdTypeTag
+{
+	LINKCODEC_MSG_ID_ACK = 0u,		/**< Acknowledge only, no payload. */
+	LINKCODEC_MSG_ID_TRACE,			/**< Streaming trace data. */
+	LINKCODEC_MSG_ID_LOG,			/**< Binary log records. */
+	LINKCODEC_MSG_ID_TRACK,			/**< Track dump data. */
+	LINKCODEC_MSG_ID_CONFIG,		/**< Configuration data. */
+	LINKCODEC_MSG_ID_SHELL,			/**< Command shell terminal data. */
+	LINKCODEC_MSG_ID_UNKNOWN		/**< Guard value. */
+} LinkCodec_MsgIdType;
+
+/**@enum LinkCodec_StatusTypeTag
+ * @brief Specifies the result of feeding data to the decoder.
+ */
+typedef enum LinkCodec_StatusTypeTag
+{
+	LINKCODEC_STATUS_PENDING = 0u,	/**< All data consumed, no complete frame yet. */
+	LINKCODEC_STATUS_FRAME,			/**< A valid frame is available in the decoder. */
+	LINKCODEC_STATUS_ERROR			/**< A corrupted frame was dropped (COBS, length or CRC error). */
+} LinkCodec_StatusType;
+
+/**@struct LinkCodec_HeaderType
+ * @brief Specifies the header fields of a frame.
+ */
+typedef struct LinkCodec_HeaderTypeTag
+{
+	uint8_t msgId;		/**< Message identifier. */
+	uint8_t flags;		/**< Frame flags. */
+	uint8_t seq;		/**< Sequence number of an acknowledged frame. */
+	uint8_t ack;		/**< Sequence number of the last frame received in order. */
+} LinkCodec_HeaderType;
+
+/**@struct LinkCodec_DecoderType
+ * @brief Specifies the state of a streaming frame decoder.
+ */
+typedef struct LinkCodec_DecoderTypeTag
+{
+	uint8_t buffer[LINKCODEC_MAX_RAW_SIZE];	/**< Decoded bytes of the current frame. */
+	uint32_t length;						/**< Number of decoded bytes of the current frame. */
+	uint16_t crc;							/**< Running CRC over the decoded bytes. */
+	uint8_t code;							/**< Current COBS block code. */
+	uint8_t remaining;						/**< Bytes left in the current COBS block. */
+	uint8_t isDropping;						/**< Current frame is corrupted, skip until the next delimiter. */
+	uint8_t isComplete;						/**< Buffer holds a complete frame which is discarded on the next call. */
+} LinkCodec_DecoderType;
+
+extern uint16_t LinkCodec_Crc16(uint16_t crc, const uint8_t *data, uint32_t length);
+extern uint32_t LinkCodec_Encode(const LinkCodec_HeaderType *header, const uint8_t *payload, const uint32_t length, uint8_t *frame);
+extern void LinkCodec_DecoderInit(LinkCodec_DecoderType *decoder);
+extern LinkCodec_StatusType LinkCodec_Decode(LinkCodec_DecoderType *decoder, const uint8_t *data, const uint32_t length, uint32_t *consumed);
+extern void LinkCodec_GetFrame(const LinkCodec_DecoderType *decoder, LinkCodec_HeaderType *header, const uint8_t **payload, uint32_t *length);
+
+#endif /* LINKCODEC_H */
@@ -0,0 +1,522 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Gps.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Gps.c
+* @brief Implements the GNSS receiver handler.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include <string.h>
+#include "Gps.h"
+#include "Vfb.h"
+#include "Log.h"
+#include "SoftwareTimer.h"
+
+/**@struct Gps_DataType
+ * @brief Container used to store the relevant data of the GNSS receiver handler.
+ */
+typedef struct Gps_DataTypeTag
+{
+#if (GPS_PROTOCOL == GPS_PROTOCOL_UBX)
+	GpsUbx_DecoderType decoder;							/**< Frame decoder of the received data. */
+#else
+	GpsNmea_DecoderType decoder;						/**< Sentence decoder of the received data. */
+#endif
+	Gps_FixType fix;									/**< Latest navigation solution. */
+	GpsSky_TableType sky;								/**< Satellites in view. */
+	Gps_StatisticsType stats;							/**< Receive statistics. */
+	uint8_t txBuffer[GPS_TX_BUFFER_SIZE];				/**< Encoded receiver commands. */
+	uint32_t txLength;									/**< Number of bytes in txBuffer. */
+	volatile uint8_t isTxPending;						/**< txBuffer is queued for transmission. */
+	uint16_t period;									/**< Measurement period in milliseconds. */
+	uint32_t bootTimer;									/**< MainFunction cycles until the receiver accepts commands. */
+	uint32_t bootReload;								/**< Reload value of bootTimer. */
+	uint8_t isPowered;									/**< The receiver supply is switched on. */
+	uint8_t isConfigPending;							/**< The receiver configuration still has to be sent. */
+} Gps_DataType;
+
+#if (GPS_PROTOCOL == GPS_PROTOCOL_UBX)
+static uint8_t configureReceiver(void);
+static void appendUbx(const uint8_t msgClass, const uint8_t msgId, const uint8_t *payload, const uint16_t length);
+static void mergeFrame(void);
+#else
+static void mergeSentence(void);
+static void mergeSatellites(const GpsNmea_GsvType *gsv, const GpsSky_SystemType system);
+#endif
+static uint8_t transmitBuffer(void);
+static void txDone(const UartHndlr_ChannelType channel, void *context);
+
+/**@brief Stores the GNSS receiver handler data.
+ */
+static Gps_DataType Gps_Data;
+
+/**@brief Used to initialize the GNSS receiver handler.
+ * @details Must be called after UartHndlr_Init() and Vfb_Dio_Init(). The receiver is switched on,
+ * its configuration is sent once it has booted.
+ * @param[in]	rec	The recurrence of the MainFunction in milliseconds.
+ */
+void Gps_Init(const uint32_t rec)
+{
+	memset(&Gps_Data, 0u, sizeof(Gps_Data));
+	Gps_Data.period = GPS_MEASUREMENT_PERIOD;
+	if (rec != 0u)
+	{
+		Gps_Data.bootReload = GPS_BOOT_TIME / rec;
+	}
+	Gps_SetPower(TRUE);
+}
+
+/**@brief Used to decode the received messages and to update the navigation solution.
+ * @details The messages are decoded directly from the receive ring of the UART handler.
+ */
+void Gps_MainFunction(void)
+{
+	const uint8_t *data;
+	uint32_t length;
+
+#if (GPS_PROTOCOL == GPS_PROTOCOL_UBX)
+	if (Gps_Data.isConfigPending)
+	{
+		swTimer_tick(Gps_Data.bootTimer);
+		if ((swTimer_isElapsed(Gps_Data.bootTimer)) && (configureReceiver()))
+		{
+			Gps_Data.isConfigPending = FALSE;
+		}
+	}
+#endif
+	while ((length = UartHndlr_GetRxData(GPS_CHANNEL, &data)) > 0u)
+	{
+		uint32_t consumed = 0u;
+		const rtcnt_t start = chSysGetRealtimeCounterX();
+#if (GPS_PROTOCOL == GPS_PROTOCOL_UBX)
+		const GpsUbx_StatusType status = GpsUbx_Decode(&Gps_Data.decoder, data, length, &consumed);
+#else
+		const GpsNmea_StatusType status = GpsNmea_Decode(&Gps_Data.decoder, data, length, &consumed);
+#endif
+
+		Gps_Data.stats.parseTime += (uint32_t)(chSysGetRealtimeCounterX() - start);
+		Gps_Data.stats.bytes += consumed;
+		UartHndlr_ReleaseRxData(GPS_CHANNEL, consumed);
+#if (GPS_PROTOCOL == GPS_PROTOCOL_UBX)
+		if (status == GPSUBX_STATUS_FRAME)
+		{
+			Gps_Data.stats.messages++;
+			mergeFrame();
+		}
+		else if (status == GPSUBX_STATUS_ERROR)
+		{
+			Gps_Data.stats.errors++;
+		}
+#else
+		if (status == GPSNMEA_STATUS_SENTENCE)
+		{
+			Gps_Data.stats.messages++;
+			mergeSentence();
+		}
+		else if (status == GPSNMEA_STATUS_ERROR)
+		{
+			Gps_Data.stats.errors++;
+		}
+#endif
+	}
+}
+
+/**@brief Used to get the latest navigation solution.
+ * @param[out]	fix	Navigation solution.
+ */
+void Gps_GetFix(Gps_FixType *fix)
+{
+	chSysLock();
+	*fix = Gps_Data.fix;
+	chSysUnlock();
+}
+
+/**@brief Used to get the satellites in view.
+ * @param[out]	satellites	Satellite list.
+ * @param[in]	number		Number of entries of the satellite list.
+ * @return	Number of satellites written.
+ */
+uint32_t Gps_GetSatellites(Gps_SatelliteType *satellites, const uint32_t number)
+{
+	uint32_t retVal = 0u;
+
+	chSysLock();
+	retVal = GpsSky_GetSatellites(&Gps_Data.sky, satellites, number);
+	chSysUnlock();
+
+	return retVal;
+}
+
+/**@brief Used to get the quality figures of the satellites in view.
+ * @param[out]	summary	Quality figures.
+ */
+void Gps_GetSkySummary(GpsSky_SummaryType *summary)
+{
+	chSysLock();
+	GpsSky_GetSummary(&Gps_Data.sky, summary);
+	chSysUnlock();
+}
+
+/**@brief Used to get the receive statistics.
+ * @details The parse time divided by the number of bytes gives the decoder cost per byte.
+ * @param[out]	stats	Receive statistics.
+ */
+void Gps_GetStatistics(Gps_StatisticsType *stats)
+{
+	chSysLock();
+	*stats = Gps_Data.stats;
+	chSysUnlock();
+}
+
+/**@brief Used to send a UBX command to the receiver.
+ * @param[in]	msgClass	Message class.
+ * @param[in]	msgId		Message identifier.
+ * @param[in]	payload		Message payload, can be NULL if the length is 0.
+ * @param[in]	length		Number of payload bytes.
+ * @return	TRUE if the command was queued, FALSE if the previous command is still being sent.
+ */
+uint8_t Gps_SendUbx(const uint8_t msgClass, const uint8_t msgId, const uint8_t *payload, const uint16_t length)
+{
+	uint8_t retVal = FALSE;
+
+	if ((Gps_Data.isTxPending == FALSE) && (((uint32_t)length + GPSUBX_FRAME_OVERHEAD) <= GPS_TX_BUFFER_SIZE))
+	{
+		Gps_Data.txLength = GpsUbx_Encode(msgClass, msgId, payload, length, Gps_Data.txBuffer);
+		retVal = transmitBuffer();
+	}
+
+	return retVal;
+}
+
+/**@brief Used to switch the receiver supply.
+ * @details The backup supply keeps the ephemeris and the time while the main supply is off, so the
+ * next power on is a hot start. The decoder is restarted, the fix is marked invalid and the satellite
+ * table is cleared, with UBX the
+ * configuration is sent again after GPS_BOOT_TIME.
+ * @param[in]	isOn	TRUE to switch the receiver on, FALSE to switch it off.
+ */
+void Gps_SetPower(const uint8_t isOn)
+{
+	Vfb_Dio_Write_Channel(VFB_DIO_GPS_ENABLE, (isOn) ? STD_HIGH : STD_LOW);
+#if (GPS_PROTOCOL == GPS_PROTOCOL_UBX)
+	GpsUbx_DecoderInit(&Gps_Data.decoder);
+	Gps_Data.isConfigPending = isOn;
+	swTimer_set(Gps_Data.bootTimer, Gps_Data.bootReload);
+#else
+	GpsNmea_DecoderInit(&Gps_Data.decoder);
+#endif
+	Gps_Data.isPowered = isOn;
+
+	chSysLock();
+	Gps_Data.fix.isValid = FALSE;
+	Gps_Data.fix.updates++;
+	GpsSky_Init(&Gps_Data.sky);
+	chSysUnlock();
+}
+
+/**@brief Used to change the measurement period of the receiver.
+ * @details While the receiver is off or booting the period is applied with the configuration.
+ * NMEA has no standard rate command, the receiver keeps running at GPS_MEASUREMENT_PERIOD and any
+ * other period is refused with a warning.
+ * @param[in]	period	Measurement period in milliseconds.
+ * @return	TRUE if the period was applied or stored, FALSE if the command could not be queued (retry)
+ * or the period can't be set (NMEA).
+ */
+uint8_t Gps_SetMeasurementPeriod(const uint16_t period)
+{
+	uint8_t retVal = FALSE;
+#if (GPS_PROTOCOL == GPS_PROTOCOL_UBX)
+	const uint8_t rate[6u] = {(uint8_t)period, (uint8_t)(period >> 8u), 1u, 0u, 0u, 0u};
+
+	if ((Gps_Data.isPowered == FALSE) || (Gps_Data.isConfigPending))
+	{
+		retVal = TRUE;
+	}
+	else
+	{
+		retVal = Gps_SendUbx(GPSUBX_CLASS_CFG, GPSUBX_ID_CFG_RATE, rate, sizeof(rate));
+	}
+	if (retVal)
+	{
+		Gps_Data.period = period;
+	}
+#else
+	if (period == Gps_Data.period)
+	{
+		retVal = TRUE;
+	}
+	else
+	{
+		Log_Warning("gps period %u ms not applied, NMEA receiver runs at %u ms", period, Gps_Data.period);
+	}
+#endif
+
+	return retVal;
+}
+
+#if (GPS_PROTOCOL == GPS_PROTOCOL_UBX)
+/**@brief Used to configure the receiver for UBX output.
+ * @details Port protocols (UBX and NMEA in, UBX out), measurement rate and the NAV-PVT / NAV-SAT
+ * output rates are sent as a single transmission.
+ * @return	TRUE if the configuration was queued, FALSE if the transmitter is busy.
+ */
+static uint8_t configureReceiver(void)
+{
+	uint8_t retVal = FALSE;
+	const uint32_t baud = UARTHNDLR_GPS_BAUDRATE;
+	const uint8_t port[20u] =
+	{
+		GPS_UBX_PORT, 0u, 0u, 0u,							/* Port, reserved, txReady. */
+		0xD0u, 0x08u, 0u, 0u,								/* Mode: 8 data bits, no parity, 1 stop bit. */
+		(uint8_t)baud, (uint8_t)(baud >> 8u), (uint8_t)(baud >> 16u), (uint8_t)(baud >> 24u),
+		0x03u, 0u,											/* Input protocols: UBX, NMEA. */
+		0x01u, 0u,											/* Output protocols: UBX. */
+		0u, 0u, 0u, 0u										/* Flags, reserved. */
+	};
+	const uint8_t rate[6u] =
+	{
+		(uint8_t)Gps_Data.period, (uint8_t)(Gps_Data.period >> 8u),
+		1u, 0u,												/* One navigation solution per measurement. */
+		0u, 0u												/* Time reference: UTC. */
+	};
+	const uint8_t pvt[3u] = {GPSUBX_CLASS_NAV, GPSUBX_ID_NAV_PVT, 1u};
+	const uint8_t sat[3u] = {GPSUBX_CLASS_NAV, GPSUBX_ID_NAV_SAT, GPS_SATELLITE_RATE};
+
+	if (Gps_Data.isTxPending == FALSE)
+	{
+		Gps_Data.txLength = 0u;
+		appendUbx(GPSUBX_CLASS_CFG, GPSUBX_ID_CFG_PRT, port, sizeof(port));
+		appendUbx(GPSUBX_CLASS_CFG, GPSUBX_ID_CFG_RATE, rate, sizeof(rate));
+		appendUbx(GPSUBX_CLASS_CFG, GPSUBX_ID_CFG_MSG, pvt, sizeof(pvt));
+		appendUbx(GPSUBX_CLASS_CFG, GPSUBX_ID_CFG_MSG, sat, sizeof(sat));
+		retVal = transmitBuffer();
+	}
+
+	return retVal;
+}
+
+/**@brief Used to append an encoded UBX frame to the transmit buffer.
+ * @param[in]	msgClass	Message class.
+ * @param[in]	msgId		Message identifier.
+ * @param[in]	payload		Message payload.
+ * @param[in]	length		Number of payload bytes.
+ */
+static void appendUbx(const uint8_t msgClass, const uint8_t msgId, const uint8_t *payload, const uint16_t length)
+{
+	if ((Gps_Data.txLength + length + GPSUBX_FRAME_OVERHEAD) <= GPS_TX_BUFFER_SIZE)
+	{
+		Gps_Data.txLength += GpsUbx_Encode(msgClass, msgId, payload, length, &Gps_Data.txBuffer[Gps_Data.txLength]);
+	}
+}
+
+/**@brief Used to merge the frame held by the decoder into the navigation solution.
+ */
+static void mergeFrame(void)
+{
+	GpsUbx_NavPvtType pvt;
+
+	if (GpsUbx_GetNavPvt(&Gps_Data.decoder, &pvt))
+	{
+		Gps_FixType *fix = &Gps_Data.fix;
+
+		chSysLock();
+		fix->time = pvt.time;
+		fix->day = pvt.day;
+		fix->month = pvt.month;
+		fix->year = (uint8_t)(pvt.year - 2000u);
+		fix->isValid = ((pvt.isFixOk) && (pvt.fixType >= 2u) && (pvt.fixType <= 4u)) ? TRUE : FALSE;
+		fix->latitude = pvt.latitude;
+		fix->longitude = pvt.longitude;
+		fix->altitude = pvt.altitude;
+		fix->speed = pvt.speed;
+		fix->course = pvt.course;
+		fix->velocityEast = pvt.velocityEast;
+		fix->velocityNorth = pvt.velocityNorth;
+		fix->speedAccuracy = pvt.speedAccuracy;
+		fix->pdop = pvt.pdop;
+		fix->satellites = pvt.satellites;
+		fix->hAccuracy = pvt.hAccuracy;
+		fix->mode = (pvt.fixType == 2u) ? GPS_FIX_MODE_2D : (((pvt.fixType == 3u) || (pvt.fixType == 4u)) ? GPS_FIX_MODE_3D : GPS_FIX_MODE_NONE);
+		fix->updates++;
+		GpsSky_AddDop(&Gps_Data.sky, pvt.pdop);
+		chSysUnlock();
+	}
+	else if ((Gps_Data.decoder.msgClass == GPSUBX_CLASS_NAV) && (Gps_Data.decoder.msgId == GPSUBX_ID_NAV_SAT))
+	{
+		GpsUbx_SatelliteType satellite[GPS_SATELLITE_NUMBER];
+		const uint32_t number = GpsUbx_GetNavSat(&Gps_Data.decoder, satellite, GPS_SATELLITE_NUMBER);
+		uint32_t idx = 0u;
+
+		chSysLock();
+		for (idx = 0u; idx < (uint32_t)GPSSKY_SYSTEM_UNKNOWN; idx++)
+		{
+			GpsSky_BeginGroup(&Gps_Data.sky, (GpsSky_SystemType)idx, 0u);
+		}
+		for (idx = 0u; idx < number; idx++)
+		{
+			const GpsSky_SatelliteType entry =
+			{
+				(uint8_t)GpsSky_GetUbxSystem(satellite[idx].gnssId), satellite[idx].svId, satellite[idx].cno,
+				satellite[idx].elevation, satellite[idx].azimuth, satellite[idx].isUsed
+			};
+
+			GpsSky_AddSatellite(&Gps_Data.sky, &entry);
+		}
+		for (idx = 0u; idx < (uint32_t)GPSSKY_SYSTEM_UNKNOWN; idx++)
+		{
+			GpsSky_EndGroup(&Gps_Data.sky, (GpsSky_SystemType)idx);
+		}
+		chSysUnlock();
+	}
+}
+#else
+/**@brief Used to merge the sentence held by the decoder into the navigation solution.
+ */
+static void mergeSentence(void)
+{
+	const GpsNmea_DecoderType *decoder = &Gps_Data.decoder;
+	Gps_FixType *fix = &Gps_Data.fix;
+
+	chSysLock();
+	switch (decoder->type)
+	{
+		case GPSNMEA_SENTENCE_GGA:
+			fix->time = decoder->sentence.gga.time;
+			fix->hdop = decoder->sentence.gga.hdop;
+			fix->satellites = decoder->sentence.gga.satellites;
+			fix->isValid = (decoder->sentence.gga.quality != 0u) ? TRUE : FALSE;
+			if (decoder->sentence.gga.quality != 0u)
+			{
+				fix->latitude = decoder->sentence.gga.latitude;
+				fix->longitude = decoder->sentence.gga.longitude;
+				fix->altitude = decoder->sentence.gga.altitude;
+			}
+			break;
+		case GPSNMEA_SENTENCE_RMC:
+			fix->time = decoder->sentence.rmc.time;
+			fix->day = decoder->sentence.rmc.day;
+			fix->month = decoder->sentence.rmc.month;
+			fix->year = decoder->sentence.rmc.year;
+			fix->isValid = decoder->sentence.rmc.isValid;
+			if (decoder->sentence.rmc.isValid)
+			{
+				fix->latitude = decoder->sentence.rmc.latitude;
+				fix->longitude = decoder->sentence.rmc.longitude;
+				fix->speed = decoder->sentence.rmc.speed;
+				fix->course = decoder->sentence.rmc.course;
+			}
+			break;
+		case GPSNMEA_SENTENCE_GSA:
+			fix->mode = (decoder->sentence.gsa.fixType >= (uint8_t)GPS_FIX_MODE_2D) ? (Gps_FixModeType)decoder->sentence.gsa.fixType : GPS_FIX_MODE_NONE;
+			fix->pdop = decoder->sentence.gsa.pdop;
+			fix->hdop = decoder->sentence.gsa.hdop;
+			fix->vdop = decoder->sentence.gsa.vdop;
+			GpsSky_SetUsed(&Gps_Data.sky, GpsSky_GetNmeaSystem(decoder->talker, decoder->sentence.gsa.systemId),
+					decoder->sentence.gsa.prn, decoder->sentence.gsa.satellites);
+			GpsSky_AddDop(&Gps_Data.sky, decoder->sentence.gsa.hdop);
+			break;
+		case GPSNMEA_SENTENCE_VTG:
+			fix->speed = decoder->sentence.vtg.speed;
+			fix->course = decoder->sentence.vtg.course;
+			break;
+		case GPSNMEA_SENTENCE_GSV:
+			mergeSatellites(&decoder->sentence.gsv, GpsSky_GetNmeaSystem(decoder->talker, 0u));
+			break;
+		default:
+			break;
+	}
+	fix->updates++;
+	chSysUnlock();
+}
+
+/**@brief Used to write the satellites of a GSV sentence into the satellite table (system locked).
+ * @details The first sentence of a group starts overwriting the table of the system, the last one
+ * removes the entries which were not overwritten.
+ * @param[in]	gsv		GSV sentence.
+ * @param[in]	system	GNSS system of the talker.
+ */
+static void mergeSatellites(const GpsNmea_GsvType *gsv, const GpsSky_SystemType system)
+{
+	uint32_t idx = 0u;
+
+	if (gsv->message == 1u)
+	{
+		GpsSky_BeginGroup(&Gps_Data.sky, system, gsv->signalId);
+	}
+	for (idx = 0u; idx < gsv->satellites; idx++)
+	{
+		const GpsNmea_GsvSatelliteType *satellite = &gsv->satellite[idx];
+		const GpsSky_SatelliteType entry =
+		{
+			(uint8_t)system, satellite->prn, satellite->cno, satellite->elevation, (int16_t)satellite->azimuth,
+			GpsSky_IsUsed(&Gps_Data.sky, system, satellite->prn)
+		};
+
+		GpsSky_AddSatellite(&Gps_Data.sky, &entry);
+	}
+	if (gsv->message == gsv->messages)
+	{
+		GpsSky_EndGroup(&Gps_Data.sky, system);
+	}
+}
+#endif
+
+/**@brief Used to queue the transmit buffer.
+ * @return	TRUE if the buffer was queued, FALSE otherwise.
+ */
+static uint8_t transmitBuffer(void)
+{
+	const UartHndlr_TxSegmentType segment = {Gps_Data.txBuffer, Gps_Data.txLength};
+	uint8_t retVal;
+
+	Gps_Data.isTxPending = TRUE;
+	retVal = UartHndlr_Transmit(GPS_CHANNEL, &segment, 1u, txDone, NULL);
+	if (retVal == FALSE)
+	{
+		Gps_Data.isTxPending = FALSE;
+	}
+
+	return retVal;
+}
+
+/**@brief Transmission end notification of the transmit buffer (ISR context, system locked).
+ * @param[in]	channel	UART channel identifier.
+ * @param[in]	context	Not used.
+ */
+static void txDone(const UartHndlr_ChannelType channel, void *context)
+{
+	(void)channel;
+	(void)context;
+	Gps_Data.isTxPending = FALSE;
+}
@@ -0,0 +1,107 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Gps.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Gps.h
+* @brief Implements the header of the GNSS receiver handler.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#if !defined(GPS_H)
+#define GPS_H
+
+#include "Gps_Cfg.h"
+
+/**@enum Gps_FixModeTypeTag
+ * @brief Specifies the fix mode reported by the receiver.
+ */
+typedef enum Gps_FixModeTypeTag
+{
+	GPS_FIX_MODE_NONE = 0u,			/**< No position. */
+	GPS_FIX_MODE_2D = 2u,			/**< Position without altitude. */
+	GPS_FIX_MODE_3D = 3u			/**< Position and altitude. */
+} Gps_FixModeType;
+
+/**@brief Specifies one satellite in view.
+ */
+typedef GpsSky_SatelliteType Gps_SatelliteType;
+
+/**@struct Gps_FixType
+ * @brief Specifies the latest navigation solution, merged from the received messages.
+ */
+typedef struct Gps_FixTypeTag
+{
+	uint32_t time;					/**< UTC time of day in milliseconds. */
+	uint8_t day;					/**< UTC day of month. */
+	uint8_t month;					/**< UTC month. */
+	uint8_t year;					/**< UTC year - 2000. */
+	uint8_t isValid;				/**< TRUE if the receiver reports a valid position. */
+	int32_t latitude;				/**< Latitude in 1e-7 degrees, north positive. */
+	int32_t longitude;				/**< Longitude in 1e-7 degrees, east positive. */
+	int32_t altitude;				/**< Altitude above mean sea level in millimeters. */
+	uint32_t speed;					/**< Speed over ground in millimeters per second. */
+	uint32_t course;				/**< Course over ground in 1e-2 degrees. */
+	int32_t velocityEast;			/**< East velocity in millimeters per second, 0 if not reported (NMEA). */
+	int32_t velocityNorth;			/**< North velocity in millimeters per second, 0 if not reported (NMEA). */
+	uint32_t speedAccuracy;			/**< Speed accuracy estimate in millimeters per second, 0 if not reported (NMEA). */
+	uint16_t pdop;					/**< Position dilution of precision x 100. */
+	uint16_t hdop;					/**< Horizontal dilution of precision x 100. */
+	uint16_t vdop;					/**< Vertical dilution of precision x 100. */
+	uint8_t satellites;				/**< Number of satellites used. */
+	uint32_t hAccuracy;				/**< Horizontal accuracy estimate in millimeters, 0 if not reported (NMEA). */
+	Gps_FixModeType mode;			/**< Fix mode. */
+	uint32_t updates;				/**< Number of merged messages, changes on every update. */
+} Gps_FixType;
+
+/**@struct Gps_StatisticsType
+ * @brief Specifies the receive statistics of the GNSS receiver.
+ */
+typedef struct Gps_StatisticsTypeTag
+{
+	uint32_t bytes;					/**< Number of parsed bytes. */
+	uint32_t messages;				/**< Number of decoded sentences or frames. */
+	uint32_t errors;				/**< Number of dropped corrupted sentences or frames. */
+	uint32_t parseTime;				/**< Number of realtime counter cycles spent in the decoder. */
+} Gps_StatisticsType;
+
+extern void Gps_Init(const uint32_t rec);
+extern void Gps_MainFunction(void);
+extern void Gps_GetFix(Gps_FixType *fix);
+extern uint32_t Gps_GetSatellites(Gps_SatelliteType *satellites, const uint32_t number);
+extern void Gps_GetSkySummary(GpsSky_SummaryType *summary);
+extern void Gps_GetStatistics(Gps_StatisticsType *stats);
+extern void Gps_SetPower(const uint8_t isOn);
+extern uint8_t Gps_SetMeasurementPeriod(const uint16_t period);
+extern uint8_t Gps_SendUbx(const uint8_t msgClass, const uint8_t msgId, const uint8_t *payload, const uint16_t length);
+
+#endif /* GPS_H */
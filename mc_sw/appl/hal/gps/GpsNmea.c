@@ -0,0 +1,618 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: GpsNmea.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file GpsNmea.c
+* @brief Implements the streaming NMEA 0183 sentence decoder (GGA, RMC, GSA, VTG).
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include <string.h>
+#include "GpsNmea.h"
+
+/**@brief Defines the decoder states.
+ */
+#define GPSNMEA_STATE_IDLE				(0u)
+#define GPSNMEA_STATE_BODY				(1u)
+#define GPSNMEA_STATE_CHECKSUM_HIGH		(2u)
+#define GPSNMEA_STATE_CHECKSUM_LOW		(3u)
+
+/**@brief Defines the value of fractionDigits before the decimal point was received.
+ */
+#define GPSNMEA_NO_FRACTION				(0xFFu)
+
+/**@brief Builds the packed sentence formatter from its three characters.
+ */
+#define GPSNMEA_ADDRESS(a, b, c)		(((uint32_t)(a) << 16u) | ((uint32_t)(b) << 8u) | (uint32_t)(c))
+
+static void fieldReset(GpsNmea_FieldType *field);
+static void fieldEnd(GpsNmea_DecoderType *decoder);
+static void storeGga(GpsNmea_DecoderType *decoder);
+static void storeRmc(GpsNmea_DecoderType *decoder);
+static void storeGsa(GpsNmea_DecoderType *decoder);
+static void storeVtg(GpsNmea_DecoderType *decoder);
+static void storeGsv(GpsNmea_DecoderType *decoder);
+static void finishGsv(GpsNmea_DecoderType *decoder);
+static uint32_t getScaled(const GpsNmea_FieldType *field, const uint8_t digits);
+static uint32_t getTime(const GpsNmea_FieldType *field);
+static int32_t getAngle(const GpsNmea_FieldType *field);
+static uint8_t getHex(const uint8_t value);
+
+/**@brief Powers of ten used to scale the fraction digits.
+ */
+static const uint32_t GpsNmea_Pow10[GPSNMEA_FRACTION_DIGITS + 1u] =
+{
+	1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u
+};
+
+/**@brief Used to initialize a streaming sentence decoder.
+ * @details Data before the first '$' is skipped, so a decoder started in the middle of a sentence
+ * resynchronizes without reporting an error.
+ * @param[out]	decoder	Decoder state.
+ */
+void GpsNmea_DecoderInit(GpsNmea_DecoderType *decoder)
+{
+	memset(decoder, 0u, sizeof(*decoder));
+	decoder->state = GPSNMEA_STATE_IDLE;
+	decoder->type = GPSNMEA_SENTENCE_UNKNOWN;
+}
+
+/**@brief Used to feed received data to a streaming sentence decoder.
+ * @details Returns as soon as a sentence of a decoded type ends, the remaining data has to be fed again
+ * after the sentence was consumed. Valid sentences of other types are skipped silently. Each field is
+ * converted when its terminating ',' or '*' is received, the result is reported after the checksum.
+ * @param[in,out]	decoder		Decoder state.
+ * @param[in]		data		Received data.
+ * @param[in]		length		Number of received bytes.
+ * @param[out]		consumed	Number of bytes consumed by the decoder.
+ * @return	Decoder status.
+ */
+GpsNmea_StatusType GpsNmea_Decode(GpsNmea_DecoderType *decoder, const uint8_t *data, const uint32_t length, uint32_t *consumed)
+{
+	GpsNmea_StatusType retVal = GPSNMEA_STATUS_PENDING;
+	uint32_t idx = 0u;
+
+	while ((idx < length) && (retVal == GPSNMEA_STATUS_PENDING))
+	{
+		const uint8_t value = data[idx];
+
+		idx++;
+		if (value == (uint8_t)'$')
+		{
+			/* A start delimiter inside a sentence means the previous one was truncated. */
+			if (decoder->state != GPSNMEA_STATE_IDLE)
+			{
+				retVal = GPSNMEA_STATUS_ERROR;
+			}
+			decoder->state = GPSNMEA_STATE_BODY;
+			decoder->checksum = 0u;
+			decoder->index = 0u;
+			decoder->length = 0u;
+			decoder->address = 0u;
+			decoder->talker = 0u;
+			decoder->type = GPSNMEA_SENTENCE_UNKNOWN;
+			fieldReset(&decoder->field);
+		}
+		else if (decoder->state == GPSNMEA_STATE_BODY)
+		{
+			decoder->length++;
+			if ((value < (uint8_t)' ') || (value > (uint8_t)'~') || (decoder->length > GPSNMEA_MAX_LENGTH))
+			{
+				retVal = GPSNMEA_STATUS_ERROR;
+				decoder->state = GPSNMEA_STATE_IDLE;
+			}
+			else if (value == (uint8_t)'*')
+			{
+				fieldEnd(decoder);
+				if (decoder->type == GPSNMEA_SENTENCE_GSV)
+				{
+					finishGsv(decoder);
+				}
+				decoder->state = GPSNMEA_STATE_CHECKSUM_HIGH;
+			}
+			else
+			{
+				decoder->checksum ^= value;
+				if (value == (uint8_t)',')
+				{
+					fieldEnd(decoder);
+				}
+				else if (decoder->index == 0u)
+				{
+					decoder->address = ((decoder->address << 8u) | value) & 0x00FFFFFFu;
+					if (decoder->length <= 2u)
+					{
+						decoder->talker = (uint16_t)((decoder->talker << 8u) | value);
+					}
+				}
+				else if ((value >= (uint8_t)'0') && (value <= (uint8_t)'9'))
+				{
+					GpsNmea_FieldType *field = &decoder->field;
+
+					field->isEmpty = 0u;
+					if (field->fractionDigits == GPSNMEA_NO_FRACTION)
+					{
+						field->integer = (field->integer * 10u) + (uint32_t)(value - (uint8_t)'0');
+					}
+					else if (field->fractionDigits < GPSNMEA_FRACTION_DIGITS)
+					{
+						field->fraction = (field->fraction * 10u) + (uint32_t)(value - (uint8_t)'0');
+						field->fractionDigits++;
+					}
+				}
+				else
+				{
+					GpsNmea_FieldType *field = &decoder->field;
+
+					field->isEmpty = 0u;
+					if (value == (uint8_t)'.')
+					{
+						field->fractionDigits = 0u;
+					}
+					else if (value == (uint8_t)'-')
+					{
+						field->isNegative = 1u;
+					}
+					else
+					{
+						field->letter = value;
+					}
+				}
+			}
+		}
+		else if (decoder->state == GPSNMEA_STATE_CHECKSUM_HIGH)
+		{
+			if (getHex(value) <= 0x0Fu)
+			{
+				decoder->received = (uint8_t)(getHex(value) << 4u);
+				decoder->state = GPSNMEA_STATE_CHECKSUM_LOW;
+			}
+			else
+			{
+				retVal = GPSNMEA_STATUS_ERROR;
+				decoder->state = GPSNMEA_STATE_IDLE;
+			}
+		}
+		else if (decoder->state == GPSNMEA_STATE_CHECKSUM_LOW)
+		{
+			decoder->state = GPSNMEA_STATE_IDLE;
+			if ((getHex(value) > 0x0Fu) || ((decoder->received | getHex(value)) != decoder->checksum))
+			{
+				retVal = GPSNMEA_STATUS_ERROR;
+			}
+			else if (decoder->type != GPSNMEA_SENTENCE_UNKNOWN)
+			{
+				retVal = GPSNMEA_STATUS_SENTENCE;
+			}
+			else
+			{
+				/* Valid sentence of a type which is not decoded. */
+			}
+		}
+		else
+		{
+			/* Line endings and noise between sentences. */
+		}
+	}
+
+	*consumed = idx;
+	return retVal;
+}
+
+/**@brief Used to clear the accumulator before a field.
+ * @param[out]	field	Field accumulator.
+ */
+static void fieldReset(GpsNmea_FieldType *field)
+{
+	field->integer = 0u;
+	field->fraction = 0u;
+	field->fractionDigits = GPSNMEA_NO_FRACTION;
+	field->isNegative = 0u;
+	field->isEmpty = 1u;
+	field->letter = 0u;
+}
+
+/**@brief Used to convert the field which just ended and to start the next one.
+ * @param[in,out]	decoder	Decoder state.
+ */
+static void fieldEnd(GpsNmea_DecoderType *decoder)
+{
+	if (decoder->index == 0u)
+	{
+		switch (decoder->address)
+		{
+			case GPSNMEA_ADDRESS('G', 'G', 'A'):
+				decoder->type = GPSNMEA_SENTENCE_GGA;
+				break;
+			case GPSNMEA_ADDRESS('R', 'M', 'C'):
+				decoder->type = GPSNMEA_SENTENCE_RMC;
+				break;
+			case GPSNMEA_ADDRESS('G', 'S', 'A'):
+				decoder->type = GPSNMEA_SENTENCE_GSA;
+				break;
+			case GPSNMEA_ADDRESS('V', 'T', 'G'):
+				decoder->type = GPSNMEA_SENTENCE_VTG;
+				break;
+			case GPSNMEA_ADDRESS('G', 'S', 'V'):
+				decoder->type = GPSNMEA_SENTENCE_GSV;
+				break;
+			default:
+				decoder->type = GPSNMEA_SENTENCE_UNKNOWN;
+				break;
+		}
+		/* Empty fields are reported as 0. */
+		memset(&decoder->sentence, 0u, sizeof(decoder->sentence));
+	}
+	else
+	{
+		switch (decoder->type)
+		{
+			case GPSNMEA_SENTENCE_GGA:
+				storeGga(decoder);
+				break;
+			case GPSNMEA_SENTENCE_RMC:
+				storeRmc(decoder);
+				break;
+			case GPSNMEA_SENTENCE_GSA:
+				storeGsa(decoder);
+				break;
+			case GPSNMEA_SENTENCE_VTG:
+				storeVtg(decoder);
+				break;
+			case GPSNMEA_SENTENCE_GSV:
+				storeGsv(decoder);
+				break;
+			default:
+				break;
+		}
+	}
+
+	decoder->index++;
+	fieldReset(&decoder->field);
+}
+
+/**@brief Used to store a field of a GGA sentence.
+ * @param[in,out]	decoder	Decoder state.
+ */
+static void storeGga(GpsNmea_DecoderType *decoder)
+{
+	const GpsNmea_FieldType *field = &decoder->field;
+	GpsNmea_GgaType *gga = &decoder->sentence.gga;
+
+	switch (decoder->index)
+	{
+		case 1u:
+			gga->time = getTime(field);
+			break;
+		case 2u:
+			gga->latitude = getAngle(field);
+			break;
+		case 3u:
+			gga->latitude = (field->letter == (uint8_t)'S') ? -gga->latitude : gga->latitude;
+			break;
+		case 4u:
+			gga->longitude = getAngle(field);
+			break;
+		case 5u:
+			gga->longitude = (field->letter == (uint8_t)'W') ? -gga->longitude : gga->longitude;
+			break;
+		case 6u:
+			gga->quality = (uint8_t)field->integer;
+			break;
+		case 7u:
+			gga->satellites = (uint8_t)field->integer;
+			break;
+		case 8u:
+			gga->hdop = (uint16_t)getScaled(field, 2u);
+			break;
+		case 9u:
+			gga->altitude = (field->isNegative != 0u) ? -(int32_t)getScaled(field, 3u) : (int32_t)getScaled(field, 3u);
+			break;
+		case 11u:
+			gga->separation = (field->isNegative != 0u) ? -(int32_t)getScaled(field, 3u) : (int32_t)getScaled(field, 3u);
+			break;
+		default:
+			break;
+	}
+}
+
+/**@brief Used to store a field of a RMC sentence.
+ * @param[in,out]	decoder	Decoder state.
+ */
+static void storeRmc(GpsNmea_DecoderType *decoder)
+{
+	const GpsNmea_FieldType *field = &decoder->field;
+	GpsNmea_RmcType *rmc = &decoder->sentence.rmc;
+
+	switch (decoder->index)
+	{
+		case 1u:
+			rmc->time = getTime(field);
+			break;
+		case 2u:
+			rmc->isValid = (field->letter == (uint8_t)'A') ? 1u : 0u;
+			break;
+		case 3u:
+			rmc->latitude = getAngle(field);
+			break;
+		case 4u:
+			rmc->latitude = (field->letter == (uint8_t)'S') ? -rmc->latitude : rmc->latitude;
+			break;
+		case 5u:
+			rmc->longitude = getAngle(field);
+			break;
+		case 6u:
+			rmc->longitude = (field->letter == (uint8_t)'W') ? -rmc->longitude : rmc->longitude;
+			break;
+		case 7u:
+			/* 1 knot = 1852 m / 3600 s = 463 / 900 mm/s per 1e-3 knot. */
+			rmc->speed = ((getScaled(field, 3u) * 463u) + 450u) / 900u;
+			break;
+		case 8u:
+			rmc->course = getScaled(field, 2u);
+			break;
+		case 9u:
+			rmc->day = (uint8_t)(field->integer / 10000u);
+			rmc->month = (uint8_t)((field->integer / 100u) % 100u);
+			rmc->year = (uint8_t)(field->integer % 100u);
+			break;
+		default:
+			break;
+	}
+}
+
+/**@brief Used to store a field of a GSA sentence.
+ * @param[in,out]	decoder	Decoder state.
+ */
+static void storeGsa(GpsNmea_DecoderType *decoder)
+{
+	const GpsNmea_FieldType *field = &decoder->field;
+	GpsNmea_GsaType *gsa = &decoder->sentence.gsa;
+
+	if (decoder->index == 2u)
+	{
+		gsa->fixType = (uint8_t)field->integer;
+	}
+	else if ((decoder->index >= 3u) && (decoder->index < (3u + GPSNMEA_GSA_SATELLITES)))
+	{
+		if (field->isEmpty == 0u)
+		{
+			gsa->prn[gsa->satellites] = (uint8_t)field->integer;
+			gsa->satellites++;
+		}
+	}
+	else if (decoder->index == 15u)
+	{
+		gsa->pdop = (uint16_t)getScaled(field, 2u);
+	}
+	else if (decoder->index == 16u)
+	{
+		gsa->hdop = (uint16_t)getScaled(field, 2u);
+	}
+	else if (decoder->index == 17u)
+	{
+		gsa->vdop = (uint16_t)getScaled(field, 2u);
+	}
+	else if (decoder->index == 18u)
+	{
+		gsa->systemId = (uint8_t)field->integer;
+	}
+	else
+	{
+		/* Mode is not used. */
+	}
+}
+
+/**@brief Used to store a field of a VTG sentence.
+ * @param[in,out]	decoder	Decoder state.
+ */
+static void storeVtg(GpsNmea_DecoderType *decoder)
+{
+	const GpsNmea_FieldType *field = &decoder->field;
+	GpsNmea_VtgType *vtg = &decoder->sentence.vtg;
+
+	if (decoder->index == 1u)
+	{
+		vtg->course = getScaled(field, 2u);
+	}
+	else if (decoder->index == 7u)
+	{
+		/* 1 km/h = 1000 m / 3600 s = 5 / 18 mm/s per 1e-3 km/h. */
+		vtg->speed = ((getScaled(field, 3u) * 5u) + 9u) / 18u;
+	}
+	else
+	{
+		/* Magnetic course and speed in knots are not used. */
+	}
+}
+
+/**@brief Used to store a field of a GSV sentence.
+ * @details Fields 4 .. 19 are four blocks of satellite number, elevation, azimuth and C/N0. NMEA 4.10
+ * appends a signal identifier, it can only be told from a satellite number by its position as last
+ * field, see finishGsv().
+ * @param[in,out]	decoder	Decoder state.
+ */
+static void storeGsv(GpsNmea_DecoderType *decoder)
+{
+	const GpsNmea_FieldType *field = &decoder->field;
+	GpsNmea_GsvType *gsv = &decoder->sentence.gsv;
+
+	if (decoder->index == 1u)
+	{
+		gsv->messages = (uint8_t)field->integer;
+	}
+	else if (decoder->index == 2u)
+	{
+		gsv->message = (uint8_t)field->integer;
+	}
+	else if (decoder->index == 3u)
+	{
+		gsv->inView = (uint8_t)field->integer;
+	}
+	else if (decoder->index >= 4u)
+	{
+		const uint32_t entry = (decoder->index - 4u) / 4u;
+
+		switch ((decoder->index - 4u) % 4u)
+		{
+			case 0u:
+				gsv->signalId = (field->letter != 0u) ? getHex(field->letter) : (uint8_t)field->integer;
+				if ((entry < GPSNMEA_GSV_SATELLITES) && (field->isEmpty == 0u))
+				{
+					gsv->satellite[entry].prn = (uint8_t)field->integer;
+					gsv->satellites = (uint8_t)(entry + 1u);
+				}
+				break;
+			case 1u:
+				if (entry < GPSNMEA_GSV_SATELLITES)
+				{
+					gsv->satellite[entry].elevation = (int8_t)((field->isNegative != 0u) ? -(int32_t)field->integer : (int32_t)field->integer);
+				}
+				break;
+			case 2u:
+				if (entry < GPSNMEA_GSV_SATELLITES)
+				{
+					gsv->satellite[entry].azimuth = (uint16_t)field->integer;
+				}
+				break;
+			default:
+				if (entry < GPSNMEA_GSV_SATELLITES)
+				{
+					gsv->satellite[entry].cno = (uint8_t)field->integer;
+				}
+				break;
+		}
+	}
+	else
+	{
+		/* Address field is handled by fieldEnd(). */
+	}
+}
+
+/**@brief Used to resolve the last field of a GSV sentence.
+ * @details A last field in a satellite number position is the signal identifier, the satellite
+ * counted for it is removed. Otherwise no signal identifier was sent.
+ * @param[in,out]	decoder	Decoder state, index is the number of received fields.
+ */
+static void finishGsv(GpsNmea_DecoderType *decoder)
+{
+	GpsNmea_GsvType *gsv = &decoder->sentence.gsv;
+	const uint32_t last = (uint32_t)decoder->index - 1u;
+
+	if ((last >= 4u) && (((last - 4u) % 4u) == 0u))
+	{
+		const uint32_t entry = (last - 4u) / 4u;
+
+		if (gsv->satellites > entry)
+		{
+			gsv->satellites = (uint8_t)entry;
+			memset(&gsv->satellite[entry], 0u, sizeof(gsv->satellite[entry]));
+		}
+	}
+	else
+	{
+		gsv->signalId = 0u;
+	}
+}
+
+/**@brief Used to get the absolute value of a numeric field with a fixed number of fraction digits.
+ * @param[in]	field	Field accumulator.
+ * @param[in]	digits	Number of fraction digits of the result, at most GPSNMEA_FRACTION_DIGITS.
+ * @return	Field value times 10^digits, truncated.
+ */
+static uint32_t getScaled(const GpsNmea_FieldType *field, const uint8_t digits)
+{
+	const uint8_t fractionDigits = (field->fractionDigits == GPSNMEA_NO_FRACTION) ? 0u : field->fractionDigits;
+	uint32_t retVal = field->integer * GpsNmea_Pow10[digits];
+
+	if (fractionDigits <= digits)
+	{
+		retVal += field->fraction * GpsNmea_Pow10[digits - fractionDigits];
+	}
+	else
+	{
+		retVal += field->fraction / GpsNmea_Pow10[fractionDigits - digits];
+	}
+
+	return retVal;
+}
+
+/**@brief Used to convert a hhmmss.sss field.
+ * @param[in]	field	Field accumulator.
+ * @return	Time of day in milliseconds.
+ */
+static uint32_t getTime(const GpsNmea_FieldType *field)
+{
+	const uint32_t hours = field->integer / 10000u;
+	const uint32_t minutes = (field->integer / 100u) % 100u;
+	const uint32_t seconds = field->integer % 100u;
+	const GpsNmea_FieldType fraction = {0u, field->fraction, field->fractionDigits, 0u, 0u, 0u};
+
+	return (((hours * 3600u) + (minutes * 60u) + seconds) * 1000u) + getScaled(&fraction, 3u);
+}
+
+/**@brief Used to convert a (d)ddmm.mmmm field.
+ * @param[in]	field	Field accumulator.
+ * @return	Angle in 1e-7 degrees, the sign is applied by the hemisphere field.
+ */
+static int32_t getAngle(const GpsNmea_FieldType *field)
+{
+	const uint32_t degrees = field->integer / 100u;
+	const GpsNmea_FieldType minutes = {field->integer % 100u, field->fraction, field->fractionDigits, 0u, 0u, 0u};
+
+	return (int32_t)((degrees * 10000000u) + ((getScaled(&minutes, 7u) + 30u) / 60u));
+}
+
+/**@brief Used to convert a hexadecimal checksum digit.
+ * @param[in]	value	Received character.
+ * @return	Digit value, 0xFF if the character is not a hexadecimal digit.
+ */
+static uint8_t getHex(const uint8_t value)
+{
+	uint8_t retVal = 0xFFu;
+
+	if ((value >= (uint8_t)'0') && (value <= (uint8_t)'9'))
+	{
+		retVal = (uint8_t)(value - (uint8_t)'0');
+	}
+	else if ((value >= (uint8_t)'A') && (value <= (uint8_t)'F'))
+	{
+		retVal = (uint8_t)(value - (uint8_t)'A' + 10u);
+	}
+	else if ((value >= (uint8_t)'a') && (value <= (uint8_t)'f'))
+	{
+		retVal = (uint8_t)(value - (uint8_t)'a' + 10u);
+	}
+
+	return retVal;
+}
@@ -0,0 +1,212 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: GpsNmea.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file GpsNmea.h
+* @brief Implements the header of the streaming NMEA 0183 sentence decoder.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#if !defined(GPSNMEA_H)
+#define GPSNMEA_H
+
+#include <stdint.h>
+
+/* This header and GpsNmea.c do not depend on the OS or the HAL and can be compiled unchanged on the host.
+ *
+ * The decoder consumes the received bytes in place, one pass per byte: the checksum is updated and the
+ * numeric fields are accumulated as integers while the bytes arrive. Nothing is copied and no string
+ * functions are used. The fields of a sentence are only valid once its checksum has been verified. */
+
+/**@brief Defines the maximum number of characters between '$' and '*' (NMEA 0183 allows 79).
+ */
+#define GPSNMEA_MAX_LENGTH				(96u)
+
+/**@brief Defines the number of fraction digits kept for a numeric field, further digits are ignored.
+ */
+#define GPSNMEA_FRACTION_DIGITS			(7u)
+
+/**@brief Defines the number of satellites reported by a GSA sentence.
+ */
+#define GPSNMEA_GSA_SATELLITES			(12u)
+
+/**@brief Defines the maximum number of satellites reported by a GSV sentence.
+ */
+#define GPSNMEA_GSV_SATELLITES			(4u)
+
+/**@brief Builds the packed talker identifier from its two characters.
+ */
+#define GPSNMEA_TALKER(a, b)			((uint16_t)(((uint16_t)(a) << 8u) | (uint16_t)(b)))
+
+/**@enum GpsNmea_SentenceTypeTag
+ * @brief Specifies the decoded sentence types, any talker identifier is accepted.
+ */
+typedef enum GpsNmea_SentenceTypeTag
+{
+	GPSNMEA_SENTENCE_GGA = 0u,		/**< Fix data. */
+	GPSNMEA_SENTENCE_RMC,			/**< Recommended minimum data. */
+	GPSNMEA_SENTENCE_GSA,			/**< DOP and active satellites. */
+	GPSNMEA_SENTENCE_VTG,			/**< Course and speed over ground. */
+	GPSNMEA_SENTENCE_GSV,			/**< Satellites in view. */
+	GPSNMEA_SENTENCE_UNKNOWN		/**< Guard value, other sentences are skipped. */
+} GpsNmea_SentenceType;
+
+/**@enum GpsNmea_StatusTypeTag
+ * @brief Specifies the result of feeding data to the decoder.
+ */
+typedef enum GpsNmea_StatusTypeTag
+{
+	GPSNMEA_STATUS_PENDING = 0u,	/**< All data consumed, no complete sentence yet. */
+	GPSNMEA_STATUS_SENTENCE,		/**< A valid sentence is available in the decoder. */
+	GPSNMEA_STATUS_ERROR			/**< A corrupted sentence was dropped (checksum, length or framing error). */
+} GpsNmea_StatusType;
+
+/**@struct GpsNmea_GgaType
+ * @brief Specifies the fields of a GGA sentence.
+ */
+typedef struct GpsNmea_GgaTypeTag
+{
+	uint32_t time;					/**< UTC time of day in milliseconds. */
+	int32_t latitude;				/**< Latitude in 1e-7 degrees, north positive. */
+	int32_t longitude;				/**< Longitude in 1e-7 degrees, east positive. */
+	uint8_t quality;				/**< Fix quality (0 no fix, 1 GPS, 2 DGPS ...). */
+	uint8_t satellites;				/**< Number of satellites used. */
+	uint16_t hdop;					/**< Horizontal dilution of precision x 100. */
+	int32_t altitude;				/**< Altitude above mean sea level in millimeters. */
+	int32_t separation;				/**< Geoid separation in millimeters. */
+} GpsNmea_GgaType;
+
+/**@struct GpsNmea_RmcType
+ * @brief Specifies the fields of a RMC sentence.
+ */
+typedef struct GpsNmea_RmcTypeTag
+{
+	uint32_t time;					/**< UTC time of day in milliseconds. */
+	uint8_t isValid;				/**< 1 if the status is 'A' (valid), else 0. */
+	uint8_t day;					/**< UTC day of month. */
+	uint8_t month;					/**< UTC month. */
+	uint8_t year;					/**< UTC year - 2000. */
+	int32_t latitude;				/**< Latitude in 1e-7 degrees, north positive. */
+	int32_t longitude;				/**< Longitude in 1e-7 degrees, east positive. */
+	uint32_t speed;					/**< Speed over ground in millimeters per second. */
+	uint32_t course;				/**< Course over ground in 1e-2 degrees. */
+} GpsNmea_RmcType;
+
+/**@struct GpsNmea_GsaType
+ * @brief Specifies the fields of a GSA sentence.
+ */
+typedef struct GpsNmea_GsaTypeTag
+{
+	uint8_t fixType;								/**< 1 no fix, 2 2D fix, 3 3D fix. */
+	uint8_t satellites;								/**< Number of valid entries in prn. */
+	uint8_t prn[GPSNMEA_GSA_SATELLITES];			/**< Satellites used in the fix. */
+	uint16_t pdop;									/**< Position dilution of precision x 100. */
+	uint16_t hdop;									/**< Horizontal dilution of precision x 100. */
+	uint16_t vdop;									/**< Vertical dilution of precision x 100. */
+	uint8_t systemId;								/**< GNSS system identifier (NMEA 4.10: 1 GPS, 2 GLONASS, 3 Galileo, 4 BeiDou), 0 if not reported. */
+} GpsNmea_GsaType;
+
+/**@struct GpsNmea_VtgType
+ * @brief Specifies the fields of a VTG sentence.
+ */
+typedef struct GpsNmea_VtgTypeTag
+{
+	uint32_t course;				/**< True course over ground in 1e-2 degrees. */
+	uint32_t speed;					/**< Speed over ground in millimeters per second. */
+} GpsNmea_VtgType;
+
+/**@struct GpsNmea_GsvSatelliteType
+ * @brief Specifies one satellite of a GSV sentence.
+ */
+typedef struct GpsNmea_GsvSatelliteTypeTag
+{
+	uint8_t prn;					/**< Satellite number. */
+	int8_t elevation;				/**< Elevation in degrees. */
+	uint16_t azimuth;				/**< Azimuth in degrees. */
+	uint8_t cno;					/**< Carrier to noise ratio in dBHz, 0 if not tracked. */
+} GpsNmea_GsvSatelliteType;
+
+/**@struct GpsNmea_GsvType
+ * @brief Specifies the fields of a GSV sentence.
+ */
+typedef struct GpsNmea_GsvTypeTag
+{
+	uint8_t messages;										/**< Number of sentences of the group. */
+	uint8_t message;										/**< Number of this sentence in the group, starting at 1. */
+	uint8_t inView;											/**< Number of satellites in view. */
+	uint8_t satellites;										/**< Number of valid entries in satellite. */
+	uint8_t signalId;										/**< Signal identifier (NMEA 4.10), 0 if not reported. */
+	GpsNmea_GsvSatelliteType satellite[GPSNMEA_GSV_SATELLITES];	/**< Satellites of this sentence. */
+} GpsNmea_GsvType;
+
+/**@struct GpsNmea_FieldType
+ * @brief Specifies the accumulator of the numeric field being received.
+ */
+typedef struct GpsNmea_FieldTypeTag
+{
+	uint32_t integer;				/**< Integer part. */
+	uint32_t fraction;				/**< Fraction part, digits received so far. */
+	uint8_t fractionDigits;			/**< Number of digits in fraction, 0xFF before the decimal point. */
+	uint8_t isNegative;				/**< A minus sign was received. */
+	uint8_t isEmpty;				/**< No character was received. */
+	uint8_t letter;					/**< Last non numeric character. */
+} GpsNmea_FieldType;
+
+/**@struct GpsNmea_DecoderType
+ * @brief Specifies the state of a streaming sentence decoder.
+ */
+typedef struct GpsNmea_DecoderTypeTag
+{
+	GpsNmea_FieldType field;		/**< Field being received. */
+	uint32_t address;				/**< Last three characters of the address field. */
+	uint16_t talker;				/**< First two characters of the address field, see GPSNMEA_TALKER. */
+	uint8_t state;					/**< Decoder state. */
+	uint8_t checksum;				/**< Running XOR over the characters between '$' and '*'. */
+	uint8_t received;				/**< Checksum received after '*'. */
+	uint8_t index;					/**< Index of the field being received, 0 is the address field. */
+	uint8_t length;					/**< Number of characters of the sentence. */
+	GpsNmea_SentenceType type;		/**< Type of the sentence being received. */
+	union
+	{
+		GpsNmea_GgaType gga;
+		GpsNmea_RmcType rmc;
+		GpsNmea_GsaType gsa;
+		GpsNmea_VtgType vtg;
+		GpsNmea_GsvType gsv;
+	} sentence;						/**< Fields of the sentence, valid after GPSNMEA_STATUS_SENTENCE. */
+} GpsNmea_DecoderType;
+
+extern void GpsNmea_DecoderInit(GpsNmea_DecoderType *decoder);
+extern GpsNmea_StatusType GpsNmea_Decode(GpsNmea_DecoderType *decoder, const uint8_t *data, const uint32_t length, uint32_t *consumed);
+
+#endif /* GPSNMEA_H */
@@ -0,0 +1,378 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: GpsSky.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file GpsSky.c
+* @brief Implements the satellite table.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include <string.h>
+#include "GpsSky.h"
+
+/**@brief Defines the satellite numbers of GLONASS in NMEA (65 .. 96).
+ */
+#define GPSSKY_NMEA_GLONASS_FIRST		(65u)
+#define GPSSKY_NMEA_GLONASS_LAST		(96u)
+
+static void addEntry(GpsSky_SystemTableType *table, const GpsSky_SatelliteType *satellite);
+static void removeEntry(GpsSky_SystemTableType *table, const GpsSky_SatelliteType *satellite);
+static void applyMask(GpsSky_SystemTableType *table, const uint64_t mask);
+
+/**@brief Used to initialize a satellite table.
+ * @param[out]	table	Satellite table.
+ */
+void GpsSky_Init(GpsSky_TableType *table)
+{
+	memset(table, 0u, sizeof(*table));
+}
+
+/**@brief Used to start a group of satellite messages of one system (first GSV sentence, NAV-SAT).
+ * @details The entries are overwritten from the start while the group arrives, the table keeps its
+ * previous content until then. A receiver sending several signals (NMEA 4.10) is followed on the
+ * first signal seen, groups of other signals are ignored.
+ * @param[in,out]	table		Satellite table.
+ * @param[in]		system		GNSS system.
+ * @param[in]		signalId	Signal identifier, 0 if not reported.
+ */
+void GpsSky_BeginGroup(GpsSky_TableType *table, const GpsSky_SystemType system, const uint8_t signalId)
+{
+	if (system < GPSSKY_SYSTEM_UNKNOWN)
+	{
+		GpsSky_SystemTableType *entry = &table->system[system];
+
+		if (entry->signalId == 0u)
+		{
+			entry->signalId = signalId;
+		}
+		entry->isGroupActive = ((signalId == 0u) || (signalId == entry->signalId)) ? 1u : 0u;
+		entry->write = 0u;
+	}
+}
+
+/**@brief Used to write the next satellite of the running group.
+ * @details Satellites above GPSSKY_SATELLITES per system are dropped.
+ * @param[in,out]	table		Satellite table.
+ * @param[in]		satellite	Satellite, its system selects the group.
+ */
+void GpsSky_AddSatellite(GpsSky_TableType *table, const GpsSky_SatelliteType *satellite)
+{
+	if (satellite->system < (uint8_t)GPSSKY_SYSTEM_UNKNOWN)
+	{
+		GpsSky_SystemTableType *entry = &table->system[satellite->system];
+
+		if ((entry->isGroupActive != 0u) && (entry->write < GPSSKY_SATELLITES))
+		{
+			if (entry->write < entry->count)
+			{
+				removeEntry(entry, &entry->satellite[entry->write]);
+			}
+			entry->satellite[entry->write] = *satellite;
+			addEntry(entry, satellite);
+			entry->write++;
+			if (entry->write > entry->count)
+			{
+				entry->count = entry->write;
+			}
+		}
+	}
+}
+
+/**@brief Used to end a group of satellite messages of one system (last GSV sentence, NAV-SAT).
+ * @details The entries which were not overwritten by the group are removed.
+ * @param[in,out]	table	Satellite table.
+ * @param[in]		system	GNSS system.
+ */
+void GpsSky_EndGroup(GpsSky_TableType *table, const GpsSky_SystemType system)
+{
+	if (system < GPSSKY_SYSTEM_UNKNOWN)
+	{
+		GpsSky_SystemTableType *entry = &table->system[system];
+
+		if (entry->isGroupActive != 0u)
+		{
+			while (entry->count > entry->write)
+			{
+				entry->count--;
+				removeEntry(entry, &entry->satellite[entry->count]);
+			}
+			entry->isGroupActive = 0u;
+		}
+	}
+}
+
+/**@brief Used to set the satellites used for navigation (GSA).
+ * @details A combined GN sentence without system identifier (NMEA before 4.10) is split between GPS
+ * and GLONASS by the satellite number. Such a receiver may send one combined sentence per system, so
+ * a combined sentence only replaces the used set of a system it holds satellite numbers of, the
+ * other system keeps the set of its own sentence.
+ * @param[in,out]	table	Satellite table.
+ * @param[in]		system	GNSS system, GPSSKY_SYSTEM_UNKNOWN for a combined sentence.
+ * @param[in]		svIds	Satellite numbers.
+ * @param[in]		number	Number of satellite numbers.
+ */
+void GpsSky_SetUsed(GpsSky_TableType *table, const GpsSky_SystemType system, const uint8_t *svIds, const uint32_t number)
+{
+	uint64_t mask = 0u;
+	uint64_t glonass = 0u;
+	uint32_t idx = 0u;
+
+	for (idx = 0u; idx < number; idx++)
+	{
+		const uint64_t bit = (uint64_t)1u << (svIds[idx] & 63u);
+
+		if ((system == GPSSKY_SYSTEM_UNKNOWN) && (svIds[idx] >= GPSSKY_NMEA_GLONASS_FIRST) && (svIds[idx] <= GPSSKY_NMEA_GLONASS_LAST))
+		{
+			glonass |= bit;
+		}
+		else
+		{
+			mask |= bit;
+		}
+	}
+
+	if (system == GPSSKY_SYSTEM_UNKNOWN)
+	{
+		if (mask != 0u)
+		{
+			applyMask(&table->system[GPSSKY_SYSTEM_GPS], mask);
+		}
+		if (glonass != 0u)
+		{
+			applyMask(&table->system[GPSSKY_SYSTEM_GLONASS], glonass);
+		}
+	}
+	else if (system < GPSSKY_SYSTEM_UNKNOWN)
+	{
+		applyMask(&table->system[system], mask);
+	}
+	else
+	{
+		/* Invalid system. */
+	}
+}
+
+/**@brief Used to check whether a satellite was reported as used by the last GSA.
+ * @param[in]	table	Satellite table.
+ * @param[in]	system	GNSS system.
+ * @param[in]	svId	Satellite number.
+ * @return	1 if the satellite is used, else 0.
+ */
+uint8_t GpsSky_IsUsed(const GpsSky_TableType *table, const GpsSky_SystemType system, const uint8_t svId)
+{
+	uint8_t retVal = 0u;
+
+	if (system < GPSSKY_SYSTEM_UNKNOWN)
+	{
+		retVal = (uint8_t)((table->system[system].usedMask >> (svId & 63u)) & 1u);
+	}
+
+	return retVal;
+}
+
+/**@brief Used to add a dilution of precision to the trend.
+ * @param[in,out]	table	Satellite table.
+ * @param[in]		dop		DOP x 100, 0 (not available) is ignored.
+ */
+void GpsSky_AddDop(GpsSky_TableType *table, const uint16_t dop)
+{
+	if (dop != 0u)
+	{
+		const uint32_t value = (uint32_t)dop << 4u;
+
+		if (table->isDopValid == 0u)
+		{
+			table->dopFast = value;
+			table->dopSlow = value;
+			table->isDopValid = 1u;
+		}
+		else
+		{
+			table->dopFast = (uint32_t)((int32_t)table->dopFast + (((int32_t)value - (int32_t)table->dopFast) >> GPSSKY_DOP_FAST_SHIFT));
+			table->dopSlow = (uint32_t)((int32_t)table->dopSlow + (((int32_t)value - (int32_t)table->dopSlow) >> GPSSKY_DOP_SLOW_SHIFT));
+		}
+		table->dop = dop;
+	}
+}
+
+/**@brief Used to get the quality figures of the table.
+ * @param[in]	table	Satellite table.
+ * @param[out]	summary	Quality figures.
+ */
+void GpsSky_GetSummary(const GpsSky_TableType *table, GpsSky_SummaryType *summary)
+{
+	uint32_t cnoSum = 0u;
+	uint32_t system = 0u;
+
+	memset(summary, 0u, sizeof(*summary));
+	for (system = 0u; system < (uint32_t)GPSSKY_SYSTEM_UNKNOWN; system++)
+	{
+		const GpsSky_SystemTableType *entry = &table->system[system];
+
+		summary->inView = (uint8_t)(summary->inView + entry->count);
+		summary->tracked = (uint8_t)(summary->tracked + entry->tracked);
+		summary->used = (uint8_t)(summary->used + entry->used);
+		summary->usedPerSystem[system] = entry->used;
+		cnoSum += entry->cnoSum;
+	}
+	if (summary->tracked != 0u)
+	{
+		summary->meanCno = (uint8_t)((cnoSum + (summary->tracked / 2u)) / summary->tracked);
+	}
+	summary->dop = table->dop;
+	summary->dopTrend = (int16_t)(((int32_t)table->dopFast - (int32_t)table->dopSlow) / 16);
+}
+
+/**@brief Used to get the satellites of all systems as one list.
+ * @param[in]	table		Satellite table.
+ * @param[out]	satellites	Satellite list.
+ * @param[in]	number		Number of entries of the satellite list.
+ * @return	Number of satellites written.
+ */
+uint32_t GpsSky_GetSatellites(const GpsSky_TableType *table, GpsSky_SatelliteType *satellites, const uint32_t number)
+{
+	uint32_t retVal = 0u;
+	uint32_t system = 0u;
+
+	for (system = 0u; system < (uint32_t)GPSSKY_SYSTEM_UNKNOWN; system++)
+	{
+		const GpsSky_SystemTableType *entry = &table->system[system];
+		const uint32_t count = ((retVal + entry->count) <= number) ? entry->count : (number - retVal);
+
+		memcpy(&satellites[retVal], entry->satellite, count * sizeof(GpsSky_SatelliteType));
+		retVal += count;
+	}
+
+	return retVal;
+}
+
+/**@brief Used to get the system of a NMEA sentence.
+ * @param[in]	talker		Talker identifier, see GPSNMEA_TALKER.
+ * @param[in]	systemId	NMEA 4.10 system identifier, 0 if not reported.
+ * @return	GNSS system, GPSSKY_SYSTEM_UNKNOWN for a combined (GN) sentence without system identifier.
+ */
+GpsSky_SystemType GpsSky_GetNmeaSystem(const uint16_t talker, const uint8_t systemId)
+{
+	GpsSky_SystemType retVal = GPSSKY_SYSTEM_UNKNOWN;
+
+	if ((systemId >= 1u) && (systemId <= 4u))
+	{
+		retVal = (GpsSky_SystemType)(systemId - 1u);
+	}
+	else
+	{
+		switch (talker)
+		{
+			case GPSNMEA_TALKER('G', 'P'):
+				retVal = GPSSKY_SYSTEM_GPS;
+				break;
+			case GPSNMEA_TALKER('G', 'L'):
+				retVal = GPSSKY_SYSTEM_GLONASS;
+				break;
+			case GPSNMEA_TALKER('G', 'A'):
+				retVal = GPSSKY_SYSTEM_GALILEO;
+				break;
+			case GPSNMEA_TALKER('G', 'B'):
+			case GPSNMEA_TALKER('B', 'D'):
+				retVal = GPSSKY_SYSTEM_BEIDOU;
+				break;
+			default:
+				break;
+		}
+	}
+
+	return retVal;
+}
+
+/**@brief Used to get the system of a UBX gnssId.
+ * @param[in]	gnssId	UBX GNSS identifier.
+ * @return	GNSS system, GPSSKY_SYSTEM_UNKNOWN for SBAS, QZSS and others.
+ */
+GpsSky_SystemType GpsSky_GetUbxSystem(const uint8_t gnssId)
+{
+	static const uint8_t system[7u] =
+	{
+		GPSSKY_SYSTEM_GPS, GPSSKY_SYSTEM_UNKNOWN, GPSSKY_SYSTEM_GALILEO, GPSSKY_SYSTEM_BEIDOU,
+		GPSSKY_SYSTEM_UNKNOWN, GPSSKY_SYSTEM_UNKNOWN, GPSSKY_SYSTEM_GLONASS
+	};
+
+	return (gnssId < sizeof(system)) ? (GpsSky_SystemType)system[gnssId] : GPSSKY_SYSTEM_UNKNOWN;
+}
+
+/**@brief Used to add the contribution of an entry to the running sums.
+ * @param[in,out]	table		Table of the system.
+ * @param[in]		satellite	Entry.
+ */
+static void addEntry(GpsSky_SystemTableType *table, const GpsSky_SatelliteType *satellite)
+{
+	if (satellite->cno != 0u)
+	{
+		table->tracked++;
+		table->cnoSum = (uint16_t)(table->cnoSum + satellite->cno);
+	}
+	table->used = (uint8_t)(table->used + satellite->isUsed);
+}
+
+/**@brief Used to remove the contribution of an entry from the running sums.
+ * @param[in,out]	table		Table of the system.
+ * @param[in]		satellite	Entry.
+ */
+static void removeEntry(GpsSky_SystemTableType *table, const GpsSky_SatelliteType *satellite)
+{
+	if (satellite->cno != 0u)
+	{
+		table->tracked--;
+		table->cnoSum = (uint16_t)(table->cnoSum - satellite->cno);
+	}
+	table->used = (uint8_t)(table->used - satellite->isUsed);
+}
+
+/**@brief Used to set the used satellites of one system.
+ * @details Only the entries of the system are visited (GSA, once per epoch), the GSV data is not.
+ * @param[in,out]	table	Table of the system.
+ * @param[in]		mask	Used satellites, bit (svId & 63).
+ */
+static void applyMask(GpsSky_SystemTableType *table, const uint64_t mask)
+{
+	uint32_t idx = 0u;
+
+	table->usedMask = mask;
+	table->used = 0u;
+	for (idx = 0u; idx < table->count; idx++)
+	{
+		GpsSky_SatelliteType *satellite = &table->satellite[idx];
+
+		satellite->isUsed = (uint8_t)((mask >> (satellite->svId & 63u)) & 1u);
+		table->used = (uint8_t)(table->used + satellite->isUsed);
+	}
+}
@@ -0,0 +1,140 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: GpsSky.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file GpsSky.h
+* @brief Implements the header of the satellite table.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#if !defined(GPSSKY_H)
+#define GPSSKY_H
+
+#include <stdint.h>
+#include "GpsNmea.h"
+
+/* This header and GpsSky.c do not depend on the OS or the HAL and can be compiled unchanged on the host.
+ *
+ * The table is updated in place while the satellite messages arrive, one GSV sentence or one NAV-SAT
+ * entry at a time. The sums behind the quality figures are adjusted with every entry written or
+ * removed, so a summary never needs a pass over the table. */
+
+/**@brief Defines the number of satellites kept per GNSS system.
+ */
+#define GPSSKY_SATELLITES				(16u)
+
+/**@brief Defines the smoothing of the fast and of the slow DOP average (weight 2^-shift of a new value).
+ */
+#define GPSSKY_DOP_FAST_SHIFT			(1u)
+#define GPSSKY_DOP_SLOW_SHIFT			(4u)
+
+/**@enum GpsSky_SystemTypeTag
+ * @brief Specifies the GNSS systems of the table.
+ */
+typedef enum GpsSky_SystemTypeTag
+{
+	GPSSKY_SYSTEM_GPS = 0u,			/**< GPS (and SBAS, QZSS reported with the GP talker). */
+	GPSSKY_SYSTEM_GLONASS,			/**< GLONASS. */
+	GPSSKY_SYSTEM_GALILEO,			/**< Galileo. */
+	GPSSKY_SYSTEM_BEIDOU,			/**< BeiDou. */
+	GPSSKY_SYSTEM_UNKNOWN			/**< Guard value, number of systems. */
+} GpsSky_SystemType;
+
+/**@struct GpsSky_SatelliteType
+ * @brief Specifies one satellite in view.
+ */
+typedef struct GpsSky_SatelliteTypeTag
+{
+	uint8_t system;					/**< GNSS system, see GpsSky_SystemType. */
+	uint8_t svId;					/**< Satellite number as reported by the receiver. */
+	uint8_t cno;					/**< Carrier to noise ratio in dBHz, 0 if not tracked. */
+	int8_t elevation;				/**< Elevation in degrees. */
+	int16_t azimuth;				/**< Azimuth in degrees. */
+	uint8_t isUsed;					/**< 1 if the satellite is used for navigation, else 0. */
+} GpsSky_SatelliteType;
+
+/**@struct GpsSky_SystemTableType
+ * @brief Specifies the satellites of one GNSS system and their running sums.
+ */
+typedef struct GpsSky_SystemTableTypeTag
+{
+	GpsSky_SatelliteType satellite[GPSSKY_SATELLITES];	/**< Satellites in view. */
+	uint64_t usedMask;				/**< Satellites reported as used by GSA, bit (svId & 63). */
+	uint8_t count;					/**< Number of valid entries in satellite. */
+	uint8_t write;					/**< Next entry written by the running group. */
+	uint8_t signalId;				/**< Signal identifier the table follows, 0 if not reported. */
+	uint8_t isGroupActive;			/**< A group is being received. */
+	uint8_t tracked;				/**< Number of entries with C/N0 > 0. */
+	uint8_t used;					/**< Number of entries used for navigation. */
+	uint16_t cnoSum;				/**< Sum of the C/N0 of the tracked entries. */
+} GpsSky_SystemTableType;
+
+/**@struct GpsSky_TableType
+ * @brief Specifies the satellite table of all GNSS systems.
+ */
+typedef struct GpsSky_TableTypeTag
+{
+	GpsSky_SystemTableType system[GPSSKY_SYSTEM_UNKNOWN];	/**< Table of each system. */
+	uint32_t dopFast;				/**< Fast DOP average, x100 x 16. */
+	uint32_t dopSlow;				/**< Slow DOP average, x100 x 16. */
+	uint16_t dop;					/**< Last DOP x 100. */
+	uint8_t isDopValid;				/**< A DOP was received. */
+} GpsSky_TableType;
+
+/**@struct GpsSky_SummaryType
+ * @brief Specifies the quality figures derived from the table.
+ */
+typedef struct GpsSky_SummaryTypeTag
+{
+	uint8_t inView;					/**< Number of satellites in view. */
+	uint8_t tracked;				/**< Number of satellites with C/N0 > 0. */
+	uint8_t used;					/**< Number of satellites used for navigation. */
+	uint8_t meanCno;				/**< Mean C/N0 of the tracked satellites in dBHz, 0 if none. */
+	uint8_t usedPerSystem[GPSSKY_SYSTEM_UNKNOWN];	/**< Number of used satellites of each system. */
+	uint16_t dop;					/**< Last DOP x 100 (HDOP from NMEA, PDOP from UBX), 0 if none. */
+	int16_t dopTrend;				/**< Fast minus slow DOP average x 100, positive while the geometry degrades. */
+} GpsSky_SummaryType;
+
+extern void GpsSky_Init(GpsSky_TableType *table);
+extern void GpsSky_BeginGroup(GpsSky_TableType *table, const GpsSky_SystemType system, const uint8_t signalId);
+extern void GpsSky_AddSatellite(GpsSky_TableType *table, const GpsSky_SatelliteType *satellite);
+extern void GpsSky_EndGroup(GpsSky_TableType *table, const GpsSky_SystemType system);
+extern void GpsSky_SetUsed(GpsSky_TableType *table, const GpsSky_SystemType system, const uint8_t *svIds, const uint32_t number);
+extern uint8_t GpsSky_IsUsed(const GpsSky_TableType *table, const GpsSky_SystemType system, const uint8_t svId);
+extern void GpsSky_AddDop(GpsSky_TableType *table, const uint16_t dop);
+extern void GpsSky_GetSummary(const GpsSky_TableType *table, GpsSky_SummaryType *summary);
+extern uint32_t GpsSky_GetSatellites(const GpsSky_TableType *table, GpsSky_SatelliteType *satellites, const uint32_t number);
+extern GpsSky_SystemType GpsSky_GetNmeaSystem(const uint16_t talker, const uint8_t systemId);
+extern GpsSky_SystemType GpsSky_GetUbxSystem(const uint8_t gnssId);
+
+#endif /* GPSSKY_H */
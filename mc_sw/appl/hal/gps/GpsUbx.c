@@ -0,0 +1,344 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: GpsUbx.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file GpsUbx.c
+* @brief Implements the u-blox UBX frame encoder and streaming decoder (NAV-PVT, NAV-SAT).
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include <string.h>
+#include "GpsUbx.h"
+
+/**@brief Defines the decoder states.
+ */
+#define GPSUBX_STATE_SYNC1				(0u)
+#define GPSUBX_STATE_SYNC2				(1u)
+#define GPSUBX_STATE_CLASS				(2u)
+#define GPSUBX_STATE_ID					(3u)
+#define GPSUBX_STATE_LENGTH_LOW			(4u)
+#define GPSUBX_STATE_LENGTH_HIGH		(5u)
+#define GPSUBX_STATE_PAYLOAD			(6u)
+#define GPSUBX_STATE_CK_A				(7u)
+#define GPSUBX_STATE_CK_B				(8u)
+
+/**@brief Defines the synchronization characters.
+ */
+#define GPSUBX_SYNC1					(0xB5u)
+#define GPSUBX_SYNC2					(0x62u)
+
+static void checksumByte(GpsUbx_DecoderType *decoder, const uint8_t value);
+static uint16_t getU2(const uint8_t *data);
+static uint32_t getU4(const uint8_t *data);
+
+/**@brief Used to encode a frame.
+ * @param[in]	msgClass	Message class.
+ * @param[in]	msgId		Message identifier.
+ * @param[in]	payload		Message payload, can be NULL if the length is 0.
+ * @param[in]	length		Number of payload bytes.
+ * @param[out]	frame		Output buffer of at least length + GPSUBX_FRAME_OVERHEAD bytes.
+ * @return	Number of bytes of the encoded frame.
+ */
+uint32_t GpsUbx_Encode(const uint8_t msgClass, const uint8_t msgId, const uint8_t *payload, const uint16_t length, uint8_t *frame)
+{
+	uint8_t ckA = 0u;
+	uint8_t ckB = 0u;
+	uint32_t idx = 0u;
+
+	frame[0u] = GPSUBX_SYNC1;
+	frame[1u] = GPSUBX_SYNC2;
+	frame[2u] = msgClass;
+	frame[3u] = msgId;
+	frame[4u] = (uint8_t)length;
+	frame[5u] = (uint8_t)(length >> 8u);
+	if (length > 0u)
+	{
+		memcpy(&frame[6u], payload, length);
+	}
+	for (idx = 2u; idx < (6u + (uint32_t)length); idx++)
+	{
+		ckA = (uint8_t)(ckA + frame[idx]);
+		ckB = (uint8_t)(ckB + ckA);
+	}
+	frame[idx] = ckA;
+	frame[idx + 1u] = ckB;
+
+	return idx + 2u;
+}
+
+/**@brief Used to initialize a streaming frame decoder.
+ * @param[out]	decoder	Decoder state.
+ */
+void GpsUbx_DecoderInit(GpsUbx_DecoderType *decoder)
+{
+	memset(decoder, 0u, sizeof(*decoder));
+	decoder->state = GPSUBX_STATE_SYNC1;
+}
+
+/**@brief Used to feed received data to a streaming frame decoder.
+ * @details Returns as soon as a frame ends, the remaining data has to be fed again after the frame
+ * was consumed. The payload is checksummed in a tight loop over the contiguous received data, only
+ * the first GPSUBX_MAX_PAYLOAD bytes are stored. Data between frames (e.g. NMEA) is skipped.
+ * @param[in,out]	decoder		Decoder state.
+ * @param[in]		data		Received data.
+ * @param[in]		length		Number of received bytes.
+ * @param[out]		consumed	Number of bytes consumed by the decoder.
+ * @return	Decoder status.
+ */
+GpsUbx_StatusType GpsUbx_Decode(GpsUbx_DecoderType *decoder, const uint8_t *data, const uint32_t length, uint32_t *consumed)
+{
+	GpsUbx_StatusType retVal = GPSUBX_STATUS_PENDING;
+	uint32_t idx = 0u;
+
+	while ((idx < length) && (retVal == GPSUBX_STATUS_PENDING))
+	{
+		if (decoder->state == GPSUBX_STATE_PAYLOAD)
+		{
+			uint32_t count = (uint32_t)(decoder->length - decoder->index);
+			uint8_t ckA = decoder->ckA;
+			uint8_t ckB = decoder->ckB;
+			uint32_t end = 0u;
+
+			if (count > (length - idx))
+			{
+				count = length - idx;
+			}
+			end = idx + count;
+			if (decoder->index < GPSUBX_MAX_PAYLOAD)
+			{
+				const uint32_t stored = ((decoder->index + count) > GPSUBX_MAX_PAYLOAD) ? (GPSUBX_MAX_PAYLOAD - decoder->index) : count;
+
+				memcpy(&decoder->payload[decoder->index], &data[idx], stored);
+			}
+			while (idx < end)
+			{
+				ckA = (uint8_t)(ckA + data[idx]);
+				ckB = (uint8_t)(ckB + ckA);
+				idx++;
+			}
+			decoder->ckA = ckA;
+			decoder->ckB = ckB;
+			decoder->index = (uint16_t)(decoder->index + count);
+			if (decoder->index == decoder->length)
+			{
+				decoder->state = GPSUBX_STATE_CK_A;
+			}
+		}
+		else
+		{
+			const uint8_t value = data[idx];
+
+			idx++;
+			switch (decoder->state)
+			{
+				case GPSUBX_STATE_SYNC1:
+					decoder->state = (value == GPSUBX_SYNC1) ? GPSUBX_STATE_SYNC2 : GPSUBX_STATE_SYNC1;
+					break;
+				case GPSUBX_STATE_SYNC2:
+					if (value == GPSUBX_SYNC2)
+					{
+						decoder->state = GPSUBX_STATE_CLASS;
+						decoder->ckA = 0u;
+						decoder->ckB = 0u;
+					}
+					else
+					{
+						decoder->state = (value == GPSUBX_SYNC1) ? GPSUBX_STATE_SYNC2 : GPSUBX_STATE_SYNC1;
+					}
+					break;
+				case GPSUBX_STATE_CLASS:
+					checksumByte(decoder, value);
+					decoder->msgClass = value;
+					decoder->state = GPSUBX_STATE_ID;
+					break;
+				case GPSUBX_STATE_ID:
+					checksumByte(decoder, value);
+					decoder->msgId = value;
+					decoder->state = GPSUBX_STATE_LENGTH_LOW;
+					break;
+				case GPSUBX_STATE_LENGTH_LOW:
+					checksumByte(decoder, value);
+					decoder->length = value;
+					decoder->state = GPSUBX_STATE_LENGTH_HIGH;
+					break;
+				case GPSUBX_STATE_LENGTH_HIGH:
+					checksumByte(decoder, value);
+					decoder->length = (uint16_t)(decoder->length | ((uint16_t)value << 8u));
+					decoder->index = 0u;
+					if (decoder->length > GPSUBX_MAX_LENGTH)
+					{
+						retVal = GPSUBX_STATUS_ERROR;
+						decoder->state = GPSUBX_STATE_SYNC1;
+					}
+					else
+					{
+						decoder->state = (decoder->length == 0u) ? GPSUBX_STATE_CK_A : GPSUBX_STATE_PAYLOAD;
+					}
+					break;
+				case GPSUBX_STATE_CK_A:
+					if (value == decoder->ckA)
+					{
+						decoder->state = GPSUBX_STATE_CK_B;
+					}
+					else
+					{
+						retVal = GPSUBX_STATUS_ERROR;
+						decoder->state = GPSUBX_STATE_SYNC1;
+					}
+					break;
+				default:
+					retVal = (value == decoder->ckB) ? GPSUBX_STATUS_FRAME : GPSUBX_STATUS_ERROR;
+					decoder->state = GPSUBX_STATE_SYNC1;
+					break;
+			}
+		}
+	}
+
+	*consumed = idx;
+	return retVal;
+}
+
+/**@brief Used to get the fields of the NAV-PVT message held by the decoder.
+ * @details Only valid after GpsUbx_Decode() returned GPSUBX_STATUS_FRAME, until the next call.
+ * @param[in]	decoder	Decoder state.
+ * @param[out]	pvt		Navigation solution.
+ * @return	1 if the decoder holds a NAV-PVT message, else 0.
+ */
+uint8_t GpsUbx_GetNavPvt(const GpsUbx_DecoderType *decoder, GpsUbx_NavPvtType *pvt)
+{
+	uint8_t retVal = 0u;
+
+	if ((decoder->msgClass == GPSUBX_CLASS_NAV) && (decoder->msgId == GPSUBX_ID_NAV_PVT) && (decoder->length == GPSUBX_NAV_PVT_LENGTH))
+	{
+		const uint8_t *payload = decoder->payload;
+		const int32_t nano = (int32_t)getU4(&payload[16u]);
+		int32_t time = (int32_t)((((uint32_t)payload[8u] * 3600u) + ((uint32_t)payload[9u] * 60u) + (uint32_t)payload[10u]) * 1000u);
+
+		/* The seconds are rounded, so the fraction of the second can be negative. */
+		time += nano / 1000000;
+		pvt->time = (uint32_t)((time < 0) ? (time + 86400000) : time);
+		pvt->year = getU2(&payload[4u]);
+		pvt->month = payload[6u];
+		pvt->day = payload[7u];
+		pvt->fixType = payload[20u];
+		pvt->isFixOk = (uint8_t)(payload[21u] & 0x01u);
+		pvt->satellites = payload[23u];
+		pvt->longitude = (int32_t)getU4(&payload[24u]);
+		pvt->latitude = (int32_t)getU4(&payload[28u]);
+		pvt->altitude = (int32_t)getU4(&payload[36u]);
+		pvt->hAccuracy = getU4(&payload[40u]);
+		pvt->vAccuracy = getU4(&payload[44u]);
+		pvt->velocityNorth = (int32_t)getU4(&payload[48u]);
+		pvt->velocityEast = (int32_t)getU4(&payload[52u]);
+		pvt->velocityDown = (int32_t)getU4(&payload[56u]);
+		pvt->speed = getU4(&payload[60u]);
+		/* Heading of motion in 1e-5 degrees. */
+		pvt->course = getU4(&payload[64u]) / 1000u;
+		pvt->speedAccuracy = getU4(&payload[68u]);
+		pvt->pdop = getU2(&payload[76u]);
+		retVal = 1u;
+	}
+
+	return retVal;
+}
+
+/**@brief Used to get the satellites of the NAV-SAT message held by the decoder.
+ * @details Only valid after GpsUbx_Decode() returned GPSUBX_STATUS_FRAME, until the next call.
+ * Satellites beyond GPSUBX_MAX_SATELLITES are not stored by the decoder and are not reported.
+ * @param[in]	decoder		Decoder state.
+ * @param[out]	satellites	Satellite list.
+ * @param[in]	number		Number of entries of the satellite list.
+ * @return	Number of satellites written, 0 if the decoder holds no NAV-SAT message.
+ */
+uint32_t GpsUbx_GetNavSat(const GpsUbx_DecoderType *decoder, GpsUbx_SatelliteType *satellites, const uint32_t number)
+{
+	uint32_t retVal = 0u;
+
+	if ((decoder->msgClass == GPSUBX_CLASS_NAV) && (decoder->msgId == GPSUBX_ID_NAV_SAT) && (decoder->length >= 8u))
+	{
+		const uint32_t stored = (decoder->length > GPSUBX_MAX_PAYLOAD) ? GPSUBX_MAX_PAYLOAD : decoder->length;
+		uint32_t count = decoder->payload[5u];
+		uint32_t idx = 0u;
+
+		if (count > ((stored - 8u) / 12u))
+		{
+			count = (stored - 8u) / 12u;
+		}
+		if (count > number)
+		{
+			count = number;
+		}
+		for (idx = 0u; idx < count; idx++)
+		{
+			const uint8_t *entry = &decoder->payload[8u + (12u * idx)];
+
+			satellites[idx].gnssId = entry[0u];
+			satellites[idx].svId = entry[1u];
+			satellites[idx].cno = entry[2u];
+			satellites[idx].elevation = (int8_t)entry[3u];
+			satellites[idx].azimuth = (int16_t)getU2(&entry[4u]);
+			satellites[idx].isUsed = (uint8_t)((entry[8u] >> 3u) & 0x01u);
+		}
+		retVal = count;
+	}
+
+	return retVal;
+}
+
+/**@brief Used to add one byte to the running checksum.
+ * @param[in,out]	decoder	Decoder state.
+ * @param[in]		value	Received byte.
+ */
+static void checksumByte(GpsUbx_DecoderType *decoder, const uint8_t value)
+{
+	decoder->ckA = (uint8_t)(decoder->ckA + value);
+	decoder->ckB = (uint8_t)(decoder->ckB + decoder->ckA);
+}
+
+/**@brief Used to read an unaligned little endian 16 bit value.
+ * @param[in]	data	First byte of the value.
+ * @return	Value.
+ */
+static uint16_t getU2(const uint8_t *data)
+{
+	return (uint16_t)((uint16_t)data[0u] | ((uint16_t)data[1u] << 8u));
+}
+
+/**@brief Used to read an unaligned little endian 32 bit value.
+ * @param[in]	data	First byte of the value.
+ * @return	Value.
+ */
+static uint32_t getU4(const uint8_t *data)
+{
+	return (uint32_t)data[0u] | ((uint32_t)data[1u] << 8u) | ((uint32_t)data[2u] << 16u) | ((uint32_t)data[3u] << 24u);
+}
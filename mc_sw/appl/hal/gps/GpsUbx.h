@@ -0,0 +1,156 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: GpsUbx.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file GpsUbx.h
+* @brief Implements the header of the u-blox UBX frame encoder and streaming decoder.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#if !defined(GPSUBX_H)
+#define GPSUBX_H
+
+#include <stdint.h>
+
+/* This header and GpsUbx.c do not depend on the OS or the HAL and can be compiled unchanged on the host.
+ *
+ * Frame layout (multi byte fields little endian):
+ *   0xB5 | 0x62 | class | id | length (2 bytes) | payload (length bytes) | ckA | ckB
+ * The 8 bit Fletcher checksum runs over class, id, length and payload. The decoder updates it while
+ * the bytes arrive and only keeps the payload of the decoded messages. */
+
+/**@brief Defines the number of satellites of a NAV-SAT message which are kept.
+ */
+#define GPSUBX_MAX_SATELLITES			(32u)
+
+/**@brief Defines the number of payload bytes kept by the decoder, large enough for NAV-PVT.
+ */
+#define GPSUBX_MAX_PAYLOAD				(8u + (12u * GPSUBX_MAX_SATELLITES))
+
+/**@brief Defines the largest accepted payload length, longer frames are treated as corrupted.
+ */
+#define GPSUBX_MAX_LENGTH				(1024u)
+
+/**@brief Defines the number of framing bytes around the payload (sync, class, id, length, checksum).
+ */
+#define GPSUBX_FRAME_OVERHEAD			(8u)
+
+/**@brief Defines the message classes and identifiers used by the driver.
+ */
+#define GPSUBX_CLASS_NAV				(0x01u)
+#define GPSUBX_CLASS_ACK				(0x05u)
+#define GPSUBX_CLASS_CFG				(0x06u)
+#define GPSUBX_ID_NAV_PVT				(0x07u)
+#define GPSUBX_ID_NAV_SAT				(0x35u)
+#define GPSUBX_ID_ACK_NAK				(0x00u)
+#define GPSUBX_ID_ACK_ACK				(0x01u)
+#define GPSUBX_ID_CFG_PRT				(0x00u)
+#define GPSUBX_ID_CFG_MSG				(0x01u)
+#define GPSUBX_ID_CFG_RST				(0x04u)
+#define GPSUBX_ID_CFG_RATE				(0x08u)
+
+/**@brief Defines the payload length of a NAV-PVT message.
+ */
+#define GPSUBX_NAV_PVT_LENGTH			(92u)
+
+/**@enum GpsUbx_StatusTypeTag
+ * @brief Specifies the result of feeding data to the decoder.
+ */
+typedef enum GpsUbx_StatusTypeTag
+{
+	GPSUBX_STATUS_PENDING = 0u,		/**< All data consumed, no complete frame yet. */
+	GPSUBX_STATUS_FRAME,			/**< A valid frame is available in the decoder. */
+	GPSUBX_STATUS_ERROR				/**< A corrupted frame was dropped (checksum or length error). */
+} GpsUbx_StatusType;
+
+/**@struct GpsUbx_NavPvtType
+ * @brief Specifies the used fields of a NAV-PVT message.
+ */
+typedef struct GpsUbx_NavPvtTypeTag
+{
+	uint32_t time;					/**< UTC time of day in milliseconds. */
+	uint16_t year;					/**< UTC year. */
+	uint8_t month;					/**< UTC month. */
+	uint8_t day;					/**< UTC day of month. */
+	uint8_t fixType;				/**< 0 no fix, 1 dead reckoning, 2 2D, 3 3D, 4 GNSS and dead reckoning, 5 time only. */
+	uint8_t isFixOk;				/**< 1 if the fix is within the configured limits, else 0. */
+	uint8_t satellites;				/**< Number of satellites used. */
+	int32_t latitude;				/**< Latitude in 1e-7 degrees, north positive. */
+	int32_t longitude;				/**< Longitude in 1e-7 degrees, east positive. */
+	int32_t altitude;				/**< Altitude above mean sea level in millimeters. */
+	uint32_t hAccuracy;				/**< Horizontal accuracy estimate in millimeters. */
+	uint32_t vAccuracy;				/**< Vertical accuracy estimate in millimeters. */
+	int32_t velocityNorth;			/**< North velocity in millimeters per second. */
+	int32_t velocityEast;			/**< East velocity in millimeters per second. */
+	int32_t velocityDown;			/**< Down velocity in millimeters per second. */
+	uint32_t speed;					/**< Ground speed in millimeters per second. */
+	uint32_t course;				/**< Heading of motion in 1e-2 degrees. */
+	uint32_t speedAccuracy;			/**< Speed accuracy estimate in millimeters per second. */
+	uint16_t pdop;					/**< Position dilution of precision x 100. */
+} GpsUbx_NavPvtType;
+
+/**@struct GpsUbx_SatelliteType
+ * @brief Specifies one satellite of a NAV-SAT message.
+ */
+typedef struct GpsUbx_SatelliteTypeTag
+{
+	uint8_t gnssId;					/**< GNSS identifier (0 GPS, 2 Galileo, 3 BeiDou, 6 GLONASS ...). */
+	uint8_t svId;					/**< Satellite identifier within the GNSS. */
+	uint8_t cno;					/**< Carrier to noise ratio in dBHz. */
+	int8_t elevation;				/**< Elevation in degrees. */
+	int16_t azimuth;				/**< Azimuth in degrees. */
+	uint8_t isUsed;					/**< 1 if the satellite is used for navigation, else 0. */
+} GpsUbx_SatelliteType;
+
+/**@struct GpsUbx_DecoderType
+ * @brief Specifies the state of a streaming frame decoder.
+ */
+typedef struct GpsUbx_DecoderTypeTag
+{
+	uint8_t state;								/**< Decoder state. */
+	uint8_t msgClass;							/**< Message class of the frame. */
+	uint8_t msgId;								/**< Message identifier of the frame. */
+	uint8_t ckA;								/**< Running Fletcher checksum, first byte. */
+	uint8_t ckB;								/**< Running Fletcher checksum, second byte. */
+	uint16_t length;							/**< Payload length of the frame. */
+	uint16_t index;								/**< Number of payload bytes received. */
+	uint8_t payload[GPSUBX_MAX_PAYLOAD];		/**< First payload bytes of the frame. */
+} GpsUbx_DecoderType;
+
+extern uint32_t GpsUbx_Encode(const uint8_t msgClass, const uint8_t msgId, const uint8_t *payload, const uint16_t length, uint8_t *frame);
+extern void GpsUbx_DecoderInit(GpsUbx_DecoderType *decoder);
+extern GpsUbx_StatusType GpsUbx_Decode(GpsUbx_DecoderType *decoder, const uint8_t *data, const uint32_t length, uint32_t *consumed);
+extern uint8_t GpsUbx_GetNavPvt(const GpsUbx_DecoderType *decoder, GpsUbx_NavPvtType *pvt);
+extern uint32_t GpsUbx_GetNavSat(const GpsUbx_DecoderType *decoder, GpsUbx_SatelliteType *satellites, const uint32_t number);
+
+#endif /* GPSUBX_H */
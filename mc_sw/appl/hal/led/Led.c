@@ -82,8 +82,9 @@ typedef struct Led_ContainerTypeTag
 {
 	Led_ConfigType config;			/**< Configuration of the LED. */
 	Led_TimerType timer;			/**< Timer(s) for the LED. */
-	Led_StateType state;			/**< State of the LED. */
+	Led_StateType state;			/**< Shadow state of the LED, the output pin is never read back. */
 	Led_ExecStateType execState;	/**< Execution function state for the LED. */
+	uint8_t isPending;				/**< Shadow state was changed and not yet written to the output pin. */
 } Led_ContainerType;
 
 /**@struct Led_DataType
@@ -97,8 +98,9 @@ typedef struct Led_DataTypeTag
 
 static void setLedActive(const Led_IdType id);
 static void setLedInactive(const Led_IdType id);
-static Led_StateType getLedState(const Led_IdType id);
+static uint8_t getLedLevel(const Led_IdType id);
 static void toggleLed(const Led_IdType id);
+static void commitLeds(void);
 
 static void toggleExec(const Led_IdType id);
 static void heartBeatExec(const Led_IdType id);
@@ -128,7 +130,6 @@ void Led_Init(uint32_t rec)
 	{
 		memcpy(&Led_Data.container[id].config, &Led_Config[id], sizeof(Led_Data.container[id].config));
 		setLedInactive(id);
-		Led_Data.container[id].state = getLedState(id);
 		Led_Data.container[id].execState = LED_EXEC_STATE_UNKNOWN;
 
 		if (Led_Data.container[id].config.exec != NULL)
@@ -147,9 +148,12 @@ void Led_Init(uint32_t rec)
 			}
 		}
 	}
+
+	commitLeds();
 }
 
 /**@brief Used to execute the LED's assigned function.
+ * @details All of the output changes of a cycle are written at the end, one register access per port.
  */
 void Led_MainFunction(void)
 {
@@ -162,6 +166,8 @@ void Led_MainFunction(void)
 			Led_Data.container[id].config.exec(id);
 		}
 	}
+
+	commitLeds();
 }
 
 /**@brief Used to deinitialize the LED driver.
@@ -173,9 +179,10 @@ void Led_Deinit(void)
 	for (id = 0u; id < (uint32_t)LED_ID_UNKNOWN; id++)
 	{
 		setLedInactive(id);
-		Led_Data.container[id].state = LED_STATE_OFF;
 		memset(&Led_Data.container[id].timer, 0u, sizeof(Led_Data.container[id].timer));
 	}
+
+	commitLeds();
 }
 
 /**@brief Used to set a LED in the ON state.
@@ -184,6 +191,7 @@ void Led_Deinit(void)
 void Led_SetOn(const Led_IdType id)
 {
 	setLedActive(id);
+	commitLeds();
 }
 
 /**@brief Used to set a LED in the OFF state.
@@ -192,6 +200,7 @@ void Led_SetOn(const Led_IdType id)
 void Led_SetOff(const Led_IdType id)
 {
 	setLedInactive(id);
+	commitLeds();
 }
 
 /**@brief LED toggle initializer.
@@ -235,82 +244,85 @@ Led_StateType Led_GetState(const Led_IdType id)
 }
 
 /**@brief Used to set the output LED in the on state.
+ * @details Only the shadow state is updated, the output pin is written by commitLeds().
  * @param[in]	id	LED identifier
  */
 static void setLedActive(const Led_IdType id)
 {
 	if (id < LED_ID_UNKNOWN)
 	{
-		if (Led_Data.container[id].config.isInverted)
-		{
-			Vfb_Write_Port_Line_Value(Led_Data.container[id].config.pinNumber, STD_LOW);
-		}
-		else
-		{
-			Vfb_Write_Port_Line_Value(Led_Data.container[id].config.pinNumber, STD_HIGH);
-		}
-		Led_Data.container[id].state = getLedState(id);
+		Led_Data.container[id].state = LED_STATE_ON;
+		Led_Data.container[id].isPending = TRUE;
 	}
 }
 
 /**@brief Used to set the output LED in the off state.
+ * @details Only the shadow state is updated, the output pin is written by commitLeds().
  * @param[in]	id	LED identifier
  */
 static void setLedInactive(const Led_IdType id)
 {
 	if (id < LED_ID_UNKNOWN)
 	{
-		if (Led_Data.container[id].config.isInverted)
-		{
-			Vfb_Write_Port_Line_Value(Led_Data.container[id].config.pinNumber, STD_HIGH);
-		}
-		else
-		{
-			Vfb_Write_Port_Line_Value(Led_Data.container[id].config.pinNumber, STD_LOW);
-		}
-		Led_Data.container[id].state = getLedState(id);
+		Led_Data.container[id].state = LED_STATE_OFF;
+		Led_Data.container[id].isPending = TRUE;
 	}
 }
 
-/**@brief Used to get output LED state.
+/**@brief Used to get the output pin logic level which corresponds to the shadow state of the LED.
  * @param[in]	id	LED identifier
- * @return		State of the LED. OFF if turned off, ON if turned on. UNKNOWN if the state can't be determined.
+ * @return		STD_HIGH or STD_LOW depending on the shadow state and the inversion of the output.
  */
-static Led_StateType getLedState(const Led_IdType id)
+static uint8_t getLedLevel(const Led_IdType id)
 {
-	Led_StateType retVal = LED_STATE_UNKNOWN;
-	if (id < LED_ID_UNKNOWN)
-	{
-		uint8_t tmp;
+	uint8_t retVal = STD_LOW;
 
-		if (Led_Config[id].isInverted)
-		{
-			tmp = ((~Vfb_Read_Port_Line_Value(Led_Data.container[id].config.pinNumber)) & 1u);
-		}
-		else
-		{
-			tmp = ((Vfb_Read_Port_Line_Value(Led_Data.container[id].config.pinNumber)) & 1u);
-		}
-		if (tmp != 0u)
-		{
-			retVal = LED_STATE_ON;
-		}
-		else
-		{
-			retVal = LED_STATE_OFF;
-		}
+	if (Led_Data.container[id].state == LED_STATE_ON)
+	{
+		retVal = STD_HIGH;
+	}
+	if (Led_Data.container[id].config.isInverted)
+	{
+		retVal ^= STD_HIGH;
 	}
 
 	return retVal;
 }
 
-/**@brief Used to toggle the output state of the LED based on the read state of the output pin.
+/**@brief Used to toggle the shadow state of the LED.
  * @param[in]	id	LED identifier
  */
 static void toggleLed(const Led_IdType id)
 {
-	Vfb_Write_Port_Line_Value(Led_Data.container[id].config.pinNumber, ((~Vfb_Read_Port_Line_Value(Led_Data.container[id].config.pinNumber)) & 1u));
-	Led_Data.container[id].state = getLedState(id);
+	if (Led_Data.container[id].state == LED_STATE_ON)
+	{
+		setLedInactive(id);
+	}
+	else
+	{
+		setLedActive(id);
+	}
+}
+
+/**@brief Used to write the pending LED changes to the output pins.
+ * @details The changes are grouped per GPIO port and each port is written with a single atomic access.
+ */
+static void commitLeds(void)
+{
+	Vfb_PortBatchType batch[LED_ID_UNKNOWN];
+	uint32_t size = 0u;
+	uint32_t id = 0u;
+
+	for (id = 0u; id < (uint32_t)LED_ID_UNKNOWN; id++)
+	{
+		if (Led_Data.container[id].isPending)
+		{
+			size = Vfb_Port_BatchAdd(batch, size, Led_Data.container[id].config.pinNumber, getLedLevel(id));
+			Led_Data.container[id].isPending = FALSE;
+		}
+	}
+
+	Vfb_Port_BatchCommit(batch, size);
 }
 
 /**@brief Implements the toggle LED function.
@@ -40,9 +40,7 @@
 #if !defined(LED_H)
 #define LED_H
 
-#include "halconf.h"
-#include "chtypes.h"
-#include "cmparams.h"
+#include <stdint.h>
 
 /**@enum Led_StateTypeTag
  * @brief Specifies the possible states of the LED.
@@ -1,8 +1,371 @@
-/*
- * UartHndl.c
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: UartHndlr.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file UartHndlr.c
+* @brief Implements the UART handler.
+*/
+/*============================================================================*/
+/* MIT License
  *
- *  Created on: Apr 12, 2016
- *      Author: modoranu_a1
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include <string.h>
+#include "UartHndlr.h"
+
+/**@brief Defines the maximum number of bytes of a single DMA transmission.
  */
+#define UARTHNDLR_TX_MAX_TRANSFER			(0xFFFFu)
 
-#include "UartHndlr.h"
+/**@struct UartHndlr_RxType
+ * @brief Container used to store the receive state of a UART channel.
+ * @details The head and tail are free running byte counters, the position inside the
+ * circular buffer is obtained by masking them with the buffer size.
+ */
+typedef struct UartHndlr_RxTypeTag
+{
+	volatile uint32_t head;		/**< Number of bytes published by the receive events. */
+	uint32_t tail;				/**< Number of bytes released by the consumer. */
+	uint32_t dmaPosition;		/**< DMA write position inside the buffer at the last receive event. */
+	uint32_t overruns;			/**< Number of times the consumer was overtaken by the DMA. */
+	uint32_t errors;			/**< Number of reported receive errors (framing, noise, overrun etc.). */
+} UartHndlr_RxType;
+
+/**@struct UartHndlr_TxType
+ * @brief Container used to store the transmit state of a UART channel.
+ * @details The head and tail are free running descriptor counters, the position inside the
+ * descriptor pool is obtained by masking them with the pool size.
+ */
+typedef struct UartHndlr_TxTypeTag
+{
+	uint32_t head;				/**< Number of queued descriptors. */
+	uint32_t tail;				/**< Number of completed descriptors. */
+	uint32_t inFlight;			/**< Number of bytes of the tail descriptor handed to the DMA. */
+	uint8_t isActive;			/**< A DMA transmission is ongoing. */
+} UartHndlr_TxType;
+
+/**@struct UartHndlr_DataType
+ * @brief Container used to store the relevant data of the UART handler.
+ */
+typedef struct UartHndlr_DataTypeTag
+{
+	UartHndlr_RxType rx[UARTHNDLR_CHANNEL_UNKNOWN];	/**< Receive state of each configured channel. */
+	UartHndlr_TxType tx[UARTHNDLR_CHANNEL_UNKNOWN];	/**< Transmit state of each configured channel. */
+} UartHndlr_DataType;
+
+static void updateRxHead(const UartHndlr_ChannelType channel);
+static void startTxI(const UartHndlr_ChannelType channel);
+
+/**@brief Stores the UART handler data.
+ */
+static UartHndlr_DataType UartHndlr_Data;
+
+/**@brief Used to initialize the UART handler.
+ * @details Every channel is started with its receive DMA running continuously into the circular buffer.
+ */
+void UartHndlr_Init(void)
+{
+	uint32_t channel = 0u;
+
+	memset(&UartHndlr_Data, 0u, sizeof(UartHndlr_Data));
+
+	for (channel = 0u; channel < (uint32_t)UARTHNDLR_CHANNEL_UNKNOWN; channel++)
+	{
+		Vfb_Write_Port_Line_Mode(UartHndlr_Config[channel].txLine, UartHndlr_Config[channel].txMode);
+		Vfb_Write_Port_Line_Mode(UartHndlr_Config[channel].rxLine, UartHndlr_Config[channel].rxMode);
+		Vfb_Uart_Start(UartHndlr_Config[channel].driver, UartHndlr_Config[channel].uartConfig);
+		Vfb_Uart_StartCircularRx(UartHndlr_Config[channel].driver, UartHndlr_Config[channel].rxBuffer, UartHndlr_Config[channel].rxBufferSize);
+	}
+}
+
+/**@brief Used to deinitialize the UART handler.
+ */
+void UartHndlr_Deinit(void)
+{
+	uint32_t channel = 0u;
+
+	for (channel = 0u; channel < (uint32_t)UARTHNDLR_CHANNEL_UNKNOWN; channel++)
+	{
+		Vfb_Uart_Stop(UartHndlr_Config[channel].driver);
+	}
+}
+
+/**@brief Used to get the received data of a channel without copying it.
+ * @details The returned block is contiguous, if the data wraps around the end of the circular
+ * buffer the remainder is returned by the next call. The data stays valid until it is released.
+ * If the consumer was overtaken by the DMA the pending data is dropped and an overrun is counted.
+ * @param[in]	channel	UART channel identifier.
+ * @param[out]	data	Start of the received data block.
+ * @return	Number of bytes in the received data block.
+ */
+uint32_t UartHndlr_GetRxData(const UartHndlr_ChannelType channel, const uint8_t **data)
+{
+	uint32_t retVal = 0u;
+
+	if (channel < UARTHNDLR_CHANNEL_UNKNOWN)
+	{
+		const uint32_t size = UartHndlr_Config[channel].rxBufferSize;
+		UartHndlr_RxType *rx = &UartHndlr_Data.rx[channel];
+		uint32_t offset;
+
+		chSysLock();
+		updateRxHead(channel);
+		chSysUnlock();
+
+		retVal = rx->head - rx->tail;
+		if (retVal >= size)
+		{
+			rx->overruns++;
+			rx->tail = rx->head;
+			retVal = 0u;
+		}
+
+		offset = rx->tail & (size - 1u);
+		if (retVal > (size - offset))
+		{
+			retVal = size - offset;
+		}
+		*data = &UartHndlr_Config[channel].rxBuffer[offset];
+	}
+
+	return retVal;
+}
+
+/**@brief Used to release received data which was processed by the consumer.
+ * @param[in]	channel	UART channel identifier.
+ * @param[in]	length	Number of bytes to release.
+ */
+void UartHndlr_ReleaseRxData(const UartHndlr_ChannelType channel, const uint32_t length)
+{
+	if (channel < UARTHNDLR_CHANNEL_UNKNOWN)
+	{
+		UartHndlr_Data.rx[channel].tail += length;
+	}
+}
+
+/**@brief Used to queue a transmit request made of caller owned buffers.
+ * @details Each segment takes one descriptor from the pool of the channel and is sent directly
+ * from the caller buffer by the DMA, nothing is copied. The request is accepted only if the pool
+ * has a free descriptor for every segment, otherwise it is rejected and the caller has to retry.
+ * Empty segments are not allowed.
+ * @param[in]	channel		UART channel identifier.
+ * @param[in]	segments	List of buffers to transmit, in order.
+ * @param[in]	count		Number of buffers in the list.
+ * @param[in]	notify		Notification called when the last buffer was sent, can be NULL.
+ * @param[in]	context		Argument passed to the notification.
+ * @return	TRUE if the request was queued, FALSE otherwise.
+ */
+uint8_t UartHndlr_Transmit(const UartHndlr_ChannelType channel, const UartHndlr_TxSegmentType *segments, const uint32_t count,
+						   const UartHndlr_TxNotifyType notify, void *context)
+{
+	uint8_t retVal = FALSE;
+	uint32_t idx = 0u;
+
+	while ((idx < count) && (segments[idx].length != 0u))
+	{
+		idx++;
+	}
+
+	if ((channel < UARTHNDLR_CHANNEL_UNKNOWN) && (count > 0u) && (idx == count))
+	{
+		const uint32_t size = UartHndlr_Config[channel].txPoolSize;
+		UartHndlr_TxType *tx = &UartHndlr_Data.tx[channel];
+
+		chSysLock();
+		if ((size - (tx->head - tx->tail)) >= count)
+		{
+			for (idx = 0u; idx < count; idx++)
+			{
+				UartHndlr_TxDescriptorType *desc = &UartHndlr_Config[channel].txPool[tx->head & (size - 1u)];
+
+				desc->data = segments[idx].data;
+				desc->length = segments[idx].length;
+				desc->notify = NULL;
+				desc->context = NULL;
+				if (idx == (count - 1u))
+				{
+					desc->notify = notify;
+					desc->context = context;
+				}
+				tx->head++;
+			}
+
+			if (tx->isActive == FALSE)
+			{
+				startTxI(channel);
+			}
+			retVal = TRUE;
+		}
+		chSysUnlock();
+	}
+
+	return retVal;
+}
+
+/**@brief Used to get the number of free transmit descriptors of a channel.
+ * @param[in]	channel	UART channel identifier.
+ * @return	Number of free transmit descriptors.
+ */
+uint32_t UartHndlr_GetTxFree(const UartHndlr_ChannelType channel)
+{
+	uint32_t retVal = 0u;
+
+	if (channel < UARTHNDLR_CHANNEL_UNKNOWN)
+	{
+		retVal = UartHndlr_Config[channel].txPoolSize - (UartHndlr_Data.tx[channel].head - UartHndlr_Data.tx[channel].tail);
+	}
+
+	return retVal;
+}
+
+/**@brief Used to get the number of receive overruns of a channel.
+ * @param[in]	channel	UART channel identifier.
+ * @return	Number of overruns.
+ */
+uint32_t UartHndlr_GetRxOverruns(const UartHndlr_ChannelType channel)
+{
+	uint32_t retVal = 0u;
+
+	if (channel < UARTHNDLR_CHANNEL_UNKNOWN)
+	{
+		retVal = UartHndlr_Data.rx[channel].overruns;
+	}
+
+	return retVal;
+}
+
+/**@brief Used to get the number of receive errors of a channel.
+ * @param[in]	channel	UART channel identifier.
+ * @return	Number of receive errors.
+ */
+uint32_t UartHndlr_GetRxErrors(const UartHndlr_ChannelType channel)
+{
+	uint32_t retVal = 0u;
+
+	if (channel < UARTHNDLR_CHANNEL_UNKNOWN)
+	{
+		retVal = UartHndlr_Data.rx[channel].errors;
+	}
+
+	return retVal;
+}
+
+/**@brief Receive event of a channel (DMA half transfer, DMA transfer complete or idle line).
+ * @details Publishes the bytes written by the DMA since the last event and notifies the consumer.
+ * @param[in]	channel	UART channel identifier.
+ */
+void UartHndlr_RxEventI(const UartHndlr_ChannelType channel)
+{
+	chSysLockFromISR();
+	updateRxHead(channel);
+	if (UartHndlr_Config[channel].rxNotify != NULL)
+	{
+		UartHndlr_Config[channel].rxNotify(channel);
+	}
+	chSysUnlockFromISR();
+}
+
+/**@brief Transmit DMA end event of a channel.
+ * @details Retires the sent part of the current descriptor, notifies the request owner when its last
+ * descriptor is done and chains the next DMA transmission.
+ * @param[in]	channel	UART channel identifier.
+ */
+void UartHndlr_TxEventI(const UartHndlr_ChannelType channel)
+{
+	const uint32_t size = UartHndlr_Config[channel].txPoolSize;
+	UartHndlr_TxType *tx = &UartHndlr_Data.tx[channel];
+	UartHndlr_TxDescriptorType *desc = &UartHndlr_Config[channel].txPool[tx->tail & (size - 1u)];
+
+	chSysLockFromISR();
+	desc->data += tx->inFlight;
+	desc->length -= tx->inFlight;
+	tx->inFlight = 0u;
+	tx->isActive = FALSE;
+
+	if (desc->length == 0u)
+	{
+		tx->tail++;
+		if (desc->notify != NULL)
+		{
+			desc->notify(channel, desc->context);
+		}
+	}
+
+	if (tx->head != tx->tail)
+	{
+		startTxI(channel);
+	}
+	chSysUnlockFromISR();
+}
+
+/**@brief Receive error event of a channel.
+ * @param[in]	channel	UART channel identifier.
+ * @param[in]	flags	Error flags reported by the driver.
+ */
+void UartHndlr_RxErrorI(const UartHndlr_ChannelType channel, const uint32_t flags)
+{
+	(void)flags;
+	UartHndlr_Data.rx[channel].errors++;
+}
+
+/**@brief Used to hand the tail descriptor of a channel to the transmit DMA.
+ * @details Must be called with the system locked and with at least one queued descriptor.
+ * Descriptors longer than a single DMA transmission are sent in several parts.
+ * @param[in]	channel	UART channel identifier.
+ */
+static void startTxI(const UartHndlr_ChannelType channel)
+{
+	const uint32_t size = UartHndlr_Config[channel].txPoolSize;
+	UartHndlr_TxType *tx = &UartHndlr_Data.tx[channel];
+	const UartHndlr_TxDescriptorType *desc = &UartHndlr_Config[channel].txPool[tx->tail & (size - 1u)];
+
+	tx->inFlight = desc->length;
+	if (tx->inFlight > UARTHNDLR_TX_MAX_TRANSFER)
+	{
+		tx->inFlight = UARTHNDLR_TX_MAX_TRANSFER;
+	}
+	tx->isActive = TRUE;
+	Vfb_Uart_Start_Send_I(UartHndlr_Config[channel].driver, tx->inFlight, desc->data);
+}
+
+/**@brief Used to publish the bytes written by the DMA since the last update.
+ * @details Must be called with the system locked. Between two updates the DMA may write at most
+ * half of the buffer (the half transfer and transfer complete events guarantee this).
+ * @param[in]	channel	UART channel identifier.
+ */
+static void updateRxHead(const UartHndlr_ChannelType channel)
+{
+	const uint32_t size = UartHndlr_Config[channel].rxBufferSize;
+	const uint32_t position = Vfb_Uart_Get_Rx_Position(UartHndlr_Config[channel].driver, size) & (size - 1u);
+	UartHndlr_RxType *rx = &UartHndlr_Data.rx[channel];
+
+	rx->head += (position - rx->dmaPosition) & (size - 1u);
+	rx->dmaPosition = position;
+}
@@ -1,13 +1,66 @@
-/*
- * UartHndlr.h
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: UartHndlr.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file UartHndlr.h
+* @brief Implements the header of the UART handler.
+*/
+/*============================================================================*/
+/* MIT License
  *
- *  Created on: Apr 12, 2016
- *      Author: modoranu_a1
- */
-
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
 #if !defined(UARTHNDLR_H)
 #define UARTHNDLR_H
 
 #include "UartHndlr_Cfg.h"
 
+/**@struct UartHndlr_TxSegmentType
+ * @brief Specifies one caller owned buffer of a transmit request.
+ */
+typedef struct UartHndlr_TxSegmentTypeTag
+{
+	const uint8_t *data;	/**< Data to transmit, must stay valid until the request is completed. */
+	uint32_t length;		/**< Number of bytes to transmit. */
+} UartHndlr_TxSegmentType;
+
+extern void UartHndlr_Init(void);
+extern void UartHndlr_Deinit(void);
+extern uint32_t UartHndlr_GetRxData(const UartHndlr_ChannelType channel, const uint8_t **data);
+extern void UartHndlr_ReleaseRxData(const UartHndlr_ChannelType channel, const uint32_t length);
+extern uint8_t UartHndlr_Transmit(const UartHndlr_ChannelType channel, const UartHndlr_TxSegmentType *segments, const uint32_t count, const UartHndlr_TxNotifyType notify, void *context);
+extern uint32_t UartHndlr_GetTxFree(const UartHndlr_ChannelType channel);
+extern uint32_t UartHndlr_GetRxOverruns(const UartHndlr_ChannelType channel);
+extern uint32_t UartHndlr_GetRxErrors(const UartHndlr_ChannelType channel);
+extern void UartHndlr_RxEventI(const UartHndlr_ChannelType channel);
+extern void UartHndlr_TxEventI(const UartHndlr_ChannelType channel);
+extern void UartHndlr_RxErrorI(const UartHndlr_ChannelType channel, const uint32_t flags);
+
 #endif /* UARTHNDLR_H */
@@ -0,0 +1,484 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Clock.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Clock.c
+* @brief Implements the system clock service, disciplined to the GPS time pulse.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include <string.h>
+#include "Clock.h"
+#include "Gps.h"
+#include "Log.h"
+#include "SoftwareTimer.h"
+
+/* The clock counts microseconds since 2000-01-01 00:00 UTC (leap seconds not counted) and is
+ * interpolated from the realtime counter since an anchor. The MainFunction moves the anchor forward,
+ * so the counter difference never wraps. A PPS edge matched to the UTC second of a fix measures the
+ * counter frequency and the time error: small errors are slewed out within the next second through
+ * the interpolation scale, large ones step the anchor. Without PPS the clock is set from the fix time
+ * or, at boot, from the RTC, which is set back from the disciplined clock. The anchor is read lock
+ * free against a sequence number, so the time can be taken from any task or ISR. */
+
+/**@brief Defines the number of microseconds in a second.
+ */
+#define CLOCK_US_PER_SECOND				(1000000u)
+
+/**@brief Defines the number of microseconds in a day.
+ */
+#define CLOCK_US_PER_DAY				((uint64_t)86400u * CLOCK_US_PER_SECOND)
+
+/**@brief Defines the number of days from 0000-03-01 to 2000-01-01 in the proleptic Gregorian calendar.
+ */
+#define CLOCK_DAYS_TO_EPOCH				(730425u)
+
+/**@struct Clock_DataType
+ * @brief Container used to store the relevant data of the clock service.
+ */
+typedef struct Clock_DataTypeTag
+{
+	volatile uint32_t sequence;		/**< Anchor sequence number, odd while the anchor is written. */
+	uint32_t anchorCounter;			/**< Realtime counter at the anchor. */
+	uint64_t anchorTime;			/**< Clock time at the anchor in microseconds. */
+	uint32_t anchorFraction;		/**< Clock time at the anchor below one microsecond, in 2^-32 microseconds. */
+	uint32_t scale;					/**< Clock time per realtime counter cycle, in 2^-32 microseconds. */
+	uint64_t frequency;				/**< Estimated realtime counter frequency, in 2^-16 Hz. */
+	int32_t slew;					/**< Time error in microseconds being removed within the current second. */
+	uint32_t edgeCounter;			/**< Realtime counter at the last PPS edge, written by the ISR. */
+	uint32_t matchedEdges;			/**< Number of PPS edges when the last edge was matched to a fix. */
+	uint32_t lastCounter;			/**< Realtime counter at the last accepted PPS edge. */
+	uint64_t lastTime;				/**< UTC of the last accepted PPS edge in microseconds, 0 if none. */
+	uint32_t fixTime;				/**< Time of day of the last used fix in milliseconds. */
+	uint32_t outliers;				/**< Consecutive PPS edges above CLOCK_STEP_THRESHOLD. */
+	uint32_t ppsTimer;				/**< MainFunction cycles until the holdover. */
+	uint32_t ppsReload;				/**< Reload value of ppsTimer. */
+	uint32_t rtcTimer;				/**< MainFunction cycles until the next RTC update. */
+	uint32_t rtcReload;				/**< Reload value of rtcTimer. */
+	uint8_t isRtcPending;			/**< The RTC is set at the next second. */
+	Clock_StatusType status;		/**< Status. */
+} Clock_DataType;
+
+static void ppsEdgeIsr(const Vfb_LineType line);
+static void matchFix(const uint32_t counter, const uint64_t time);
+static void discipline(const uint32_t counter, const uint64_t utc);
+static void step(const uint32_t counter, const uint64_t utc, const Clock_SourceType source);
+static void readTime(const uint32_t counter, uint64_t *time, uint32_t *fraction);
+static void writeAnchor(const uint32_t counter, const uint64_t time, const uint32_t fraction, const int32_t slew);
+static uint64_t toTime(const uint32_t year, const uint32_t month, const uint32_t day, const uint32_t millisecond);
+static void toDate(const uint64_t time, Vfb_RtcDateTimeType *timespec);
+
+/**@brief Stores the clock service data.
+ */
+static Clock_DataType Clock_Data;
+
+/**@brief Used to initialize the clock service.
+ * @details Starts from the RTC if its calendar is set, enables the PPS edge interrupt. Must be
+ * called after the OS is initialized, the time reads 0 before.
+ * @param[in]	rec	The recurrence of the MainFunction in milliseconds.
+ */
+void Clock_Init(const uint32_t rec)
+{
+	Vfb_RtcDateTimeType timespec;
+	uint64_t time = 0u;
+
+	memset(&Clock_Data, 0u, sizeof(Clock_Data));
+	if (rec != 0u)
+	{
+		Clock_Data.ppsReload = CLOCK_PPS_TIMEOUT / rec;
+		Clock_Data.rtcReload = (CLOCK_RTC_PERIOD * 1000u) / rec;
+	}
+	Clock_Data.frequency = (uint64_t)CLOCK_COUNTER_FREQUENCY << 16u;
+
+	Vfb_Rtc_Get_Time(CLOCK_RTC, &timespec);
+	if (((timespec.year + VFB_RTC_BASE_YEAR) >= CLOCK_RTC_MIN_YEAR) && (timespec.month >= 1u) && (timespec.month <= 12u) && (timespec.day >= 1u))
+	{
+		time = toTime(timespec.year + VFB_RTC_BASE_YEAR, timespec.month, timespec.day, timespec.millisecond);
+		Clock_Data.status.source = CLOCK_SOURCE_RTC;
+	}
+	writeAnchor(chSysGetRealtimeCounterX(), time, 0u, 0);
+
+	Vfb_Port_EnableLineEvent(CLOCK_PPS_LINE, ppsEdgeIsr);
+}
+
+/**@brief Used to move the anchor, to discipline the clock to the GPS time and to update the RTC.
+ * @details Must run at least every 20 s (realtime counter wrap) and right after Gps_MainFunction(),
+ * the delay of the fix merge counts into CLOCK_FIX_LATENCY.
+ */
+void Clock_MainFunction(void)
+{
+	const uint32_t counter = chSysGetRealtimeCounterX();
+	uint64_t time = 0u;
+	uint32_t fraction = 0u;
+
+	readTime(counter, &time, &fraction);
+	writeAnchor(counter, time, fraction, Clock_Data.slew);
+	matchFix(counter, time);
+
+	swTimer_tick(Clock_Data.ppsTimer);
+	if ((swTimer_isElapsed(Clock_Data.ppsTimer)) && ((Clock_Data.slew != 0) || (Clock_Data.status.isLocked)))
+	{
+		readTime(counter, &time, &fraction);
+		writeAnchor(counter, time, fraction, 0);
+		Clock_Data.status.isLocked = FALSE;
+		Log_Warning("clock holdover after %u pps edges", Clock_Data.status.edges);
+	}
+
+	swTimer_tick(Clock_Data.rtcTimer);
+	if ((swTimer_isElapsed(Clock_Data.rtcTimer)) && (Clock_Data.status.source >= CLOCK_SOURCE_GPS))
+	{
+		Clock_Data.isRtcPending = TRUE;
+	}
+	readTime(counter, &time, &fraction);
+	if ((Clock_Data.isRtcPending) && ((time % CLOCK_US_PER_SECOND) < ((uint64_t)CLOCK_RTC_WINDOW * 1000u)))
+	{
+		Vfb_RtcDateTimeType timespec;
+
+		toDate(time, &timespec);
+		Vfb_Rtc_Set_Time(CLOCK_RTC, &timespec);
+		Clock_Data.isRtcPending = FALSE;
+		swTimer_set(Clock_Data.rtcTimer, Clock_Data.rtcReload);
+		Clock_Data.status.rtcUpdates++;
+	}
+}
+
+/**@brief Used to get the clock time.
+ * @details Lock free, can be called from any task or ISR.
+ * @return	Microseconds since 2000-01-01 00:00 UTC.
+ */
+uint64_t Clock_GetTime(void)
+{
+	return Clock_GetTimeAt(chSysGetRealtimeCounterX());
+}
+
+/**@brief Used to convert a realtime counter value taken earlier (e.g. in a sensor ISR) to clock time.
+ * @details Lock free, can be called from any task or ISR. The counter value must be less than 20 s old.
+ * @param[in]	counter	Realtime counter value.
+ * @return	Microseconds since 2000-01-01 00:00 UTC.
+ */
+uint64_t Clock_GetTimeAt(const uint32_t counter)
+{
+	uint64_t time = 0u;
+	uint32_t fraction = 0u;
+
+	readTime(counter, &time, &fraction);
+
+	return time;
+}
+
+/**@brief Used to get the state of the clock discipline.
+ * @param[out]	status	State of the clock discipline.
+ */
+void Clock_GetStatus(Clock_StatusType *status)
+{
+	const int64_t deviation = (int64_t)Clock_Data.frequency - ((int64_t)CLOCK_COUNTER_FREQUENCY << 16u);
+
+	chSysLock();
+	*status = Clock_Data.status;
+	chSysUnlock();
+	status->frequencyError = (int32_t)((deviation * 1000000) / (((int64_t)CLOCK_COUNTER_FREQUENCY * 65536) / 1000));
+}
+
+/**@brief PPS edge interrupt callback, takes the realtime counter at the rising edge.
+ * @details The edge interrupt latency (kernel critical sections) is the time stamp jitter.
+ * @param[in]	line	Pin on which the edge occurred.
+ */
+static void ppsEdgeIsr(const Vfb_LineType line)
+{
+	const uint32_t counter = chSysGetRealtimeCounterX();
+
+	if (Vfb_Dio_Read_Channel(line) == STD_HIGH)
+	{
+		chSysLockFromISR();
+		Clock_Data.edgeCounter = counter;
+		Clock_Data.status.edges++;
+		chSysUnlockFromISR();
+	}
+}
+
+/**@brief Used to match a new fix time to the last PPS edge, or to set the clock from it without PPS.
+ * @details The edge of the UTC second E precedes the fix (epoch T, merged at T + latency), so
+ * E = T + latency - age of the edge: the only whole second in [T - age, T - age + CLOCK_FIX_LATENCY).
+ * @param[in]	counter	Realtime counter of this MainFunction call.
+ * @param[in]	time	Clock time at counter in microseconds.
+ */
+static void matchFix(const uint32_t counter, const uint64_t time)
+{
+	Gps_FixType fix;
+	uint32_t edgeCounter = 0u;
+	uint32_t edges = 0u;
+
+	chSysLock();
+	edgeCounter = Clock_Data.edgeCounter;
+	edges = Clock_Data.status.edges;
+	chSysUnlock();
+
+	Gps_GetFix(&fix);
+	if ((fix.isValid) && (fix.time != Clock_Data.fixTime) && (fix.month >= 1u) && (fix.month <= 12u) && (fix.day >= 1u))
+	{
+		const uint64_t fixTime = toTime(2000u + fix.year, fix.month, fix.day, fix.time);
+		const uint64_t latency = (uint64_t)CLOCK_FIX_LATENCY * 1000u;
+
+		Clock_Data.fixTime = fix.time;
+		if (edges != Clock_Data.matchedEdges)
+		{
+			const uint64_t earliest = fixTime - (((uint64_t)(counter - edgeCounter) * Clock_Data.scale) >> 32u);
+			const uint64_t second = ((earliest + CLOCK_US_PER_SECOND - 1u) / CLOCK_US_PER_SECOND) * CLOCK_US_PER_SECOND;
+
+			Clock_Data.matchedEdges = edges;
+			if ((second - earliest) < latency)
+			{
+				discipline(edgeCounter, second);
+			}
+			else
+			{
+				Clock_Data.status.rejects++;
+			}
+		}
+		else if (swTimer_isElapsed(Clock_Data.ppsTimer))
+		{
+			if ((time < fixTime) || (time > (fixTime + latency)))
+			{
+				step(counter, fixTime + (latency / 2u), CLOCK_SOURCE_GPS);
+			}
+			else if (Clock_Data.status.source < CLOCK_SOURCE_GPS)
+			{
+				Clock_Data.status.source = CLOCK_SOURCE_GPS;
+				Clock_Data.isRtcPending = TRUE;
+			}
+		}
+	}
+}
+
+/**@brief Used to discipline the clock to a PPS edge matched to its UTC second.
+ * @details The frequency is measured over the interval from the last accepted edge. An error up to
+ * CLOCK_STEP_THRESHOLD is slewed out within the next second, at most CLOCK_SLEW_LIMIT. A disciplined
+ * clock is only stepped after CLOCK_STEP_CONFIRM edges in a row above the threshold.
+ * @param[in]	counter	Realtime counter at the edge.
+ * @param[in]	utc		UTC of the edge in microseconds.
+ */
+static void discipline(const uint32_t counter, const uint64_t utc)
+{
+	uint64_t time = 0u;
+	uint32_t fraction = 0u;
+	uint64_t frequency = Clock_Data.frequency;
+	uint8_t isAccepted = TRUE;
+	int64_t error = 0;
+
+	if ((Clock_Data.lastTime != 0u) && (utc > Clock_Data.lastTime) && ((utc - Clock_Data.lastTime) <= ((uint64_t)CLOCK_PPS_GAP * CLOCK_US_PER_SECOND)))
+	{
+		const uint32_t seconds = (uint32_t)((utc - Clock_Data.lastTime) / CLOCK_US_PER_SECOND);
+		const uint64_t cycles = (uint64_t)(uint32_t)(counter - Clock_Data.lastCounter);
+		const uint64_t expected = (uint64_t)seconds * (Clock_Data.frequency >> 16u);
+		const uint64_t tolerance = (expected / CLOCK_US_PER_SECOND) * CLOCK_FREQUENCY_TOLERANCE;
+
+		if ((cycles + tolerance >= expected) && (cycles <= expected + tolerance))
+		{
+			const int64_t measured = (int64_t)((cycles << 16u) / seconds);
+
+			frequency = (uint64_t)((int64_t)frequency + ((measured - (int64_t)frequency) / (1 << CLOCK_FREQUENCY_SHIFT)));
+		}
+		else
+		{
+			isAccepted = FALSE;
+		}
+	}
+
+	readTime(counter, &time, &fraction);
+	error = (int64_t)(time - utc);
+
+	if (isAccepted == FALSE)
+	{
+		Clock_Data.status.rejects++;
+	}
+	else if ((error > CLOCK_STEP_THRESHOLD) || (error < -(int64_t)CLOCK_STEP_THRESHOLD))
+	{
+		Clock_Data.outliers++;
+		if ((Clock_Data.status.source == CLOCK_SOURCE_PPS) && (Clock_Data.outliers < CLOCK_STEP_CONFIRM))
+		{
+			Clock_Data.status.rejects++;
+			isAccepted = FALSE;
+		}
+		else
+		{
+			Clock_Data.frequency = frequency;
+			step(counter, utc, CLOCK_SOURCE_PPS);
+		}
+	}
+	else
+	{
+		const int32_t slew = (int32_t)error;
+
+		Clock_Data.outliers = 0u;
+		Clock_Data.frequency = frequency;
+		if (Clock_Data.status.source != CLOCK_SOURCE_PPS)
+		{
+			Clock_Data.status.source = CLOCK_SOURCE_PPS;
+			Clock_Data.isRtcPending = TRUE;
+		}
+		writeAnchor(counter, time, fraction, (slew > CLOCK_SLEW_LIMIT) ? CLOCK_SLEW_LIMIT : ((slew < -CLOCK_SLEW_LIMIT) ? -CLOCK_SLEW_LIMIT : slew));
+		Clock_Data.status.isLocked = ((slew <= CLOCK_LOCK_ERROR) && (slew >= -CLOCK_LOCK_ERROR)) ? TRUE : FALSE;
+	}
+
+	if (isAccepted)
+	{
+		Clock_Data.status.offset = (error > INT32_MAX) ? INT32_MAX : ((error < INT32_MIN) ? INT32_MIN : (int32_t)error);
+		Clock_Data.lastCounter = counter;
+		Clock_Data.lastTime = utc;
+		swTimer_set(Clock_Data.ppsTimer, Clock_Data.ppsReload);
+	}
+}
+
+/**@brief Used to step the clock.
+ * @param[in]	counter	Realtime counter of the new time.
+ * @param[in]	utc		New time in microseconds.
+ * @param[in]	source	Reference of the new time.
+ */
+static void step(const uint32_t counter, const uint64_t utc, const Clock_SourceType source)
+{
+	writeAnchor(counter, utc, 0u, 0);
+	Clock_Data.outliers = 0u;
+	Clock_Data.status.source = source;
+	Clock_Data.status.isLocked = FALSE;
+	Clock_Data.status.steps++;
+	Clock_Data.isRtcPending = TRUE;
+	Log_Info("clock step to %u s, source %u", (uint32_t)(utc / CLOCK_US_PER_SECOND), (uint32_t)source);
+}
+
+/**@brief Used to interpolate the clock time at a realtime counter value from the anchor.
+ * @details Retried while the anchor is written, the writer never waits for a reader.
+ * @param[in]	counter		Realtime counter value, at most 2^31 cycles from the anchor.
+ * @param[out]	time		Clock time in microseconds.
+ * @param[out]	fraction	Clock time below one microsecond, in 2^-32 microseconds.
+ */
+static void readTime(const uint32_t counter, uint64_t *time, uint32_t *fraction)
+{
+	uint32_t sequence = 0u;
+	uint32_t anchorCounter = 0u;
+	uint64_t anchorTime = 0u;
+	uint32_t anchorFraction = 0u;
+	uint32_t scale = 0u;
+	int32_t delta = 0;
+
+	do
+	{
+		sequence = __atomic_load_n(&Clock_Data.sequence, __ATOMIC_ACQUIRE);
+		anchorCounter = Clock_Data.anchorCounter;
+		anchorTime = Clock_Data.anchorTime;
+		anchorFraction = Clock_Data.anchorFraction;
+		scale = Clock_Data.scale;
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	} while (((sequence & 1u) != 0u) || (sequence != __atomic_load_n(&Clock_Data.sequence, __ATOMIC_RELAXED)));
+
+	delta = (int32_t)(counter - anchorCounter);
+	if (delta >= 0)
+	{
+		const uint64_t sum = ((uint64_t)(uint32_t)delta * scale) + anchorFraction;
+
+		*time = anchorTime + (sum >> 32u);
+		*fraction = (uint32_t)sum;
+	}
+	else
+	{
+		const uint64_t back = (uint64_t)(0u - (uint32_t)delta) * scale;
+
+		*time = anchorTime - (back >> 32u) - (((uint32_t)back > anchorFraction) ? 1u : 0u);
+		*fraction = anchorFraction - (uint32_t)back;
+	}
+}
+
+/**@brief Used to write the anchor and the interpolation scale.
+ * @param[in]	counter		Realtime counter at the anchor.
+ * @param[in]	time		Clock time at the anchor in microseconds.
+ * @param[in]	fraction	Clock time at the anchor below one microsecond, in 2^-32 microseconds.
+ * @param[in]	slew		Time error in microseconds to remove within the next second, clock minus UTC.
+ */
+static void writeAnchor(const uint32_t counter, const uint64_t time, const uint32_t fraction, const int32_t slew)
+{
+	const int64_t hertz = (int64_t)((Clock_Data.frequency + 0x8000u) >> 16u);
+	const uint64_t effective = (uint64_t)(hertz + ((hertz * slew) / (int64_t)CLOCK_US_PER_SECOND));
+	const uint32_t scale = (uint32_t)(((uint64_t)CLOCK_US_PER_SECOND << 32u) / effective);
+
+	chSysLock();
+	__atomic_store_n(&Clock_Data.sequence, Clock_Data.sequence + 1u, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	Clock_Data.anchorCounter = counter;
+	Clock_Data.anchorTime = time;
+	Clock_Data.anchorFraction = fraction;
+	Clock_Data.scale = scale;
+	__atomic_store_n(&Clock_Data.sequence, Clock_Data.sequence + 1u, __ATOMIC_RELEASE);
+	Clock_Data.slew = slew;
+	chSysUnlock();
+}
+
+/**@brief Used to convert a UTC calendar date and time of day to clock time.
+ * @param[in]	year		Year, from 2000.
+ * @param[in]	month		Month, 1 to 12.
+ * @param[in]	day			Day of month, 1 to 31.
+ * @param[in]	millisecond	Time of day in milliseconds.
+ * @return	Microseconds since 2000-01-01 00:00 UTC.
+ */
+static uint64_t toTime(const uint32_t year, const uint32_t month, const uint32_t day, const uint32_t millisecond)
+{
+	const uint32_t marchYear = (month <= 2u) ? (year - 1u) : year;
+	const uint32_t era = marchYear / 400u;
+	const uint32_t yearOfEra = marchYear - (era * 400u);
+	const uint32_t dayOfYear = ((((153u * ((month > 2u) ? (month - 3u) : (month + 9u))) + 2u) / 5u) + day) - 1u;
+	const uint32_t dayOfEra = (yearOfEra * 365u) + (yearOfEra / 4u) - (yearOfEra / 100u) + dayOfYear;
+	const uint32_t days = (era * 146097u) + dayOfEra - CLOCK_DAYS_TO_EPOCH;
+
+	return (((uint64_t)days * 86400000u) + millisecond) * 1000u;
+}
+
+/**@brief Used to convert clock time to a UTC calendar date and time of day.
+ * @param[in]	time		Microseconds since 2000-01-01 00:00 UTC.
+ * @param[out]	timespec	Date and time.
+ */
+static void toDate(const uint64_t time, Vfb_RtcDateTimeType *timespec)
+{
+	const uint32_t days = (uint32_t)(time / CLOCK_US_PER_DAY);
+	const uint32_t marchDays = days + CLOCK_DAYS_TO_EPOCH;
+	const uint32_t era = marchDays / 146097u;
+	const uint32_t dayOfEra = marchDays - (era * 146097u);
+	const uint32_t yearOfEra = (dayOfEra - (dayOfEra / 1460u) + (dayOfEra / 36524u) - (dayOfEra / 146096u)) / 365u;
+	const uint32_t dayOfYear = dayOfEra - ((yearOfEra * 365u) + (yearOfEra / 4u) - (yearOfEra / 100u));
+	const uint32_t marchMonth = ((5u * dayOfYear) + 2u) / 153u;
+	const uint32_t month = (marchMonth < 10u) ? (marchMonth + 3u) : (marchMonth - 9u);
+
+	timespec->year = ((yearOfEra + (era * 400u) + ((month <= 2u) ? 1u : 0u)) - VFB_RTC_BASE_YEAR) & 0xFFu;
+	timespec->month = month & 0xFu;
+	timespec->dstflag = 0u;
+	timespec->dayofweek = (((days + 5u) % 7u) + 1u) & 0x7u;
+	timespec->day = ((dayOfYear - ((((153u * marchMonth) + 2u) / 5u))) + 1u) & 0x1Fu;
+	timespec->millisecond = (uint32_t)((time % CLOCK_US_PER_DAY) / 1000u);
+}
@@ -0,0 +1,77 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Clock.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Clock.h
+* @brief Implements the header of the system clock service.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#if !defined(CLOCK_H)
+#define CLOCK_H
+
+#include "Clock_Cfg.h"
+
+/**@enum Clock_SourceTypeTag
+ * @brief Specifies the reference the clock was last set from.
+ */
+typedef enum Clock_SourceTypeTag
+{
+	CLOCK_SOURCE_NONE = 0u,			/**< Not set, counts from 2000-01-01 at init. */
+	CLOCK_SOURCE_RTC,				/**< Set from the RTC at init. */
+	CLOCK_SOURCE_GPS,				/**< Set from the fix time, within CLOCK_FIX_LATENCY. */
+	CLOCK_SOURCE_PPS				/**< Disciplined to the PPS edges. */
+} Clock_SourceType;
+
+/**@struct Clock_StatusType
+ * @brief Specifies the state of the clock discipline.
+ */
+typedef struct Clock_StatusTypeTag
+{
+	Clock_SourceType source;		/**< Reference the clock was last set from. */
+	uint8_t isLocked;				/**< TRUE while the PPS edges arrive and the time error is below CLOCK_LOCK_ERROR. */
+	int32_t offset;					/**< Time error at the last PPS edge in microseconds, clock minus UTC. */
+	int32_t frequencyError;			/**< Estimated deviation of the realtime counter from its nominal frequency in ppb. */
+	uint32_t edges;					/**< Number of PPS edges. */
+	uint32_t rejects;				/**< Number of PPS edges rejected (interval or time error). */
+	uint32_t steps;					/**< Number of time steps. */
+	uint32_t rtcUpdates;			/**< Number of RTC updates. */
+} Clock_StatusType;
+
+extern void Clock_Init(const uint32_t rec);
+extern void Clock_MainFunction(void);
+extern uint64_t Clock_GetTime(void);
+extern uint64_t Clock_GetTimeAt(const uint32_t counter);
+extern void Clock_GetStatus(Clock_StatusType *status);
+
+#endif /* CLOCK_H */
@@ -0,0 +1,199 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Log.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Log.c
+* @brief Implements the deferred formatting binary logging.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include <string.h>
+#include "ch.h"
+#include "Log.h"
+#include "Clock.h"
+#include "Link.h"
+
+/**@brief Defines the commit marker of a record header word.
+ */
+#define LOG_RECORD_VALID			(0x80000000u)
+
+/**@brief Defines the position of the argument count in a record header word.
+ */
+#define LOG_RECORD_NARGS_SHIFT		(28u)
+
+/**@brief Defines the mask of the site identifier and level in a record header word.
+ */
+#define LOG_RECORD_SITE_MASK		(0x0FFFFFFFu)
+
+/**@brief Defines the number of words of a record without arguments (header and time stamp).
+ */
+#define LOG_RECORD_OVERHEAD			(2u)
+
+/**@struct Log_DataType
+ * @brief Container used to store the relevant data of the logging.
+ * @details The ring holds records of LOG_RECORD_OVERHEAD + count words. Producers reserve space by
+ * advancing head with a compare and swap and commit a record by writing its header word last. The
+ * consumer only reads records whose header carries LOG_RECORD_VALID.
+ */
+typedef struct Log_DataTypeTag
+{
+	volatile uint32_t ring[LOG_RING_SIZE];	/**< Log record ring. */
+	volatile uint32_t head;					/**< Number of reserved words. */
+	volatile uint32_t tail;					/**< Number of words sent to the host. */
+	volatile uint32_t dropped;				/**< Number of records dropped because the ring was full. */
+} Log_DataType;
+
+/**@brief Stores the logging data.
+ */
+static Log_DataType Log_Data;
+
+/**@brief Used to initialize the logging.
+ */
+void Log_Init(void)
+{
+	memset((void *)&Log_Data, 0u, sizeof(Log_Data));
+}
+
+/**@brief Used to send the committed log records to the host.
+ * @details Whole records are packed into LINKCODEC_MSG_ID_LOG frames as little endian words. If
+ * the link is busy the records stay in the ring and are sent by the next call.
+ */
+void Log_MainFunction(void)
+{
+	uint32_t frames = 0u;
+	uint8_t isBlocked = FALSE;
+
+	while ((frames < LOG_FRAMES_PER_CYCLE) && (isBlocked == FALSE))
+	{
+		uint32_t payload[LINKCODEC_MAX_PAYLOAD / sizeof(uint32_t)];
+		uint32_t words = 0u;
+		uint32_t tail = Log_Data.tail;
+		uint8_t isFull = FALSE;
+
+		while (isFull == FALSE)
+		{
+			const uint32_t header = __atomic_load_n(&Log_Data.ring[tail & (LOG_RING_SIZE - 1u)], __ATOMIC_ACQUIRE);
+			const uint32_t size = LOG_RECORD_OVERHEAD + ((header >> LOG_RECORD_NARGS_SHIFT) & 0x7u);
+
+			if (((header & LOG_RECORD_VALID) == 0u) || ((words + size) > (sizeof(payload) / sizeof(uint32_t))))
+			{
+				isFull = TRUE;
+			}
+			else
+			{
+				uint32_t idx = 0u;
+
+				for (idx = 0u; idx < size; idx++)
+				{
+					payload[words] = Log_Data.ring[tail & (LOG_RING_SIZE - 1u)];
+					payload[words] &= (idx == 0u) ? ~LOG_RECORD_VALID : 0xFFFFFFFFu;
+					words++;
+					tail++;
+				}
+			}
+		}
+
+		if (words == 0u)
+		{
+			isBlocked = TRUE;
+		}
+		else if (Link_Send(LINKCODEC_MSG_ID_LOG, (const uint8_t *)payload, words * sizeof(uint32_t), FALSE))
+		{
+			uint32_t idx = 0u;
+
+			for (idx = Log_Data.tail; idx != tail; idx++)
+			{
+				Log_Data.ring[idx & (LOG_RING_SIZE - 1u)] = 0u;
+			}
+			__atomic_store_n(&Log_Data.tail, tail, __ATOMIC_RELEASE);
+			frames++;
+		}
+		else
+		{
+			isBlocked = TRUE;
+		}
+	}
+}
+
+/**@brief Used to record a log site with its raw arguments.
+ * @details Lock free, can be called from any task or ISR. Use the Log() macros instead of calling it directly.
+ * The time stamp is the low word of the clock time in microseconds, the clock step records give the full time.
+ * @param[in]	site	Log site identifier and level.
+ * @param[in]	args	Raw arguments.
+ * @param[in]	count	Number of arguments.
+ */
+void Log_Write(const uint32_t site, const uint32_t *args, const uint32_t count)
+{
+	const uint32_t size = LOG_RECORD_OVERHEAD + count;
+	uint32_t head = Log_Data.head;
+	uint8_t isReserved = FALSE;
+
+	do
+	{
+		if ((head + size - Log_Data.tail) > LOG_RING_SIZE)
+		{
+			__atomic_fetch_add(&Log_Data.dropped, 1u, __ATOMIC_RELAXED);
+			break;
+		}
+		isReserved = __atomic_compare_exchange_n(&Log_Data.head, &head, head + size, FALSE, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+	} while (isReserved == FALSE);
+
+	if (isReserved)
+	{
+		uint32_t idx = 0u;
+
+		Log_Data.ring[(head + 1u) & (LOG_RING_SIZE - 1u)] = (uint32_t)Clock_GetTime();
+		for (idx = 0u; idx < count; idx++)
+		{
+			Log_Data.ring[(head + LOG_RECORD_OVERHEAD + idx) & (LOG_RING_SIZE - 1u)] = args[idx];
+		}
+		__atomic_store_n(&Log_Data.ring[head & (LOG_RING_SIZE - 1u)],
+						 LOG_RECORD_VALID | (count << LOG_RECORD_NARGS_SHIFT) | (site & LOG_RECORD_SITE_MASK), __ATOMIC_RELEASE);
+	}
+}
+
+/**@brief Used to get the number of log records dropped because the ring was full.
+ * @return	Number of dropped records.
+ */
+uint32_t Log_GetDropped(void)
+{
+	return Log_Data.dropped;
+}
+
+/**@brief Used to get the number of ring words reserved and not yet sent to the host.
+ * @return	Number of pending words, at most LOG_RING_SIZE.
+ */
+uint32_t Log_GetPending(void)
+{
+	return Log_Data.head - Log_Data.tail;
+}
@@ -0,0 +1,118 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Log.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Log.h
+* @brief Implements the header of the deferred formatting binary logging.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#if !defined(LOG_H)
+#define LOG_H
+
+#include <stdint.h>
+
+/**@brief Defines the error log level.
+ */
+#define LOG_LEVEL_ERROR				(0u)
+
+/**@brief Defines the warning log level.
+ */
+#define LOG_LEVEL_WARNING			(1u)
+
+/**@brief Defines the information log level.
+ */
+#define LOG_LEVEL_INFO				(2u)
+
+/**@brief Defines the debug log level.
+ */
+#define LOG_LEVEL_DEBUG				(3u)
+
+/**@brief Defines the highest log level which is compiled in, log sites above it generate no code.
+ */
+#if !defined(LOG_LEVEL)
+#define LOG_LEVEL					(LOG_LEVEL_INFO)
+#endif
+
+/**@brief Defines the maximum number of arguments of a log site.
+ */
+#define LOG_MAX_ARGS				(4u)
+
+/**@brief Defines the size of the log ring in 32 bit words.
+ * @note Must be a power of two.
+ */
+#define LOG_RING_SIZE				(256u)
+
+/**@brief Defines the maximum number of link frames sent by one MainFunction call.
+ */
+#define LOG_FRAMES_PER_CYCLE		(4u)
+
+/**@brief Defines the wrapper which counts the arguments of a log site (0 to LOG_MAX_ARGS).
+ */
+#define LOG_NARGS(...)				LOG_NARGS_(0, ##__VA_ARGS__, 4u, 3u, 2u, 1u, 0u)
+#define LOG_NARGS_(z, a, b, c, d, n, ...)	(n)
+
+/**@brief Defines the wrapper which places the format string of a log site in the log string table.
+ * @details The format string is never stored in flash, its offset in the table is the log site identifier.
+ */
+#define LOG_SITE(level, fmt) \
+	({ static const char Log_Site[] __attribute__((section(".logstr"), used)) = (fmt); \
+	   ((uint32_t)(uintptr_t)Log_Site | ((uint32_t)(level) << 24u)); })
+
+/**@brief Defines the log macro, only the site identifier and the raw arguments are recorded.
+ * @details The arguments are stored as 32 bit values and formatted on the host. Pointers to strings
+ * can not be logged.
+ * @param[in]	level	Log level (LOG_LEVEL_ERROR ... LOG_LEVEL_DEBUG).
+ * @param[in]	fmt		printf style format string literal.
+ */
+#define Log(level, fmt, ...) \
+	do { \
+		if ((level) <= LOG_LEVEL) \
+		{ \
+			_Static_assert(LOG_NARGS(__VA_ARGS__) <= LOG_MAX_ARGS, "Log: too many arguments"); \
+			Log_Write(LOG_SITE(level, fmt), (const uint32_t[LOG_MAX_ARGS + 1u]){0u, ##__VA_ARGS__} + 1u, LOG_NARGS(__VA_ARGS__)); \
+		} \
+	} while (0)
+
+#define Log_Error(fmt, ...)			Log(LOG_LEVEL_ERROR, fmt, ##__VA_ARGS__)
+#define Log_Warning(fmt, ...)		Log(LOG_LEVEL_WARNING, fmt, ##__VA_ARGS__)
+#define Log_Info(fmt, ...)			Log(LOG_LEVEL_INFO, fmt, ##__VA_ARGS__)
+#define Log_Debug(fmt, ...)			Log(LOG_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
+
+extern void Log_Init(void);
+extern void Log_MainFunction(void);
+extern void Log_Write(const uint32_t site, const uint32_t *args, const uint32_t count);
+extern uint32_t Log_GetDropped(void);
+extern uint32_t Log_GetPending(void);
+
+#endif /* LOG_H */
@@ -0,0 +1,545 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Fusion.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Fusion.c
+* @brief Implements the GPS/IMU position fusion (loosely coupled error-state Kalman filter).
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include <string.h>
+#include "Fusion.h"
+#include "SoftwareTimer.h"
+
+/* The filter runs in a local east, north frame. Per axis the error state is position, velocity and
+ * accelerometer bias. East and north have the same dynamics and the GPS reports an isotropic
+ * horizontal accuracy, so both axes share one 3x3 covariance. Only its upper triangle is stored and
+ * every update is a scalar one, no matrix inversion or allocation is needed. After each update the
+ * estimated error is injected into the nominal state and reset to zero.
+ *
+ * The IMU input is level frame acceleration. Producing it needs an attitude and heading estimate
+ * (gyroscope and magnetometer) to rotate the body frame samples, which the target does not have
+ * yet: only the bus and chip select of the IMU are configured (VFB_SPI_DEVICE_IMU) and nothing on
+ * the target calls Fusion_AddAcceleration(). The target therefore always runs the constant velocity
+ * model with FUSION_MANEUVER_NOISE and isImuUsed stays FALSE. The IMU path is exercised by the
+ * replay tool with recorded level frame data. */
+
+/**@brief Defines the index of the covariance entries in the stored upper triangle.
+ */
+#define FUSION_P_PP						(0u)
+#define FUSION_P_PV						(1u)
+#define FUSION_P_PB						(2u)
+#define FUSION_P_VV						(3u)
+#define FUSION_P_VB						(4u)
+#define FUSION_P_BB						(5u)
+
+/**@brief Defines the index of the measured states.
+ */
+#define FUSION_STATE_POSITION			(0u)
+#define FUSION_STATE_VELOCITY			(1u)
+
+/**@brief Defines the initial standard deviations of the velocity (m/s) and of the bias (m/s^2).
+ */
+#define FUSION_INIT_VELOCITY			(5.0f)
+#define FUSION_INIT_BIAS				(0.5f)
+
+/**@struct Fusion_NoiseType
+ * @brief Specifies the precomputed process noise of one prediction step.
+ */
+typedef struct Fusion_NoiseTypeTag
+{
+	float pp;						/**< Position variance. */
+	float pv;						/**< Position velocity covariance. */
+	float vv;						/**< Velocity variance. */
+	float bb;						/**< Bias variance. */
+} Fusion_NoiseType;
+
+/**@struct Fusion_DataType
+ * @brief Container used to store the relevant data of the position fusion.
+ */
+typedef struct Fusion_DataTypeTag
+{
+	Geo_FrameType frame;			/**< Local frame of the nominal state. */
+	float position[2u];				/**< East, north position in meters. */
+	float velocity[2u];				/**< East, north velocity in meters per second. */
+	float bias[2u];					/**< East, north accelerometer bias in m/s^2. */
+	float covariance[6u];			/**< Upper triangle of the per axis error covariance. */
+	float period;					/**< Prediction period in seconds. */
+	Fusion_NoiseType imuNoise;		/**< Process noise with IMU data. */
+	Fusion_NoiseType modelNoise;	/**< Process noise of the constant velocity model. */
+	int32_t accelSum[2u];			/**< Sum of the received east, north accelerations in mm/s^2. */
+	float accelSquareSum;			/**< Sum of the squared received acceleration magnitudes in m^2/s^4. */
+	uint32_t accelCount;			/**< Number of received accelerations. */
+	float acceleration[2u];			/**< Mean acceleration of the last IMU samples in m/s^2. */
+	uint32_t imuTimer;				/**< MainFunction cycles until the IMU data is considered lost. */
+	uint32_t imuReload;				/**< Reload value of imuTimer. */
+	float windowSum[2u];			/**< Sum of the east, north accelerations of the stillness window in m/s^2. */
+	float windowSquareSum;			/**< Sum of the squared acceleration magnitudes of the stillness window. */
+	uint32_t windowCount;			/**< Number of accelerations in the stillness window. */
+	uint32_t windowTimer;			/**< MainFunction cycles until the stillness window is evaluated. */
+	uint32_t windowReload;			/**< Reload value of windowTimer. */
+	uint32_t stillTimer;			/**< MainFunction cycles without motion until the device is still. */
+	uint32_t stillReload;			/**< Reload value of stillTimer. */
+	uint32_t gpsTimer;				/**< MainFunction cycles until the GPS is considered lost. */
+	uint32_t gpsReload;				/**< Reload value of gpsTimer. */
+	uint32_t fixTime;				/**< Time of day of the last processed fix. */
+	uint8_t rejectCount;			/**< Number of consecutive rejected fixes. */
+	uint8_t isInitialized;			/**< The nominal state was set from a fix. */
+	Fusion_StateType state;			/**< Output state. */
+	Fusion_StatisticsType stats;	/**< Statistics. */
+} Fusion_DataType;
+
+static void collect(void);
+static void detectMotion(void);
+static void predict(void);
+static void correct(const Gps_FixType *fix);
+static void update(const uint8_t measured, const float east, const float north, const float variance);
+static void reset(const Gps_FixType *fix, const float variance);
+static void recenter(void);
+static void publish(void);
+
+/**@brief Index of the covariance entry of each row and column.
+ */
+static const uint8_t Fusion_CovarianceIndex[3u][3u] =
+{
+	{ FUSION_P_PP, FUSION_P_PV, FUSION_P_PB },
+	{ FUSION_P_PV, FUSION_P_VV, FUSION_P_VB },
+	{ FUSION_P_PB, FUSION_P_VB, FUSION_P_BB }
+};
+
+/**@brief Stores the position fusion data.
+ */
+static Fusion_DataType Fusion_Data;
+
+/**@brief Used to initialize the position fusion.
+ * @param[in]	rec	The recurrence of the MainFunction in milliseconds.
+ */
+void Fusion_Init(const uint32_t rec)
+{
+	float dt2;
+
+	memset(&Fusion_Data, 0u, sizeof(Fusion_Data));
+	Fusion_Data.period = (float)rec * 0.001f;
+	Fusion_Data.fixTime = 0xFFFFFFFFu;
+	if (rec != 0u)
+	{
+		Fusion_Data.imuReload = FUSION_IMU_TIMEOUT / rec;
+		Fusion_Data.gpsReload = FUSION_GPS_TIMEOUT / rec;
+		Fusion_Data.windowReload = FUSION_STILL_WINDOW / rec;
+		Fusion_Data.stillReload = FUSION_STILL_TIME / rec;
+	}
+	swTimer_set(Fusion_Data.windowTimer, Fusion_Data.windowReload);
+	swTimer_set(Fusion_Data.stillTimer, Fusion_Data.stillReload);
+
+	/* Continuous white acceleration: Q = q [dt^3/3, dt^2/2; dt^2/2, dt], independent of the rate. */
+	dt2 = Fusion_Data.period * Fusion_Data.period;
+	Fusion_Data.imuNoise.pp = (dt2 * Fusion_Data.period * FUSION_ACCEL_NOISE * FUSION_ACCEL_NOISE) / 3.0f;
+	Fusion_Data.imuNoise.pv = 0.5f * dt2 * FUSION_ACCEL_NOISE * FUSION_ACCEL_NOISE;
+	Fusion_Data.imuNoise.vv = Fusion_Data.period * FUSION_ACCEL_NOISE * FUSION_ACCEL_NOISE;
+	Fusion_Data.imuNoise.bb = Fusion_Data.period * FUSION_BIAS_NOISE * FUSION_BIAS_NOISE;
+	Fusion_Data.modelNoise.pp = (dt2 * Fusion_Data.period * FUSION_MANEUVER_NOISE * FUSION_MANEUVER_NOISE) / 3.0f;
+	Fusion_Data.modelNoise.pv = 0.5f * dt2 * FUSION_MANEUVER_NOISE * FUSION_MANEUVER_NOISE;
+	Fusion_Data.modelNoise.vv = Fusion_Data.period * FUSION_MANEUVER_NOISE * FUSION_MANEUVER_NOISE;
+	Fusion_Data.modelNoise.bb = 0.0f;
+}
+
+/**@brief Used to propagate the state and to correct it with a new GPS fix.
+ * @details GPS fixes arrive asynchronously, each new fix (new time of day) is applied once in the
+ * cycle it is first seen.
+ */
+void Fusion_MainFunction(void)
+{
+	const rtcnt_t start = chSysGetRealtimeCounterX();
+	Gps_FixType fix;
+	uint32_t time;
+
+	Gps_GetFix(&fix);
+	collect();
+	if (Fusion_Data.isInitialized)
+	{
+		predict();
+	}
+	if ((fix.isValid) && (fix.time != Fusion_Data.fixTime))
+	{
+		Fusion_Data.fixTime = fix.time;
+		correct(&fix);
+	}
+	swTimer_tick(Fusion_Data.gpsTimer);
+	detectMotion();
+	publish();
+
+	time = (uint32_t)(chSysGetRealtimeCounterX() - start);
+	Fusion_Data.stats.lastTime = time;
+	Fusion_Data.stats.maxTime = (time > Fusion_Data.stats.maxTime) ? time : Fusion_Data.stats.maxTime;
+	if (time > FUSION_CYCLE_BUDGET)
+	{
+		Fusion_Data.stats.overruns++;
+	}
+}
+
+/**@brief Used to pass an accelerometer sample to the position fusion.
+ * @details The sample has to be rotated into the local level frame by the caller (IMU driver).
+ * The samples received between two MainFunction calls are averaged. No target code calls it yet,
+ * see the limitation at the top of this file.
+ * @param[in]	east	East acceleration in mm/s^2.
+ * @param[in]	north	North acceleration in mm/s^2.
+ */
+void Fusion_AddAcceleration(const int32_t east, const int32_t north)
+{
+	const float square = (((float)east * (float)east) + ((float)north * (float)north)) * 1e-6f;
+
+	chSysLock();
+	Fusion_Data.accelSum[0u] += east;
+	Fusion_Data.accelSum[1u] += north;
+	Fusion_Data.accelSquareSum += square;
+	Fusion_Data.accelCount++;
+	chSysUnlock();
+}
+
+/**@brief Used to get the fused position and velocity.
+ * @param[out]	state	Fused state.
+ */
+void Fusion_GetState(Fusion_StateType *state)
+{
+	chSysLock();
+	*state = Fusion_Data.state;
+	chSysUnlock();
+}
+
+/**@brief Used to get the filter statistics.
+ * @param[out]	stats	Statistics.
+ */
+void Fusion_GetStatistics(Fusion_StatisticsType *stats)
+{
+	chSysLock();
+	*stats = Fusion_Data.stats;
+	chSysUnlock();
+}
+
+/**@brief Used to take over the accelerations received since the last call.
+ * @details Runs every cycle, also before the first fix, so the sums cannot overflow and the
+ * stillness detection works without GPS.
+ */
+static void collect(void)
+{
+	float square = 0.0f;
+	uint32_t count;
+
+	chSysLock();
+	count = Fusion_Data.accelCount;
+	if (count != 0u)
+	{
+		Fusion_Data.acceleration[0u] = ((float)Fusion_Data.accelSum[0u] * 0.001f) / (float)count;
+		Fusion_Data.acceleration[1u] = ((float)Fusion_Data.accelSum[1u] * 0.001f) / (float)count;
+		square = Fusion_Data.accelSquareSum;
+		Fusion_Data.accelSum[0u] = 0;
+		Fusion_Data.accelSum[1u] = 0;
+		Fusion_Data.accelSquareSum = 0.0f;
+		Fusion_Data.accelCount = 0u;
+	}
+	chSysUnlock();
+
+	if (count != 0u)
+	{
+		Fusion_Data.windowSum[0u] += Fusion_Data.acceleration[0u] * (float)count;
+		Fusion_Data.windowSum[1u] += Fusion_Data.acceleration[1u] * (float)count;
+		Fusion_Data.windowSquareSum += square;
+		Fusion_Data.windowCount += count;
+		swTimer_set(Fusion_Data.imuTimer, Fusion_Data.imuReload);
+	}
+	else
+	{
+		swTimer_tick(Fusion_Data.imuTimer);
+	}
+	Fusion_Data.state.isImuUsed = (swTimer_isElapsed(Fusion_Data.imuTimer)) ? FALSE : TRUE;
+}
+
+/**@brief Used to detect whether the device is still.
+ * @details With IMU data the acceleration variance over FUSION_STILL_WINDOW is compared, a window
+ * covers several steps or rope pulls. Without IMU data the fused speed is compared while it is
+ * valid, otherwise there is no evidence of motion. The device is still after FUSION_STILL_TIME
+ * without motion.
+ */
+static void detectMotion(void)
+{
+	uint8_t isMoving = FALSE;
+
+	if (Fusion_Data.state.isImuUsed)
+	{
+		swTimer_tick(Fusion_Data.windowTimer);
+		if ((swTimer_isElapsed(Fusion_Data.windowTimer)) && (Fusion_Data.windowCount != 0u))
+		{
+			const float inverse = 1.0f / (float)Fusion_Data.windowCount;
+			const float east = Fusion_Data.windowSum[0u] * inverse;
+			const float north = Fusion_Data.windowSum[1u] * inverse;
+			const float variance = (Fusion_Data.windowSquareSum * inverse) - ((east * east) + (north * north));
+
+			isMoving = (variance > FUSION_STILL_VARIANCE) ? TRUE : FALSE;
+			Fusion_Data.windowSum[0u] = 0.0f;
+			Fusion_Data.windowSum[1u] = 0.0f;
+			Fusion_Data.windowSquareSum = 0.0f;
+			Fusion_Data.windowCount = 0u;
+			swTimer_set(Fusion_Data.windowTimer, Fusion_Data.windowReload);
+		}
+	}
+	else if ((Fusion_Data.isInitialized) && (!swTimer_isElapsed(Fusion_Data.gpsTimer)))
+	{
+		const float speed = (Fusion_Data.velocity[0u] * Fusion_Data.velocity[0u]) + (Fusion_Data.velocity[1u] * Fusion_Data.velocity[1u]);
+
+		isMoving = (speed > (FUSION_STILL_SPEED * FUSION_STILL_SPEED)) ? TRUE : FALSE;
+	}
+
+	if (isMoving)
+	{
+		swTimer_set(Fusion_Data.stillTimer, Fusion_Data.stillReload);
+	}
+	else
+	{
+		swTimer_tick(Fusion_Data.stillTimer);
+	}
+	Fusion_Data.state.isStill = (swTimer_isElapsed(Fusion_Data.stillTimer)) ? TRUE : FALSE;
+}
+
+/**@brief Used to propagate the nominal state and the error covariance by one period.
+ * @details F = [1, dt, -dt^2/2; 0, 1, -dt; 0, 0, 1] with IMU data, the bias columns are dropped
+ * for the constant velocity model. P = F P F' + Q is expanded on the six stored entries.
+ */
+static void predict(void)
+{
+	const float dt = Fusion_Data.period;
+	const Fusion_NoiseType *noise = &Fusion_Data.modelNoise;
+	float *p = Fusion_Data.covariance;
+	float b = 0.0f;
+	float c = 0.0f;
+	float fp00;
+	float fp01;
+	float fp02;
+	float fp11;
+	float fp12;
+	uint32_t axis = 0u;
+
+	for (axis = 0u; axis < 2u; axis++)
+	{
+		const float accel = (Fusion_Data.state.isImuUsed) ? (Fusion_Data.acceleration[axis] - Fusion_Data.bias[axis]) : 0.0f;
+
+		Fusion_Data.position[axis] += (Fusion_Data.velocity[axis] + (0.5f * accel * dt)) * dt;
+		Fusion_Data.velocity[axis] += accel * dt;
+	}
+
+	if (Fusion_Data.state.isImuUsed)
+	{
+		noise = &Fusion_Data.imuNoise;
+		b = -0.5f * dt * dt;
+		c = -dt;
+	}
+	fp00 = p[FUSION_P_PP] + (dt * p[FUSION_P_PV]) + (b * p[FUSION_P_PB]);
+	fp01 = p[FUSION_P_PV] + (dt * p[FUSION_P_VV]) + (b * p[FUSION_P_VB]);
+	fp02 = p[FUSION_P_PB] + (dt * p[FUSION_P_VB]) + (b * p[FUSION_P_BB]);
+	fp11 = p[FUSION_P_VV] + (c * p[FUSION_P_VB]);
+	fp12 = p[FUSION_P_VB] + (c * p[FUSION_P_BB]);
+	p[FUSION_P_PP] = fp00 + (dt * fp01) + (b * fp02) + noise->pp;
+	p[FUSION_P_PV] = fp01 + (c * fp02) + noise->pv;
+	p[FUSION_P_PB] = fp02;
+	p[FUSION_P_VV] = fp11 + (c * fp12) + noise->vv;
+	p[FUSION_P_VB] = fp12;
+	p[FUSION_P_BB] += noise->bb;
+
+	Fusion_Data.stats.predictions++;
+	recenter();
+}
+
+/**@brief Used to correct the state with a GPS fix.
+ * @param[in]	fix	GPS fix.
+ */
+static void correct(const Gps_FixType *fix)
+{
+	const Geo_PointType point = {fix->latitude, fix->longitude};
+	float variance;
+
+	if (fix->hAccuracy != 0u)
+	{
+		variance = (float)fix->hAccuracy * 0.001f;
+	}
+	else
+	{
+		variance = ((fix->hdop != 0u) ? ((float)fix->hdop * 0.01f) : 1.0f) * FUSION_UERE;
+	}
+	variance *= variance;
+
+	if (Fusion_Data.isInitialized == FALSE)
+	{
+		reset(fix, variance);
+	}
+	else
+	{
+		Geo_EnuType enu;
+		float east;
+		float north;
+		float innovation;
+
+		Geo_ToEnu(&Fusion_Data.frame, &point, 0, &enu);
+		east = ((float)enu.east * 0.001f) - Fusion_Data.position[0u];
+		north = ((float)enu.north * 0.001f) - Fusion_Data.position[1u];
+		innovation = ((east * east) + (north * north)) / (Fusion_Data.covariance[FUSION_P_PP] + variance);
+
+		if (innovation <= FUSION_GATE)
+		{
+			Fusion_Data.rejectCount = 0u;
+			update(FUSION_STATE_POSITION, east, north, variance);
+			if (fix->speedAccuracy != 0u)
+			{
+				const float speedVariance = ((float)fix->speedAccuracy * 0.001f) * ((float)fix->speedAccuracy * 0.001f);
+
+				update(FUSION_STATE_VELOCITY, ((float)fix->velocityEast * 0.001f) - Fusion_Data.velocity[0u],
+						((float)fix->velocityNorth * 0.001f) - Fusion_Data.velocity[1u], speedVariance);
+			}
+			Fusion_Data.stats.updates++;
+			swTimer_set(Fusion_Data.gpsTimer, Fusion_Data.gpsReload);
+		}
+		else
+		{
+			Fusion_Data.stats.rejects++;
+			Fusion_Data.rejectCount++;
+			if (Fusion_Data.rejectCount >= FUSION_REJECT_LIMIT)
+			{
+				reset(fix, variance);
+			}
+		}
+	}
+}
+
+/**@brief Used to apply a scalar measurement of one state to both axes.
+ * @details K = P(:,k) / (P(k,k) + R), the error K y is injected into the nominal state and
+ * P = P - K P(k,:) is updated on the six stored entries.
+ * @param[in]	measured	Index of the measured state (position or velocity).
+ * @param[in]	east		East innovation.
+ * @param[in]	north		North innovation.
+ * @param[in]	variance	Measurement variance.
+ */
+static void update(const uint8_t measured, const float east, const float north, const float variance)
+{
+	float *p = Fusion_Data.covariance;
+	const float pk0 = p[Fusion_CovarianceIndex[measured][0u]];
+	const float pk1 = p[Fusion_CovarianceIndex[measured][1u]];
+	const float pk2 = p[Fusion_CovarianceIndex[measured][2u]];
+	const float inverse = 1.0f / (p[Fusion_CovarianceIndex[measured][measured]] + variance);
+	const float k0 = pk0 * inverse;
+	const float k1 = pk1 * inverse;
+	const float k2 = pk2 * inverse;
+
+	Fusion_Data.position[0u] += k0 * east;
+	Fusion_Data.position[1u] += k0 * north;
+	Fusion_Data.velocity[0u] += k1 * east;
+	Fusion_Data.velocity[1u] += k1 * north;
+	Fusion_Data.bias[0u] += k2 * east;
+	Fusion_Data.bias[1u] += k2 * north;
+
+	p[FUSION_P_PP] -= k0 * pk0;
+	p[FUSION_P_PV] -= k0 * pk1;
+	p[FUSION_P_PB] -= k0 * pk2;
+	p[FUSION_P_VV] -= k1 * pk1;
+	p[FUSION_P_VB] -= k1 * pk2;
+	p[FUSION_P_BB] -= k2 * pk2;
+}
+
+/**@brief Used to restart the filter at a GPS fix.
+ * @param[in]	fix			GPS fix.
+ * @param[in]	variance	Position variance of the fix.
+ */
+static void reset(const Gps_FixType *fix, const float variance)
+{
+	const Geo_PointType point = {fix->latitude, fix->longitude};
+	float velocityVariance = FUSION_INIT_VELOCITY * FUSION_INIT_VELOCITY;
+
+	Geo_FrameInit(&Fusion_Data.frame, &point, 0);
+	Fusion_Data.position[0u] = 0.0f;
+	Fusion_Data.position[1u] = 0.0f;
+	Fusion_Data.velocity[0u] = 0.0f;
+	Fusion_Data.velocity[1u] = 0.0f;
+	Fusion_Data.bias[0u] = 0.0f;
+	Fusion_Data.bias[1u] = 0.0f;
+	if (fix->speedAccuracy != 0u)
+	{
+		Fusion_Data.velocity[0u] = (float)fix->velocityEast * 0.001f;
+		Fusion_Data.velocity[1u] = (float)fix->velocityNorth * 0.001f;
+		velocityVariance = ((float)fix->speedAccuracy * 0.001f) * ((float)fix->speedAccuracy * 0.001f);
+	}
+	memset(Fusion_Data.covariance, 0u, sizeof(Fusion_Data.covariance));
+	Fusion_Data.covariance[FUSION_P_PP] = variance;
+	Fusion_Data.covariance[FUSION_P_VV] = velocityVariance;
+	Fusion_Data.covariance[FUSION_P_BB] = FUSION_INIT_BIAS * FUSION_INIT_BIAS;
+	Fusion_Data.rejectCount = 0u;
+	Fusion_Data.isInitialized = TRUE;
+	Fusion_Data.stats.resets++;
+	swTimer_set(Fusion_Data.gpsTimer, Fusion_Data.gpsReload);
+}
+
+/**@brief Used to move the frame origin to the current position when it got too far away.
+ * @details Keeps the float position small, so its resolution stays below a millimeter.
+ */
+static void recenter(void)
+{
+	if ((Fusion_Data.position[0u] > FUSION_RECENTER_DISTANCE) || (Fusion_Data.position[0u] < -FUSION_RECENTER_DISTANCE) ||
+		(Fusion_Data.position[1u] > FUSION_RECENTER_DISTANCE) || (Fusion_Data.position[1u] < -FUSION_RECENTER_DISTANCE))
+	{
+		const Geo_EnuType enu = {(int32_t)(Fusion_Data.position[0u] * 1000.0f), (int32_t)(Fusion_Data.position[1u] * 1000.0f), 0};
+		Geo_PointType origin;
+
+		Geo_FromEnu(&Fusion_Data.frame, &enu, &origin, NULL);
+		Geo_FrameInit(&Fusion_Data.frame, &origin, 0);
+		Fusion_Data.position[0u] = 0.0f;
+		Fusion_Data.position[1u] = 0.0f;
+	}
+}
+
+/**@brief Used to update the output state.
+ */
+static void publish(void)
+{
+	Fusion_StateType state = Fusion_Data.state;
+
+	if (Fusion_Data.isInitialized)
+	{
+		const Geo_EnuType enu = {(int32_t)(Fusion_Data.position[0u] * 1000.0f), (int32_t)(Fusion_Data.position[1u] * 1000.0f), 0};
+
+		Geo_FromEnu(&Fusion_Data.frame, &enu, &state.position, NULL);
+		state.velocityEast = (int32_t)(Fusion_Data.velocity[0u] * 1000.0f);
+		state.velocityNorth = (int32_t)(Fusion_Data.velocity[1u] * 1000.0f);
+		state.accuracy = (uint32_t)(__builtin_sqrtf(Fusion_Data.covariance[FUSION_P_PP]) * 1000.0f);
+	}
+	state.isValid = ((Fusion_Data.isInitialized) && (!swTimer_isElapsed(Fusion_Data.gpsTimer))) ? TRUE : FALSE;
+
+	chSysLock();
+	Fusion_Data.state = state;
+	chSysUnlock();
+}
@@ -0,0 +1,79 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Fusion.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Fusion.h
+* @brief Implements the header of the GPS/IMU position fusion.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#if !defined(FUSION_H)
+#define FUSION_H
+
+#include "Fusion_Cfg.h"
+
+/**@struct Fusion_StateType
+ * @brief Specifies the fused horizontal position and velocity.
+ */
+typedef struct Fusion_StateTypeTag
+{
+	Geo_PointType position;			/**< Position. */
+	int32_t velocityEast;			/**< East velocity in millimeters per second. */
+	int32_t velocityNorth;			/**< North velocity in millimeters per second. */
+	uint32_t accuracy;				/**< Standard deviation of the position (one axis) in millimeters. */
+	uint8_t isValid;				/**< TRUE while the filter is tracking GPS fixes. */
+	uint8_t isImuUsed;				/**< TRUE if the last prediction used IMU data. */
+	uint8_t isStill;				/**< TRUE if no motion was detected for FUSION_STILL_TIME. */
+} Fusion_StateType;
+
+/**@struct Fusion_StatisticsType
+ * @brief Specifies the filter statistics and the cycle budget accounting.
+ */
+typedef struct Fusion_StatisticsTypeTag
+{
+	uint32_t predictions;			/**< Number of prediction steps. */
+	uint32_t updates;				/**< Number of applied GPS fixes. */
+	uint32_t rejects;				/**< Number of GPS fixes rejected by the innovation gate. */
+	uint32_t resets;				/**< Number of resets to the GPS fix. */
+	uint32_t lastTime;				/**< Realtime counter cycles of the last MainFunction call. */
+	uint32_t maxTime;				/**< Largest realtime counter cycles of a MainFunction call. */
+	uint32_t overruns;				/**< Number of calls above FUSION_CYCLE_BUDGET. */
+} Fusion_StatisticsType;
+
+extern void Fusion_Init(const uint32_t rec);
+extern void Fusion_MainFunction(void);
+extern void Fusion_AddAcceleration(const int32_t east, const int32_t north);
+extern void Fusion_GetState(Fusion_StateType *state);
+extern void Fusion_GetStatistics(Fusion_StatisticsType *stats);
+
+#endif /* FUSION_H */
@@ -0,0 +1,287 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Geo.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Geo.c
+* @brief Implements the fixed point geodetic coordinate library (single precision kernels).
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include <stddef.h>
+#include "Geo.h"
+
+/**@brief Defines the WGS84 semi-major axis in millimeters.
+ */
+#define GEO_WGS84_A						(6378137000.0f)
+
+/**@brief Defines the WGS84 first eccentricity squared.
+ */
+#define GEO_WGS84_E2					(0.00669437999f)
+
+/**@brief Defines the mean earth radius in millimeters.
+ */
+#define GEO_EARTH_RADIUS				(6371008800.0f)
+
+/**@brief Defines the number of radians per 1e-7 degrees.
+ */
+#define GEO_RAD_PER_UNIT				(1.74532925e-9f)
+
+/**@brief Defines the number of 1e-7 degrees of a full turn.
+ */
+#define GEO_UNITS_PER_TURN				(3600000000ll)
+
+/**@brief Defines the number of 1e-2 degrees per radian.
+ */
+#define GEO_CENTIDEG_PER_RAD			(5729.57795f)
+
+/**@brief Defines pi and half pi.
+ */
+#define GEO_PI							(3.14159265f)
+#define GEO_HALF_PI						(1.57079633f)
+
+static int32_t getLongitudeDelta(const int32_t from, const int32_t to);
+static void getScale(const int32_t latitude, float *east, float *north);
+static float getSin(const float x);
+static float getCos(const float x);
+static float getAtan2(const float y, const float x);
+static uint32_t toDistance(const float distance);
+
+/**@brief Used to initialize a local east, north, up frame.
+ * @param[out]	frame		Frame.
+ * @param[in]	origin		Origin of the frame.
+ * @param[in]	altitude	Altitude of the origin in millimeters.
+ */
+void Geo_FrameInit(Geo_FrameType *frame, const Geo_PointType *origin, const int32_t altitude)
+{
+	frame->origin = *origin;
+	frame->altitude = altitude;
+	getScale(origin->latitude, &frame->east, &frame->north);
+}
+
+/**@brief Used to project a position into a local frame.
+ * @details Valid within 2000 km of the origin.
+ * @param[in]	frame		Frame.
+ * @param[in]	point		Position.
+ * @param[in]	altitude	Altitude of the position in millimeters.
+ * @param[out]	enu			Local position.
+ */
+void Geo_ToEnu(const Geo_FrameType *frame, const Geo_PointType *point, const int32_t altitude, Geo_EnuType *enu)
+{
+	const float east = (float)getLongitudeDelta(frame->origin.longitude, point->longitude) * frame->east;
+	const float north = (float)(point->latitude - frame->origin.latitude) * frame->north;
+
+	enu->east = (int32_t)((east < 0.0f) ? (east - 0.5f) : (east + 0.5f));
+	enu->north = (int32_t)((north < 0.0f) ? (north - 0.5f) : (north + 0.5f));
+	enu->up = altitude - frame->altitude;
+}
+
+/**@brief Used to convert a local position back to a geodetic position.
+ * @param[in]	frame		Frame.
+ * @param[in]	enu			Local position.
+ * @param[out]	point		Position.
+ * @param[out]	altitude	Altitude of the position in millimeters, can be NULL.
+ */
+void Geo_FromEnu(const Geo_FrameType *frame, const Geo_EnuType *enu, Geo_PointType *point, int32_t *altitude)
+{
+	const float east = (float)enu->east / frame->east;
+	const float north = (float)enu->north / frame->north;
+	int64_t longitude = (int64_t)frame->origin.longitude + (int32_t)((east < 0.0f) ? (east - 0.5f) : (east + 0.5f));
+
+	if (longitude > (GEO_UNITS_PER_TURN / 2))
+	{
+		longitude -= GEO_UNITS_PER_TURN;
+	}
+	else if (longitude <= -(GEO_UNITS_PER_TURN / 2))
+	{
+		longitude += GEO_UNITS_PER_TURN;
+	}
+	point->longitude = (int32_t)longitude;
+	point->latitude = frame->origin.latitude + (int32_t)((north < 0.0f) ? (north - 0.5f) : (north + 0.5f));
+	if (altitude != NULL)
+	{
+		*altitude = enu->up + frame->altitude;
+	}
+}
+
+/**@brief Used to get the equirectangular distance between two positions.
+ * @details Intended for the short distances of track points, fences and routes.
+ * @param[in]	from	First position.
+ * @param[in]	to		Second position.
+ * @return	Distance in millimeters, GEO_DISTANCE_MAX if it does not fit.
+ */
+uint32_t Geo_Distance(const Geo_PointType *from, const Geo_PointType *to)
+{
+	const int32_t deltaLatitude = to->latitude - from->latitude;
+	float eastScale;
+	float northScale;
+	float east;
+	float north;
+
+	getScale(from->latitude + (deltaLatitude / 2), &eastScale, &northScale);
+	east = (float)getLongitudeDelta(from->longitude, to->longitude) * eastScale;
+	north = (float)deltaLatitude * northScale;
+
+	return toDistance(__builtin_sqrtf((east * east) + (north * north)));
+}
+
+/**@brief Used to get the great circle distance between two positions.
+ * @param[in]	from	First position.
+ * @param[in]	to		Second position.
+ * @return	Distance in millimeters, GEO_DISTANCE_MAX if it does not fit.
+ */
+uint32_t Geo_DistanceHaversine(const Geo_PointType *from, const Geo_PointType *to)
+{
+	const float sinLatitude = getSin((float)(to->latitude - from->latitude) * (0.5f * GEO_RAD_PER_UNIT));
+	const float sinLongitude = getSin((float)getLongitudeDelta(from->longitude, to->longitude) * (0.5f * GEO_RAD_PER_UNIT));
+	const float cosProduct = getCos((float)from->latitude * GEO_RAD_PER_UNIT) * getCos((float)to->latitude * GEO_RAD_PER_UNIT);
+	float h = (sinLatitude * sinLatitude) + (cosProduct * sinLongitude * sinLongitude);
+
+	h = (h > 1.0f) ? 1.0f : h;
+
+	/* Central angle 2 * asin(sqrt(h)), atan2 keeps the accuracy for small and large angles. */
+	return toDistance(2.0f * GEO_EARTH_RADIUS * getAtan2(__builtin_sqrtf(h), __builtin_sqrtf(1.0f - h)));
+}
+
+/**@brief Used to get the bearing from one position to another.
+ * @param[in]	from	First position.
+ * @param[in]	to		Second position.
+ * @return	Bearing in 1e-2 degrees clockwise from north (0 .. 35999), 0 if the positions are equal.
+ */
+uint32_t Geo_Bearing(const Geo_PointType *from, const Geo_PointType *to)
+{
+	const int32_t deltaLatitude = to->latitude - from->latitude;
+	float eastScale;
+	float northScale;
+	float bearing;
+
+	getScale(from->latitude + (deltaLatitude / 2), &eastScale, &northScale);
+	bearing = getAtan2((float)getLongitudeDelta(from->longitude, to->longitude) * eastScale, (float)deltaLatitude * northScale) * GEO_CENTIDEG_PER_RAD;
+	bearing = (bearing < 0.0f) ? (bearing + 36000.0f) : bearing;
+
+	return ((uint32_t)(bearing + 0.5f)) % 36000u;
+}
+
+/**@brief Used to get the longitude difference across the antimeridian.
+ * @param[in]	from	First longitude in 1e-7 degrees.
+ * @param[in]	to		Second longitude in 1e-7 degrees.
+ * @return	Difference to - from in 1e-7 degrees, -180 .. 180 degrees.
+ */
+static int32_t getLongitudeDelta(const int32_t from, const int32_t to)
+{
+	int64_t delta = (int64_t)to - (int64_t)from;
+
+	if (delta > (GEO_UNITS_PER_TURN / 2))
+	{
+		delta -= GEO_UNITS_PER_TURN;
+	}
+	else if (delta <= -(GEO_UNITS_PER_TURN / 2))
+	{
+		delta += GEO_UNITS_PER_TURN;
+	}
+
+	return (int32_t)delta;
+}
+
+/**@brief Used to get the local scale factors from the WGS84 radii of curvature.
+ * @param[in]	latitude	Latitude in 1e-7 degrees.
+ * @param[out]	east		Millimeters per 1e-7 degrees of longitude.
+ * @param[out]	north		Millimeters per 1e-7 degrees of latitude.
+ */
+static void getScale(const int32_t latitude, float *east, float *north)
+{
+	const float angle = (float)latitude * GEO_RAD_PER_UNIT;
+	const float sinLatitude = getSin(angle);
+	const float w2 = 1.0f - (GEO_WGS84_E2 * sinLatitude * sinLatitude);
+	const float w = __builtin_sqrtf(w2);
+
+	/* Prime vertical radius a / w and meridional radius a (1 - e2) / w^3. */
+	*east = ((GEO_WGS84_A * GEO_RAD_PER_UNIT) / w) * getCos(angle);
+	*north = (GEO_WGS84_A * (1.0f - GEO_WGS84_E2) * GEO_RAD_PER_UNIT) / (w2 * w);
+}
+
+/**@brief Used to get the sine of an angle, Taylor series to x^11.
+ * @param[in]	x	Angle in radians, -pi/2 .. pi/2.
+ * @return	Sine, absolute error < 6e-8.
+ */
+static float getSin(const float x)
+{
+	const float x2 = x * x;
+
+	return x * (1.0f + (x2 * (-1.66666667e-1f + (x2 * (8.33333333e-3f + (x2 * (-1.98412698e-4f + (x2 * (2.75573192e-6f + (x2 * -2.50521084e-8f))))))))));
+}
+
+/**@brief Used to get the cosine of an angle, Taylor series to x^12.
+ * @param[in]	x	Angle in radians, -pi/2 .. pi/2.
+ * @return	Cosine, absolute error < 1e-8.
+ */
+static float getCos(const float x)
+{
+	const float x2 = x * x;
+
+	return 1.0f + (x2 * (-0.5f + (x2 * (4.16666667e-2f + (x2 * (-1.38888889e-3f + (x2 * (2.48015873e-5f + (x2 * (-2.75573192e-7f + (x2 * 2.08767570e-9f)))))))))));
+}
+
+/**@brief Used to get the four quadrant arc tangent.
+ * @details Minimax polynomial on the octant, absolute error < 4e-8 radians.
+ * @param[in]	y	Ordinate.
+ * @param[in]	x	Abscissa.
+ * @return	Angle in radians, -pi .. pi, 0 if both arguments are 0.
+ */
+static float getAtan2(const float y, const float x)
+{
+	const float absY = (y < 0.0f) ? -y : y;
+	const float absX = (x < 0.0f) ? -x : x;
+	float retVal = 0.0f;
+
+	if ((absX > 0.0f) || (absY > 0.0f))
+	{
+		const float z = (absY > absX) ? (absX / absY) : (absY / absX);
+		const float z2 = z * z;
+
+		retVal = z * (9.99999344e-01f + (z2 * (-3.33298594e-01f + (z2 * (1.99465647e-01f + (z2 * (-1.39086261e-01f + (z2 * (9.64218825e-02f + (z2 * (-5.59121743e-02f + (z2 * (2.18628384e-02f + (z2 * -4.05453006e-03f))))))))))))));
+		retVal = (absY > absX) ? (GEO_HALF_PI - retVal) : retVal;
+		retVal = (x < 0.0f) ? (GEO_PI - retVal) : retVal;
+		retVal = (y < 0.0f) ? -retVal : retVal;
+	}
+
+	return retVal;
+}
+
+/**@brief Used to round a distance to millimeters.
+ * @param[in]	distance	Distance in millimeters.
+ * @return	Rounded distance, GEO_DISTANCE_MAX if it does not fit.
+ */
+static uint32_t toDistance(const float distance)
+{
+	return (distance < 4294967040.0f) ? (uint32_t)(distance + 0.5f) : GEO_DISTANCE_MAX;
+}
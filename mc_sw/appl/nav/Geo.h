@@ -0,0 +1,105 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Geo.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Geo.h
+* @brief Implements the header of the fixed point geodetic coordinate library.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#if !defined(GEO_H)
+#define GEO_H
+
+#include <stdint.h>
+
+/* This header and Geo.c do not depend on the OS or the HAL and can be compiled unchanged on the host.
+ *
+ * Positions are int32 in 1e-7 degrees, lengths are int32 / uint32 in millimeters. Coordinates are only
+ * subtracted as integers, float (single precision, FPU) is used for the differences and for the scale
+ * factors and trigonometry of the latitude, never for absolute coordinates. Differences below 1.67
+ * degrees are exact in float.
+ *
+ * Error bounds against double precision Vincenty (WGS84) and haversine over random pairs up to 80 degrees
+ * latitude (values in brackets up to 60 degrees), checked by ts/host/GeoTest.c:
+ * - Geo_Distance: equirectangular with the WGS84 radii at the mean latitude. Below 10 km the error is
+ *   < 0.5 mm + 4e-6 (7e-7) relative, below 100 km < 4e-4 (4e-5) relative.
+ * - Geo_DistanceHaversine: great circle on the mean earth sphere (6371008.8 m). Within 2e-6 relative of the
+ *   double precision haversine, the sphere itself is within 0.6 % of WGS84. Saturates at 4294 km.
+ * - Geo_Bearing: bearing at the midpoint with the WGS84 radii. It differs from the initial geodesic
+ *   bearing by half the meridian convergence, < 0.25 (0.08) degrees below 10 km.
+ * - Geo_ToEnu / Geo_FromEnu: tangent plane with the WGS84 radii at the origin. The scale error grows with
+ *   the distance from the origin, < 1.7e-3 (5.2e-4) relative at 10 km. The round trip error is at most
+ *   1e-7 degrees below 10 km and 5e-7 degrees below 100 km. */
+
+/**@brief Defines the value returned by the distance functions when the distance does not fit in 32 bits.
+ */
+#define GEO_DISTANCE_MAX				(0xFFFFFFFFu)
+
+/**@struct Geo_PointType
+ * @brief Specifies a geodetic position.
+ */
+typedef struct Geo_PointTypeTag
+{
+	int32_t latitude;				/**< Latitude in 1e-7 degrees, north positive. */
+	int32_t longitude;				/**< Longitude in 1e-7 degrees, east positive. */
+} Geo_PointType;
+
+/**@struct Geo_EnuType
+ * @brief Specifies a position in a local east, north, up frame.
+ */
+typedef struct Geo_EnuTypeTag
+{
+	int32_t east;					/**< East offset in millimeters. */
+	int32_t north;					/**< North offset in millimeters. */
+	int32_t up;						/**< Up offset in millimeters. */
+} Geo_EnuType;
+
+/**@struct Geo_FrameType
+ * @brief Specifies a local east, north, up frame.
+ */
+typedef struct Geo_FrameTypeTag
+{
+	Geo_PointType origin;			/**< Origin of the frame. */
+	int32_t altitude;				/**< Altitude of the origin in millimeters. */
+	float east;						/**< Millimeters per 1e-7 degrees of longitude at the origin. */
+	float north;					/**< Millimeters per 1e-7 degrees of latitude at the origin. */
+} Geo_FrameType;
+
+extern void Geo_FrameInit(Geo_FrameType *frame, const Geo_PointType *origin, const int32_t altitude);
+extern void Geo_ToEnu(const Geo_FrameType *frame, const Geo_PointType *point, const int32_t altitude, Geo_EnuType *enu);
+extern void Geo_FromEnu(const Geo_FrameType *frame, const Geo_EnuType *enu, Geo_PointType *point, int32_t *altitude);
+extern uint32_t Geo_Distance(const Geo_PointType *from, const Geo_PointType *to);
+extern uint32_t Geo_DistanceHaversine(const Geo_PointType *from, const Geo_PointType *to);
+extern uint32_t Geo_Bearing(const Geo_PointType *from, const Geo_PointType *to);
+
+#endif /* GEO_H */
@@ -0,0 +1,485 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Geofence.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Geofence.c
+* @brief Implements the geofence monitor (grid indexed point in polygon tests).
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include <string.h>
+#include "Geofence.h"
+#include "Log.h"
+
+/* The fences are polygons in flash. On init a uniform grid of GEOFENCE_GRID_COLUMNS x GEOFENCE_GRID_ROWS
+ * cells is laid over the bounding box of all of the fences and every cell lists the fences whose bounding
+ * box overlaps it. A fix looks up its cell, prefilters the listed fences by their bounding box and runs
+ * the crossing number test on the rest, so the cost depends on the fences around the position and not on
+ * the number of fences. The test works on the integer coordinates (64 bit cross products), it is exact
+ * and needs no projection. Fences must span less than GEOFENCE_MAX_SPAN and must not cross the
+ * antimeridian. */
+
+/**@brief Defines the largest latitude and longitude span of a fence in 1e-7 degrees (the cross products fit in 63 bits).
+ */
+#define GEOFENCE_MAX_SPAN				(900000000u)
+
+/**@brief Defines the number of grid cells.
+ */
+#define GEOFENCE_CELL_NUMBER			(GEOFENCE_GRID_COLUMNS * GEOFENCE_GRID_ROWS)
+
+/**@struct Geofence_DataType
+ * @brief Container used to store the relevant data of the geofence monitor.
+ */
+typedef struct Geofence_DataTypeTag
+{
+	Geofence_StatusType status;		/**< Status. */
+	Geo_PointType min;				/**< South west corner of the grid. */
+	Geo_PointType max;				/**< North east corner of the grid. */
+	uint32_t cellWidth;				/**< Width of a cell in 1e-7 degrees of longitude. */
+	uint32_t cellHeight;			/**< Height of a cell in 1e-7 degrees of latitude. */
+	uint8_t isIndexed;				/**< TRUE if the grid is built. */
+	uint8_t hasAllowed;				/**< TRUE if an allowed fence exists. */
+	uint32_t fixToken;				/**< Applied and reset fusion fixes at the last test. */
+	uint32_t valid[(GEOFENCE_FENCE_NUMBER + 31u) / 32u];	/**< Valid fences, one bit each. */
+	uint16_t cell[GEOFENCE_CELL_NUMBER + 1u];	/**< First reference of each cell in index, the last entry is the end. */
+	uint16_t index[GEOFENCE_INDEX_SIZE];		/**< Fence references, grouped by cell. */
+	uint16_t inside[GEOFENCE_MAX_INSIDE];		/**< Fences the position is inside. */
+} Geofence_DataType;
+
+static uint8_t isValid(const Geofence_FenceType *fence);
+static uint8_t buildIndex(void);
+static void getCells(const Geofence_FenceType *fence, uint32_t *column, uint32_t *row, uint32_t *columns, uint32_t *rows);
+static uint32_t findFences(const Geo_PointType *point, uint16_t *fences, const uint32_t number, uint32_t *candidates, uint32_t *edges);
+static uint8_t isInside(const Geofence_FenceType *fence, const Geo_PointType *point);
+static void report(const uint16_t *fences, const uint32_t number);
+static uint8_t isListed(const uint16_t *fences, const uint32_t number, const uint16_t fence);
+
+/**@brief Stores the geofence monitor data.
+ */
+static Geofence_DataType Geofence_Data;
+
+/**@brief Used to initialize the geofence monitor.
+ * @details Checks the fence table and builds the grid index. Invalid fences are dropped with an error
+ * log, if the grid does not fit in GEOFENCE_INDEX_SIZE all of the fences are tested by bounding box.
+ */
+void Geofence_Init(void)
+{
+	uint32_t idx = 0u;
+
+	memset(&Geofence_Data, 0u, sizeof(Geofence_Data));
+	for (idx = 0u; idx < GEOFENCE_FENCE_NUMBER; idx++)
+	{
+		const Geofence_FenceType *fence = &Geofence_Fence[idx];
+
+		if (isValid(fence) == FALSE)
+		{
+			Log_Error("geofence %u invalid", idx);
+		}
+		else
+		{
+			if (Geofence_Data.status.fences == 0u)
+			{
+				Geofence_Data.min = fence->min;
+				Geofence_Data.max = fence->max;
+			}
+			Geofence_Data.min.latitude = (fence->min.latitude < Geofence_Data.min.latitude) ? fence->min.latitude : Geofence_Data.min.latitude;
+			Geofence_Data.min.longitude = (fence->min.longitude < Geofence_Data.min.longitude) ? fence->min.longitude : Geofence_Data.min.longitude;
+			Geofence_Data.max.latitude = (fence->max.latitude > Geofence_Data.max.latitude) ? fence->max.latitude : Geofence_Data.max.latitude;
+			Geofence_Data.max.longitude = (fence->max.longitude > Geofence_Data.max.longitude) ? fence->max.longitude : Geofence_Data.max.longitude;
+			Geofence_Data.valid[idx / 32u] |= (uint32_t)1u << (idx % 32u);
+			Geofence_Data.hasAllowed |= (fence->kind == GEOFENCE_KIND_ALLOWED) ? TRUE : FALSE;
+			Geofence_Data.status.fences++;
+		}
+	}
+
+	if (Geofence_Data.status.fences != 0u)
+	{
+		Geofence_Data.cellWidth = ((uint32_t)Geofence_Data.max.longitude - (uint32_t)Geofence_Data.min.longitude) / GEOFENCE_GRID_COLUMNS + 1u;
+		Geofence_Data.cellHeight = ((uint32_t)Geofence_Data.max.latitude - (uint32_t)Geofence_Data.min.latitude) / GEOFENCE_GRID_ROWS + 1u;
+		Geofence_Data.isIndexed = buildIndex();
+		if (Geofence_Data.isIndexed == FALSE)
+		{
+			Log_Warning("geofence grid needs more than %u references", GEOFENCE_INDEX_SIZE);
+		}
+	}
+}
+
+/**@brief Used to test every new fused fix against the fences and to report the entered and left fences.
+ */
+void Geofence_MainFunction(void)
+{
+	Fusion_StateType state;
+	Fusion_StatisticsType stats;
+	uint16_t fences[GEOFENCE_MAX_INSIDE];
+	uint32_t candidates = 0u;
+	uint32_t edges = 0u;
+	uint32_t number = 0u;
+	uint32_t time = 0u;
+	rtcnt_t start = 0u;
+
+	Fusion_GetState(&state);
+	Fusion_GetStatistics(&stats);
+	if ((state.isValid) && (state.accuracy <= GEOFENCE_MAX_ACCURACY) && ((stats.updates + stats.resets) != Geofence_Data.fixToken))
+	{
+		Geofence_Data.fixToken = stats.updates + stats.resets;
+		start = chSysGetRealtimeCounterX();
+		number = findFences(&state.position, fences, GEOFENCE_MAX_INSIDE, &candidates, &edges);
+		time = (uint32_t)(chSysGetRealtimeCounterX() - start);
+
+		report(fences, number);
+
+		chSysLock();
+		memcpy(Geofence_Data.inside, fences, number * sizeof(fences[0]));
+		Geofence_Data.status.inside = (uint8_t)number;
+		Geofence_Data.status.fixes++;
+		Geofence_Data.status.candidates = (uint16_t)candidates;
+		Geofence_Data.status.edges = (edges > 0xFFFFu) ? 0xFFFFu : (uint16_t)edges;
+		Geofence_Data.status.lastTime = time;
+		Geofence_Data.status.maxTime = (time > Geofence_Data.status.maxTime) ? time : Geofence_Data.status.maxTime;
+		if (time > GEOFENCE_CYCLE_BUDGET)
+		{
+			Geofence_Data.status.overruns++;
+		}
+		chSysUnlock();
+	}
+}
+
+/**@brief Used to find the fences which contain a position.
+ * @details Uses the grid index only, can be called from any task after Geofence_Init().
+ * @param[in]	point	Position.
+ * @param[out]	fences	Indices of the fences in Geofence_Fence which contain the position.
+ * @param[in]	number	Number of elements of fences.
+ * @return	Number of stored fences, at most number.
+ */
+uint32_t Geofence_Query(const Geo_PointType *point, uint16_t *fences, const uint32_t number)
+{
+	uint32_t candidates = 0u;
+	uint32_t edges = 0u;
+
+	return findFences(point, fences, number, &candidates, &edges);
+}
+
+/**@brief Used to get the fences the position was inside at the last tested fix.
+ * @param[out]	fences	Indices of the fences in Geofence_Fence.
+ * @param[in]	number	Number of elements of fences.
+ * @return	Number of stored fences, at most number.
+ */
+uint32_t Geofence_GetInside(uint16_t *fences, const uint32_t number)
+{
+	uint32_t inside = 0u;
+
+	chSysLock();
+	inside = (Geofence_Data.status.inside < number) ? Geofence_Data.status.inside : number;
+	memcpy(fences, Geofence_Data.inside, inside * sizeof(fences[0]));
+	chSysUnlock();
+
+	return inside;
+}
+
+/**@brief Used to get the status of the geofence monitor.
+ * @param[out]	status	Status of the geofence monitor.
+ */
+void Geofence_GetStatus(Geofence_StatusType *status)
+{
+	chSysLock();
+	*status = Geofence_Data.status;
+	chSysUnlock();
+}
+
+/**@brief Used to check a fence of the table.
+ * @param[in]	fence	Fence.
+ * @return	TRUE if the vertices exist and lie in the bounding box and the span is below GEOFENCE_MAX_SPAN.
+ */
+static uint8_t isValid(const Geofence_FenceType *fence)
+{
+	uint8_t isValid = FALSE;
+	uint32_t idx = 0u;
+
+	if ((fence->number >= 3u) && (((uint32_t)fence->first + fence->number) <= GEOFENCE_VERTEX_NUMBER) &&
+		(fence->min.latitude <= fence->max.latitude) && (fence->min.longitude <= fence->max.longitude) &&
+		(((uint32_t)fence->max.latitude - (uint32_t)fence->min.latitude) < GEOFENCE_MAX_SPAN) &&
+		(((uint32_t)fence->max.longitude - (uint32_t)fence->min.longitude) < GEOFENCE_MAX_SPAN))
+	{
+		isValid = TRUE;
+		for (idx = fence->first; idx < ((uint32_t)fence->first + fence->number); idx++)
+		{
+			const Geo_PointType *vertex = &Geofence_Vertex[idx];
+
+			if ((vertex->latitude < fence->min.latitude) || (vertex->latitude > fence->max.latitude) ||
+				(vertex->longitude < fence->min.longitude) || (vertex->longitude > fence->max.longitude))
+			{
+				isValid = FALSE;
+			}
+		}
+	}
+
+	return isValid;
+}
+
+/**@brief Used to build the grid index of the valid fences.
+ * @details Counts the references of each cell, turns the counts into end offsets and fills the
+ * references backwards so that the offsets end up at the start of each cell.
+ * @return	TRUE if the references fit in GEOFENCE_INDEX_SIZE.
+ */
+static uint8_t buildIndex(void)
+{
+	uint32_t total = 0u;
+	uint32_t idx = 0u;
+	uint32_t column = 0u;
+	uint32_t row = 0u;
+	uint32_t columns = 0u;
+	uint32_t rows = 0u;
+	uint32_t x = 0u;
+	uint32_t y = 0u;
+
+	for (idx = 0u; (idx < GEOFENCE_FENCE_NUMBER) && (total <= GEOFENCE_INDEX_SIZE); idx++)
+	{
+		if ((Geofence_Data.valid[idx / 32u] & ((uint32_t)1u << (idx % 32u))) != 0u)
+		{
+			getCells(&Geofence_Fence[idx], &column, &row, &columns, &rows);
+			for (y = row; y < (row + rows); y++)
+			{
+				for (x = column; x < (column + columns); x++)
+				{
+					Geofence_Data.cell[(y * GEOFENCE_GRID_COLUMNS) + x]++;
+				}
+			}
+			total += columns * rows;
+		}
+	}
+
+	if (total <= GEOFENCE_INDEX_SIZE)
+	{
+		for (idx = 1u; idx <= GEOFENCE_CELL_NUMBER; idx++)
+		{
+			Geofence_Data.cell[idx] += Geofence_Data.cell[idx - 1u];
+		}
+		for (idx = 0u; idx < GEOFENCE_FENCE_NUMBER; idx++)
+		{
+			if ((Geofence_Data.valid[idx / 32u] & ((uint32_t)1u << (idx % 32u))) != 0u)
+			{
+				getCells(&Geofence_Fence[idx], &column, &row, &columns, &rows);
+				for (y = row; y < (row + rows); y++)
+				{
+					for (x = column; x < (column + columns); x++)
+					{
+						Geofence_Data.index[--Geofence_Data.cell[(y * GEOFENCE_GRID_COLUMNS) + x]] = (uint16_t)idx;
+					}
+				}
+			}
+		}
+		Geofence_Data.cell[GEOFENCE_CELL_NUMBER] = (uint16_t)total;
+		Geofence_Data.status.indexed = (uint16_t)total;
+	}
+
+	return (total <= GEOFENCE_INDEX_SIZE) ? TRUE : FALSE;
+}
+
+/**@brief Used to get the cells covered by the bounding box of a fence.
+ * @param[in]	fence	Fence.
+ * @param[out]	column	First column.
+ * @param[out]	row		First row.
+ * @param[out]	columns	Number of columns.
+ * @param[out]	rows	Number of rows.
+ */
+static void getCells(const Geofence_FenceType *fence, uint32_t *column, uint32_t *row, uint32_t *columns, uint32_t *rows)
+{
+	*column = ((uint32_t)fence->min.longitude - (uint32_t)Geofence_Data.min.longitude) / Geofence_Data.cellWidth;
+	*row = ((uint32_t)fence->min.latitude - (uint32_t)Geofence_Data.min.latitude) / Geofence_Data.cellHeight;
+	*columns = (((uint32_t)fence->max.longitude - (uint32_t)Geofence_Data.min.longitude) / Geofence_Data.cellWidth) - *column + 1u;
+	*rows = (((uint32_t)fence->max.latitude - (uint32_t)Geofence_Data.min.latitude) / Geofence_Data.cellHeight) - *row + 1u;
+}
+
+/**@brief Used to find the fences which contain a position.
+ * @param[in]	point		Position.
+ * @param[out]	fences		Indices of the fences which contain the position.
+ * @param[in]	number		Number of elements of fences.
+ * @param[out]	candidates	Number of fences tested point in polygon.
+ * @param[out]	edges		Number of tested edges.
+ * @return	Number of stored fences, at most number.
+ */
+static uint32_t findFences(const Geo_PointType *point, uint16_t *fences, const uint32_t number, uint32_t *candidates, uint32_t *edges)
+{
+	uint32_t found = 0u;
+	uint32_t first = 0u;
+	uint32_t last = 0u;
+	uint32_t idx = 0u;
+
+	*candidates = 0u;
+	*edges = 0u;
+	if ((Geofence_Data.status.fences != 0u) &&
+		(point->latitude >= Geofence_Data.min.latitude) && (point->latitude <= Geofence_Data.max.latitude) &&
+		(point->longitude >= Geofence_Data.min.longitude) && (point->longitude <= Geofence_Data.max.longitude))
+	{
+		if (Geofence_Data.isIndexed)
+		{
+			const uint32_t cell = ((((uint32_t)point->latitude - (uint32_t)Geofence_Data.min.latitude) / Geofence_Data.cellHeight) * GEOFENCE_GRID_COLUMNS) +
+				(((uint32_t)point->longitude - (uint32_t)Geofence_Data.min.longitude) / Geofence_Data.cellWidth);
+
+			first = Geofence_Data.cell[cell];
+			last = Geofence_Data.cell[cell + 1u];
+		}
+		else
+		{
+			last = GEOFENCE_FENCE_NUMBER;
+		}
+
+		for (idx = first; (idx < last) && (found < number); idx++)
+		{
+			const uint32_t id = (Geofence_Data.isIndexed) ? Geofence_Data.index[idx] : idx;
+			const Geofence_FenceType *fence = &Geofence_Fence[id];
+
+			if (((Geofence_Data.valid[id / 32u] & ((uint32_t)1u << (id % 32u))) != 0u) &&
+				(point->latitude >= fence->min.latitude) && (point->latitude <= fence->max.latitude) &&
+				(point->longitude >= fence->min.longitude) && (point->longitude <= fence->max.longitude))
+			{
+				(*candidates)++;
+				*edges += fence->number;
+				if (isInside(fence, point))
+				{
+					fences[found] = (uint16_t)id;
+					found++;
+				}
+			}
+		}
+	}
+
+	return found;
+}
+
+/**@brief Used to test if a position is inside a fence (crossing number).
+ * @details Casts a ray from the position along its parallel toward increasing longitude and counts the
+ * edges it crosses: an edge counts if it straddles the latitude of the position and meets the parallel
+ * east of it. The side of the crossing is the sign of a cross product of the integer coordinate
+ * differences, no division is needed.
+ * @param[in]	fence	Fence, the position must be inside its bounding box.
+ * @param[in]	point	Position.
+ * @return	TRUE if the position is inside.
+ */
+static uint8_t isInside(const Geofence_FenceType *fence, const Geo_PointType *point)
+{
+	const Geo_PointType *vertex = &Geofence_Vertex[fence->first];
+	const Geo_PointType *previous = &vertex[fence->number - 1u];
+	uint8_t isInside = FALSE;
+	uint32_t idx = 0u;
+
+	for (idx = 0u; idx < fence->number; idx++)
+	{
+		const Geo_PointType *current = &vertex[idx];
+
+		if ((current->latitude > point->latitude) != (previous->latitude > point->latitude))
+		{
+			const int64_t cross = (((int64_t)previous->longitude - current->longitude) * ((int64_t)point->latitude - current->latitude)) -
+				(((int64_t)point->longitude - current->longitude) * ((int64_t)previous->latitude - current->latitude));
+
+			if ((previous->latitude > current->latitude) ? (cross > 0) : (cross < 0))
+			{
+				isInside = (isInside) ? FALSE : TRUE;
+			}
+		}
+		previous = current;
+	}
+
+	return isInside;
+}
+
+/**@brief Used to log the entered and the left fences.
+ * @details Entering a danger area and leaving the last allowed area are warnings.
+ * @param[in]	fences	Fences the position is inside now.
+ * @param[in]	number	Number of fences.
+ */
+static void report(const uint16_t *fences, const uint32_t number)
+{
+	uint8_t isOutsideAllowed = Geofence_Data.hasAllowed;
+	uint32_t idx = 0u;
+
+	for (idx = 0u; idx < Geofence_Data.status.inside; idx++)
+	{
+		if (isListed(fences, number, Geofence_Data.inside[idx]) == FALSE)
+		{
+			Geofence_Data.status.exits++;
+			Log_Info("geofence %u left", Geofence_Data.inside[idx]);
+		}
+	}
+
+	for (idx = 0u; idx < number; idx++)
+	{
+		const Geofence_FenceType *fence = &Geofence_Fence[fences[idx]];
+
+		if (isListed(Geofence_Data.inside, Geofence_Data.status.inside, fences[idx]) == FALSE)
+		{
+			Geofence_Data.status.enters++;
+			if (fence->kind == GEOFENCE_KIND_DANGER)
+			{
+				Log_Warning("geofence %u danger area entered", fences[idx]);
+			}
+			else
+			{
+				Log_Info("geofence %u entered", fences[idx]);
+			}
+		}
+		isOutsideAllowed = (fence->kind == GEOFENCE_KIND_ALLOWED) ? FALSE : isOutsideAllowed;
+	}
+
+	if (isOutsideAllowed != Geofence_Data.status.isOutsideAllowed)
+	{
+		if (isOutsideAllowed)
+		{
+			Log_Warning("geofence outside of all allowed areas");
+		}
+		else
+		{
+			Log_Info("geofence back in an allowed area");
+		}
+	}
+	Geofence_Data.status.isOutsideAllowed = isOutsideAllowed;
+}
+
+/**@brief Used to check if a fence is in a list.
+ * @param[in]	fences	List of fences.
+ * @param[in]	number	Number of fences in the list.
+ * @param[in]	fence	Fence to look for.
+ * @return	TRUE if the fence is in the list.
+ */
+static uint8_t isListed(const uint16_t *fences, const uint32_t number, const uint16_t fence)
+{
+	uint8_t isListed = FALSE;
+	uint32_t idx = 0u;
+
+	for (idx = 0u; (idx < number) && (isListed == FALSE); idx++)
+	{
+		isListed = (fences[idx] == fence) ? TRUE : FALSE;
+	}
+
+	return isListed;
+}
@@ -0,0 +1,70 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Geofence.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Geofence.h
+* @brief Implements the header of the geofence monitor.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#if !defined(GEOFENCE_H)
+#define GEOFENCE_H
+
+#include "Geofence_Cfg.h"
+
+/**@struct Geofence_StatusType
+ * @brief Specifies the fences the position is inside and the cost of the tests.
+ */
+typedef struct Geofence_StatusTypeTag
+{
+	uint16_t fences;				/**< Number of valid fences. */
+	uint16_t indexed;				/**< Number of fence references in the grid, 0 if the grid does not fit. */
+	uint8_t inside;					/**< Number of fences the position is inside. */
+	uint8_t isOutsideAllowed;		/**< TRUE if allowed fences exist and the position is inside none of them. */
+	uint32_t fixes;					/**< Number of tested fixes. */
+	uint32_t enters;				/**< Number of entered fences. */
+	uint32_t exits;					/**< Number of left fences. */
+	uint16_t candidates;			/**< Number of fences tested point in polygon at the last fix. */
+	uint16_t edges;					/**< Number of edges tested at the last fix. */
+	uint32_t lastTime;				/**< Realtime counter cycles of the last test. */
+	uint32_t maxTime;				/**< Largest realtime counter cycles of a test. */
+	uint32_t overruns;				/**< Number of tests above GEOFENCE_CYCLE_BUDGET. */
+} Geofence_StatusType;
+
+extern void Geofence_Init(void);
+extern void Geofence_MainFunction(void);
+extern uint32_t Geofence_Query(const Geo_PointType *point, uint16_t *fences, const uint32_t number);
+extern uint32_t Geofence_GetInside(uint16_t *fences, const uint32_t number);
+extern void Geofence_GetStatus(Geofence_StatusType *status);
+
+#endif /* GEOFENCE_H */
@@ -0,0 +1,325 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: GpsDuty.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file GpsDuty.c
+* @brief Implements the GNSS receiver duty cycling.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include <string.h>
+#include "GpsDuty.h"
+#include "Log.h"
+#include "SoftwareTimer.h"
+
+#if (GPS_PROTOCOL == GPS_PROTOCOL_NMEA) && (GPSDUTY_NORMAL_PERIOD != GPS_MEASUREMENT_PERIOD)
+#error "GpsDuty: the 1 Hz mode period must be the fixed measurement period of an NMEA receiver"
+#endif
+
+/* The receiver runs at 1 Hz by default and at GPSDUTY_CONTINUOUS_PERIOD while moving fast. Once the
+ * device is still (IMU stillness, fused speed without IMU) with a good fix, the receiver is switched
+ * off and woken every GPSDUTY_WAKE_PERIOD for a hot start, the backup supply keeps the ephemeris.
+ * Motion detected by the IMU or a wake fix away from the sleep position ends the periodic mode. */
+
+/**@struct GpsDuty_DataType
+ * @brief Container used to store the relevant data of the duty cycling.
+ */
+typedef struct GpsDuty_DataTypeTag
+{
+	GpsDuty_StatusType status;		/**< Status. */
+	uint32_t rec;					/**< Recurrence of the MainFunction in milliseconds. */
+	GpsDuty_ModeType target;		/**< Rate mode waiting for the dwell time. */
+	uint32_t dwellTimer;			/**< MainFunction cycles until the target mode is applied. */
+	uint32_t dwellReload;			/**< Reload value of dwellTimer. */
+	uint32_t wakeTimer;				/**< MainFunction cycles until the next hot start. */
+	uint32_t wakeReload;			/**< Reload value of wakeTimer. */
+	uint32_t acquireTimer;			/**< MainFunction cycles until the hot start is given up. */
+	uint32_t acquireReload;			/**< Reload value of acquireTimer. */
+	uint32_t modeCycles;			/**< MainFunction cycles in the current mode. */
+	uint32_t modeCharge;			/**< Charge at the last mode change in mAs. */
+	uint32_t chargeFraction;		/**< Charge below 1 mAs in microampere milliseconds. */
+	Geo_PointType sleepPosition;	/**< Position of the fix the periodic mode was entered with. */
+	uint16_t period;				/**< Measurement period still to be sent, 0 if none. */
+} GpsDuty_DataType;
+
+static void changeMode(const GpsDuty_ModeType mode, const GpsDuty_ReasonType reason);
+static GpsDuty_ModeType getRateMode(const Gps_FixType *fix);
+static uint8_t isGoodFix(const Gps_FixType *fix);
+static uint8_t isGoodSky(void);
+
+/**@brief Estimated receiver current of each mode in microamperes.
+ */
+static const uint32_t GpsDuty_Current[GPSDUTY_MODE_NUMBER] = GPSDUTY_CURRENT;
+
+/**@brief Stores the duty cycling data.
+ */
+static GpsDuty_DataType GpsDuty_Data;
+
+/**@brief Used to initialize the duty cycling.
+ * @details Must be called after Gps_Init(), starts in the 1 Hz mode.
+ * @param[in]	rec	The recurrence of the MainFunction in milliseconds.
+ */
+void GpsDuty_Init(const uint32_t rec)
+{
+	memset(&GpsDuty_Data, 0u, sizeof(GpsDuty_Data));
+	GpsDuty_Data.rec = rec;
+	if (rec != 0u)
+	{
+		GpsDuty_Data.dwellReload = GPSDUTY_DWELL_TIME / rec;
+		GpsDuty_Data.wakeReload = GPSDUTY_WAKE_PERIOD / rec;
+		GpsDuty_Data.acquireReload = GPSDUTY_ACQUIRE_TIMEOUT / rec;
+	}
+	GpsDuty_Data.status.mode = GPSDUTY_MODE_1HZ;
+	changeMode(GPSDUTY_MODE_1HZ, GPSDUTY_REASON_INIT);
+	GpsDuty_Data.status.transitions = 0u;
+}
+
+/**@brief Used to select the receiver mode from the stillness and the fix quality.
+ */
+void GpsDuty_MainFunction(void)
+{
+	Gps_FixType fix;
+	Fusion_StateType state;
+	uint32_t charge;
+
+	Gps_GetFix(&fix);
+	Fusion_GetState(&state);
+
+	switch (GpsDuty_Data.status.mode)
+	{
+		case GPSDUTY_MODE_CONTINUOUS:
+		case GPSDUTY_MODE_1HZ:
+			if ((state.isStill) && (GpsDuty_Data.modeCycles >= GpsDuty_Data.dwellReload) && (isGoodFix(&fix)) && (isGoodSky()))
+			{
+				GpsDuty_Data.sleepPosition.latitude = fix.latitude;
+				GpsDuty_Data.sleepPosition.longitude = fix.longitude;
+				changeMode(GPSDUTY_MODE_SLEEP, GPSDUTY_REASON_STILL);
+			}
+			else
+			{
+				const GpsDuty_ModeType target = getRateMode(&fix);
+
+				if (target != GpsDuty_Data.target)
+				{
+					GpsDuty_Data.target = target;
+					swTimer_set(GpsDuty_Data.dwellTimer, GpsDuty_Data.dwellReload);
+				}
+				else if (target != GpsDuty_Data.status.mode)
+				{
+					swTimer_tick(GpsDuty_Data.dwellTimer);
+					if (swTimer_isElapsed(GpsDuty_Data.dwellTimer))
+					{
+						changeMode(target, (target == GPSDUTY_MODE_CONTINUOUS) ? GPSDUTY_REASON_FAST : GPSDUTY_REASON_SLOW);
+					}
+				}
+				else
+				{
+					/* Nothing to do. */
+				}
+			}
+			break;
+		case GPSDUTY_MODE_SLEEP:
+			swTimer_tick(GpsDuty_Data.wakeTimer);
+			if ((state.isImuUsed) && (state.isStill == FALSE))
+			{
+				changeMode(GPSDUTY_MODE_1HZ, GPSDUTY_REASON_MOTION);
+			}
+			else if (swTimer_isElapsed(GpsDuty_Data.wakeTimer))
+			{
+				changeMode(GPSDUTY_MODE_WAKE, GPSDUTY_REASON_WAKE_TIMER);
+			}
+			else
+			{
+				/* Keep sleeping. */
+			}
+			break;
+		case GPSDUTY_MODE_WAKE:
+			swTimer_tick(GpsDuty_Data.acquireTimer);
+			if ((state.isImuUsed) && (state.isStill == FALSE))
+			{
+				changeMode(GPSDUTY_MODE_1HZ, GPSDUTY_REASON_MOTION);
+			}
+			else if (isGoodFix(&fix))
+			{
+				const Geo_PointType position = {fix.latitude, fix.longitude};
+
+				if (Geo_Distance(&GpsDuty_Data.sleepPosition, &position) > GPSDUTY_MOVE_DISTANCE)
+				{
+					changeMode(GPSDUTY_MODE_1HZ, GPSDUTY_REASON_DISPLACED);
+				}
+				else
+				{
+					changeMode(GPSDUTY_MODE_SLEEP, GPSDUTY_REASON_FIX_ACQUIRED);
+				}
+			}
+			else if (swTimer_isElapsed(GpsDuty_Data.acquireTimer))
+			{
+				changeMode(GPSDUTY_MODE_SLEEP, GPSDUTY_REASON_TIMEOUT);
+			}
+			else
+			{
+				/* Keep acquiring. */
+			}
+			break;
+		default:
+			break;
+	}
+
+	if ((GpsDuty_Data.period != 0u) && (Gps_SetMeasurementPeriod(GpsDuty_Data.period)))
+	{
+		GpsDuty_Data.period = 0u;
+	}
+
+	GpsDuty_Data.modeCycles++;
+	GpsDuty_Data.chargeFraction += GpsDuty_Current[GpsDuty_Data.status.mode] * GpsDuty_Data.rec;
+	charge = GpsDuty_Data.status.charge + (GpsDuty_Data.chargeFraction / 1000000u);
+	GpsDuty_Data.chargeFraction %= 1000000u;
+
+	chSysLock();
+	GpsDuty_Data.status.charge = charge;
+	GpsDuty_Data.status.modeTime = (GpsDuty_Data.modeCycles * GpsDuty_Data.rec) / 1000u;
+	chSysUnlock();
+}
+
+/**@brief Used to get the duty cycling status.
+ * @param[out]	status	Status.
+ */
+void GpsDuty_GetStatus(GpsDuty_StatusType *status)
+{
+	chSysLock();
+	*status = GpsDuty_Data.status;
+	chSysUnlock();
+}
+
+/**@brief Used to switch the receiver to another mode.
+ * @details The decision is logged with the charge spent in the previous mode and the estimated
+ * current of the new one.
+ * @param[in]	mode	New mode.
+ * @param[in]	reason	Reason of the change.
+ */
+static void changeMode(const GpsDuty_ModeType mode, const GpsDuty_ReasonType reason)
+{
+	const GpsDuty_ModeType previous = GpsDuty_Data.status.mode;
+	GpsDuty_StatusType status = GpsDuty_Data.status;
+
+	if (mode == GPSDUTY_MODE_SLEEP)
+	{
+		Gps_SetPower(FALSE);
+		GpsDuty_Data.period = 0u;
+		swTimer_set(GpsDuty_Data.wakeTimer, GpsDuty_Data.wakeReload);
+	}
+	else
+	{
+		if (previous == GPSDUTY_MODE_SLEEP)
+		{
+			Gps_SetPower(TRUE);
+		}
+		GpsDuty_Data.period = (mode == GPSDUTY_MODE_CONTINUOUS) ? GPSDUTY_CONTINUOUS_PERIOD : GPSDUTY_NORMAL_PERIOD;
+		swTimer_set(GpsDuty_Data.acquireTimer, GpsDuty_Data.acquireReload);
+	}
+	GpsDuty_Data.target = mode;
+	swTimer_set(GpsDuty_Data.dwellTimer, GpsDuty_Data.dwellReload);
+
+	Log_Info("gps mode %u, reason %u, %u mAs in last mode, %u uA", mode, reason,
+			status.charge - GpsDuty_Data.modeCharge, GpsDuty_Current[mode]);
+	GpsDuty_Data.modeCharge = status.charge;
+	GpsDuty_Data.modeCycles = 0u;
+	status.mode = mode;
+	status.reason = reason;
+	status.transitions++;
+	status.modeTime = 0u;
+	status.current = GpsDuty_Current[mode];
+
+	chSysLock();
+	GpsDuty_Data.status = status;
+	chSysUnlock();
+}
+
+/**@brief Used to select the mode of the receiver while it is on.
+ * @details The measurement period of an NMEA receiver can't be set, so it stays in the 1 Hz mode and
+ * the charge is not accounted for a rate the receiver never ran at.
+ * @param[in]	fix	GPS fix.
+ * @return	Continuous mode above GPSDUTY_FAST_SPEED, 1 Hz mode otherwise.
+ */
+static GpsDuty_ModeType getRateMode(const Gps_FixType *fix)
+{
+	GpsDuty_ModeType retVal = GPSDUTY_MODE_1HZ;
+
+#if (GPS_PROTOCOL == GPS_PROTOCOL_UBX)
+	if ((fix->isValid) && (fix->speed > GPSDUTY_FAST_SPEED))
+	{
+		retVal = GPSDUTY_MODE_CONTINUOUS;
+	}
+#else
+	(void)fix;
+#endif
+
+	return retVal;
+}
+
+/**@brief Used to check whether a fix is accurate enough to rely on.
+ * @param[in]	fix	GPS fix.
+ * @return	TRUE if the fix is valid and accurate, FALSE otherwise.
+ */
+static uint8_t isGoodFix(const Gps_FixType *fix)
+{
+	uint8_t retVal = FALSE;
+
+	if (fix->isValid)
+	{
+		if (fix->hAccuracy != 0u)
+		{
+			retVal = (fix->hAccuracy <= GPSDUTY_GOOD_ACCURACY) ? TRUE : FALSE;
+		}
+		else
+		{
+			retVal = ((fix->hdop != 0u) && (fix->hdop <= GPSDUTY_GOOD_HDOP)) ? TRUE : FALSE;
+		}
+	}
+
+	return retVal;
+}
+
+/**@brief Used to check whether the sky allows a quick hot start after sleeping.
+ * @details Enough used satellites with a strong mean signal and a geometry which is not degrading,
+ * under a wall or in a gully the receiver stays on.
+ * @return	TRUE if the periodic mode may be entered, FALSE otherwise.
+ */
+static uint8_t isGoodSky(void)
+{
+	GpsSky_SummaryType sky;
+
+	Gps_GetSkySummary(&sky);
+
+	return ((sky.used >= GPSDUTY_MIN_USED) && (sky.meanCno >= GPSDUTY_MIN_CNO) && (sky.dopTrend <= GPSDUTY_MAX_DOP_TREND)) ? TRUE : FALSE;
+}
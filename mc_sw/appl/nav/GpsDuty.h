@@ -0,0 +1,91 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: GpsDuty.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file GpsDuty.h
+* @brief Implements the header of the GNSS receiver duty cycling.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#if !defined(GPSDUTY_H)
+#define GPSDUTY_H
+
+#include "GpsDuty_Cfg.h"
+
+/**@enum GpsDuty_ModeTypeTag
+ * @brief Specifies the operating mode of the receiver.
+ */
+typedef enum GpsDuty_ModeTypeTag
+{
+	GPSDUTY_MODE_CONTINUOUS = 0u,	/**< Receiver on, GPSDUTY_CONTINUOUS_PERIOD. */
+	GPSDUTY_MODE_1HZ,				/**< Receiver on, GPSDUTY_NORMAL_PERIOD. */
+	GPSDUTY_MODE_SLEEP,				/**< Periodic mode, receiver off until the next hot start. */
+	GPSDUTY_MODE_WAKE,				/**< Periodic mode, receiver on until a good fix. */
+	GPSDUTY_MODE_NUMBER				/**< Number of modes. */
+} GpsDuty_ModeType;
+
+/**@enum GpsDuty_ReasonTypeTag
+ * @brief Specifies the reason of a mode change.
+ */
+typedef enum GpsDuty_ReasonTypeTag
+{
+	GPSDUTY_REASON_INIT = 0u,		/**< Initialization. */
+	GPSDUTY_REASON_POOR_FIX,		/**< No fix or the accuracy is above GPSDUTY_GOOD_ACCURACY. */
+	GPSDUTY_REASON_FAST,			/**< The speed is above GPSDUTY_FAST_SPEED. */
+	GPSDUTY_REASON_SLOW,			/**< Good fix and the speed is below GPSDUTY_FAST_SPEED. */
+	GPSDUTY_REASON_STILL,			/**< Good fix and the device is still. */
+	GPSDUTY_REASON_MOTION,			/**< The IMU detected motion. */
+	GPSDUTY_REASON_WAKE_TIMER,		/**< GPSDUTY_WAKE_PERIOD elapsed. */
+	GPSDUTY_REASON_FIX_ACQUIRED,	/**< Good fix close to the sleep position. */
+	GPSDUTY_REASON_DISPLACED,		/**< Good fix away from the sleep position. */
+	GPSDUTY_REASON_TIMEOUT			/**< No good fix within GPSDUTY_ACQUIRE_TIMEOUT. */
+} GpsDuty_ReasonType;
+
+/**@struct GpsDuty_StatusType
+ * @brief Specifies the duty cycling status and the energy estimate.
+ */
+typedef struct GpsDuty_StatusTypeTag
+{
+	GpsDuty_ModeType mode;			/**< Current mode. */
+	GpsDuty_ReasonType reason;		/**< Reason of the last mode change. */
+	uint32_t transitions;			/**< Number of mode changes. */
+	uint32_t modeTime;				/**< Time in the current mode in seconds. */
+	uint32_t charge;				/**< Estimated receiver charge since init in millicoulomb (mAs). */
+	uint32_t current;				/**< Estimated receiver current of the current mode in microamperes. */
+} GpsDuty_StatusType;
+
+extern void GpsDuty_Init(const uint32_t rec);
+extern void GpsDuty_MainFunction(void);
+extern void GpsDuty_GetStatus(GpsDuty_StatusType *status);
+
+#endif /* GPSDUTY_H */
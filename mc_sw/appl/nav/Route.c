@@ -0,0 +1,549 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Route.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Route.c
+* @brief Implements the route monitor (off route detection with a cursor and a grid index).
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include <string.h>
+#include "Route.h"
+#include "Log.h"
+
+/* The route is a polyline in flash. The points are int16 offsets in 1e-6 degrees from the anchor of their
+ * block of ROUTE_BLOCK_SIZE points, any point is decoded without the ones before it (4.5 bytes per point).
+ * Every block carries the bounding box of its segments and its distance from the start.
+ *
+ * A fix is first matched against the segments around the cursor (the last matched segment). Only if none
+ * of them is within ROUTE_OFF_DISTANCE the grid is searched: the cells within ROUTE_SEARCH_RADIUS list the
+ * blocks whose bounding box overlaps them, blocks farther than the best match so far are skipped by their
+ * bounding box. The distances are computed in a tangent plane at the fix. */
+
+/**@brief Defines the number of grid cells.
+ */
+#define ROUTE_CELL_NUMBER				(ROUTE_GRID_COLUMNS * ROUTE_GRID_ROWS)
+
+/**@brief Defines the number of route segments.
+ */
+#define ROUTE_SEGMENT_NUMBER			(ROUTE_POINT_NUMBER - 1u)
+
+/**@struct Route_DataType
+ * @brief Container used to store the relevant data of the route monitor.
+ */
+typedef struct Route_DataTypeTag
+{
+	Route_StatusType status;		/**< Status. */
+	Geo_PointType min;				/**< South west corner of the grid. */
+	Geo_PointType max;				/**< North east corner of the grid. */
+	uint32_t cellWidth;				/**< Width of a cell in 1e-7 degrees of longitude. */
+	uint32_t cellHeight;			/**< Height of a cell in 1e-7 degrees of latitude. */
+	uint8_t isIndexed;				/**< TRUE if the grid is built. */
+	uint8_t isCursorValid;			/**< TRUE if a fix was matched. */
+	uint8_t confirm;				/**< Consecutive fixes against the on route state. */
+	uint32_t cursor;				/**< Segment of the last match. */
+	uint32_t fixToken;				/**< Applied and reset fusion fixes at the last match. */
+	uint16_t cell[ROUTE_CELL_NUMBER + 1u];	/**< First reference of each cell in index, the last entry is the end. */
+	uint16_t index[ROUTE_INDEX_SIZE];		/**< Block references, grouped by cell. */
+} Route_DataType;
+
+/**@struct Route_SearchType
+ * @brief Specifies the state of a nearest segment search.
+ */
+typedef struct Route_SearchTypeTag
+{
+	Geo_FrameType frame;			/**< Tangent plane at the searched position. */
+	float distance;					/**< Distance to the nearest segment so far in millimeters. */
+	float along;					/**< Distance from the first point of the nearest segment to the nearest point in millimeters. */
+	uint32_t segment;				/**< Nearest segment so far. */
+} Route_SearchType;
+
+static uint8_t isValid(void);
+static uint8_t buildIndex(void);
+static void getPoint(const uint32_t idx, Geo_PointType *point);
+static void getCells(const Geo_PointType *min, const Geo_PointType *max, uint32_t *column, uint32_t *row, uint32_t *lastColumn, uint32_t *lastRow);
+static void searchSegments(Route_SearchType *search, const uint32_t first, const uint32_t last);
+static void searchBlock(Route_SearchType *search, const uint32_t block);
+static void searchGrid(Route_SearchType *search);
+static void getMatch(const Route_SearchType *search, Route_MatchType *match);
+static void updateAlert(const Route_MatchType *match, const uint32_t accuracy);
+
+/**@brief Stores the route monitor data.
+ */
+static Route_DataType Route_Data;
+
+/**@brief Used to initialize the route monitor.
+ * @details Checks the route table and builds the grid index. An invalid route is not monitored, if the
+ * grid does not fit in ROUTE_INDEX_SIZE the bounding boxes of all of the blocks are searched.
+ */
+void Route_Init(void)
+{
+	Geo_PointType from;
+	Geo_PointType to;
+	uint32_t idx = 0u;
+
+	memset(&Route_Data, 0u, sizeof(Route_Data));
+	Route_Data.status.match.offset = GEO_DISTANCE_MAX;
+	Route_Data.status.isValid = isValid();
+	if (Route_Data.status.isValid == FALSE)
+	{
+		Log_Error("route invalid");
+	}
+	else
+	{
+		Route_Data.min = Route_Block[0].min;
+		Route_Data.max = Route_Block[0].max;
+		for (idx = 1u; idx < ROUTE_BLOCK_NUMBER; idx++)
+		{
+			const Route_BlockType *block = &Route_Block[idx];
+
+			Route_Data.min.latitude = (block->min.latitude < Route_Data.min.latitude) ? block->min.latitude : Route_Data.min.latitude;
+			Route_Data.min.longitude = (block->min.longitude < Route_Data.min.longitude) ? block->min.longitude : Route_Data.min.longitude;
+			Route_Data.max.latitude = (block->max.latitude > Route_Data.max.latitude) ? block->max.latitude : Route_Data.max.latitude;
+			Route_Data.max.longitude = (block->max.longitude > Route_Data.max.longitude) ? block->max.longitude : Route_Data.max.longitude;
+		}
+
+		Route_Data.status.length = Route_Block[ROUTE_BLOCK_NUMBER - 1u].distance;
+		for (idx = (ROUTE_BLOCK_NUMBER - 1u) * ROUTE_BLOCK_SIZE; idx < ROUTE_SEGMENT_NUMBER; idx++)
+		{
+			getPoint(idx, &from);
+			getPoint(idx + 1u, &to);
+			Route_Data.status.length += Geo_Distance(&from, &to);
+		}
+
+		Route_Data.cellWidth = ((uint32_t)Route_Data.max.longitude - (uint32_t)Route_Data.min.longitude) / ROUTE_GRID_COLUMNS + 1u;
+		Route_Data.cellHeight = ((uint32_t)Route_Data.max.latitude - (uint32_t)Route_Data.min.latitude) / ROUTE_GRID_ROWS + 1u;
+		Route_Data.isIndexed = buildIndex();
+		if (Route_Data.isIndexed == FALSE)
+		{
+			Log_Warning("route grid needs more than %u references", ROUTE_INDEX_SIZE);
+		}
+	}
+}
+
+/**@brief Used to match every new fused fix to the route and to raise and clear the off route alert.
+ */
+void Route_MainFunction(void)
+{
+	Fusion_StateType state;
+	Fusion_StatisticsType stats;
+	Route_SearchType search;
+	Route_MatchType match;
+	uint8_t isSearched = FALSE;
+	uint32_t time = 0u;
+	rtcnt_t start = 0u;
+
+	Fusion_GetState(&state);
+	Fusion_GetStatistics(&stats);
+	if ((Route_Data.status.isValid) && (state.isValid) && (state.accuracy <= ROUTE_MAX_ACCURACY) &&
+		((stats.updates + stats.resets) != Route_Data.fixToken))
+	{
+		Route_Data.fixToken = stats.updates + stats.resets;
+		start = chSysGetRealtimeCounterX();
+
+		Geo_FrameInit(&search.frame, &state.position, 0);
+		search.distance = (float)ROUTE_SEARCH_RADIUS;
+		search.along = 0.0f;
+		search.segment = 0u;
+		if (Route_Data.isCursorValid)
+		{
+			const uint32_t first = (Route_Data.cursor > ROUTE_CURSOR_BEHIND) ? (Route_Data.cursor - ROUTE_CURSOR_BEHIND) : 0u;
+			const uint32_t last = ((Route_Data.cursor + ROUTE_CURSOR_AHEAD) < ROUTE_SEGMENT_NUMBER) ? (Route_Data.cursor + ROUTE_CURSOR_AHEAD + 1u) : ROUTE_SEGMENT_NUMBER;
+
+			searchSegments(&search, first, last);
+		}
+		if ((Route_Data.isCursorValid == FALSE) || (search.distance > (float)ROUTE_OFF_DISTANCE))
+		{
+			const uint32_t segment = search.segment;
+
+			searchGrid(&search);
+			isSearched = TRUE;
+			if ((Route_Data.isCursorValid) && (search.segment != segment))
+			{
+				Route_Data.status.jumps++;
+			}
+		}
+		getMatch(&search, &match);
+		if (match.offset != GEO_DISTANCE_MAX)
+		{
+			Route_Data.cursor = match.segment;
+			Route_Data.isCursorValid = TRUE;
+		}
+		time = (uint32_t)(chSysGetRealtimeCounterX() - start);
+
+		updateAlert(&match, state.accuracy);
+
+		chSysLock();
+		Route_Data.status.match = match;
+		Route_Data.status.fixes++;
+		Route_Data.status.searches += (isSearched) ? 1u : 0u;
+		Route_Data.status.lastTime = time;
+		Route_Data.status.maxTime = (time > Route_Data.status.maxTime) ? time : Route_Data.status.maxTime;
+		if (time > ROUTE_CYCLE_BUDGET)
+		{
+			Route_Data.status.overruns++;
+		}
+		chSysUnlock();
+	}
+}
+
+/**@brief Used to find the nearest route segment of a position.
+ * @details Searches the grid only (no cursor), can be called from any task after Route_Init().
+ * @param[in]	point	Position.
+ * @param[out]	match	Nearest segment, the offset is GEO_DISTANCE_MAX if none is within ROUTE_SEARCH_RADIUS.
+ */
+void Route_Find(const Geo_PointType *point, Route_MatchType *match)
+{
+	Route_SearchType search;
+
+	Geo_FrameInit(&search.frame, point, 0);
+	search.distance = (float)ROUTE_SEARCH_RADIUS;
+	search.along = 0.0f;
+	search.segment = 0u;
+	if (Route_Data.status.isValid)
+	{
+		searchGrid(&search);
+	}
+	getMatch(&search, match);
+}
+
+/**@brief Used to get the status of the route monitor.
+ * @param[out]	status	Status of the route monitor.
+ */
+void Route_GetStatus(Route_StatusType *status)
+{
+	chSysLock();
+	*status = Route_Data.status;
+	chSysUnlock();
+}
+
+/**@brief Used to check the route table.
+ * @return	TRUE if every block contains its points and the first point of the next block and the distances increase.
+ */
+static uint8_t isValid(void)
+{
+	Geo_PointType point;
+	uint8_t isValid = (ROUTE_POINT_NUMBER >= 2u) ? TRUE : FALSE;
+	uint32_t idx = 0u;
+
+	for (idx = 0u; (idx < ROUTE_POINT_NUMBER) && (isValid); idx++)
+	{
+		const Route_BlockType *block = &Route_Block[idx / ROUTE_BLOCK_SIZE];
+
+		getPoint(idx, &point);
+		if ((point.latitude < block->min.latitude) || (point.latitude > block->max.latitude) ||
+			(point.longitude < block->min.longitude) || (point.longitude > block->max.longitude))
+		{
+			isValid = FALSE;
+		}
+		else if (((idx % ROUTE_BLOCK_SIZE) == 0u) && (idx != 0u))
+		{
+			const Route_BlockType *previous = &Route_Block[(idx / ROUTE_BLOCK_SIZE) - 1u];
+
+			isValid = ((point.latitude >= previous->min.latitude) && (point.latitude <= previous->max.latitude) &&
+				(point.longitude >= previous->min.longitude) && (point.longitude <= previous->max.longitude) &&
+				(block->distance >= previous->distance)) ? TRUE : FALSE;
+		}
+		else
+		{
+			/* Nothing to do. */
+		}
+	}
+
+	return isValid;
+}
+
+/**@brief Used to build the grid index of the blocks.
+ * @details Counts the references of each cell, turns the counts into end offsets and fills the
+ * references backwards so that the offsets end up at the start of each cell.
+ * @return	TRUE if the references fit in ROUTE_INDEX_SIZE.
+ */
+static uint8_t buildIndex(void)
+{
+	uint32_t total = 0u;
+	uint32_t idx = 0u;
+	uint32_t column = 0u;
+	uint32_t row = 0u;
+	uint32_t lastColumn = 0u;
+	uint32_t lastRow = 0u;
+	uint32_t x = 0u;
+	uint32_t y = 0u;
+
+	for (idx = 0u; (idx < ROUTE_BLOCK_NUMBER) && (total <= ROUTE_INDEX_SIZE); idx++)
+	{
+		getCells(&Route_Block[idx].min, &Route_Block[idx].max, &column, &row, &lastColumn, &lastRow);
+		for (y = row; y <= lastRow; y++)
+		{
+			for (x = column; x <= lastColumn; x++)
+			{
+				Route_Data.cell[(y * ROUTE_GRID_COLUMNS) + x]++;
+			}
+		}
+		total += (lastColumn - column + 1u) * (lastRow - row + 1u);
+	}
+
+	if (total <= ROUTE_INDEX_SIZE)
+	{
+		for (idx = 1u; idx <= ROUTE_CELL_NUMBER; idx++)
+		{
+			Route_Data.cell[idx] += Route_Data.cell[idx - 1u];
+		}
+		for (idx = 0u; idx < ROUTE_BLOCK_NUMBER; idx++)
+		{
+			getCells(&Route_Block[idx].min, &Route_Block[idx].max, &column, &row, &lastColumn, &lastRow);
+			for (y = row; y <= lastRow; y++)
+			{
+				for (x = column; x <= lastColumn; x++)
+				{
+					Route_Data.index[--Route_Data.cell[(y * ROUTE_GRID_COLUMNS) + x]] = (uint16_t)idx;
+				}
+			}
+		}
+		Route_Data.cell[ROUTE_CELL_NUMBER] = (uint16_t)total;
+		Route_Data.status.indexed = (uint16_t)total;
+	}
+
+	return (total <= ROUTE_INDEX_SIZE) ? TRUE : FALSE;
+}
+
+/**@brief Used to decode a route point.
+ * @param[in]	idx		Index of the point.
+ * @param[out]	point	Position of the point.
+ */
+static void getPoint(const uint32_t idx, Geo_PointType *point)
+{
+	const Route_BlockType *block = &Route_Block[idx / ROUTE_BLOCK_SIZE];
+
+	point->latitude = block->anchor.latitude + ((int32_t)Route_Point[idx].latitude * 10);
+	point->longitude = block->anchor.longitude + ((int32_t)Route_Point[idx].longitude * 10);
+}
+
+/**@brief Used to get the cells covered by a box within the grid.
+ * @param[in]	min			South west corner of the box.
+ * @param[in]	max			North east corner of the box.
+ * @param[out]	column		First column.
+ * @param[out]	row			First row.
+ * @param[out]	lastColumn	Last column.
+ * @param[out]	lastRow		Last row.
+ */
+static void getCells(const Geo_PointType *min, const Geo_PointType *max, uint32_t *column, uint32_t *row, uint32_t *lastColumn, uint32_t *lastRow)
+{
+	*column = ((uint32_t)min->longitude - (uint32_t)Route_Data.min.longitude) / Route_Data.cellWidth;
+	*row = ((uint32_t)min->latitude - (uint32_t)Route_Data.min.latitude) / Route_Data.cellHeight;
+	*lastColumn = ((uint32_t)max->longitude - (uint32_t)Route_Data.min.longitude) / Route_Data.cellWidth;
+	*lastRow = ((uint32_t)max->latitude - (uint32_t)Route_Data.min.latitude) / Route_Data.cellHeight;
+}
+
+/**@brief Used to search a range of segments for one nearer than the best match so far.
+ * @param[in,out]	search	Search state.
+ * @param[in]		first	First segment.
+ * @param[in]		last	Segment after the last one.
+ */
+static void searchSegments(Route_SearchType *search, const uint32_t first, const uint32_t last)
+{
+	Geo_PointType point;
+	Geo_EnuType from;
+	Geo_EnuType to;
+	uint32_t idx = 0u;
+
+	getPoint(first, &point);
+	Geo_ToEnu(&search->frame, &point, 0, &to);
+	for (idx = first; idx < last; idx++)
+	{
+		float east = 0.0f;
+		float north = 0.0f;
+		float lengthSquare = 0.0f;
+		float ratio = 0.0f;
+		float distance = 0.0f;
+
+		from = to;
+		getPoint(idx + 1u, &point);
+		Geo_ToEnu(&search->frame, &point, 0, &to);
+		east = (float)(to.east - from.east);
+		north = (float)(to.north - from.north);
+		lengthSquare = (east * east) + (north * north);
+
+		/* Nearest point of the segment to the origin of the plane (the searched position). */
+		ratio = (lengthSquare > 0.0f) ? (-(((float)from.east * east) + ((float)from.north * north)) / lengthSquare) : 0.0f;
+		ratio = (ratio < 0.0f) ? 0.0f : ((ratio > 1.0f) ? 1.0f : ratio);
+		east = (float)from.east + (ratio * east);
+		north = (float)from.north + (ratio * north);
+		distance = __builtin_sqrtf((east * east) + (north * north));
+		if (distance < search->distance)
+		{
+			search->distance = distance;
+			search->along = ratio * __builtin_sqrtf(lengthSquare);
+			search->segment = idx;
+		}
+	}
+}
+
+/**@brief Used to search the segments of a block unless its bounding box is farther than the best match so far.
+ * @param[in,out]	search	Search state.
+ * @param[in]		block	Block.
+ */
+static void searchBlock(Route_SearchType *search, const uint32_t block)
+{
+	const Route_BlockType *box = &Route_Block[block];
+	const Geo_PointType *origin = &search->frame.origin;
+	const uint32_t first = block * ROUTE_BLOCK_SIZE;
+	const uint32_t last = ((first + ROUTE_BLOCK_SIZE) < ROUTE_SEGMENT_NUMBER) ? (first + ROUTE_BLOCK_SIZE) : ROUTE_SEGMENT_NUMBER;
+	const int32_t deltaLatitude = (origin->latitude < box->min.latitude) ? (box->min.latitude - origin->latitude) :
+		((origin->latitude > box->max.latitude) ? (origin->latitude - box->max.latitude) : 0);
+	const int32_t deltaLongitude = (origin->longitude < box->min.longitude) ? (box->min.longitude - origin->longitude) :
+		((origin->longitude > box->max.longitude) ? (origin->longitude - box->max.longitude) : 0);
+	const float north = (float)deltaLatitude * search->frame.north;
+	const float east = (float)deltaLongitude * search->frame.east;
+
+	if (((east * east) + (north * north)) < (search->distance * search->distance))
+	{
+		searchSegments(search, first, last);
+	}
+}
+
+/**@brief Used to search the blocks of the grid cells within the best match so far.
+ * @details A block listed in several of the searched cells is only searched in the first one.
+ * @param[in,out]	search	Search state.
+ */
+static void searchGrid(Route_SearchType *search)
+{
+	const Geo_PointType *origin = &search->frame.origin;
+	const int32_t deltaLatitude = (int32_t)(search->distance / search->frame.north) + 1;
+	const int32_t deltaLongitude = (int32_t)(search->distance / search->frame.east) + 1;
+	Geo_PointType min;
+	Geo_PointType max;
+	uint32_t column = 0u;
+	uint32_t row = 0u;
+	uint32_t lastColumn = 0u;
+	uint32_t lastRow = 0u;
+	uint32_t blockColumn = 0u;
+	uint32_t blockRow = 0u;
+	uint32_t x = 0u;
+	uint32_t y = 0u;
+	uint32_t idx = 0u;
+
+	min.latitude = ((origin->latitude - deltaLatitude) > Route_Data.min.latitude) ? (origin->latitude - deltaLatitude) : Route_Data.min.latitude;
+	min.longitude = ((origin->longitude - deltaLongitude) > Route_Data.min.longitude) ? (origin->longitude - deltaLongitude) : Route_Data.min.longitude;
+	max.latitude = ((origin->latitude + deltaLatitude) < Route_Data.max.latitude) ? (origin->latitude + deltaLatitude) : Route_Data.max.latitude;
+	max.longitude = ((origin->longitude + deltaLongitude) < Route_Data.max.longitude) ? (origin->longitude + deltaLongitude) : Route_Data.max.longitude;
+	if ((min.latitude <= max.latitude) && (min.longitude <= max.longitude))
+	{
+		if (Route_Data.isIndexed)
+		{
+			getCells(&min, &max, &column, &row, &lastColumn, &lastRow);
+			for (y = row; y <= lastRow; y++)
+			{
+				for (x = column; x <= lastColumn; x++)
+				{
+					const uint32_t cell = (y * ROUTE_GRID_COLUMNS) + x;
+
+					for (idx = Route_Data.cell[cell]; idx < Route_Data.cell[cell + 1u]; idx++)
+					{
+						const uint32_t block = Route_Data.index[idx];
+
+						blockColumn = ((uint32_t)Route_Block[block].min.longitude - (uint32_t)Route_Data.min.longitude) / Route_Data.cellWidth;
+						blockRow = ((uint32_t)Route_Block[block].min.latitude - (uint32_t)Route_Data.min.latitude) / Route_Data.cellHeight;
+						if ((x == ((blockColumn > column) ? blockColumn : column)) && (y == ((blockRow > row) ? blockRow : row)))
+						{
+							searchBlock(search, block);
+						}
+					}
+				}
+			}
+		}
+		else
+		{
+			for (idx = 0u; idx < ROUTE_BLOCK_NUMBER; idx++)
+			{
+				searchBlock(search, idx);
+			}
+		}
+	}
+}
+
+/**@brief Used to turn the result of a search into a match.
+ * @param[in]	search	Search state.
+ * @param[out]	match	Match.
+ */
+static void getMatch(const Route_SearchType *search, Route_MatchType *match)
+{
+	Geo_PointType from;
+	Geo_PointType to;
+	uint32_t idx = 0u;
+
+	match->segment = search->segment;
+	match->offset = GEO_DISTANCE_MAX;
+	match->progress = 0u;
+	if (search->distance < (float)ROUTE_SEARCH_RADIUS)
+	{
+		match->offset = (uint32_t)search->distance;
+		match->progress = Route_Block[search->segment / ROUTE_BLOCK_SIZE].distance + (uint32_t)search->along;
+		for (idx = search->segment & ~(ROUTE_BLOCK_SIZE - 1u); idx < search->segment; idx++)
+		{
+			getPoint(idx, &from);
+			getPoint(idx + 1u, &to);
+			match->progress += Geo_Distance(&from, &to);
+		}
+	}
+}
+
+/**@brief Used to raise and to clear the off route alert with hysteresis.
+ * @details The route is left after ROUTE_OFF_CONFIRM fixes farther than ROUTE_OFF_DISTANCE plus the fix
+ * accuracy and joined after ROUTE_ON_CONFIRM fixes nearer than ROUTE_ON_DISTANCE.
+ * @param[in]	match		Match of the fix.
+ * @param[in]	accuracy	Accuracy of the fix in millimeters.
+ */
+static void updateAlert(const Route_MatchType *match, const uint32_t accuracy)
+{
+	if (Route_Data.status.isOnRoute)
+	{
+		Route_Data.confirm = (match->offset > (ROUTE_OFF_DISTANCE + accuracy)) ? (Route_Data.confirm + 1u) : 0u;
+		if (Route_Data.confirm >= ROUTE_OFF_CONFIRM)
+		{
+			Route_Data.status.isOnRoute = FALSE;
+			Route_Data.status.alerts++;
+			Route_Data.confirm = 0u;
+			Log_Warning("route left, %u m off at %u m", match->offset / 1000u, match->progress / 1000u);
+		}
+	}
+	else
+	{
+		Route_Data.confirm = (match->offset < ROUTE_ON_DISTANCE) ? (Route_Data.confirm + 1u) : 0u;
+		if (Route_Data.confirm >= ROUTE_ON_CONFIRM)
+		{
+			Route_Data.status.isOnRoute = TRUE;
+			Route_Data.confirm = 0u;
+			Log_Info("route joined at %u m of %u m", match->progress / 1000u, Route_Data.status.length / 1000u);
+		}
+	}
+}
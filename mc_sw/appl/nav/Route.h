@@ -0,0 +1,79 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Route.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Route.h
+* @brief Implements the header of the route monitor.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#if !defined(ROUTE_H)
+#define ROUTE_H
+
+#include "Route_Cfg.h"
+
+/**@struct Route_MatchType
+ * @brief Specifies the nearest route segment of a position.
+ */
+typedef struct Route_MatchTypeTag
+{
+	uint32_t segment;				/**< Index of the first point of the segment. */
+	uint32_t offset;				/**< Distance to the segment in millimeters, GEO_DISTANCE_MAX if none is within ROUTE_SEARCH_RADIUS. */
+	uint32_t progress;				/**< Route distance of the nearest point of the segment from the start in millimeters. */
+} Route_MatchType;
+
+/**@struct Route_StatusType
+ * @brief Specifies the route progress, the alert state and the cost of the search.
+ */
+typedef struct Route_StatusTypeTag
+{
+	uint8_t isValid;				/**< TRUE if the route table is valid. */
+	uint8_t isOnRoute;				/**< TRUE while the position follows the route, FALSE before the route is joined and while off the route. */
+	uint16_t indexed;				/**< Number of block references in the grid, 0 if the grid does not fit. */
+	Route_MatchType match;			/**< Match of the last fix. */
+	uint32_t length;				/**< Length of the route in millimeters. */
+	uint32_t fixes;					/**< Number of matched fixes. */
+	uint32_t alerts;				/**< Number of times the route was left. */
+	uint32_t searches;				/**< Number of fixes not found near the cursor and searched in the grid. */
+	uint32_t jumps;					/**< Number of times the grid search moved the cursor. */
+	uint32_t lastTime;				/**< Realtime counter cycles of the last match. */
+	uint32_t maxTime;				/**< Largest realtime counter cycles of a match. */
+	uint32_t overruns;				/**< Number of matches above ROUTE_CYCLE_BUDGET. */
+} Route_StatusType;
+
+extern void Route_Init(void);
+extern void Route_MainFunction(void);
+extern void Route_Find(const Geo_PointType *point, Route_MatchType *match);
+extern void Route_GetStatus(Route_StatusType *status);
+
+#endif /* ROUTE_H */
@@ -0,0 +1,488 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Shell.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Shell.c
+* @brief Implements the command shell over the link (line buffer and hash table dispatch).
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include <string.h>
+#include "Shell.h"
+#include "Os.h"
+#include "Led.h"
+#include "Link.h"
+#include "Log.h"
+#include "Gps.h"
+#include "GpsDuty.h"
+#include "Geofence.h"
+#include "Route.h"
+#include "Clock.h"
+
+/**@struct Shell_DataType
+ * @brief Container used to store the relevant data of the command shell.
+ * @details The line is filled by Shell_Receive() (link task) and executed by Shell_MainFunction()
+ * (background task). Input received while a line waits for execution is dropped, the host terminal
+ * (ts/linkterm) sends the next line only once the reply of the previous one is complete.
+ */
+typedef struct Shell_DataTypeTag
+{
+	char line[SHELL_LINE_SIZE];					/**< Command line buffer. */
+	uint32_t length;							/**< Number of characters in the command line buffer. */
+	volatile uint8_t isLineReady;				/**< Command line is complete and waits for execution. */
+	char output[LINKCODEC_MAX_PAYLOAD];			/**< Output buffer, sent when full or when a command is done. */
+	uint32_t outputLength;						/**< Number of characters in the output buffer. */
+	uint32_t outputDropped;						/**< Number of output characters dropped because the link was busy. */
+} Shell_DataType;
+
+static uint32_t hashCommand(const char *name, const uint32_t length);
+static void flushOutput(void);
+
+/**@brief Stores the command shell data.
+ */
+static Shell_DataType Shell_Data;
+
+/**@brief Used to initialize the command shell.
+ */
+void Shell_Init(void)
+{
+	memset(&Shell_Data, 0u, sizeof(Shell_Data));
+}
+
+/**@brief Used to execute a complete command line.
+ */
+void Shell_MainFunction(void)
+{
+	if (Shell_Data.isLineReady)
+	{
+		const char *args;
+		uint32_t length = 0u;
+		const Shell_CommandType *cmd;
+
+		while ((Shell_Data.line[length] != ' ') && (Shell_Data.line[length] != '\0'))
+		{
+			length++;
+		}
+		args = &Shell_Data.line[length];
+		while (*args == ' ')
+		{
+			args++;
+		}
+
+		cmd = &Shell_Command[hashCommand(Shell_Data.line, length)];
+		if ((length != 0u) && (cmd->name != NULL) && (strncmp(cmd->name, Shell_Data.line, length) == 0) && (cmd->name[length] == '\0'))
+		{
+			cmd->func(args);
+		}
+		else if (length != 0u)
+		{
+			Shell_Print("unknown command, try help\r\n");
+		}
+		Shell_Print("> ");
+		flushOutput();
+
+		Shell_Data.length = 0u;
+		__atomic_store_n(&Shell_Data.isLineReady, FALSE, __ATOMIC_RELEASE);
+	}
+}
+
+/**@brief Link handler of the shell terminal data.
+ * @details Only collects characters into the line buffer, the command is executed by the background task.
+ * @param[in]	payload	Received characters.
+ * @param[in]	length	Number of received characters.
+ */
+void Shell_Receive(const uint8_t *payload, const uint32_t length)
+{
+	uint32_t idx = 0u;
+
+	while ((idx < length) && (Shell_Data.isLineReady == FALSE))
+	{
+		const char c = (char)payload[idx];
+
+		if ((c == '\r') || (c == '\n'))
+		{
+			Shell_Data.line[Shell_Data.length] = '\0';
+			__atomic_store_n(&Shell_Data.isLineReady, TRUE, __ATOMIC_RELEASE);
+		}
+		else if ((c == '\b') || (c == 0x7F))
+		{
+			if (Shell_Data.length > 0u)
+			{
+				Shell_Data.length--;
+			}
+		}
+		else if (Shell_Data.length < (SHELL_LINE_SIZE - 1u))
+		{
+			Shell_Data.line[Shell_Data.length] = c;
+			Shell_Data.length++;
+		}
+		idx++;
+	}
+}
+
+/**@brief Used to print a text on the shell terminal.
+ * @param[in]	text	Zero terminated text.
+ */
+void Shell_Print(const char *text)
+{
+	while (*text != '\0')
+	{
+		if (Shell_Data.outputLength == sizeof(Shell_Data.output))
+		{
+			flushOutput();
+		}
+		Shell_Data.output[Shell_Data.outputLength] = *text;
+		Shell_Data.outputLength++;
+		text++;
+	}
+}
+
+/**@brief Used to print an unsigned decimal number on the shell terminal.
+ * @param[in]	value	Number to print.
+ */
+void Shell_PrintNumber(const uint32_t value)
+{
+	char text[11u];
+	uint32_t idx = sizeof(text) - 1u;
+	uint32_t rest = value;
+
+	text[idx] = '\0';
+	do
+	{
+		idx--;
+		text[idx] = (char)('0' + (rest % 10u));
+		rest /= 10u;
+	} while (rest != 0u);
+
+	Shell_Print(&text[idx]);
+}
+
+/**@brief Shell command: list of commands.
+ */
+void Shell_CmdHelp(const char *args)
+{
+	uint32_t idx = 0u;
+
+	(void)args;
+	for (idx = 0u; idx < SHELL_HASH_SIZE; idx++)
+	{
+		if (Shell_Command[idx].name != NULL)
+		{
+			Shell_Print(Shell_Command[idx].name);
+			Shell_Print("\t");
+			Shell_Print(Shell_Command[idx].help);
+			Shell_Print("\r\n");
+		}
+	}
+}
+
+/**@brief Shell command: OS task states.
+ */
+void Shell_CmdTasks(const char *args)
+{
+	uint32_t id = 0u;
+
+	(void)args;
+	Shell_Print("id\tprio\tstate\tperiod\r\n");
+	for (id = 0u; id < OS_THREAD_NUMBER; id++)
+	{
+		const thread_t *task = Os_GetTask(id);
+
+		if (task != NULL)
+		{
+			Shell_PrintNumber(id);
+			Shell_Print("\t");
+			Shell_PrintNumber((uint32_t)task->prio);
+			Shell_Print("\t");
+			Shell_PrintNumber((uint32_t)task->state);
+			Shell_Print("\t");
+			Shell_PrintNumber((uint32_t)task->recurrence);
+			Shell_Print("\r\n");
+		}
+	}
+}
+
+/**@brief Shell command: LED states.
+ */
+void Shell_CmdLed(const char *args)
+{
+	uint32_t id = 0u;
+
+	(void)args;
+	for (id = 0u; id < (uint32_t)LED_ID_UNKNOWN; id++)
+	{
+		Shell_Print("led ");
+		Shell_PrintNumber(id);
+		Shell_Print((Led_GetState((Led_IdType)id) == LED_STATE_ON) ? " on\r\n" : " off\r\n");
+	}
+}
+
+/**@brief Shell command: UART channel statistics.
+ */
+void Shell_CmdUart(const char *args)
+{
+	uint32_t channel = 0u;
+
+	(void)args;
+	Shell_Print("ch\toverrun\terror\ttxfree\r\n");
+	for (channel = 0u; channel < (uint32_t)UARTHNDLR_CHANNEL_UNKNOWN; channel++)
+	{
+		Shell_PrintNumber(channel);
+		Shell_Print("\t");
+		Shell_PrintNumber(UartHndlr_GetRxOverruns((UartHndlr_ChannelType)channel));
+		Shell_Print("\t");
+		Shell_PrintNumber(UartHndlr_GetRxErrors((UartHndlr_ChannelType)channel));
+		Shell_Print("\t");
+		Shell_PrintNumber(UartHndlr_GetTxFree((UartHndlr_ChannelType)channel));
+		Shell_Print("\r\n");
+	}
+}
+
+/**@brief Shell command: log and link statistics.
+ * @details The log is kept in the RAM ring only, its records are streamed to the host and decoded
+ * there. The command reports the ring fill level, the dropped records and the dropped shell output.
+ */
+void Shell_CmdLog(const char *args)
+{
+	(void)args;
+	Shell_Print("log pending ");
+	Shell_PrintNumber(Log_GetPending());
+	Shell_Print("/");
+	Shell_PrintNumber(LOG_RING_SIZE);
+	Shell_Print(" words, dropped ");
+	Shell_PrintNumber(Log_GetDropped());
+	Shell_Print("\r\nlink rx errors ");
+	Shell_PrintNumber(Link_GetRxErrors());
+	Shell_Print("\r\nshell output dropped ");
+	Shell_PrintNumber(Shell_Data.outputDropped);
+	Shell_Print("\r\n");
+}
+
+/**@brief Shell command: GNSS fix and receive statistics.
+ * @details Latitude and longitude are printed in 1e-7 degrees, the parse time in realtime counter cycles,
+ * the clock in seconds since 2000-01-01 UTC and its time error at the last PPS edge in microseconds.
+ */
+void Shell_CmdGnss(const char *args)
+{
+	Gps_FixType fix;
+	Gps_StatisticsType stats;
+	GpsDuty_StatusType duty;
+	GpsSky_SummaryType sky;
+	Clock_StatusType clock;
+
+	(void)args;
+	Gps_GetFix(&fix);
+	Gps_GetStatistics(&stats);
+	GpsDuty_GetStatus(&duty);
+	Gps_GetSkySummary(&sky);
+	Clock_GetStatus(&clock);
+	Shell_Print("fix ");
+	Shell_PrintNumber(fix.isValid);
+	Shell_Print(" mode ");
+	Shell_PrintNumber((uint32_t)fix.mode);
+	Shell_Print(" sats ");
+	Shell_PrintNumber(fix.satellites);
+	Shell_Print(" lat ");
+	Shell_Print((fix.latitude < 0) ? "-" : "");
+	Shell_PrintNumber((fix.latitude < 0) ? (uint32_t)-fix.latitude : (uint32_t)fix.latitude);
+	Shell_Print(" lon ");
+	Shell_Print((fix.longitude < 0) ? "-" : "");
+	Shell_PrintNumber((fix.longitude < 0) ? (uint32_t)-fix.longitude : (uint32_t)fix.longitude);
+	Shell_Print("\r\nsky ");
+	Shell_PrintNumber(sky.used);
+	Shell_Print("/");
+	Shell_PrintNumber(sky.tracked);
+	Shell_Print("/");
+	Shell_PrintNumber(sky.inView);
+	Shell_Print(" cno ");
+	Shell_PrintNumber(sky.meanCno);
+	Shell_Print(" dop ");
+	Shell_PrintNumber(sky.dop);
+	Shell_Print((sky.dopTrend > 0) ? " rising" : " steady");
+	Shell_Print("\r\nbytes ");
+	Shell_PrintNumber(stats.bytes);
+	Shell_Print(" messages ");
+	Shell_PrintNumber(stats.messages);
+	Shell_Print(" errors ");
+	Shell_PrintNumber(stats.errors);
+	Shell_Print(" cycles ");
+	Shell_PrintNumber(stats.parseTime);
+	Shell_Print("\r\nduty ");
+	Shell_PrintNumber((uint32_t)duty.mode);
+	Shell_Print(" for ");
+	Shell_PrintNumber(duty.modeTime);
+	Shell_Print(" s, ");
+	Shell_PrintNumber(duty.current);
+	Shell_Print(" uA, ");
+	Shell_PrintNumber(duty.charge);
+	Shell_Print(" mAs\r\nclock ");
+	Shell_PrintNumber((uint32_t)(Clock_GetTime() / 1000000u));
+	Shell_Print(" source ");
+	Shell_PrintNumber((uint32_t)clock.source);
+	Shell_Print(clock.isLocked ? " locked" : " free");
+	Shell_Print(" offset ");
+	Shell_Print((clock.offset < 0) ? "-" : "");
+	Shell_PrintNumber((clock.offset < 0) ? (uint32_t)-clock.offset : (uint32_t)clock.offset);
+	Shell_Print(" us pps ");
+	Shell_PrintNumber(clock.edges);
+	Shell_Print(" steps ");
+	Shell_PrintNumber(clock.steps);
+	Shell_Print("\r\n");
+}
+
+/**@brief Used to print the fences the position is inside and the geofence test cost.
+ * @param[in]	args	Unused.
+ */
+void Shell_CmdArea(const char *args)
+{
+	Geofence_StatusType status;
+	uint16_t fences[GEOFENCE_MAX_INSIDE];
+	uint32_t number = 0u;
+	uint32_t idx = 0u;
+
+	(void)args;
+	Geofence_GetStatus(&status);
+	number = Geofence_GetInside(fences, GEOFENCE_MAX_INSIDE);
+	Shell_Print("fences ");
+	Shell_PrintNumber(status.fences);
+	Shell_Print(" indexed ");
+	Shell_PrintNumber(status.indexed);
+	Shell_Print(" fixes ");
+	Shell_PrintNumber(status.fixes);
+	Shell_Print(" enters ");
+	Shell_PrintNumber(status.enters);
+	Shell_Print(" exits ");
+	Shell_PrintNumber(status.exits);
+	Shell_Print("\r\ninside");
+	for (idx = 0u; idx < number; idx++)
+	{
+		Shell_Print(" ");
+		Shell_PrintNumber(fences[idx]);
+	}
+	Shell_Print(status.isOutsideAllowed ? " (outside allowed areas)" : "");
+	Shell_Print("\r\ntested ");
+	Shell_PrintNumber(status.candidates);
+	Shell_Print(" fences ");
+	Shell_PrintNumber(status.edges);
+	Shell_Print(" edges, cycles ");
+	Shell_PrintNumber(status.lastTime);
+	Shell_Print(" max ");
+	Shell_PrintNumber(status.maxTime);
+	Shell_Print(" overruns ");
+	Shell_PrintNumber(status.overruns);
+	Shell_Print("\r\n");
+}
+
+/**@brief Used to print the route progress, the off route state and the route search cost.
+ * @param[in]	args	Unused.
+ */
+void Shell_CmdTrail(const char *args)
+{
+	Route_StatusType status;
+
+	(void)args;
+	Route_GetStatus(&status);
+	Shell_Print(status.isValid ? "route " : "route invalid ");
+	Shell_PrintNumber(status.match.progress / 1000u);
+	Shell_Print(" of ");
+	Shell_PrintNumber(status.length / 1000u);
+	Shell_Print(" m, segment ");
+	Shell_PrintNumber(status.match.segment);
+	Shell_Print(status.isOnRoute ? " on route" : " off route");
+	if (status.match.offset != GEO_DISTANCE_MAX)
+	{
+		Shell_Print(", offset ");
+		Shell_PrintNumber(status.match.offset / 1000u);
+		Shell_Print(" m");
+	}
+	Shell_Print("\r\nfixes ");
+	Shell_PrintNumber(status.fixes);
+	Shell_Print(" alerts ");
+	Shell_PrintNumber(status.alerts);
+	Shell_Print(" searches ");
+	Shell_PrintNumber(status.searches);
+	Shell_Print(" jumps ");
+	Shell_PrintNumber(status.jumps);
+	Shell_Print(" indexed ");
+	Shell_PrintNumber(status.indexed);
+	Shell_Print("\r\ncycles ");
+	Shell_PrintNumber(status.lastTime);
+	Shell_Print(" max ");
+	Shell_PrintNumber(status.maxTime);
+	Shell_Print(" overruns ");
+	Shell_PrintNumber(status.overruns);
+	Shell_Print("\r\n");
+}
+
+/**@brief Used to compute the hash table slot of a command name.
+ * @param[in]	name	Command name (not terminated).
+ * @param[in]	length	Number of characters of the command name.
+ * @return	Slot in the command hash table.
+ */
+static uint32_t hashCommand(const char *name, const uint32_t length)
+{
+	uint32_t hash = SHELL_HASH_SEED;
+	uint32_t idx = 0u;
+
+	for (idx = 0u; idx < length; idx++)
+	{
+		hash = (hash ^ (uint8_t)name[idx]) * 0x01000193u;
+	}
+
+	return hash & (SHELL_HASH_SIZE - 1u);
+}
+
+/**@brief Used to send the output buffer over the link.
+ * @details Runs in the background task, so it waits up to SHELL_FLUSH_RETRIES times 10 ms for a free
+ * window position. If no peer acknowledges the frames the output is dropped and counted.
+ */
+static void flushOutput(void)
+{
+	if (Shell_Data.outputLength != 0u)
+	{
+		uint32_t retries = 0u;
+		uint8_t isSent = Link_Send(LINKCODEC_MSG_ID_SHELL, (const uint8_t *)Shell_Data.output, Shell_Data.outputLength, TRUE);
+
+		while ((isSent == FALSE) && (retries < SHELL_FLUSH_RETRIES))
+		{
+			chThdSleepMilliseconds(10u);
+			retries++;
+			isSent = Link_Send(LINKCODEC_MSG_ID_SHELL, (const uint8_t *)Shell_Data.output, Shell_Data.outputLength, TRUE);
+		}
+		if (isSent == FALSE)
+		{
+			Shell_Data.outputDropped += Shell_Data.outputLength;
+		}
+		Shell_Data.outputLength = 0u;
+	}
+}
@@ -0,0 +1,60 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Shell.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Shell.h
+* @brief Implements the header of the command shell.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#if !defined(SHELL_H)
+#define SHELL_H
+
+#include "Shell_Cfg.h"
+
+extern void Shell_Init(void);
+extern void Shell_MainFunction(void);
+extern void Shell_Receive(const uint8_t *payload, const uint32_t length);
+extern void Shell_Print(const char *text);
+extern void Shell_PrintNumber(const uint32_t value);
+
+extern void Shell_CmdHelp(const char *args);
+extern void Shell_CmdTasks(const char *args);
+extern void Shell_CmdLed(const char *args);
+extern void Shell_CmdUart(const char *args);
+extern void Shell_CmdLog(const char *args);
+extern void Shell_CmdGnss(const char *args);
+extern void Shell_CmdArea(const char *args);
+extern void Shell_CmdTrail(const char *args);
+
+#endif /* SHELL_H */
@@ -40,6 +40,17 @@
 #include "Os.h"
 #include "hal.h"
 #include "Led.h"
+#include "UartHndlr.h"
+#include "Link.h"
+#include "Gps.h"
+#include "Fusion.h"
+#include "GpsDuty.h"
+#include "Geofence.h"
+#include "Route.h"
+#include "Clock.h"
+#include "Log.h"
+#include "Shell.h"
+#include "Vfb.h"
 
 /**@brief Application entry point.
  */
@@ -51,17 +62,38 @@ void main(void) {
    *   and performs the board-specific initializations.
    */
   halInit();
+  Log_Init();
+  Vfb_Dio_Init();
 
   /*
-     * Activates the serial driver 2 using the driver default configuration.
-     */
-  Led_Init(10u);
-  Led_HeartBeat(LED_ID_USER0, 100u, 2u, 500u);
+   * Switches the sensor supply on with the modem power key released, in one port write.
+   */
+  Vfb_Dio_Write_Group(VFB_DIO_GROUP_POWER, VFB_DIO_MASK(VFB_DIO_SENSOR_ENABLE));
 
   /*
-   * Creates the threads.
+   * Initializes the kernel and creates the threads (suspended).
    */
   Os_Init();
+
+  /*
+   * Starts the drivers. Their interrupts use the kernel locks and services,
+   * so they are only enabled once the kernel is initialized.
+   */
+  UartHndlr_Init();
+  Vfb_I2c_Init();
+  Vfb_Spi_Init();
+  Vfb_Adc_Init();
+  Vfb_Dio_InputInit();
+  Link_Init(10u);
+  Gps_Init(20u);
+  Fusion_Init(20u);
+  GpsDuty_Init(100u);
+  Geofence_Init();
+  Route_Init();
+  Shell_Init();
+  Led_Init(10u);
+  Led_HeartBeat(LED_ID_USER0, 100u, 2u, 500u);
+  Clock_Init(20u);
   Os_StartTasks();
 
   chThdExit(0);
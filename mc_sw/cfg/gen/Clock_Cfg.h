@@ -0,0 +1,111 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Clock_Cfg.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Clock_Cfg.h
+* @brief Implements the configuration of the system clock service.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#if !defined(CLOCK_CFG_H)
+#define CLOCK_CFG_H
+
+#include "Vfb.h"
+
+/**@brief Defines the input of the receiver time pulse.
+ */
+#define CLOCK_PPS_LINE					(VFB_DIO_GPS_PPS)
+
+/**@brief Defines the RTC driver set from the GPS time.
+ */
+#define CLOCK_RTC						(VFB_RTC_RTC1)
+
+/**@brief Defines the nominal frequency of the realtime counter (DWT cycle counter, system clock) in Hz.
+ */
+#define CLOCK_COUNTER_FREQUENCY			(80000000u)
+
+/**@brief Defines the deviation in ppm from the estimated frequency up to which a PPS interval is accepted.
+ * @details The system clock is locked to the LSE crystal (MSI PLL mode), so a larger deviation
+ * is a missed or a spurious edge.
+ */
+#define CLOCK_FREQUENCY_TOLERANCE		(200u)
+
+/**@brief Defines the low pass shift of the frequency estimate, the time constant is 2^shift PPS intervals.
+ */
+#define CLOCK_FREQUENCY_SHIFT			(2u)
+
+/**@brief Defines the maximum number of seconds between two PPS edges used for a frequency measurement.
+ */
+#define CLOCK_PPS_GAP					(16u)
+
+/**@brief Defines the maximum time in milliseconds from a measurement epoch until its fix is merged.
+ * @details Includes the receiver output latency and the delay of the MainFunctions, must stay
+ * below one second so that a PPS edge can be matched to its UTC second without ambiguity.
+ */
+#define CLOCK_FIX_LATENCY				(600u)
+
+/**@brief Defines the time error in microseconds above which the clock is stepped instead of slewed.
+ */
+#define CLOCK_STEP_THRESHOLD			(1000u)
+
+/**@brief Defines the number of consecutive PPS edges above CLOCK_STEP_THRESHOLD needed to step a disciplined clock.
+ */
+#define CLOCK_STEP_CONFIRM				(3u)
+
+/**@brief Defines the maximum time error in microseconds removed per second by slewing (500 ppm).
+ */
+#define CLOCK_SLEW_LIMIT				(500)
+
+/**@brief Defines the time error in microseconds up to which the disciplined clock is locked.
+ */
+#define CLOCK_LOCK_ERROR				(10)
+
+/**@brief Defines the time in milliseconds without PPS edge after which the clock is in holdover.
+ */
+#define CLOCK_PPS_TIMEOUT				(2500u)
+
+/**@brief Defines the time in seconds between two RTC updates from the disciplined clock.
+ */
+#define CLOCK_RTC_PERIOD				(3600u)
+
+/**@brief Defines the time in milliseconds after the second in which the RTC is set.
+ * @details The RTC drops the milliseconds when it is set, so it is set right after a second. Must
+ * be above the recurrence of the MainFunction.
+ */
+#define CLOCK_RTC_WINDOW				(25u)
+
+/**@brief Defines the first year the RTC calendar is trusted from at boot (not set after a backup domain reset).
+ */
+#define CLOCK_RTC_MIN_YEAR				(2017u)
+
+#endif /* CLOCK_CFG_H */
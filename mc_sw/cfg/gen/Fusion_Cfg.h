@@ -0,0 +1,109 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Fusion_Cfg.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Fusion_Cfg.h
+* @brief Implements the configuration of the GPS/IMU position fusion.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#if !defined(FUSION_CFG_H)
+#define FUSION_CFG_H
+
+#include "Geo.h"
+#include "Gps.h"
+
+/**@brief Defines the noise density of the level frame acceleration in m/s^2 per sqrt(Hz).
+ * @details Covers the sensor noise and the errors of the rotation into the level frame.
+ */
+#define FUSION_ACCEL_NOISE				(0.3f)
+
+/**@brief Defines the noise density of the unknown acceleration in m/s^2 per sqrt(Hz) while no IMU data is received.
+ * @details Without IMU data the filter runs a constant velocity model, walking and climbing
+ * accelerations are covered by this process noise.
+ */
+#define FUSION_MANEUVER_NOISE			(1.0f)
+
+/**@brief Defines the noise density of the accelerometer bias random walk in m/s^2 per sqrt(s).
+ */
+#define FUSION_BIAS_NOISE				(0.01f)
+
+/**@brief Defines the standard deviation of the receiver range error in meters.
+ * @details Used with the HDOP when the receiver does not report an accuracy estimate (NMEA).
+ */
+#define FUSION_UERE						(4.0f)
+
+/**@brief Defines the squared innovation distance above which a GPS measurement is rejected.
+ * @details Chi-square with two degrees of freedom, 13.8 rejects 0.1 % of the valid measurements.
+ */
+#define FUSION_GATE						(13.8f)
+
+/**@brief Defines the number of consecutive rejected fixes after which the filter is reset to the GPS.
+ */
+#define FUSION_REJECT_LIMIT				(5u)
+
+/**@brief Defines the distance in meters from the frame origin at which the frame is moved.
+ */
+#define FUSION_RECENTER_DISTANCE		(5000.0f)
+
+/**@brief Defines the time in milliseconds without IMU data after which the constant velocity model is used.
+ */
+#define FUSION_IMU_TIMEOUT				(100u)
+
+/**@brief Defines the time in milliseconds without GPS fix after which the output is marked invalid.
+ */
+#define FUSION_GPS_TIMEOUT				(10000u)
+
+/**@brief Defines the time in milliseconds over which the acceleration variance is evaluated.
+ */
+#define FUSION_STILL_WINDOW				(1000u)
+
+/**@brief Defines the level frame acceleration variance in m^2/s^4 above which the device is moving.
+ * @details 0.05 is a standard deviation of about 0.22 m/s^2, well above the sensor noise and well
+ * below walking or climbing.
+ */
+#define FUSION_STILL_VARIANCE			(0.05f)
+
+/**@brief Defines the fused speed in m/s above which the device is moving while no IMU data is received.
+ */
+#define FUSION_STILL_SPEED				(0.5f)
+
+/**@brief Defines the time in milliseconds without motion after which the device is still.
+ */
+#define FUSION_STILL_TIME				(30000u)
+
+/**@brief Defines the realtime counter cycles one MainFunction call may take (80 MHz core, 25 us).
+ */
+#define FUSION_CYCLE_BUDGET				(2000u)
+
+#endif /* FUSION_CFG_H */
@@ -0,0 +1,85 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Geofence_Cfg.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Geofence_Cfg.c
+* @brief Implements the fence tables of the geofence monitor.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include "Geofence.h"
+
+/**@brief Stores the fences.
+ * @details Generated table: the bounding boxes are computed from the vertices, fences with a wrong box
+ * are dropped on init.
+ */
+const Geofence_FenceType Geofence_Fence[GEOFENCE_FENCE_NUMBER] =
+{
+	{	{474230000, 109870000},	{474305000, 109985000},	0u,		5u,	GEOFENCE_KIND_DANGER	},	/* 0 Hoellental avalanche slope */
+	{	{474082000, 110130000},	{474092000, 110146000},	5u,		4u,	GEOFENCE_KIND_HUT		},	/* 1 Knorrhuette */
+	{	{474070000, 110080000},	{474150000, 110900000},	9u,		8u,	GEOFENCE_KIND_ALLOWED	},	/* 2 Reintal trail corridor */
+	{	{473975000, 110000000},	{474030000, 110100000},	17u,	6u,	GEOFENCE_KIND_DANGER	}	/* 3 Platt rockfall area */
+};
+
+/**@brief Stores the vertices of all of the fences.
+ */
+const Geo_PointType Geofence_Vertex[GEOFENCE_VERTEX_NUMBER] =
+{
+	/* 0 Hoellental avalanche slope */
+	{474305000, 109890000},
+	{474290000, 109960000},
+	{474240000, 109985000},
+	{474230000, 109920000},
+	{474262000, 109870000},
+	/* 1 Knorrhuette */
+	{474092000, 110130000},
+	{474092000, 110146000},
+	{474082000, 110146000},
+	{474082000, 110130000},
+	/* 2 Reintal trail corridor */
+	{474120000, 110900000},
+	{474105000, 110600000},
+	{474085000, 110300000},
+	{474070000, 110120000},
+	{474100000, 110080000},
+	{474115000, 110290000},
+	{474135000, 110590000},
+	{474150000, 110895000},
+	/* 3 Platt rockfall area */
+	{474030000, 110000000},
+	{474030000, 110100000},
+	{474000000, 110100000},
+	{474000000, 110060000},
+	{473975000, 110060000},
+	{473975000, 110000000}
+};
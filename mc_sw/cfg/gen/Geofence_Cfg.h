@@ -0,0 +1,105 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Geofence_Cfg.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Geofence_Cfg.h
+* @brief Implements the configuration of the geofence monitor.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#if !defined(GEOFENCE_CFG_H)
+#define GEOFENCE_CFG_H
+
+#include "Geo.h"
+#include "Fusion.h"
+
+/**@brief Defines the number of fences in Geofence_Fence.
+ */
+#define GEOFENCE_FENCE_NUMBER			(4u)
+
+/**@brief Defines the number of vertices in Geofence_Vertex.
+ */
+#define GEOFENCE_VERTEX_NUMBER			(23u)
+
+/**@brief Defines the number of grid columns (longitude) over the bounding box of all of the fences.
+ */
+#define GEOFENCE_GRID_COLUMNS			(32u)
+
+/**@brief Defines the number of grid rows (latitude) over the bounding box of all of the fences.
+ */
+#define GEOFENCE_GRID_ROWS				(32u)
+
+/**@brief Defines the number of fence references the grid can hold (sum of the covered cells of all of the fences).
+ * @details If the grid does not fit, every fix is tested against the bounding boxes of all of the fences.
+ * @note Must be below 65536.
+ */
+#define GEOFENCE_INDEX_SIZE				(2048u)
+
+/**@brief Defines the number of fences the position can be inside at the same time.
+ */
+#define GEOFENCE_MAX_INSIDE				(8u)
+
+/**@brief Defines the position accuracy (one axis) in millimeters above which the fences are not tested.
+ */
+#define GEOFENCE_MAX_ACCURACY			(50000u)
+
+/**@brief Defines the realtime counter cycles a MainFunction call should stay below.
+ */
+#define GEOFENCE_CYCLE_BUDGET			(80000u)
+
+/**@enum Geofence_KindTypeTag
+ * @brief Specifies what a fence marks and when it is reported.
+ */
+typedef enum Geofence_KindTypeTag
+{
+	GEOFENCE_KIND_DANGER = 0u,		/**< Danger area, entering is a warning. */
+	GEOFENCE_KIND_HUT,				/**< Point of interest, entering and leaving are reported. */
+	GEOFENCE_KIND_ALLOWED			/**< Allowed area, leaving all of them is a warning. */
+} Geofence_KindType;
+
+/**@struct Geofence_FenceType
+ * @brief Specifies a polygon fence, its vertices are consecutive in Geofence_Vertex.
+ */
+typedef struct Geofence_FenceTypeTag
+{
+	Geo_PointType min;				/**< South west corner of the bounding box. */
+	Geo_PointType max;				/**< North east corner of the bounding box. */
+	uint16_t first;					/**< Index of the first vertex. */
+	uint16_t number;				/**< Number of vertices (at least 3), the last one connects to the first one. */
+	Geofence_KindType kind;			/**< What the fence marks. */
+} Geofence_FenceType;
+
+extern const Geofence_FenceType Geofence_Fence[GEOFENCE_FENCE_NUMBER];
+extern const Geo_PointType Geofence_Vertex[GEOFENCE_VERTEX_NUMBER];
+
+#endif /* GEOFENCE_CFG_H */
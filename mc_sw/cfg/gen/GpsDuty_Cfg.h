@@ -0,0 +1,101 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: GpsDuty_Cfg.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file GpsDuty_Cfg.h
+* @brief Implements the configuration of the GNSS receiver duty cycling.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#if !defined(GPSDUTY_CFG_H)
+#define GPSDUTY_CFG_H
+
+#include "Geo.h"
+#include "Gps.h"
+#include "Fusion.h"
+
+/**@brief Defines the measurement period in milliseconds of the continuous mode.
+ */
+#define GPSDUTY_CONTINUOUS_PERIOD		(200u)
+
+/**@brief Defines the measurement period in milliseconds of the 1 Hz and of the wake mode.
+ */
+#define GPSDUTY_NORMAL_PERIOD			(1000u)
+
+/**@brief Defines the horizontal accuracy in millimeters up to which a fix is good.
+ */
+#define GPSDUTY_GOOD_ACCURACY			(10000u)
+
+/**@brief Defines the HDOP x 100 up to which a fix is good if the receiver reports no accuracy (NMEA).
+ */
+#define GPSDUTY_GOOD_HDOP				(200u)
+
+/**@brief Defines the minimum number of used satellites to enter the periodic mode.
+ */
+#define GPSDUTY_MIN_USED				(6u)
+
+/**@brief Defines the minimum mean C/N0 in dBHz of the tracked satellites to enter the periodic mode.
+ */
+#define GPSDUTY_MIN_CNO					(30u)
+
+/**@brief Defines the DOP trend x 100 above which the periodic mode is not entered (geometry degrading).
+ */
+#define GPSDUTY_MAX_DOP_TREND			(20)
+
+/**@brief Defines the speed over ground in millimeters per second above which the continuous mode is used.
+ */
+#define GPSDUTY_FAST_SPEED				(3000u)
+
+/**@brief Defines the time in milliseconds a condition has to persist before the rate is changed.
+ */
+#define GPSDUTY_DWELL_TIME				(10000u)
+
+/**@brief Defines the time in milliseconds between two hot starts of the periodic mode.
+ */
+#define GPSDUTY_WAKE_PERIOD				(300000u)
+
+/**@brief Defines the time in milliseconds a hot start may take before the receiver is switched off again.
+ */
+#define GPSDUTY_ACQUIRE_TIMEOUT			(30000u)
+
+/**@brief Defines the distance in millimeters from the sleep position above which a wake fix counts as motion.
+ */
+#define GPSDUTY_MOVE_DISTANCE			(50000u)
+
+/**@brief Defines the estimated receiver supply current of each mode in microamperes.
+ * @details Order of GpsDuty_ModeType: continuous, 1 Hz, sleep (backup supply only), wake (acquisition).
+ * With a hot start of about 5 s every 5 minutes the periodic mode averages about 0.5 mA.
+ */
+#define GPSDUTY_CURRENT					{ 32000u, 25000u, 15u, 29000u }
+
+#endif /* GPSDUTY_CFG_H */
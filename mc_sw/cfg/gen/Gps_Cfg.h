@@ -0,0 +1,90 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Gps_Cfg.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Gps_Cfg.h
+* @brief Implements the configuration of the GNSS receiver handler.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#if !defined(GPS_CFG_H)
+#define GPS_CFG_H
+
+#include "GpsNmea.h"
+#include "GpsUbx.h"
+#include "GpsSky.h"
+#include "UartHndlr.h"
+
+/**@brief Defines the protocols the receiver output can be decoded from.
+ */
+#define GPS_PROTOCOL_NMEA				(0u)
+#define GPS_PROTOCOL_UBX				(1u)
+
+/**@brief Defines the protocol of the receiver output.
+ * @details With GPS_PROTOCOL_UBX the receiver (u-blox) is configured on init to output NAV-PVT and
+ * NAV-SAT only. It must already listen on UARTHNDLR_GPS_BAUDRATE. The host programs select the
+ * protocol of their input with -DGPS_PROTOCOL.
+ */
+#if !defined(GPS_PROTOCOL)
+#define GPS_PROTOCOL					(GPS_PROTOCOL_UBX)
+#endif
+
+/**@brief Defines the UART channel connected to the GNSS receiver.
+ */
+#define GPS_CHANNEL						(UARTHNDLR_CHANNEL_GPS)
+
+/**@brief Defines the receiver port the UART channel is connected to (1 = UART1).
+ */
+#define GPS_UBX_PORT					(1u)
+
+/**@brief Defines the measurement period of the receiver in milliseconds after init.
+ */
+#define GPS_MEASUREMENT_PERIOD			(1000u)
+
+/**@brief Defines the time in milliseconds from power on until the receiver accepts commands.
+ */
+#define GPS_BOOT_TIME					(1000u)
+
+/**@brief Defines the number of navigation solutions between two NAV-SAT messages.
+ */
+#define GPS_SATELLITE_RATE				(5u)
+
+/**@brief Defines the number of NAV-SAT entries which are decoded, the table keeps GPSSKY_SATELLITES per system.
+ */
+#define GPS_SATELLITE_NUMBER			(GPSUBX_MAX_SATELLITES)
+
+/**@brief Defines the size in bytes of the transmit buffer for receiver commands.
+ */
+#define GPS_TX_BUFFER_SIZE				(96u)
+
+#endif /* GPS_CFG_H */
@@ -0,0 +1,70 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Link_Cfg.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Link_Cfg.h
+* @brief Implements the header of the link protocol configuration.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#if !defined(LINK_CFG_H)
+#define LINK_CFG_H
+
+#include "LinkCodec.h"
+#include "UartHndlr.h"
+
+/**@brief Defines the UART channel used by the link.
+ */
+#define LINK_CHANNEL					(UARTHNDLR_CHANNEL_DEBUG)
+
+/**@brief Defines the maximum number of acknowledged frames which can be in flight.
+ * @note Must be a power of two, at most 128.
+ */
+#define LINK_WINDOW_SIZE				(4u)
+
+/**@brief Defines the number of encoded frame buffers (acknowledged and unacknowledged frames).
+ */
+#define LINK_TX_SLOT_NUMBER				(8u)
+
+/**@brief Defines the time in milliseconds after which unacknowledged frames are sent again.
+ */
+#define LINK_RETRANSMIT_TIME			(200u)
+
+/**@brief Specifies the handler of a received message.
+ * @details Called from the task of Link_MainFunction(). The payload is only valid during the call.
+ */
+typedef void (*Link_RxHandlerType)(const uint8_t *payload, const uint32_t length);
+
+extern const Link_RxHandlerType Link_RxHandler[LINKCODEC_MSG_ID_UNKNOWN];
+
+#endif /* LINK_CFG_H */
@@ -39,6 +39,16 @@
 /*============================================================================*/
 #include "Os_Cfg.h"
 #include "Led.h"
+#include "Link.h"
+#include "Gps.h"
+#include "Fusion.h"
+#include "GpsDuty.h"
+#include "Geofence.h"
+#include "Route.h"
+#include "Clock.h"
+#include "Log.h"
+#include "Shell.h"
+#include "Vfb.h"
 
 /**@brief Defines the wrapper for the thread stack name.
  */
@@ -54,6 +64,18 @@
  */
 #define TerminateTask()				chThdSleepMilliseconds(currp->recurrence); }
 
+/**@brief Defines the wrapper for the event activated OS thread.
+ * @details The first activation runs with all of the events set, the signaled events are in "events".
+ */
+#define EVENT_TASK(tname)			static THD_FUNCTION(tname, arg) { \
+										eventmask_t events = ALL_EVENTS; \
+										(void)arg; \
+										while(TRUE)
+
+/**@brief Defines the wrapper for the event activated OS thread exit condition (wait for events).
+ */
+#define TerminateEventTask()		events = chEvtWaitAny(ALL_EVENTS); }
+
 static THD_FUNCTION(Task_2ms, arg);
 static THD_FUNCTION(Task_5ms, arg);
 static THD_FUNCTION(Task_10ms, arg);
@@ -61,6 +83,9 @@ static THD_FUNCTION(Task_20ms, arg);
 static THD_FUNCTION(Task_40ms, arg);
 static THD_FUNCTION(Task_80ms, arg);
 static THD_FUNCTION(Task_100ms, arg);
+static THD_FUNCTION(Task_Background, arg);
+static THD_FUNCTION(Task_Io, arg);
+static THD_FUNCTION(Task_Spi, arg);
 
 static THD_WORKING_AREA(THREAD_STACK(Task_2ms), OS_THREAD_STACK_SIZE);
 static THD_WORKING_AREA(THREAD_STACK(Task_5ms), OS_THREAD_STACK_SIZE);
@@ -69,6 +94,9 @@ static THD_WORKING_AREA(THREAD_STACK(Task_20ms), OS_THREAD_STACK_SIZE);
 static THD_WORKING_AREA(THREAD_STACK(Task_40ms), OS_THREAD_STACK_SIZE);
 static THD_WORKING_AREA(THREAD_STACK(Task_80ms), OS_THREAD_STACK_SIZE);
 static THD_WORKING_AREA(THREAD_STACK(Task_100ms), OS_THREAD_STACK_SIZE);
+static THD_WORKING_AREA(THREAD_STACK(Task_Background), OS_THREAD_STACK_SIZE);
+static THD_WORKING_AREA(THREAD_STACK(Task_Io), OS_THREAD_STACK_SIZE);
+static THD_WORKING_AREA(THREAD_STACK(Task_Spi), OS_THREAD_STACK_SIZE);
 
 /**@brief Stores the OS wrapper thread configuration.
  */
@@ -80,7 +108,10 @@ const OsCfg_ConfigType OsCfg_Config[OS_THREAD_NUMBER] =
 	{	Task_20ms,	NULL,	NORMALPRIO + 40u,	4u,	20u,	THD_WORKING_AREA_BASE(THREAD_STACK(Task_20ms)),		THD_WORKING_AREA_END(THREAD_STACK(Task_20ms)) },
 	{	Task_40ms,	NULL,	NORMALPRIO + 30u, 	5u,	40u,	THD_WORKING_AREA_BASE(THREAD_STACK(Task_40ms)),		THD_WORKING_AREA_END(THREAD_STACK(Task_40ms)) },
 	{	Task_80ms,	NULL,	NORMALPRIO + 20u,	6u,	80u,	THD_WORKING_AREA_BASE(THREAD_STACK(Task_80ms)),		THD_WORKING_AREA_END(THREAD_STACK(Task_80ms)) },
-	{	Task_100ms,	NULL,	NORMALPRIO + 10u,	7u,	100u,	THD_WORKING_AREA_BASE(THREAD_STACK(Task_100ms)),	THD_WORKING_AREA_END(THREAD_STACK(Task_100ms))}
+	{	Task_100ms,	NULL,	NORMALPRIO + 10u,	7u,	100u,	THD_WORKING_AREA_BASE(THREAD_STACK(Task_100ms)),	THD_WORKING_AREA_END(THREAD_STACK(Task_100ms))},
+	{	Task_Background,	NULL,	NORMALPRIO - 10u,	8u,	50u,	THD_WORKING_AREA_BASE(THREAD_STACK(Task_Background)),	THD_WORKING_AREA_END(THREAD_STACK(Task_Background))},
+	{	Task_Io,	NULL,	NORMALPRIO + 80u,	0u,	0u,	THD_WORKING_AREA_BASE(THREAD_STACK(Task_Io)),		THD_WORKING_AREA_END(THREAD_STACK(Task_Io))   },
+	{	Task_Spi,	NULL,	NORMALPRIO + 90u,	0u,	0u,	THD_WORKING_AREA_BASE(THREAD_STACK(Task_Spi)),		THD_WORKING_AREA_END(THREAD_STACK(Task_Spi))  }
 };
 
 /**@brief 2 milliseconds recurrence thread.
@@ -103,6 +134,7 @@ TASK(Task_5ms)
 TASK(Task_10ms)
 {
 	Led_MainFunction();
+	Link_MainFunction();
 	TerminateTask();
 }
 
@@ -110,6 +142,9 @@ TASK(Task_10ms)
  */
 TASK(Task_20ms)
 {
+	Gps_MainFunction();
+	Clock_MainFunction();
+	Fusion_MainFunction();
 	TerminateTask();
 }
 
@@ -131,5 +166,59 @@ TASK(Task_80ms)
  */
 TASK(Task_100ms)
 {
+	GpsDuty_MainFunction();
+	Geofence_MainFunction();
+	Route_MainFunction();
+	Log_MainFunction();
+	TerminateTask();
+}
+
+/**@brief 50 milliseconds recurrence background thread.
+ * @details Runs below all of the rate groups and below the main thread, work done here can never delay them.
+ */
+TASK(Task_Background)
+{
+	Shell_MainFunction();
 	TerminateTask();
 }
+
+/**@brief Event activated I/O thread.
+ * @details Runs above all of the rate groups and sleeps while the bus transfers run on DMA,
+ * the debounced input events are served before the queued bus transfers.
+ */
+EVENT_TASK(Task_Io)
+{
+	if ((events & OS_EVENT_INPUT) != 0u)
+	{
+		const Vfb_DioLevelType levels = Vfb_Dio_Read_Group(VFB_DIO_GROUP_INPUTS);
+		Vfb_DioInputStatusType status;
+		uint32_t input = 0u;
+
+		for (input = 0u; input < VFB_DIO_INPUT_UNKNOWN; input++)
+		{
+			Vfb_Dio_GetInputEvents((Vfb_DioInputType)input, &status);
+			if (status.events != 0u)
+			{
+				Log_Info("input %u: events 0x%x, clicks %u, level %u", input, status.events, status.clicks,
+						 Vfb_Dio_Get_Snapshot_Channel(levels, Vfb_Dio_InputConfig[input].channel));
+			}
+		}
+	}
+	if ((events & OS_EVENT_I2C) != 0u)
+	{
+		Vfb_I2c_MainFunction();
+	}
+	TerminateEventTask();
+}
+
+/**@brief Event activated SPI thread.
+ * @details Serves the high rate sensor bus, independent of the I2C bus transfers of the I/O thread.
+ */
+EVENT_TASK(Task_Spi)
+{
+	if ((events & OS_EVENT_SPI) != 0u)
+	{
+		Vfb_Spi_MainFunction();
+	}
+	TerminateEventTask();
+}
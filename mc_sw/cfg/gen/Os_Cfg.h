@@ -44,7 +44,27 @@
 
 /**@brief Defines the maximum number of OS threads.
  */
-#define OS_THREAD_NUMBER				(7u)
+#define OS_THREAD_NUMBER				(10u)
+
+/**@brief Defines the index of the event activated I/O thread.
+ */
+#define OS_TASK_ID_IO					(8u)
+
+/**@brief Defines the I/O thread event signaled when I2C transactions are queued.
+ */
+#define OS_EVENT_I2C					(EVENT_MASK(0))
+
+/**@brief Defines the I/O thread event signaled when a debounced input reports an event.
+ */
+#define OS_EVENT_INPUT					(EVENT_MASK(1))
+
+/**@brief Defines the index of the event activated SPI thread.
+ */
+#define OS_TASK_ID_SPI					(9u)
+
+/**@brief Defines the SPI thread event signaled when SPI transactions are queued.
+ */
+#define OS_EVENT_SPI					(EVENT_MASK(0))
 
 /**@brief Defines the stack size for each configured OS thread.
  */
@@ -0,0 +1,154 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Route_Cfg.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Route_Cfg.c
+* @brief Implements the route table of the route monitor.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include "Route.h"
+
+/* Hammersbach - Hoellental - Zugspitze, 92 points, 10.0 km. */
+
+/**@brief Stores the blocks of the route.
+ * @details Generated table: the points are quantized to 1e-6 degrees from the anchor (first point) of
+ * their block, the bounding boxes and the distances are computed from the quantized points.
+ */
+const Route_BlockType Route_Block[ROUTE_BLOCK_NUMBER] =
+{
+	{	{474680000, 110540000},	{474542000, 110432000},	{474680000, 110540000},	0u	},
+	{	{474542000, 110432000},	{474425000, 110288000},	{474542000, 110432000},	1741673u	},
+	{	{474425000, 110288000},	{474352000, 110089000},	{474425000, 110288000},	3442243u	},
+	{	{474352000, 110089000},	{474246000, 109920000},	{474352000, 110089000},	5149422u	},
+	{	{474246000, 109920000},	{474100000, 109830000},	{474246000, 109920000},	6943862u	},
+	{	{474100000, 109840000},	{474020000, 109820000},	{474100000, 109863000},	8764656u	}
+};
+
+/**@brief Stores the points of the route.
+ */
+const Route_PointType Route_Point[ROUTE_POINT_NUMBER] =
+{
+	{0, 0},
+	{-900, -600},
+	{-1800, -1200},
+	{-2700, -1800},
+	{-3600, -2400},
+	{-4500, -3000},
+	{-5400, -3600},
+	{-6300, -4200},
+	{-7200, -4800},
+	{-8100, -5400},
+	{-9000, -6000},
+	{-9800, -6800},
+	{-10600, -7600},
+	{-11400, -8400},
+	{-12200, -9200},
+	{-13000, -10000},
+	{0, 0},
+	{-800, -800},
+	{-1600, -1600},
+	{-2400, -2400},
+	{-3200, -3200},
+	{-3927, -4109},
+	{-4654, -5018},
+	{-5382, -5927},
+	{-6109, -6836},
+	{-6836, -7746},
+	{-7564, -8654},
+	{-8291, -9564},
+	{-9018, -10473},
+	{-9746, -11382},
+	{-10473, -12291},
+	{-11200, -13200},
+	{0, 0},
+	{-500, -1200},
+	{-1000, -2400},
+	{-1500, -3600},
+	{-2000, -4800},
+	{-2500, -6000},
+	{-3000, -7200},
+	{-3500, -8400},
+	{-4000, -9600},
+	{-4500, -10800},
+	{-4900, -12100},
+	{-5300, -13400},
+	{-5700, -14700},
+	{-6100, -16000},
+	{-6500, -17300},
+	{-6900, -18600},
+	{0, 0},
+	{-400, -1300},
+	{-800, -2600},
+	{-1200, -3900},
+	{-1700, -5067},
+	{-2200, -6233},
+	{-2700, -7400},
+	{-3200, -8567},
+	{-3700, -9733},
+	{-4200, -10900},
+	{-5200, -11650},
+	{-6200, -12400},
+	{-7200, -13150},
+	{-8200, -13900},
+	{-9000, -14900},
+	{-9800, -15900},
+	{0, 0},
+	{-800, -1000},
+	{-1600, -2000},
+	{-2600, -2600},
+	{-3600, -3200},
+	{-4600, -3800},
+	{-5600, -4400},
+	{-6600, -5000},
+	{-7600, -5250},
+	{-8600, -5500},
+	{-9600, -5750},
+	{-10600, -6000},
+	{-11350, -6750},
+	{-12100, -7500},
+	{-12850, -8250},
+	{-13600, -9000},
+	{0, 0},
+	{-1000, 1000},
+	{-2000, 1500},
+	{-3000, 2000},
+	{-4000, 0},
+	{-5000, -1000},
+	{-6000, -2000},
+	{-7000, -1000},
+	{-7500, 0},
+	{-7800, 1000},
+	{-8000, 1800},
+	{-7900, 2300}
+};
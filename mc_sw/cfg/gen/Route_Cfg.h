@@ -0,0 +1,136 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Route_Cfg.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Route_Cfg.h
+* @brief Implements the configuration of the route monitor.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#if !defined(ROUTE_CFG_H)
+#define ROUTE_CFG_H
+
+#include "Geo.h"
+#include "Fusion.h"
+
+/**@brief Defines the number of points in Route_Point (at least 2).
+ * @details The host benchmark replaces the table with a generated one and passes -DROUTE_POINT_NUMBER, see ts/host/RouteGen.c.
+ */
+#if !defined(ROUTE_POINT_NUMBER)
+#define ROUTE_POINT_NUMBER				(92u)
+#endif
+
+/**@brief Defines the number of points sharing an anchor and a bounding box.
+ * @note Must be a power of two.
+ */
+#define ROUTE_BLOCK_SIZE				(16u)
+
+/**@brief Defines the number of blocks in Route_Block.
+ */
+#define ROUTE_BLOCK_NUMBER				((ROUTE_POINT_NUMBER + ROUTE_BLOCK_SIZE - 1u) / ROUTE_BLOCK_SIZE)
+
+/**@brief Defines the number of grid columns (longitude) over the bounding box of the route.
+ */
+#define ROUTE_GRID_COLUMNS				(32u)
+
+/**@brief Defines the number of grid rows (latitude) over the bounding box of the route.
+ */
+#define ROUTE_GRID_ROWS					(32u)
+
+/**@brief Defines the number of block references the grid can hold (sum of the covered cells of all of the blocks).
+ * @details If the grid does not fit, the bounding boxes of all of the blocks are searched.
+ * @note Must be below 65536.
+ */
+#define ROUTE_INDEX_SIZE				(2048u)
+
+/**@brief Defines the distance in millimeters up to which the nearest segment is searched.
+ */
+#define ROUTE_SEARCH_RADIUS				(500000u)
+
+/**@brief Defines the number of segments behind the cursor which are searched first.
+ */
+#define ROUTE_CURSOR_BEHIND				(8u)
+
+/**@brief Defines the number of segments ahead of the cursor which are searched first.
+ */
+#define ROUTE_CURSOR_AHEAD				(32u)
+
+/**@brief Defines the distance in millimeters to the route above which a fix is off the route.
+ * @details The horizontal accuracy of the fix is added, a poor fix does not raise an alert.
+ */
+#define ROUTE_OFF_DISTANCE				(50000u)
+
+/**@brief Defines the distance in millimeters to the route below which a fix is on the route again.
+ */
+#define ROUTE_ON_DISTANCE				(25000u)
+
+/**@brief Defines the number of consecutive fixes off the route until the alert is raised.
+ */
+#define ROUTE_OFF_CONFIRM				(3u)
+
+/**@brief Defines the number of consecutive fixes on the route until the alert is cleared.
+ */
+#define ROUTE_ON_CONFIRM				(2u)
+
+/**@brief Defines the position accuracy (one axis) in millimeters above which the fix is not matched.
+ */
+#define ROUTE_MAX_ACCURACY				(50000u)
+
+/**@brief Defines the realtime counter cycles a MainFunction call should stay below.
+ */
+#define ROUTE_CYCLE_BUDGET				(80000u)
+
+/**@struct Route_BlockType
+ * @brief Specifies ROUTE_BLOCK_SIZE consecutive points of the route.
+ */
+typedef struct Route_BlockTypeTag
+{
+	Geo_PointType anchor;			/**< Reference of the point offsets. */
+	Geo_PointType min;				/**< South west corner of the bounding box of the points and the first point of the next block. */
+	Geo_PointType max;				/**< North east corner of the bounding box. */
+	uint32_t distance;				/**< Route distance of the first point from the start in millimeters. */
+} Route_BlockType;
+
+/**@struct Route_PointType
+ * @brief Specifies a route point as offset from the anchor of its block.
+ */
+typedef struct Route_PointTypeTag
+{
+	int16_t latitude;				/**< Latitude offset in 1e-6 degrees. */
+	int16_t longitude;				/**< Longitude offset in 1e-6 degrees. */
+} Route_PointType;
+
+extern const Route_BlockType Route_Block[ROUTE_BLOCK_NUMBER];
+extern const Route_PointType Route_Point[ROUTE_POINT_NUMBER];
+
+#endif /* ROUTE_CFG_H */
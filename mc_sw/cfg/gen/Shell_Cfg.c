@@ -0,0 +1,56 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Shell_Cfg.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Shell_Cfg.c
+* @brief Implements the command shell configuration.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include "Shell.h"
+
+/**@brief Stores the shell commands, each one in the slot given by its hash.
+ * @details Generated table: slot = FNV-1a(name, SHELL_HASH_SEED) & (SHELL_HASH_SIZE - 1).
+ * The seed has to be searched again when commands are added so that the table stays collision free.
+ */
+const Shell_CommandType Shell_Command[SHELL_HASH_SIZE] =
+{
+	{	"log",		Shell_CmdLog,		"Log and link statistics"			},	/* 0 */
+	{	"gnss",		Shell_CmdGnss,		"GNSS fix and parser statistics"	},	/* 1 */
+	{	"uart",		Shell_CmdUart,		"UART channel statistics"			},	/* 2 */
+	{	"led",		Shell_CmdLed,		"LED states"						},	/* 3 */
+	{	"tasks",	Shell_CmdTasks,		"OS task states"					},	/* 4 */
+	{	"help",		Shell_CmdHelp,		"List of commands"					},	/* 5 */
+	{	"trail",	Shell_CmdTrail,		"Route progress and off route state"	},	/* 6 */
+	{	"area",		Shell_CmdArea,		"Geofence areas and statistics"		}	/* 7 */
+};
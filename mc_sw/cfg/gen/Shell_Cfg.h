@@ -0,0 +1,82 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Shell_Cfg.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Shell_Cfg.h
+* @brief Implements the header of the command shell configuration.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#if !defined(SHELL_CFG_H)
+#define SHELL_CFG_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**@brief Defines the size of the command line buffer (terminating character included).
+ */
+#define SHELL_LINE_SIZE					(64u)
+
+/**@brief Defines the number of 10 ms waits for a free link window before the output is dropped.
+ * @details Without a peer acknowledging the frames the window stays full, the output is then dropped
+ * instead of stalling the background task.
+ */
+#define SHELL_FLUSH_RETRIES				(10u)
+
+/**@brief Defines the number of slots of the command hash table.
+ * @note Must be a power of two.
+ */
+#define SHELL_HASH_SIZE					(8u)
+
+/**@brief Defines the seed of the command hash, chosen so that no two commands share a slot.
+ */
+#define SHELL_HASH_SEED					(2u)
+
+/**@brief Specifies the handler of a shell command.
+ * @param[in]	args	Command arguments (rest of the line after the command name), never NULL.
+ */
+typedef void (*Shell_CommandFuncType)(const char *args);
+
+/**@struct Shell_CommandType
+ * @brief Specifies a slot of the command hash table.
+ */
+typedef struct Shell_CommandTypeTag
+{
+	const char *name;				/**< Command name, NULL for an empty slot. */
+	Shell_CommandFuncType func;		/**< Command handler. */
+	const char *help;				/**< One line description of the command. */
+} Shell_CommandType;
+
+extern const Shell_CommandType Shell_Command[SHELL_HASH_SIZE];
+
+#endif /* SHELL_CFG_H */
@@ -1,8 +1,119 @@
-/*
- * UartHndlr_Cfg.c
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: UartHndlr_Cfg.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file UartHndlr_Cfg.c
+* @brief Implements the UART handler configuration.
+*/
+/*============================================================================*/
+/* MIT License
  *
- *  Created on: Apr 12, 2016
- *      Author: modoranu_a1
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include "UartHndlr.h"
+
+/**@brief Defines the check that a buffer or pool size is a power of two.
+ */
+#define IS_POWER_OF_TWO(size)		(((size) != 0u) && (((size) & ((size) - 1u)) == 0u))
+
+#if !IS_POWER_OF_TWO(UARTHNDLR_GPS_RX_BUFFER_SIZE) || !IS_POWER_OF_TWO(UARTHNDLR_GPS_TX_DESCRIPTOR_NUMBER)
+#error "UartHndlr: GPS channel buffer sizes must be powers of two"
+#endif
+#if (UARTHNDLR_GSM_ENABLED) && (!IS_POWER_OF_TWO(UARTHNDLR_GSM_RX_BUFFER_SIZE) || !IS_POWER_OF_TWO(UARTHNDLR_GSM_TX_DESCRIPTOR_NUMBER))
+#error "UartHndlr: GSM channel buffer sizes must be powers of two"
+#endif
+#if !IS_POWER_OF_TWO(UARTHNDLR_DEBUG_RX_BUFFER_SIZE) || !IS_POWER_OF_TWO(UARTHNDLR_DEBUG_TX_DESCRIPTOR_NUMBER)
+#error "UartHndlr: debug channel buffer sizes must be powers of two"
+#endif
+
+/**@brief Defines the wrapper which generates the static data and the driver callbacks of a channel.
+ * @details The callbacks forward the driver events with the channel identifier resolved at compile time.
+ * @param[in]	name	Channel name (GPS, GSM, DEBUG etc.).
+ * @param[in]	baud	Channel baud rate.
  */
+#define UARTHNDLR_CHANNEL(name, baud) \
+	static uint8_t UartHndlr_##name##_RxBuffer[UARTHNDLR_##name##_RX_BUFFER_SIZE]; \
+	static UartHndlr_TxDescriptorType UartHndlr_##name##_TxPool[UARTHNDLR_##name##_TX_DESCRIPTOR_NUMBER]; \
+	static void UartHndlr_##name##_TxEvent(Vfb_UartDriverType *uartp) \
+	{ \
+		(void)uartp; \
+		UartHndlr_TxEventI(UARTHNDLR_CHANNEL_##name); \
+	} \
+	static void UartHndlr_##name##_RxEvent(Vfb_UartDriverType *uartp, uint16_t c) \
+	{ \
+		(void)uartp; \
+		(void)c; \
+		UartHndlr_RxEventI(UARTHNDLR_CHANNEL_##name); \
+	} \
+	static void UartHndlr_##name##_RxIdle(Vfb_UartDriverType *uartp) \
+	{ \
+		(void)uartp; \
+		UartHndlr_RxEventI(UARTHNDLR_CHANNEL_##name); \
+	} \
+	static void UartHndlr_##name##_RxError(Vfb_UartDriverType *uartp, Vfb_UartFlagsType e) \
+	{ \
+		(void)uartp; \
+		UartHndlr_RxErrorI(UARTHNDLR_CHANNEL_##name, (uint32_t)e); \
+	} \
+	static const Vfb_UartConfigType UartHndlr_##name##_UartConfig = \
+		VFB_UART_CONFIG(UartHndlr_##name##_TxEvent, UartHndlr_##name##_RxEvent, \
+						UartHndlr_##name##_RxIdle, UartHndlr_##name##_RxError, (baud))
 
+/**@brief Defines the wrapper for the configuration container of a channel.
+ * @param[in]	name	Channel name (GPS, GSM, DEBUG etc.).
+ * @param[in]	driver	UART driver used by the channel.
+ * @param[in]	txLine	Transmit pin.
+ * @param[in]	txAf	Alternate function number of the transmit pin.
+ * @param[in]	rxLine	Receive pin.
+ * @param[in]	rxAf	Alternate function number of the receive pin.
+ * @param[in]	notify	Consumer notification for new received data, can be NULL.
+ */
+#define UARTHNDLR_CHANNEL_CONFIG(name, driver, txLine, txAf, rxLine, rxAf, notify) \
+	{ (driver), &UartHndlr_##name##_UartConfig, \
+	  (txLine), VFB_UART_PIN_MODE(txAf), (rxLine), VFB_UART_PIN_MODE(rxAf), \
+	  UartHndlr_##name##_RxBuffer, UARTHNDLR_##name##_RX_BUFFER_SIZE, (notify), \
+	  UartHndlr_##name##_TxPool, UARTHNDLR_##name##_TX_DESCRIPTOR_NUMBER }
 
+UARTHNDLR_CHANNEL(GPS, UARTHNDLR_GPS_BAUDRATE);
+UARTHNDLR_CHANNEL(DEBUG, UARTHNDLR_DEBUG_BAUDRATE);
+#if (UARTHNDLR_GSM_ENABLED)
+UARTHNDLR_CHANNEL(GSM, UARTHNDLR_GSM_BAUDRATE);
+#endif
+
+/**@brief Stores the UART handler channel configuration.
+ */
+const UartHndlr_ConfigType UartHndlr_Config[UARTHNDLR_CHANNEL_UNKNOWN] =
+{
+	UARTHNDLR_CHANNEL_CONFIG(GPS,	VFB_UART_USART1,	LINE_ARD_D1,	7u,	LINE_ARD_D0,	7u,	NULL),
+	UARTHNDLR_CHANNEL_CONFIG(DEBUG,	VFB_UART_USART2,	LINE_VCP_TX,	7u,	LINE_VCP_RX,	3u,	NULL),
+#if (UARTHNDLR_GSM_ENABLED)
+	UARTHNDLR_CHANNEL_CONFIG(GSM,	VFB_UART_LPUART1,	LINE_VCP_TX,	8u,	LINE_ARD_A2,	8u,	NULL)
+#endif
+};
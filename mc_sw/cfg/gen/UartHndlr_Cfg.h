@@ -1,13 +1,150 @@
-/*
- * UartHndlr_Cfg.h
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: UartHndlr_Cfg.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file UartHndlr_Cfg.h
+* @brief Implements the header of the UART handler configuration.
+*/
+/*============================================================================*/
+/* MIT License
  *
- *  Created on: Apr 12, 2016
- *      Author: modoranu_a1
- */
-
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
 #if !defined(UARTHNDLR_CFG_H)
 #define UARTHNDLR_CFG_H
 
+#include "Vfb.h"
+
+/**@brief Defines the baud rate of the GPS channel.
+ */
+#define UARTHNDLR_GPS_BAUDRATE					(115200u)
+
+/**@brief Defines the size in bytes of the circular receive buffer of the GPS channel.
+ * @note Must be a power of two.
+ */
+#define UARTHNDLR_GPS_RX_BUFFER_SIZE			(1024u)
+
+/**@brief Defines the number of transmit descriptors of the GPS channel.
+ * @note Must be a power of two.
+ */
+#define UARTHNDLR_GPS_TX_DESCRIPTOR_NUMBER		(4u)
+
+/**@brief Defines if the GSM channel is configured.
+ * @details The Nucleo-32 board has no UART left for the GSM modem: on the STM32L432KC LPUART1 only
+ * exists on PA2/PA3, PA2 is the VCP_TX of USART2 (debug channel) and PA3 the battery voltage ADC input,
+ * the other USART1 pins (PB6/PB7) belong to the peripheral of the GPS channel. The channel is only
+ * enabled on a board which routes LPUART1 to the modem.
+ */
+#define UARTHNDLR_GSM_ENABLED					(0u)
+
+/**@brief Defines the baud rate of the GSM channel.
+ */
+#define UARTHNDLR_GSM_BAUDRATE					(115200u)
+
+/**@brief Defines the size in bytes of the circular receive buffer of the GSM channel.
+ * @note Must be a power of two.
+ */
+#define UARTHNDLR_GSM_RX_BUFFER_SIZE			(512u)
+
+/**@brief Defines the number of transmit descriptors of the GSM channel.
+ * @note Must be a power of two.
+ */
+#define UARTHNDLR_GSM_TX_DESCRIPTOR_NUMBER		(8u)
+
+/**@brief Defines the baud rate of the debug channel.
+ */
+#define UARTHNDLR_DEBUG_BAUDRATE				(115200u)
+
+/**@brief Defines the size in bytes of the circular receive buffer of the debug channel.
+ * @note Must be a power of two.
+ */
+#define UARTHNDLR_DEBUG_RX_BUFFER_SIZE			(128u)
+
+/**@brief Defines the number of transmit descriptors of the debug channel.
+ * @note Must be a power of two.
+ */
+#define UARTHNDLR_DEBUG_TX_DESCRIPTOR_NUMBER	(16u)
+
+/**@enum UartHndlr_ChannelTypeTag
+ * @brief Specifies the configured UART channels.
+ */
+typedef enum UartHndlr_ChannelTypeTag
+{
+	UARTHNDLR_CHANNEL_GPS = 0u,		/**< GPS receiver channel (USART1, TX on PA9, RX on PA10). */
+	UARTHNDLR_CHANNEL_DEBUG,		/**< Debug channel (USART2, virtual COM port, TX on PA2, RX on PA15). */
+#if (UARTHNDLR_GSM_ENABLED)
+	UARTHNDLR_CHANNEL_GSM,			/**< GSM modem channel (LPUART1, TX on PA2, RX on PA3). */
+#endif
+	UARTHNDLR_CHANNEL_UNKNOWN		/**< Guard value. */
+} UartHndlr_ChannelType;
+
+/**@brief Specifies the receive notification of a channel consumer.
+ * @details Called from the ISR context with the system locked, only I-class functions can be used.
+ */
+typedef void (*UartHndlr_RxNotifyType)(const UartHndlr_ChannelType channel);
+
+/**@brief Specifies the completion notification of a transmit request.
+ * @details Called from the ISR context with the system locked, only I-class functions can be used.
+ */
+typedef void (*UartHndlr_TxNotifyType)(const UartHndlr_ChannelType channel, void *context);
+
+/**@struct UartHndlr_TxDescriptorType
+ * @brief Specifies a transmit descriptor pointing to a caller owned buffer.
+ */
+typedef struct UartHndlr_TxDescriptorTypeTag
+{
+	const uint8_t *data;				/**< Data to transmit. */
+	uint32_t length;					/**< Number of bytes to transmit. */
+	UartHndlr_TxNotifyType notify;		/**< Completion notification, only set on the last descriptor of a request. */
+	void *context;						/**< Argument passed to the completion notification. */
+} UartHndlr_TxDescriptorType;
+
+/**@struct UartHndlr_ConfigType
+ * @brief Specifies the configuration container for a UART channel.
+ * @details The DMA streams of each driver are selected in mcuconf.h.
+ */
+typedef struct UartHndlr_ConfigTypeTag
+{
+	Vfb_UartDriverType *driver;				/**< UART driver used by the channel. */
+	const Vfb_UartConfigType *uartConfig;	/**< UART driver configuration. */
+	Vfb_LineType txLine;					/**< Transmit pin. */
+	Vfb_PortModeType txMode;				/**< Alternate function of the transmit pin. */
+	Vfb_LineType rxLine;					/**< Receive pin. */
+	Vfb_PortModeType rxMode;				/**< Alternate function of the receive pin. */
+	uint8_t *rxBuffer;						/**< Circular receive buffer filled by the DMA. */
+	uint32_t rxBufferSize;					/**< Size of the circular receive buffer in bytes. */
+	UartHndlr_RxNotifyType rxNotify;		/**< Consumer notification for new received data. */
+	UartHndlr_TxDescriptorType *txPool;		/**< Transmit descriptor pool. */
+	uint32_t txPoolSize;					/**< Number of descriptors in the transmit descriptor pool. */
+} UartHndlr_ConfigType;
 
+extern const UartHndlr_ConfigType UartHndlr_Config[UARTHNDLR_CHANNEL_UNKNOWN];
 
 #endif /* UARTHNDLR_CFG_H */
@@ -0,0 +1,77 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Vfb_Cfg.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Vfb_Cfg.c
+* @brief Implements the virtual function bus configuration.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include "Vfb.h"
+#include "Os.h"
+
+/**@brief Stores the configuration of the devices on the I2C bus.
+ */
+const Vfb_I2cDeviceConfigType Vfb_I2c_DeviceConfig[VFB_I2C_DEVICE_UNKNOWN] =
+{
+	{	0x76u,	TRUE,	0x00u	},		/* BMP280, auto increment. */
+	{	0x1Cu,	TRUE,	0x80u	},		/* LIS3MDL, auto increment on MSB of the register address. */
+	{	0x36u,	FALSE,	0x00u	}		/* MAX17048, 16 bit registers. */
+};
+
+/**@brief Stores the initial configuration of the digital channels.
+ */
+const Vfb_DioChannelConfigType Vfb_Dio_ChannelConfig[VFB_DIO_CHANNEL_NUMBER] =
+{
+	{	VFB_DIO_GSM_PWRKEY,		VFB_DIO_MODE_OUTPUT,		STD_LOW		},
+	{	VFB_DIO_GPS_ENABLE,		VFB_DIO_MODE_OUTPUT,		STD_LOW		},
+	{	VFB_DIO_SENSOR_ENABLE,	VFB_DIO_MODE_OUTPUT,		STD_LOW		},
+	{	VFB_DIO_SOS_BUTTON,		VFB_DIO_MODE_INPUT_PULLUP,	STD_LOW		},
+	{	VFB_DIO_LID_SWITCH,		VFB_DIO_MODE_INPUT_PULLUP,	STD_LOW		},
+	{	VFB_DIO_GPS_PPS,		VFB_DIO_MODE_INPUT_PULLDOWN,	STD_LOW		}
+};
+
+/**@brief Stores the configuration of the debounced inputs.
+ */
+const Vfb_DioInputConfigType Vfb_Dio_InputConfig[VFB_DIO_INPUT_UNKNOWN] =
+{
+	{	VFB_DIO_SOS_BUTTON,	STD_LOW,	20u,		2000u,		400u,		OS_TASK_ID_IO,	OS_EVENT_INPUT	},		/* Multi-click and long press. */
+	{	VFB_DIO_LID_SWITCH,	STD_LOW,	50u,		0u,			0u,			OS_TASK_ID_IO,	OS_EVENT_INPUT	}		/* Open/close only. */
+};
+
+/**@brief Stores the SPI driver configuration of each device on the SPI bus.
+ */
+const Vfb_SpiConfigType Vfb_Spi_DeviceConfig[VFB_SPI_DEVICE_UNKNOWN] =
+{
+	VFB_SPI_CONFIG(VFB_SPI_IMU_CS_LINE, 2u, 3u)		/* IMU, 10 MHz, mode 3. */
+};
@@ -0,0 +1,242 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Vfb_Cfg.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Vfb_Cfg.h
+* @brief Implements the header of the virtual function bus configuration.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#if !defined(VFB_CFG_H)
+#define VFB_CFG_H
+
+#include <stdint.h>
+
+/* Pin map of the STM32L432KC on the Nucleo-32 board, every pin has a single owner:
+ *   PA0  SOS button input			VFB_DIO_SOS_BUTTON		PB0  GSM modem power key		VFB_DIO_GSM_PWRKEY
+ *   PA1  lid switch input			VFB_DIO_LID_SWITCH		PB1  GPS receiver enable		VFB_DIO_GPS_ENABLE
+ *   PA2  USART2 TX (VCP, debug)	UartHndlr_Config		PB3  user LED					VFB_DIO_LED_GREEN
+ *   PA3  battery ADC input			VFB_ADC_BATTERY_LINE	PB4  I2C3 SDA					VFB_I2C_SDA_LINE
+ *   PA4  IMU chip select			VFB_SPI_IMU_CS_LINE		PB5  sensor supply enable		VFB_DIO_SENSOR_ENABLE
+ *   PA5  SPI1 SCK					VFB_SPI_SCK_LINE		PB6  free (USART1 TX alternate)
+ *   PA6  SPI1 MISO					VFB_SPI_MISO_LINE		PB7  free (USART1 RX alternate)
+ *   PA7  I2C3 SCL					VFB_I2C_SCL_LINE
+ *   PA8  GPS time pulse input		VFB_DIO_GPS_PPS
+ *   PA9  USART1 TX (GPS)			UartHndlr_Config
+ *   PA10 USART1 RX (GPS)			UartHndlr_Config
+ *   PA11 free
+ *   PA12 SPI1 MOSI					VFB_SPI_MOSI_LINE
+ *   PA13 SWDIO, PA14 SWCLK
+ *   PA15 USART2 RX (VCP, debug)	UartHndlr_Config
+ * LPUART1 can only use PA2/PA3 on this package, which belong to the debug channel and the battery
+ * input, so the GSM channel is disabled (UARTHNDLR_GSM_ENABLED). */
+
+/**@brief Defines the I2C bus shared by the sensors (I2C3, SCL on PA7, SDA on PB4).
+ * @note I2C1 cannot get DMA streams next to the DMA driven USART2 and LPUART1.
+ */
+#define VFB_I2C_BUS						(VFB_I2C_I2C3)
+
+/**@brief Defines the I2C bus clock line.
+ */
+#define VFB_I2C_SCL_LINE				(LINE_ARD_A6)
+
+/**@brief Defines the I2C bus data line.
+ */
+#define VFB_I2C_SDA_LINE				(LINE_ARD_D12)
+
+/**@brief Defines the I2C timing register value (400 kHz fast mode, 80 MHz kernel clock).
+ */
+#define VFB_I2C_TIMING					(0x00702991u)
+
+/**@brief Defines the maximum number of data bytes of a register write transaction.
+ */
+#define VFB_I2C_WRITE_SIZE				(16u)
+
+/**@brief Defines the time in milliseconds after which a transaction is aborted.
+ */
+#define VFB_I2C_TIMEOUT					(10u)
+
+/**@brief Defines the maximum number of data bytes of a merged register read burst.
+ */
+#define VFB_I2C_BURST_SIZE				(32u)
+
+/**@brief Defines the maximum number of register reads merged into one burst.
+ */
+#define VFB_I2C_BURST_NUMBER			(4u)
+
+/**@brief Specifies the devices on the I2C bus.
+ */
+typedef enum
+{
+	VFB_I2C_DEVICE_BAROMETER = 0u,
+	VFB_I2C_DEVICE_MAGNETOMETER,
+	VFB_I2C_DEVICE_FUEL_GAUGE,
+	VFB_I2C_DEVICE_UNKNOWN
+} Vfb_I2cDeviceType;
+
+/**@struct Vfb_I2cDeviceConfigType
+ * @brief Specifies the configuration of a device on the I2C bus.
+ */
+typedef struct Vfb_I2cDeviceConfigTypeTag
+{
+	uint8_t address;			/**< 7 bit device address. */
+	uint8_t isMergeable;		/**< TRUE if reads of consecutive byte registers can be merged into one burst. */
+	uint8_t burstFlag;			/**< Register address bits to set for multi byte accesses (auto increment). */
+} Vfb_I2cDeviceConfigType;
+
+extern const Vfb_I2cDeviceConfigType Vfb_I2c_DeviceConfig[VFB_I2C_DEVICE_UNKNOWN];
+
+/**@brief Defines the SPI bus of the high rate sensors (SPI1, SCK on PA5, MISO on PA6, MOSI on PA12).
+ */
+#define VFB_SPI_BUS						(VFB_SPI_SPI1)
+
+/**@brief Defines the SPI bus clock line.
+ */
+#define VFB_SPI_SCK_LINE				(LINE_ARD_A4)
+
+/**@brief Defines the SPI bus input data line.
+ */
+#define VFB_SPI_MISO_LINE				(LINE_ARD_A5)
+
+/**@brief Defines the SPI bus output data line.
+ */
+#define VFB_SPI_MOSI_LINE				(LINE_ARD_D2)
+
+/**@brief Defines the IMU chip select line.
+ */
+#define VFB_SPI_IMU_CS_LINE				(LINE_ARD_A3)
+
+/**@brief Defines the maximum number of command bytes of a SPI transaction.
+ */
+#define VFB_SPI_COMMAND_SIZE			(2u)
+
+/**@brief Specifies the devices on the SPI bus.
+ */
+typedef enum
+{
+	VFB_SPI_DEVICE_IMU = 0u,
+	VFB_SPI_DEVICE_UNKNOWN
+} Vfb_SpiDeviceType;
+
+/**@brief Defines the ADC sampling the battery, the internal reference and the temperature sensor (ADC1, DMA1 channel 1).
+ */
+#define VFB_ADC_BUS						(VFB_ADC_ADC1)
+
+/**@brief Defines the timer triggering the ADC scans (TIM6 trigger output).
+ */
+#define VFB_ADC_TIMER					(VFB_ADC_TIM6)
+
+/**@brief Defines the battery voltage divider input (PA3, ADC1_IN8).
+ * @note PA3 is also the only LPUART1 RX pin, the battery input owns it while the GSM channel is disabled.
+ */
+#define VFB_ADC_BATTERY_LINE			(LINE_ARD_A2)
+
+/**@brief Defines the ADC channel of the battery voltage divider input.
+ */
+#define VFB_ADC_BATTERY_CHANNEL			(8u)
+
+/**@brief Defines the battery voltage divider ratio (battery voltage = input voltage * NUM / DEN).
+ */
+#define VFB_ADC_BATTERY_DIVIDER_NUM		(2u)
+#define VFB_ADC_BATTERY_DIVIDER_DEN		(1u)
+
+/**@brief Defines the counter frequency of the trigger timer in Hz.
+ */
+#define VFB_ADC_TIMER_FREQUENCY			(10000u)
+
+/**@brief Defines the scan frequency in Hz.
+ */
+#define VFB_ADC_SCAN_FREQUENCY			(10u)
+
+/**@brief Defines the number of scans in the circular DMA buffer, the filter runs every half buffer.
+ */
+#define VFB_ADC_DEPTH					(8u)
+
+/**@brief Defines the low pass filter shift, the time constant is 2^VFB_ADC_FILTER_SHIFT scans.
+ */
+#define VFB_ADC_FILTER_SHIFT			(3u)
+
+/**@brief Defines the GSM modem power key output (PB0).
+ */
+#define VFB_DIO_GSM_PWRKEY				(LINE_ARD_D3)
+
+/**@brief Defines the GPS receiver enable output (PB1).
+ */
+#define VFB_DIO_GPS_ENABLE				(LINE_ARD_D6)
+
+/**@brief Defines the sensor supply enable output (PB5).
+ */
+#define VFB_DIO_SENSOR_ENABLE			(LINE_ARD_D11)
+
+/**@brief Defines the user LED output (PB3).
+ */
+#define VFB_DIO_LED_GREEN				(LINE_LED_GREEN)
+
+/**@brief Defines the SOS button input, active low (PA0).
+ */
+#define VFB_DIO_SOS_BUTTON				(LINE_ARD_A0)
+
+/**@brief Defines the lid switch input, active low (PA1).
+ */
+#define VFB_DIO_LID_SWITCH				(LINE_ARD_A1)
+
+/**@brief Defines the GPS receiver time pulse input, rising edge at the UTC second (PA8, TIM1_CH1).
+ */
+#define VFB_DIO_GPS_PPS					(LINE_ARD_D9)
+
+/**@brief Defines the group of the supply outputs switched together at start up.
+ * @note The GPS enable (Gps_SetPower()) and the LED (Led.c shadow state) have their own owners and
+ * are not part of the group, a group write would override them.
+ */
+#define VFB_DIO_GROUP_POWER				VFB_DIO_GROUP(VFB_DIO_GSM_PWRKEY, \
+											VFB_DIO_MASK(VFB_DIO_GSM_PWRKEY) | VFB_DIO_MASK(VFB_DIO_SENSOR_ENABLE))
+
+/**@brief Defines the group of the user inputs, sampled together.
+ */
+#define VFB_DIO_GROUP_INPUTS			VFB_DIO_GROUP(VFB_DIO_SOS_BUTTON, \
+											VFB_DIO_MASK(VFB_DIO_SOS_BUTTON) | VFB_DIO_MASK(VFB_DIO_LID_SWITCH))
+
+/**@brief Defines the number of digital channels configured by Vfb_Dio_Init().
+ */
+#define VFB_DIO_CHANNEL_NUMBER			(6u)
+
+/**@brief Specifies the debounced inputs, index in Vfb_Dio_InputConfig.
+ */
+typedef enum
+{
+	VFB_DIO_INPUT_SOS = 0u,
+	VFB_DIO_INPUT_LID,
+	VFB_DIO_INPUT_UNKNOWN
+} Vfb_DioInputType;
+
+#endif /* VFB_CFG_H */
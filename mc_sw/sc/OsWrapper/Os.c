@@ -67,14 +67,59 @@ void Os_Init(void)
 	}
 }
 
+/**@brief OS wrapper function used to get a configured OS thread.
+ * @param[in]	id	Index of the thread in the OS configuration.
+ * @return	Thread descriptor, NULL if the index is not configured.
+ */
+thread_t *Os_GetTask(const uint32_t id)
+{
+	thread_t *retVal = NULL;
+
+	if (id < OS_THREAD_NUMBER)
+	{
+		retVal = OsCfg_TaskPool[id];
+	}
+
+	return retVal;
+}
+
+/**@brief OS wrapper function used to activate an event activated OS thread.
+ * @details Events signaled before the OS is initialized are lost, event activated threads run once at start.
+ * @param[in]	id		Index of the thread in the OS configuration.
+ * @param[in]	events	Events to signal.
+ */
+void Os_SetEvent(const uint32_t id, const eventmask_t events)
+{
+	thread_t *task = Os_GetTask(id);
+
+	if (task != NULL)
+	{
+		chEvtSignal(task, events);
+	}
+}
+
+/**@brief OS wrapper function used to activate an event activated OS thread from the ISR context.
+ * @param[in]	id		Index of the thread in the OS configuration.
+ * @param[in]	events	Events to signal.
+ */
+void Os_SetEventI(const uint32_t id, const eventmask_t events)
+{
+	thread_t *task = Os_GetTask(id);
+
+	if (task != NULL)
+	{
+		chEvtSignalI(task, events);
+	}
+}
+
 /**@brief OS wrapper function used to start all of the configured OS threads. */
 void Os_StartTasks(void)
 {
 	const systime_t startTime = chVTGetSystemTime();	/* Get the current system time. */
 	uint32_t noOfStartedTasks = 0u;						/* Initialize the number of started threads counter. */
 
-	/* Start all of the configured threads. */
-	while (noOfStartedTasks <= OS_THREAD_NUMBER)
+	/* Start all of the configured threads, then return so the caller can exit. */
+	while (noOfStartedTasks < OS_THREAD_NUMBER)
 	{
 		uint32_t id = 0u;
 		for (id = 0u; id < OS_THREAD_NUMBER; id++)
@@ -44,5 +44,8 @@
 
 extern void Os_Init(void);
 extern void Os_StartTasks(void);
+extern thread_t *Os_GetTask(const uint32_t id);
+extern void Os_SetEvent(const uint32_t id, const eventmask_t events);
+extern void Os_SetEventI(const uint32_t id, const eventmask_t events);
 
 #endif /* OS_H */
@@ -38,3 +38,145 @@
  * SOFTWARE.																  */
 /*============================================================================*/
 #include "Vfb.h"
+
+#if (VFB_BACKEND == VFB_BACKEND_HAL)
+/**@brief Defines the number of EXTI lines connected to the GPIO pads.
+ */
+#define VFB_PORT_EVENT_NUMBER		(16u)
+
+/**@struct Vfb_PortEventDataType
+ * @brief Specifies the pin edge interrupts routed through the EXT driver.
+ */
+typedef struct Vfb_PortEventDataTypeTag
+{
+	EXTConfig config;												/**< EXT driver configuration, updated at run time. */
+	Vfb_LineType line[VFB_PORT_EVENT_NUMBER];						/**< Pin routed to each EXTI line. */
+	Vfb_PortEventCallbackType callback[VFB_PORT_EVENT_NUMBER];		/**< Callback of each EXTI line. */
+} Vfb_PortEventDataType;
+
+static void portEventIsr(EXTDriver *extp, expchannel_t channel);
+
+/**@brief Stores the pin edge interrupts.
+ */
+static Vfb_PortEventDataType Vfb_Port_EventData;
+#endif
+
+/**@brief Used to add the change of a HW pin to a list of port batches.
+ * @details If a batch for the port of the pin already exists the change is merged into it,
+ * otherwise a new batch is appended. The list must be able to hold one batch for each added pin.
+ * @param[in,out]	batch	List of port batches.
+ * @param[in]		size	Number of used entries in the list.
+ * @param[in]		line	Pin identifier.
+ * @param[in]		value	Logic value of the pin.
+ * @return	Number of used entries in the list after the change was added.
+ */
+uint32_t Vfb_Port_BatchAdd(Vfb_PortBatchType *batch, const uint32_t size, const Vfb_LineType line, const uint8_t value)
+{
+	const Vfb_PortIdType port = Vfb_Get_Port_Line_Port(line);
+	const Vfb_PortMaskType mask = Vfb_Get_Port_Line_Mask(line);
+	uint32_t idx = 0u;
+	uint32_t retVal = size;
+
+	while ((idx < size) && (batch[idx].port != port))
+	{
+		idx++;
+	}
+
+	if (idx == size)
+	{
+		batch[idx].port = port;
+		batch[idx].mask = 0u;
+		batch[idx].value = 0u;
+		retVal++;
+	}
+
+	batch[idx].mask |= mask;
+	if (value != STD_LOW)
+	{
+		batch[idx].value |= mask;
+	}
+	else
+	{
+		batch[idx].value &= ~mask;
+	}
+
+	return retVal;
+}
+
+/**@brief Used to write a list of port batches to the HW, one register access per port.
+ * @param[in]	batch	List of port batches.
+ * @param[in]	size	Number of used entries in the list.
+ */
+void Vfb_Port_BatchCommit(const Vfb_PortBatchType *batch, const uint32_t size)
+{
+	uint32_t idx = 0u;
+
+	for (idx = 0u; idx < size; idx++)
+	{
+		Vfb_Write_Port_Group_Value(batch[idx].port, batch[idx].mask, batch[idx].value);
+	}
+}
+
+#if (VFB_BACKEND == VFB_BACKEND_HAL)
+/**@brief Used to enable the interrupt on both edges of a HW pin.
+ * @details The EXTI line is shared by the pins with the same pad number on all of the ports,
+ * so only one of them can be registered. Must be called after the OS is initialized.
+ * @param[in]	line		Pin identifier.
+ * @param[in]	callback	Called from the ISR context on each edge.
+ */
+void Vfb_Port_EnableLineEvent(const Vfb_LineType line, const Vfb_PortEventCallbackType callback)
+{
+	const EXTChannelConfig channelConfig =
+	{
+		EXT_CH_MODE_BOTH_EDGES | EXT_CH_MODE_AUTOSTART | (Vfb_Get_Port_Line_Index(line) << EXT_MODE_GPIO_OFF),
+		portEventIsr
+	};
+	const uint32_t pad = PAL_PAD(line);
+
+	if (EXTD1.state != EXT_ACTIVE)
+	{
+		extStart(&EXTD1, &Vfb_Port_EventData.config);
+	}
+
+	Vfb_Port_EventData.line[pad] = line;
+	Vfb_Port_EventData.callback[pad] = callback;
+
+	osalSysLock();
+	extSetChannelModeI(&EXTD1, pad, &channelConfig);
+	osalSysUnlock();
+}
+
+/**@brief Used to switch the receive DMA of a started UART driver to a continuous circular transfer.
+ * @details The DMA interrupts (half transfer and transfer complete) are reported through the
+ * rxchar_cb callback of the driver configuration, the received character argument has no meaning.
+ * uartStartReceive() must not be used on a driver running in this mode.
+ * @param[in]	drv		UART driver.
+ * @param[in]	buffer	Circular receive buffer.
+ * @param[in]	size	Size of the circular receive buffer in bytes.
+ */
+void Vfb_Uart_StartCircularRx(Vfb_UartDriverType *drv, uint8_t *buffer, const uint32_t size)
+{
+	osalSysLock();
+	dmaStreamDisable(drv->dmarx);
+	dmaStreamSetMemory0(drv->dmarx, buffer);
+	dmaStreamSetTransactionSize(drv->dmarx, size);
+	dmaStreamSetMode(drv->dmarx, drv->dmamode | STM32_DMA_CR_DIR_P2M | STM32_DMA_CR_MINC |
+								 STM32_DMA_CR_CIRC | STM32_DMA_CR_HTIE | STM32_DMA_CR_TCIE);
+	dmaStreamEnable(drv->dmarx);
+	osalSysUnlock();
+}
+
+/**@brief EXT driver callback, forwards the edge to the callback of the pin.
+ * @param[in]	extp		EXT driver.
+ * @param[in]	channel		EXTI line.
+ */
+static void portEventIsr(EXTDriver *extp, expchannel_t channel)
+{
+	(void)extp;
+
+	if ((channel < VFB_PORT_EVENT_NUMBER) && (Vfb_Port_EventData.callback[channel] != NULL))
+	{
+		Vfb_Port_EventData.callback[channel](Vfb_Port_EventData.line[channel]);
+	}
+}
+#endif
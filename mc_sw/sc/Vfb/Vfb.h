@@ -40,10 +40,26 @@
 #if !defined(VFB_H)
 #define VFB_H
 
+#include "Vfb_Adc.h"
 #include "Vfb_Dio.h"
 #include "Vfb_I2c.h"
 #include "Vfb_Port.h"
+#include "Vfb_Rtc.h"
 #include "Vfb_Spi.h"
 #include "Vfb_Uart.h"
 
+#if (VFB_BACKEND != VFB_BACKEND_HAL)
+#include "Vfb_Sim.h"
+#endif
+
+/**@brief Defines the virtual function bus macro used to order the queued bus transactions.
+ * @details Earliest deadline first, equal deadlines by priority. Deadlines are compared wrap safe.
+ * @param[in]	first	Transaction to check (I2C or SPI)
+ * @param[in]	second	Transaction to check against
+ * @return TRUE if the first transaction has to be executed before the second one.
+ */
+#define Vfb_Is_Scheduled_Before(first, second) \
+	((((int32_t)((first)->deadline - (second)->deadline) < 0) \
+	|| (((first)->deadline == (second)->deadline) && ((first)->priority > (second)->priority))) ? TRUE : FALSE)
+
 #endif /* VFB_H */
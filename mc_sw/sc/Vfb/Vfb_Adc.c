@@ -0,0 +1,167 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Vfb_Adc.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Vfb_Adc.c
+* @brief Implements the timer triggered ADC service of the virtual function bus.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include "Vfb.h"
+
+/**@struct Vfb_AdcDataType
+ * @brief Specifies the runtime data of the ADC service.
+ */
+typedef struct Vfb_AdcDataTypeTag
+{
+	Vfb_AdcSampleType buffer[VFB_ADC_DEPTH * VFB_ADC_CHANNEL_NUMBER];	/**< Circular DMA buffer of the scans. */
+	uint32_t state[VFB_ADC_CHANNEL_NUMBER];								/**< Filtered samples, scaled by 2^VFB_ADC_FILTER_SHIFT. */
+	uint32_t scans;														/**< Number of filtered scans. */
+} Vfb_AdcDataType;
+
+static void adcEndIsr(Vfb_AdcDriverType *drv, Vfb_AdcSampleType *buffer, size_t n);
+
+/**@brief Stores the ADC driver configuration.
+ */
+static const Vfb_AdcConfigType Vfb_Adc_Config = VFB_ADC_CONFIG;
+
+/**@brief Stores the scan of the internal reference, the battery and the temperature sensor.
+ */
+static const Vfb_AdcGroupType Vfb_Adc_Group = VFB_ADC_GROUP(adcEndIsr, VFB_ADC_BATTERY_CHANNEL);
+
+/**@brief Stores the trigger timer configuration.
+ */
+static const Vfb_AdcTimerConfigType Vfb_Adc_TimerConfig = VFB_ADC_TIMER_CONFIG(VFB_ADC_TIMER_FREQUENCY);
+
+/**@brief Stores the runtime data of the ADC service.
+ */
+static Vfb_AdcDataType Vfb_Adc_Data;
+
+/**@brief Initialization function of the ADC service.
+ * @details The scans are started by the timer and written by the DMA, the CPU only runs
+ * the filter at half and full buffer.
+ */
+void Vfb_Adc_Init(void)
+{
+#if (VFB_BACKEND == VFB_BACKEND_HAL)
+	Vfb_Write_Port_Line_Mode(VFB_ADC_BATTERY_LINE, VFB_ADC_PIN_MODE);
+#endif
+	Vfb_Adc_Data.scans = 0u;
+	Vfb_Adc_Start(VFB_ADC_BUS, &Vfb_Adc_Config);
+	Vfb_Adc_Enable_Internal(VFB_ADC_BUS);
+	Vfb_Adc_Start_Conversion(VFB_ADC_BUS, &Vfb_Adc_Group, Vfb_Adc_Data.buffer, VFB_ADC_DEPTH);
+	Vfb_Adc_Timer_Start(VFB_ADC_TIMER, &Vfb_Adc_TimerConfig, VFB_ADC_TIMER_FREQUENCY / VFB_ADC_SCAN_FREQUENCY);
+}
+
+/**@brief Deinitialization function of the ADC service.
+ */
+void Vfb_Adc_Deinit(void)
+{
+	Vfb_Adc_Timer_Stop(VFB_ADC_TIMER);
+	Vfb_Adc_Stop_Conversion(VFB_ADC_BUS);
+	Vfb_Adc_Stop(VFB_ADC_BUS);
+}
+
+/**@brief Used to get the filtered measurements.
+ * @details The conversion to physical units is done here, on the reader side, the ISR only filters.
+ * @param[out]	values	Filtered measurements.
+ * @return	TRUE if at least one scan was filtered, FALSE otherwise (values not written).
+ */
+uint8_t Vfb_Adc_GetValues(Vfb_AdcValuesType *values)
+{
+	uint32_t state[VFB_ADC_CHANNEL_NUMBER];
+	uint32_t scans = 0u;
+	uint8_t retVal = FALSE;
+
+	chSysLock();
+	state[VFB_ADC_CHANNEL_VREFINT] = Vfb_Adc_Data.state[VFB_ADC_CHANNEL_VREFINT];
+	state[VFB_ADC_CHANNEL_BATTERY] = Vfb_Adc_Data.state[VFB_ADC_CHANNEL_BATTERY];
+	state[VFB_ADC_CHANNEL_TEMPERATURE] = Vfb_Adc_Data.state[VFB_ADC_CHANNEL_TEMPERATURE];
+	scans = Vfb_Adc_Data.scans;
+	chSysUnlock();
+
+	if ((scans != 0u) && (state[VFB_ADC_CHANNEL_VREFINT] != 0u))
+	{
+		const int32_t tsCal1 = (int32_t)VFB_ADC_TS_CAL1;
+		const int32_t tsCal2 = (int32_t)VFB_ADC_TS_CAL2;
+		/* VDDA = 3.0 V * VREFINT_CAL / VREFINT. */
+		const uint32_t supply = (uint32_t)(((uint64_t)3000u * VFB_ADC_VREFINT_CAL << VFB_ADC_FILTER_SHIFT) / state[VFB_ADC_CHANNEL_VREFINT]);
+		/* Temperature sensor sample scaled to the 3.0 V calibration supply. */
+		const int64_t sensor = (int64_t)(((uint64_t)state[VFB_ADC_CHANNEL_TEMPERATURE] * supply) / 3000u);
+
+		values->supply = supply;
+		values->battery = (uint32_t)(((uint64_t)state[VFB_ADC_CHANNEL_BATTERY] * supply * VFB_ADC_BATTERY_DIVIDER_NUM) /
+									 ((uint64_t)VFB_ADC_FULL_SCALE * VFB_ADC_BATTERY_DIVIDER_DEN << VFB_ADC_FILTER_SHIFT));
+		values->temperature = 3000 + (int32_t)((10000 * (sensor - ((int64_t)tsCal1 << VFB_ADC_FILTER_SHIFT))) /
+											   ((int64_t)(tsCal2 - tsCal1) << VFB_ADC_FILTER_SHIFT));
+		values->scans = scans;
+		retVal = TRUE;
+	}
+
+	return retVal;
+}
+
+/**@brief ADC DMA callback, called at half and full buffer with the completed scans.
+ * @details Each channel runs through a first order low pass filter, y += x - y / 2^VFB_ADC_FILTER_SHIFT.
+ * The first scan sets the filters, so the measurements are valid at once.
+ * @param[in]	drv		ADC driver.
+ * @param[in]	buffer	Completed scans.
+ * @param[in]	n		Number of completed scans.
+ */
+static void adcEndIsr(Vfb_AdcDriverType *drv, Vfb_AdcSampleType *buffer, size_t n)
+{
+	uint32_t scan = 0u;
+	uint32_t channel = 0u;
+
+	(void)drv;
+
+	chSysLockFromISR();
+	for (scan = 0u; scan < n; scan++)
+	{
+		for (channel = 0u; channel < VFB_ADC_CHANNEL_NUMBER; channel++)
+		{
+			const uint32_t sample = buffer[(scan * VFB_ADC_CHANNEL_NUMBER) + channel];
+
+			if (Vfb_Adc_Data.scans == 0u)
+			{
+				Vfb_Adc_Data.state[channel] = sample << VFB_ADC_FILTER_SHIFT;
+			}
+			else
+			{
+				Vfb_Adc_Data.state[channel] += sample - (Vfb_Adc_Data.state[channel] >> VFB_ADC_FILTER_SHIFT);
+			}
+		}
+		Vfb_Adc_Data.scans++;
+	}
+	chSysUnlockFromISR();
+}
@@ -0,0 +1,299 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Vfb_Adc.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Vfb_Adc.h
+* @brief Implements the header of the timer triggered ADC service of the virtual function bus.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#if !defined(VFB_ADC_H)
+#define VFB_ADC_H
+
+#include <stdint.h>
+#include "Vfb_Backend.h"
+#include "Vfb_Cfg.h"
+
+#if (VFB_BACKEND == VFB_BACKEND_HAL)
+
+#include "hal.h"
+
+/**@brief Defines the virtual function bus type of an ADC driver.
+ */
+typedef ADCDriver Vfb_AdcDriverType;
+
+/**@brief Defines the virtual function bus type of an ADC driver configuration.
+ */
+typedef ADCConfig Vfb_AdcConfigType;
+
+/**@brief Defines the virtual function bus type of an ADC scan (conversion group).
+ */
+typedef ADCConversionGroup Vfb_AdcGroupType;
+
+/**@brief Defines the virtual function bus type of an ADC sample.
+ */
+typedef adcsample_t Vfb_AdcSampleType;
+
+/**@brief Defines the virtual function bus type of the timer triggering the ADC scans.
+ */
+typedef GPTDriver Vfb_AdcTimerType;
+
+/**@brief Defines the virtual function bus type of the trigger timer configuration.
+ */
+typedef GPTConfig Vfb_AdcTimerConfigType;
+
+/**@brief Defines the virtual function bus ADC drivers.
+ */
+#define VFB_ADC_ADC1								(&ADCD1)
+
+/**@brief Defines the virtual function bus ADC trigger timers.
+ */
+#define VFB_ADC_TIM6								(&GPTD6)
+
+/**@brief Defines the pin function of an analog input.
+ */
+#define VFB_ADC_PIN_MODE							(PAL_MODE_INPUT_ANALOG)
+
+/**@brief Defines the virtual function bus initializer of an ADC driver configuration (single ended inputs).
+ */
+#define VFB_ADC_CONFIG								{ 0u }
+
+/**@brief Defines the virtual function bus initializer of the trigger timer configuration.
+ * @details The update event is the trigger output (TRGO), no interrupt is used.
+ * @param[in]	counterFrequency	Timer counter frequency in Hz
+ */
+#define VFB_ADC_TIMER_CONFIG(counterFrequency) \
+	{ \
+		.frequency = (counterFrequency), \
+		.callback = NULL, \
+		.cr2 = TIM_CR2_MMS_1, \
+		.dier = 0u \
+	}
+
+/**@brief Defines the virtual function bus macro used to get the sample time bits of an input in SMPR1 (inputs 0 to 9).
+ * @param[in]	channel		ADC channel
+ * @param[in]	time		Sample time
+ */
+#define VFB_ADC_SMPR1_SMP(channel, time)			((uint32_t)(time) << ((channel) * 3u))
+
+/**@brief Defines the virtual function bus initializer of the circular scan of the internal reference,
+ * an external input and the temperature sensor, started by the TIM6 trigger output.
+ * @details Each channel is oversampled 16 times and shifted by 4 bits in HW, so the result stays
+ * 12 bit wide with 2 more effective bits.
+ * @param[in]	callback	Called from the DMA ISR at half and full buffer
+ * @param[in]	channel		ADC channel of the external input
+ */
+#define VFB_ADC_GROUP(callback, channel) \
+	{ \
+		.circular = TRUE, \
+		.num_channels = VFB_ADC_CHANNEL_NUMBER, \
+		.end_cb = (callback), \
+		.error_cb = NULL, \
+		.cfgr = ADC_CFGR_EXTEN_RISING | ADC_CFGR_EXTSEL_SRC(13u), \
+		.cfgr2 = ADC_CFGR2_ROVSE | (3u << ADC_CFGR2_OVSR_Pos) | (4u << ADC_CFGR2_OVSS_Pos), \
+		.tr1 = ADC_TR(0u, 4095u), \
+		.smpr = { ADC_SMPR1_SMP_AN0(ADC_SMPR_SMP_640P5) | VFB_ADC_SMPR1_SMP(channel, ADC_SMPR_SMP_247P5), \
+				  ADC_SMPR2_SMP_AN17(ADC_SMPR_SMP_640P5) }, \
+		.sqr = { ADC_SQR1_SQ1_N(ADC_CHANNEL_IN0) | ADC_SQR1_SQ2_N(channel) | ADC_SQR1_SQ3_N(ADC_CHANNEL_IN17), \
+				 0u, 0u, 0u } \
+	}
+
+/**@brief Defines the internal reference raw value measured at 3.0 V in production.
+ */
+#define VFB_ADC_VREFINT_CAL							(*(const uint16_t *)0x1FFF75AAu)
+
+/**@brief Defines the temperature sensor raw value measured at 30 degree C and 3.0 V in production.
+ */
+#define VFB_ADC_TS_CAL1								(*(const uint16_t *)0x1FFF75A8u)
+
+/**@brief Defines the temperature sensor raw value measured at 130 degree C and 3.0 V in production.
+ */
+#define VFB_ADC_TS_CAL2								(*(const uint16_t *)0x1FFF75CAu)
+
+/**@brief Defines the virtual function bus macro used to start an ADC driver.
+ * @param[in]	drv		ADC driver
+ * @param[in]	cfg		ADC driver configuration
+ */
+#define Vfb_Adc_Start(drv, cfg)						adcStart(drv, cfg)
+
+/**@brief Defines the virtual function bus macro used to stop an ADC driver.
+ * @param[in]	drv		ADC driver
+ */
+#define Vfb_Adc_Stop(drv)							adcStop(drv)
+
+/**@brief Defines the virtual function bus macro used to connect the internal reference and the temperature sensor.
+ * @param[in]	drv		ADC driver
+ */
+#define Vfb_Adc_Enable_Internal(drv)				do { adcSTM32EnableVREF(drv); adcSTM32EnableTS(drv); } while (0)
+
+/**@brief Defines the virtual function bus macro used to start the circular DMA scans.
+ * @param[in]	drv		ADC driver
+ * @param[in]	group	Scan
+ * @param[out]	buffer	Circular sample buffer
+ * @param[in]	depth	Number of scans in the buffer
+ */
+#define Vfb_Adc_Start_Conversion(drv, group, buffer, depth)	adcStartConversion(drv, group, buffer, depth)
+
+/**@brief Defines the virtual function bus macro used to stop the circular DMA scans.
+ * @param[in]	drv		ADC driver
+ */
+#define Vfb_Adc_Stop_Conversion(drv)				adcStopConversion(drv)
+
+/**@brief Defines the virtual function bus macro used to start the trigger timer.
+ * @param[in]	tim			Timer
+ * @param[in]	cfg			Timer configuration
+ * @param[in]	interval	Trigger period in timer counts
+ */
+#define Vfb_Adc_Timer_Start(tim, cfg, interval)		do { gptStart(tim, cfg); gptStartContinuous(tim, interval); } while (0)
+
+/**@brief Defines the virtual function bus macro used to stop the trigger timer.
+ * @param[in]	tim			Timer
+ */
+#define Vfb_Adc_Timer_Stop(tim)						do { gptStopTimer(tim); gptStop(tim); } while (0)
+
+#elif (VFB_BACKEND == VFB_BACKEND_LINUX) || (VFB_BACKEND == VFB_BACKEND_MOCK)
+
+#include <stddef.h>
+
+typedef uint16_t Vfb_AdcSampleType;
+
+typedef struct Vfb_AdcDriverTypeTag Vfb_AdcDriverType;
+
+/**@struct Vfb_AdcConfigType
+ * @brief Specifies the configuration of a simulated ADC driver.
+ */
+typedef struct Vfb_AdcConfigTypeTag
+{
+	uint32_t difsel;						/**< Differential inputs (unused). */
+} Vfb_AdcConfigType;
+
+/**@struct Vfb_AdcGroupType
+ * @brief Specifies a simulated ADC scan.
+ */
+typedef struct Vfb_AdcGroupTypeTag
+{
+	uint32_t num_channels;																	/**< Number of channels of a scan. */
+	void (*end_cb)(Vfb_AdcDriverType *drv, Vfb_AdcSampleType *buffer, size_t n);			/**< Half and full buffer callback. */
+	uint32_t channel;																		/**< External input (unused). */
+} Vfb_AdcGroupType;
+
+/**@struct Vfb_AdcDriverType
+ * @brief Specifies a simulated ADC driver, the scans are delivered by the host test.
+ */
+struct Vfb_AdcDriverTypeTag
+{
+	uint32_t id;							/**< Driver index in the traces. */
+	const Vfb_AdcConfigType *config;		/**< Driver configuration, NULL if stopped. */
+	const Vfb_AdcGroupType *group;			/**< Running scan, NULL if stopped. */
+	Vfb_AdcSampleType *buffer;				/**< Circular sample buffer. */
+	uint32_t depth;							/**< Number of scans in the buffer. */
+	uint32_t position;						/**< Index of the next scan in the buffer. */
+};
+
+/**@struct Vfb_AdcTimerConfigType
+ * @brief Specifies the configuration of a simulated trigger timer.
+ */
+typedef struct Vfb_AdcTimerConfigTypeTag
+{
+	uint32_t frequency;						/**< Timer counter frequency in Hz. */
+} Vfb_AdcTimerConfigType;
+
+/**@struct Vfb_AdcTimerType
+ * @brief Specifies a simulated trigger timer.
+ */
+typedef struct Vfb_AdcTimerTypeTag
+{
+	uint32_t id;							/**< Timer index in the traces. */
+	uint32_t interval;						/**< Trigger period in timer counts, 0 if stopped. */
+} Vfb_AdcTimerType;
+
+extern Vfb_AdcDriverType Vfb_Adc_Adc1;
+extern Vfb_AdcTimerType Vfb_Adc_Tim6;
+
+#define VFB_ADC_ADC1								(&Vfb_Adc_Adc1)
+#define VFB_ADC_TIM6								(&Vfb_Adc_Tim6)
+
+#define VFB_ADC_CONFIG								{ 0u }
+#define VFB_ADC_TIMER_CONFIG(frequency)				{ (frequency) }
+#define VFB_ADC_GROUP(callback, channel)			{ VFB_ADC_CHANNEL_NUMBER, (callback), (channel) }
+
+/**@brief Defines typical calibration values of the simulated internal channels.
+ */
+#define VFB_ADC_VREFINT_CAL							(1655u)
+#define VFB_ADC_TS_CAL1								(1035u)
+#define VFB_ADC_TS_CAL2								(1375u)
+
+#define Vfb_Adc_Enable_Internal(drv)				((void)(drv))
+
+extern void Vfb_Adc_Start(Vfb_AdcDriverType *drv, const Vfb_AdcConfigType *cfg);
+extern void Vfb_Adc_Stop(Vfb_AdcDriverType *drv);
+extern void Vfb_Adc_Start_Conversion(Vfb_AdcDriverType *drv, const Vfb_AdcGroupType *group, Vfb_AdcSampleType *buffer, const uint32_t depth);
+extern void Vfb_Adc_Stop_Conversion(Vfb_AdcDriverType *drv);
+extern void Vfb_Adc_Timer_Start(Vfb_AdcTimerType *tim, const Vfb_AdcTimerConfigType *cfg, const uint32_t interval);
+extern void Vfb_Adc_Timer_Stop(Vfb_AdcTimerType *tim);
+extern void Vfb_Adc_SimScan(Vfb_AdcDriverType *drv, const Vfb_AdcSampleType *samples);
+
+#else
+#error "Vfb: unknown backend"
+#endif
+
+/**@brief Defines the full scale value of a 12 bit sample.
+ */
+#define VFB_ADC_FULL_SCALE							(4095u)
+
+/**@brief Specifies the channels of a scan, in conversion order.
+ */
+typedef enum
+{
+	VFB_ADC_CHANNEL_VREFINT = 0u,			/**< Internal reference, gives the supply voltage. */
+	VFB_ADC_CHANNEL_BATTERY,				/**< Battery voltage divider. */
+	VFB_ADC_CHANNEL_TEMPERATURE,			/**< Internal temperature sensor. */
+	VFB_ADC_CHANNEL_NUMBER
+} Vfb_AdcChannelType;
+
+/**@struct Vfb_AdcValuesType
+ * @brief Specifies the filtered measurements.
+ */
+typedef struct Vfb_AdcValuesTypeTag
+{
+	uint32_t supply;						/**< Analog supply voltage in millivolts. */
+	uint32_t battery;						/**< Battery voltage in millivolts. */
+	int32_t temperature;					/**< Die temperature in centidegrees Celsius. */
+	uint32_t scans;							/**< Number of filtered scans. */
+} Vfb_AdcValuesType;
+
+extern void Vfb_Adc_Init(void);
+extern void Vfb_Adc_Deinit(void);
+extern uint8_t Vfb_Adc_GetValues(Vfb_AdcValuesType *values);
+
+#endif /* VFB_ADC_H */
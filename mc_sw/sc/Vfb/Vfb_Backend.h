@@ -0,0 +1,61 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Vfb_Backend.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Vfb_Backend.h
+* @brief Implements the build time selection of the virtual function bus backend.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#if !defined(VFB_BACKEND_H)
+#define VFB_BACKEND_H
+
+/**@brief Defines the HW backend (ChibiOS HAL), used by the target build.
+ */
+#define VFB_BACKEND_HAL			(0u)
+
+/**@brief Defines the Linux simulation backend, used by the host build.
+ */
+#define VFB_BACKEND_LINUX		(1u)
+
+/**@brief Defines the recording mock backend, used by the host unit tests.
+ */
+#define VFB_BACKEND_MOCK		(2u)
+
+/**@brief Defines the selected backend, the host builds pass -DVFB_BACKEND=VFB_BACKEND_LINUX or VFB_BACKEND_MOCK.
+ */
+#if !defined(VFB_BACKEND)
+#define VFB_BACKEND				VFB_BACKEND_HAL
+#endif
+
+#endif /* VFB_BACKEND_H */
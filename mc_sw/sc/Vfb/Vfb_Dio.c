@@ -0,0 +1,255 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Vfb_Dio.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Vfb_Dio.c
+* @brief Implements the digital channels and the debounced inputs of the virtual function bus.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include "Vfb.h"
+#include "Os.h"
+
+/**@struct Vfb_DioInputDataType
+ * @brief Specifies the runtime data of a debounced input.
+ */
+typedef struct Vfb_DioInputDataTypeTag
+{
+	virtual_timer_t debounceTimer;		/**< One-shot timer armed by an edge, samples the settled level. */
+	virtual_timer_t gestureTimer;		/**< One-shot timer of the long press (pressed) or of the click gap (released). */
+	uint8_t isPressed;					/**< Debounced state. */
+	uint8_t isLongPress;				/**< The current press was reported as long press. */
+	uint8_t clickCount;					/**< Clicks of the running click sequence. */
+	uint8_t clicks;						/**< Clicks of the last reported click sequence. */
+	Vfb_DioEventType events;			/**< Reported events not read yet. */
+} Vfb_DioInputDataType;
+
+/**@struct Vfb_DioDataType
+ * @brief Specifies the runtime data of the debounced inputs.
+ */
+typedef struct Vfb_DioDataTypeTag
+{
+	Vfb_DioInputDataType input[VFB_DIO_INPUT_UNKNOWN];		/**< Runtime data of each input. */
+} Vfb_DioDataType;
+
+static void inputEdgeIsr(const Vfb_LineType line);
+static void inputSettled(void *arg);
+static void inputLongPress(void *arg);
+static void inputClickEnd(void *arg);
+static void signalEvents(const uint32_t idx, const Vfb_DioEventType events);
+
+/**@brief Stores the runtime data of the debounced inputs.
+ */
+static Vfb_DioDataType Vfb_Dio_Data;
+
+/**@brief Initialization function of the digital channels.
+ * @details The output value is written before the pin function, so no glitch is driven.
+ */
+void Vfb_Dio_Init(void)
+{
+	uint32_t idx = 0u;
+
+	for (idx = 0u; idx < VFB_DIO_CHANNEL_NUMBER; idx++)
+	{
+		if (Vfb_Dio_ChannelConfig[idx].mode == VFB_DIO_MODE_OUTPUT)
+		{
+			Vfb_Dio_Write_Channel(Vfb_Dio_ChannelConfig[idx].channel, Vfb_Dio_ChannelConfig[idx].value);
+		}
+		Vfb_Write_Port_Line_Mode(Vfb_Dio_ChannelConfig[idx].channel, Vfb_Dio_ChannelConfig[idx].mode);
+	}
+}
+
+/**@brief Initialization function of the debounced inputs.
+ * @details Enables the edge interrupts of the inputs, the timers are armed only when an edge occurs,
+ * so no thread polls the inputs. Must be called after the OS is initialized.
+ */
+void Vfb_Dio_InputInit(void)
+{
+	uint32_t idx = 0u;
+
+	for (idx = 0u; idx < VFB_DIO_INPUT_UNKNOWN; idx++)
+	{
+		Vfb_DioInputDataType *data = &Vfb_Dio_Data.input[idx];
+
+		chVTObjectInit(&data->debounceTimer);
+		chVTObjectInit(&data->gestureTimer);
+		data->isPressed = (Vfb_Dio_Read_Channel(Vfb_Dio_InputConfig[idx].channel) == Vfb_Dio_InputConfig[idx].activeLevel) ? TRUE : FALSE;
+		data->isLongPress = FALSE;
+		data->clickCount = 0u;
+		data->clicks = 0u;
+		data->events = 0u;
+		Vfb_Port_EnableLineEvent(Vfb_Dio_InputConfig[idx].channel, inputEdgeIsr);
+	}
+}
+
+/**@brief Used to read and clear the events reported by a debounced input.
+ * @param[in]	input	Debounced input.
+ * @param[out]	status	Events reported since the last call and debounced state.
+ */
+void Vfb_Dio_GetInputEvents(const Vfb_DioInputType input, Vfb_DioInputStatusType *status)
+{
+	status->events = 0u;
+	status->clicks = 0u;
+	status->isPressed = FALSE;
+
+	if (input < VFB_DIO_INPUT_UNKNOWN)
+	{
+		Vfb_DioInputDataType *data = &Vfb_Dio_Data.input[input];
+
+		chSysLock();
+		status->events = data->events;
+		status->clicks = data->clicks;
+		status->isPressed = data->isPressed;
+		data->events = 0u;
+		chSysUnlock();
+	}
+}
+
+/**@brief Edge interrupt callback of the debounced inputs.
+ * @details The edge interrupt is disabled while the level settles, so a bouncing contact
+ * raises a single interrupt and arms the debounce timer once.
+ * @param[in]	line	Pin on which the edge occurred.
+ */
+static void inputEdgeIsr(const Vfb_LineType line)
+{
+	uint32_t idx = 0u;
+
+	while ((idx < VFB_DIO_INPUT_UNKNOWN) && (Vfb_Dio_InputConfig[idx].channel != line))
+	{
+		idx++;
+	}
+
+	if (idx < VFB_DIO_INPUT_UNKNOWN)
+	{
+		chSysLockFromISR();
+		Vfb_Disable_Port_Line_Event_I(line);
+		chVTSetI(&Vfb_Dio_Data.input[idx].debounceTimer, MS2ST(Vfb_Dio_InputConfig[idx].debounceTime),
+				 inputSettled, (void *)(uintptr_t)idx);
+		chSysUnlockFromISR();
+	}
+}
+
+/**@brief Debounce timer callback, samples the settled level of a debounced input.
+ * @details The edge interrupt is enabled before the sample, so a change after it is never missed.
+ * @param[in]	arg		Index of the input.
+ */
+static void inputSettled(void *arg)
+{
+	const uint32_t idx = (uint32_t)(uintptr_t)arg;
+	const Vfb_DioInputConfigType *config = &Vfb_Dio_InputConfig[idx];
+	Vfb_DioInputDataType *data = &Vfb_Dio_Data.input[idx];
+	uint8_t isPressed = FALSE;
+
+	chSysLockFromISR();
+	Vfb_Enable_Port_Line_Event_I(config->channel);
+	isPressed = (Vfb_Dio_Read_Channel(config->channel) == config->activeLevel) ? TRUE : FALSE;
+
+	if (isPressed != data->isPressed)
+	{
+		data->isPressed = isPressed;
+		chVTResetI(&data->gestureTimer);
+
+		if (isPressed != FALSE)
+		{
+			data->isLongPress = FALSE;
+			if (config->longPressTime != 0u)
+			{
+				chVTSetI(&data->gestureTimer, MS2ST(config->longPressTime), inputLongPress, arg);
+			}
+			signalEvents(idx, VFB_DIO_EVENT_PRESS);
+		}
+		else if (data->isLongPress != FALSE)
+		{
+			signalEvents(idx, VFB_DIO_EVENT_RELEASE);
+		}
+		else
+		{
+			if (data->clickCount < UINT8_MAX)
+			{
+				data->clickCount++;
+			}
+
+			if (config->clickTime != 0u)
+			{
+				chVTSetI(&data->gestureTimer, MS2ST(config->clickTime), inputClickEnd, arg);
+				signalEvents(idx, VFB_DIO_EVENT_RELEASE);
+			}
+			else
+			{
+				data->clicks = data->clickCount;
+				data->clickCount = 0u;
+				signalEvents(idx, VFB_DIO_EVENT_RELEASE | VFB_DIO_EVENT_CLICK);
+			}
+		}
+	}
+	chSysUnlockFromISR();
+}
+
+/**@brief Gesture timer callback, the input stayed pressed for the long press time.
+ * @details The clicks of the running click sequence are dropped.
+ * @param[in]	arg		Index of the input.
+ */
+static void inputLongPress(void *arg)
+{
+	const uint32_t idx = (uint32_t)(uintptr_t)arg;
+
+	chSysLockFromISR();
+	Vfb_Dio_Data.input[idx].isLongPress = TRUE;
+	Vfb_Dio_Data.input[idx].clickCount = 0u;
+	signalEvents(idx, VFB_DIO_EVENT_LONG_PRESS);
+	chSysUnlockFromISR();
+}
+
+/**@brief Gesture timer callback, the input stayed released for the click gap time.
+ * @param[in]	arg		Index of the input.
+ */
+static void inputClickEnd(void *arg)
+{
+	const uint32_t idx = (uint32_t)(uintptr_t)arg;
+
+	chSysLockFromISR();
+	Vfb_Dio_Data.input[idx].clicks = Vfb_Dio_Data.input[idx].clickCount;
+	Vfb_Dio_Data.input[idx].clickCount = 0u;
+	signalEvents(idx, VFB_DIO_EVENT_CLICK);
+	chSysUnlockFromISR();
+}
+
+/**@brief Used to report events of a debounced input and to activate the configured OS thread, I-class.
+ * @param[in]	idx		Index of the input.
+ * @param[in]	events	Events to report.
+ */
+static void signalEvents(const uint32_t idx, const Vfb_DioEventType events)
+{
+	Vfb_Dio_Data.input[idx].events |= events;
+	Os_SetEventI(Vfb_Dio_InputConfig[idx].taskId, Vfb_Dio_InputConfig[idx].osEvent);
+}
@@ -40,4 +40,146 @@
 #if !defined(VFB_DIO_H)
 #define VFB_DIO_H
 
+#include "ch.h"
+#include "Vfb_Port.h"
+#include "Vfb_Cfg.h"
+
+/**@brief Defines the virtual function bus type of a digital channel (compile time pin handle).
+ */
+typedef Vfb_LineType Vfb_DioChannelType;
+
+/**@brief Defines the virtual function bus type of the sampled values of a channel group.
+ */
+typedef Vfb_PortMaskType Vfb_DioLevelType;
+
+/**@struct Vfb_DioGroupType
+ * @brief Specifies a group of digital channels on one port, accessed with a single register access.
+ */
+typedef struct Vfb_DioGroupTypeTag
+{
+	Vfb_PortIdType port;			/**< Port to which all of the channels belong. */
+	Vfb_PortMaskType mask;			/**< Mask of the channels. */
+} Vfb_DioGroupType;
+
+/**@struct Vfb_DioChannelConfigType
+ * @brief Specifies the initial configuration of a digital channel.
+ */
+typedef struct Vfb_DioChannelConfigTypeTag
+{
+	Vfb_DioChannelType channel;		/**< Channel. */
+	Vfb_PortModeType mode;			/**< Pin function. */
+	uint8_t value;					/**< Initial logic value of an output. */
+} Vfb_DioChannelConfigType;
+
+/**@brief Defines the virtual function bus type of the events reported by a debounced input (VFB_DIO_EVENT_*).
+ */
+typedef uint8_t Vfb_DioEventType;
+
+/**@struct Vfb_DioInputConfigType
+ * @brief Specifies a debounced input, sampled only on its edge interrupt.
+ * @details The pads of the inputs must differ, the pads of all of the ports share the EXTI lines.
+ */
+typedef struct Vfb_DioInputConfigTypeTag
+{
+	Vfb_DioChannelType channel;		/**< Input channel, configured as input in Vfb_Dio_ChannelConfig. */
+	uint8_t activeLevel;			/**< Logic value of the pressed state. */
+	uint16_t debounceTime;			/**< Time the level must be stable after an edge, in milliseconds. */
+	uint16_t longPressTime;			/**< Press time reported as long press, in milliseconds, 0 if not used. */
+	uint16_t clickTime;				/**< Max. release time between the clicks of a multi-click, in milliseconds,
+										 0 to report each click at the release. */
+	uint32_t taskId;				/**< OS thread activated when the input reports an event. */
+	eventmask_t osEvent;			/**< OS event signaled when the input reports an event. */
+} Vfb_DioInputConfigType;
+
+/**@struct Vfb_DioInputStatusType
+ * @brief Specifies the events reported by a debounced input since they were last read.
+ */
+typedef struct Vfb_DioInputStatusTypeTag
+{
+	Vfb_DioEventType events;		/**< Reported events (VFB_DIO_EVENT_*). */
+	uint8_t clicks;					/**< Number of clicks of the last VFB_DIO_EVENT_CLICK. */
+	uint8_t isPressed;				/**< Debounced state, TRUE if pressed. */
+} Vfb_DioInputStatusType;
+
+/**@brief Defines the event reported when the debounced input becomes active.
+ */
+#define VFB_DIO_EVENT_PRESS							(0x01u)
+
+/**@brief Defines the event reported when the debounced input becomes inactive.
+ */
+#define VFB_DIO_EVENT_RELEASE						(0x02u)
+
+/**@brief Defines the event reported after the last click of a click sequence.
+ */
+#define VFB_DIO_EVENT_CLICK							(0x04u)
+
+/**@brief Defines the event reported when the input stays active for the long press time.
+ * @details The release of a long press does not count as a click.
+ */
+#define VFB_DIO_EVENT_LONG_PRESS					(0x08u)
+
+/**@brief Defines the pin function of a push pull output channel.
+ */
+#define VFB_DIO_MODE_OUTPUT							(VFB_PORT_MODE_OUTPUT)
+
+/**@brief Defines the pin function of an input channel with pull up.
+ */
+#define VFB_DIO_MODE_INPUT_PULLUP					(VFB_PORT_MODE_INPUT_PULLUP)
+
+/**@brief Defines the pin function of an input channel with pull down.
+ */
+#define VFB_DIO_MODE_INPUT_PULLDOWN					(VFB_PORT_MODE_INPUT_PULLDOWN)
+
+/**@brief Defines the virtual function bus macro used to get the group mask of a channel.
+ * @param[in]	channel		Channel
+ * @return Mask with only the bit of the channel set, used to build group masks and values.
+ */
+#define VFB_DIO_MASK(channel)						(Vfb_Get_Port_Line_Mask(channel))
+
+/**@brief Defines the virtual function bus initializer of a channel group, resolved at compile time.
+ * @param[in]	channel		Any channel of the group (selects the port)
+ * @param[in]	mask		Masks of all of the channels of the group
+ */
+#define VFB_DIO_GROUP(channel, mask)				((Vfb_DioGroupType){ Vfb_Get_Port_Line_Port(channel), (mask) })
+
+/**@brief Defines the virtual function bus macro used to set the logic value of a channel.
+ * @param[in]	channel		Channel
+ * @param[in]	value		STD_HIGH or STD_LOW
+ */
+#define Vfb_Dio_Write_Channel(channel, value)		Vfb_Write_Port_Line_Value(channel, value)
+
+/**@brief Defines the virtual function bus macro used to get the logic value of a channel.
+ * @param[in]	channel		Channel
+ * @return STD_HIGH or STD_LOW.
+ */
+#define Vfb_Dio_Read_Channel(channel)				Vfb_Read_Port_Line_Value(channel)
+
+/**@brief Defines the virtual function bus macro used to set the logic values of a channel group.
+ * @details All of the channels change at once, through a single access of the set/reset register.
+ * @param[in]	group		Channel group
+ * @param[in]	value		Masks of the channels to set high, the other channels of the group are set low
+ */
+#define Vfb_Dio_Write_Group(group, value)			Vfb_Write_Port_Group_Value((group).port, (group).mask, value)
+
+/**@brief Defines the virtual function bus macro used to sample the logic values of a channel group.
+ * @details All of the channels are sampled at once, through a single access of the input data register.
+ * @param[in]	group		Channel group
+ * @return Snapshot with the bits of the high channels set.
+ */
+#define Vfb_Dio_Read_Group(group)					((Vfb_DioLevelType)(Vfb_Read_Port_Value((group).port) & (group).mask))
+
+/**@brief Defines the virtual function bus macro used to get the logic value of a channel from a group snapshot.
+ * @param[in]	snapshot	Snapshot returned by Vfb_Dio_Read_Group()
+ * @param[in]	channel		Channel of the sampled group
+ * @return STD_HIGH or STD_LOW.
+ */
+#define Vfb_Dio_Get_Snapshot_Channel(snapshot, channel)	((((snapshot) & VFB_DIO_MASK(channel)) != 0u) ? STD_HIGH : STD_LOW)
+
+extern const Vfb_DioChannelConfigType Vfb_Dio_ChannelConfig[VFB_DIO_CHANNEL_NUMBER];
+extern const Vfb_DioInputConfigType Vfb_Dio_InputConfig[VFB_DIO_INPUT_UNKNOWN];
+
+extern void Vfb_Dio_Init(void);
+extern void Vfb_Dio_InputInit(void);
+extern void Vfb_Dio_GetInputEvents(const Vfb_DioInputType input, Vfb_DioInputStatusType *status);
+
 #endif /* VFB_DIO_H */
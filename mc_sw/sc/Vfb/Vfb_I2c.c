@@ -0,0 +1,350 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Vfb_I2c.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Vfb_I2c.c
+* @brief Implements the virtual function bus I2C transaction queue.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include <string.h>
+#include "Vfb.h"
+#include "Os.h"
+
+/**@struct Vfb_I2cDataType
+ * @brief Specifies the runtime data of the I2C transaction queue.
+ */
+typedef struct Vfb_I2cDataTypeTag
+{
+	Vfb_I2cTransactionType *head;								/**< Queued transactions, in execution order. */
+	Vfb_I2cStatsType stats[VFB_I2C_DEVICE_UNKNOWN];				/**< Bus usage accounting of each device. */
+	uint8_t txBuffer[VFB_I2C_WRITE_SIZE + 1u];					/**< Register address followed by the write data. */
+	uint8_t rxBuffer[VFB_I2C_BURST_SIZE];						/**< Data of a merged register read burst. */
+} Vfb_I2cDataType;
+
+static uint32_t collectBurst(Vfb_I2cTransactionType **burst);
+static void executeBurst(Vfb_I2cTransactionType * const *burst, const uint32_t count);
+static void recoverBus(void);
+
+/**@brief Stores the I2C driver configuration.
+ */
+static const Vfb_I2cConfigType Vfb_I2c_Config = VFB_I2C_CONFIG(VFB_I2C_TIMING);
+
+/**@brief Stores the runtime data of the I2C transaction queue.
+ */
+static Vfb_I2cDataType Vfb_I2c_Data;
+
+/**@brief Initialization function of the I2C transaction queue.
+ */
+void Vfb_I2c_Init(void)
+{
+#if (VFB_BACKEND == VFB_BACKEND_HAL)
+	Vfb_Write_Port_Line_Mode(VFB_I2C_SCL_LINE, VFB_I2C_PIN_MODE);
+	Vfb_Write_Port_Line_Mode(VFB_I2C_SDA_LINE, VFB_I2C_PIN_MODE);
+#endif
+	Vfb_I2c_Data.head = NULL;
+	(void)memset(Vfb_I2c_Data.stats, 0, sizeof(Vfb_I2c_Data.stats));
+	Vfb_I2c_Start(VFB_I2C_BUS, &Vfb_I2c_Config);
+}
+
+/**@brief Deinitialization function of the I2C transaction queue.
+ * @details Transactions still queued are dropped without notification.
+ */
+void Vfb_I2c_Deinit(void)
+{
+	chSysLock();
+	Vfb_I2c_Data.head = NULL;
+	chSysUnlock();
+	Vfb_I2c_Stop(VFB_I2C_BUS);
+}
+
+/**@brief Used to queue an I2C transaction without waiting for it.
+ * @details The transaction is inserted by its deadline and priority and executed by the I/O task,
+ * back to back with the other queued ones. The completion callback is called afterwards.
+ * The transaction must stay valid until then.
+ * @param[in,out]	transaction		Transaction to queue.
+ * @return	TRUE if the transaction was queued, FALSE if it is invalid or still busy.
+ */
+uint8_t Vfb_I2c_Submit(Vfb_I2cTransactionType *transaction)
+{
+	uint8_t retVal = FALSE;
+
+	if ((transaction->device < VFB_I2C_DEVICE_UNKNOWN) && (transaction->length != 0u)
+	&& ((transaction->isRead != FALSE) || (transaction->length <= VFB_I2C_WRITE_SIZE)))
+	{
+		chSysLock();
+		if (transaction->state != VFB_I2C_STATE_BUSY)
+		{
+			Vfb_I2cTransactionType **link = &Vfb_I2c_Data.head;
+
+			while ((*link != NULL) && (Vfb_Is_Scheduled_Before(transaction, *link) == FALSE))
+			{
+				link = &(*link)->next;
+			}
+			transaction->state = VFB_I2C_STATE_BUSY;
+			transaction->next = *link;
+			*link = transaction;
+			retVal = TRUE;
+		}
+		chSysUnlock();
+	}
+
+	if (retVal != FALSE)
+	{
+		Os_SetEvent(OS_TASK_ID_IO, OS_EVENT_I2C);
+	}
+
+	return retVal;
+}
+
+/**@brief Main function of the I2C transaction queue, executes all of the queued transactions.
+ * @details Runs in the I/O task when activated by Vfb_I2c_Submit().
+ */
+void Vfb_I2c_MainFunction(void)
+{
+	uint32_t count = 0u;
+
+	do
+	{
+		Vfb_I2cTransactionType *burst[VFB_I2C_BURST_NUMBER];
+
+		count = 0u;
+		chSysLock();
+		burst[0u] = Vfb_I2c_Data.head;
+		if (burst[0u] != NULL)
+		{
+			Vfb_I2c_Data.head = burst[0u]->next;
+			count = collectBurst(burst);
+		}
+		chSysUnlock();
+
+		if (count != 0u)
+		{
+			executeBurst(burst, count);
+		}
+	} while (count != 0u);
+}
+
+/**@brief Used to get the number of failed transactions.
+ * @return	Number of transactions not acknowledged by the devices.
+ */
+uint32_t Vfb_I2c_GetErrors(void)
+{
+	uint32_t retVal = 0u;
+	uint32_t device = 0u;
+
+	for (device = 0u; device < (uint32_t)VFB_I2C_DEVICE_UNKNOWN; device++)
+	{
+		retVal += Vfb_I2c_Data.stats[device].errors;
+	}
+
+	return retVal;
+}
+
+/**@brief Used to get the bus usage accounting of a device.
+ * @param[in]	device	Device on the I2C bus.
+ * @return	Bus usage accounting, NULL if the device is not configured.
+ */
+const Vfb_I2cStatsType *Vfb_I2c_GetStats(const Vfb_I2cDeviceType device)
+{
+	const Vfb_I2cStatsType *retVal = NULL;
+
+	if (device < VFB_I2C_DEVICE_UNKNOWN)
+	{
+		retVal = &Vfb_I2c_Data.stats[device];
+	}
+
+	return retVal;
+}
+
+/**@brief Used to remove from the queue the register reads which continue a read burst.
+ * @details Only called with the system locked. The queue is scanned in execution order and a read is
+ * merged if it addresses the same device and starts at the register following the burst. The scan
+ * stops at the first other transaction of the device (a write or a read which does not continue the
+ * burst): the transactions of a device keep their order, a read never passes a write.
+ * @param[in,out]	burst	Transactions of the burst, the first one is already removed from the queue.
+ * @return	Number of transactions in the burst.
+ */
+static uint32_t collectBurst(Vfb_I2cTransactionType **burst)
+{
+	const Vfb_I2cTransactionType *first = burst[0u];
+	Vfb_I2cTransactionType **link = &Vfb_I2c_Data.head;
+	uint32_t count = 1u;
+	uint32_t length = first->length;
+	uint8_t isBlocked = FALSE;
+
+	if ((first->isRead == FALSE) || (Vfb_I2c_DeviceConfig[first->device].isMergeable == FALSE))
+	{
+		isBlocked = TRUE;
+	}
+
+	while ((isBlocked == FALSE) && (*link != NULL) && (count < VFB_I2C_BURST_NUMBER))
+	{
+		Vfb_I2cTransactionType *candidate = *link;
+
+		if (candidate->device != first->device)
+		{
+			link = &candidate->next;
+		}
+		else if ((candidate->isRead != FALSE)
+		&& ((uint32_t)candidate->reg == ((uint32_t)first->reg + length))
+		&& ((length + candidate->length) <= VFB_I2C_BURST_SIZE))
+		{
+			*link = candidate->next;
+			burst[count] = candidate;
+			length += candidate->length;
+			count++;
+		}
+		else
+		{
+			isBlocked = TRUE;
+		}
+	}
+
+	return count;
+}
+
+/**@brief Used to execute a burst of transactions as one bus exchange and notify their owners.
+ * @param[in]	burst	Transactions of the burst, a write is always alone.
+ * @param[in]	count	Number of transactions in the burst.
+ */
+static void executeBurst(Vfb_I2cTransactionType * const *burst, const uint32_t count)
+{
+	const Vfb_I2cTransactionType *first = burst[0u];
+	const Vfb_I2cDeviceConfigType *config = &Vfb_I2c_DeviceConfig[first->device];
+	Vfb_I2cStatsType *stats = &Vfb_I2c_Data.stats[first->device];
+	const rtcnt_t start = chSysGetRealtimeCounterX();
+	uint32_t length = 0u;
+	uint32_t idx = 0u;
+	uint8_t reg = first->reg;
+	Vfb_I2cResultType result = VFB_I2C_RESULT_ERROR;
+
+	for (idx = 0u; idx < count; idx++)
+	{
+		length += burst[idx]->length;
+	}
+	if (length > 1u)
+	{
+		reg |= config->burstFlag;
+	}
+
+	if (first->isRead == FALSE)
+	{
+		Vfb_I2c_Data.txBuffer[0u] = reg;
+		(void)memcpy(&Vfb_I2c_Data.txBuffer[1u], first->data, first->length);
+		result = Vfb_I2c_Exchange(VFB_I2C_BUS, config->address, Vfb_I2c_Data.txBuffer, first->length + 1u, NULL, 0u);
+	}
+	else if (count == 1u)
+	{
+		result = Vfb_I2c_Exchange(VFB_I2C_BUS, config->address, &reg, 1u, first->data, first->length);
+	}
+	else
+	{
+		result = Vfb_I2c_Exchange(VFB_I2C_BUS, config->address, &reg, 1u, Vfb_I2c_Data.rxBuffer, length);
+		if (result == VFB_I2C_RESULT_OK)
+		{
+			uint32_t offset = 0u;
+
+			for (idx = 0u; idx < count; idx++)
+			{
+				(void)memcpy(burst[idx]->data, &Vfb_I2c_Data.rxBuffer[offset], burst[idx]->length);
+				offset += burst[idx]->length;
+			}
+		}
+	}
+
+	if (result == VFB_I2C_RESULT_TIMEOUT)
+	{
+		stats->timeouts++;
+		recoverBus();
+	}
+
+	stats->busTime += (uint32_t)(chSysGetRealtimeCounterX() - start);
+	stats->bursts++;
+
+	for (idx = 0u; idx < count; idx++)
+	{
+		Vfb_I2cTransactionType *transaction = burst[idx];
+
+		stats->transactions++;
+		if (result == VFB_I2C_RESULT_OK)
+		{
+			transaction->state = VFB_I2C_STATE_DONE;
+		}
+		else
+		{
+			stats->errors++;
+			transaction->state = VFB_I2C_STATE_ERROR;
+		}
+
+		if (transaction->notify != NULL)
+		{
+			transaction->notify(transaction);
+		}
+	}
+}
+
+/**@brief Used to bring the bus back to a usable state after a timed out exchange.
+ * @details The HAL driver is left locked after a timeout, it is stopped and started again. Before the
+ * restart the bus is clocked free: a device holding SDA low in the middle of a byte releases it
+ * within 9 clocks, the following start and stop conditions reset the state machines of all devices.
+ */
+static void recoverBus(void)
+{
+	Vfb_I2c_Stop(VFB_I2C_BUS);
+#if (VFB_BACKEND == VFB_BACKEND_HAL)
+	{
+		uint32_t pulse = 0u;
+
+		Vfb_Write_Port_Line_Value(VFB_I2C_SCL_LINE, STD_HIGH);
+		Vfb_Write_Port_Line_Value(VFB_I2C_SDA_LINE, STD_HIGH);
+		Vfb_Write_Port_Line_Mode(VFB_I2C_SCL_LINE, VFB_I2C_RECOVERY_PIN_MODE);
+		Vfb_Write_Port_Line_Mode(VFB_I2C_SDA_LINE, VFB_I2C_RECOVERY_PIN_MODE);
+		while ((pulse < 9u) && (Vfb_Read_Port_Line_Value(VFB_I2C_SDA_LINE) == STD_LOW))
+		{
+			Vfb_Write_Port_Line_Value(VFB_I2C_SCL_LINE, STD_LOW);
+			Vfb_I2c_Recovery_Delay();
+			Vfb_Write_Port_Line_Value(VFB_I2C_SCL_LINE, STD_HIGH);
+			Vfb_I2c_Recovery_Delay();
+			pulse++;
+		}
+		Vfb_Write_Port_Line_Value(VFB_I2C_SDA_LINE, STD_LOW);
+		Vfb_I2c_Recovery_Delay();
+		Vfb_Write_Port_Line_Value(VFB_I2C_SDA_LINE, STD_HIGH);
+		Vfb_I2c_Recovery_Delay();
+		Vfb_Write_Port_Line_Mode(VFB_I2C_SCL_LINE, VFB_I2C_PIN_MODE);
+		Vfb_Write_Port_Line_Mode(VFB_I2C_SDA_LINE, VFB_I2C_PIN_MODE);
+	}
+#endif
+	Vfb_I2c_Start(VFB_I2C_BUS, &Vfb_I2c_Config);
+}
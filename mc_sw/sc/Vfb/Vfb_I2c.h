@@ -40,4 +40,174 @@
 #if !defined(VFB_I2C_H)
 #define VFB_I2C_H
 
+#include <stdint.h>
+#include "Vfb_Backend.h"
+#include "Vfb_Cfg.h"
+
+#if (VFB_BACKEND == VFB_BACKEND_HAL)
+
+#include "hal.h"
+
+/**@brief Defines the virtual function bus type of an I2C driver.
+ */
+typedef I2CDriver Vfb_I2cDriverType;
+
+/**@brief Defines the virtual function bus type of an I2C driver configuration.
+ */
+typedef I2CConfig Vfb_I2cConfigType;
+
+/**@brief Defines the virtual function bus type of the result of an exchange.
+ */
+typedef msg_t Vfb_I2cResultType;
+
+/**@brief Defines the virtual function bus I2C drivers.
+ */
+#define VFB_I2C_I2C3								(&I2CD3)
+
+/**@brief Defines the results of an exchange.
+ * @details After a timeout the driver is left locked and the bus may be held by a device,
+ * it has to be recovered before the next exchange.
+ */
+#define VFB_I2C_RESULT_OK							(MSG_OK)
+#define VFB_I2C_RESULT_ERROR						(MSG_RESET)
+#define VFB_I2C_RESULT_TIMEOUT						(MSG_TIMEOUT)
+
+/**@brief Defines the pin function of the I2C3 clock and data lines.
+ */
+#define VFB_I2C_PIN_MODE							(PAL_MODE_ALTERNATE(4u) | PAL_STM32_OTYPE_OPENDRAIN | PAL_STM32_OSPEED_HIGHEST)
+
+/**@brief Defines the pin function of the I2C3 clock and data lines while the bus is clocked free.
+ */
+#define VFB_I2C_RECOVERY_PIN_MODE					(PAL_MODE_OUTPUT_OPENDRAIN | PAL_STM32_OSPEED_HIGHEST)
+
+/**@brief Defines the virtual function bus macro used to wait half a period of the bus recovery clock (100 kHz).
+ */
+#define Vfb_I2c_Recovery_Delay()					chSysPolledDelayX(US2RTC(STM32_HCLK, 5u))
+
+/**@brief Defines the virtual function bus initializer of an I2C driver configuration.
+ * @param[in]	timing		Timing register value
+ */
+#define VFB_I2C_CONFIG(timing)						{ (timing), 0u, 0u }
+
+/**@brief Defines the virtual function bus macro used to start an I2C driver.
+ * @param[in]	drv		I2C driver
+ * @param[in]	cfg		I2C driver configuration
+ */
+#define Vfb_I2c_Start(drv, cfg)						i2cStart(drv, cfg)
+
+/**@brief Defines the virtual function bus macro used to stop an I2C driver.
+ * @param[in]	drv		I2C driver
+ */
+#define Vfb_I2c_Stop(drv)							i2cStop(drv)
+
+/**@brief Defines the virtual function bus macro used to do a DMA write/read exchange with a device.
+ * @details The calling thread sleeps until the DMA transfer ends, the CPU is free meanwhile.
+ * @param[in]	drv		I2C driver
+ * @param[in]	addr	7 bit device address
+ * @param[in]	tx		Data to write (at least one byte)
+ * @param[in]	txLen	Number of bytes to write
+ * @param[out]	rx		Buffer for the read data, NULL if nothing is read
+ * @param[in]	rxLen	Number of bytes to read
+ * @return VFB_I2C_RESULT_OK if the device acknowledged the whole exchange, VFB_I2C_RESULT_ERROR on a
+ * NACK or bus error, VFB_I2C_RESULT_TIMEOUT if the exchange did not end within VFB_I2C_TIMEOUT.
+ */
+#define Vfb_I2c_Exchange(drv, addr, tx, txLen, rx, rxLen) \
+	i2cMasterTransmitTimeout(drv, addr, tx, txLen, rx, rxLen, MS2ST(VFB_I2C_TIMEOUT))
+
+#elif (VFB_BACKEND == VFB_BACKEND_LINUX) || (VFB_BACKEND == VFB_BACKEND_MOCK)
+
+#include <stddef.h>
+
+/**@struct Vfb_I2cConfigType
+ * @brief Specifies the configuration of a simulated I2C driver.
+ */
+typedef struct Vfb_I2cConfigTypeTag
+{
+	uint32_t timingr;						/**< Timing register value (unused). */
+} Vfb_I2cConfigType;
+
+/**@struct Vfb_I2cDriverType
+ * @brief Specifies a simulated I2C driver, the device answers are scripted by the host test.
+ */
+typedef struct Vfb_I2cDriverTypeTag
+{
+	uint32_t id;							/**< Driver index in the traces. */
+	const Vfb_I2cConfigType *config;		/**< Driver configuration, NULL if stopped. */
+} Vfb_I2cDriverType;
+
+typedef int32_t Vfb_I2cResultType;
+
+extern Vfb_I2cDriverType Vfb_I2c_I2c3;
+
+#define VFB_I2C_I2C3								(&Vfb_I2c_I2c3)
+
+#define VFB_I2C_RESULT_OK							(0)
+#define VFB_I2C_RESULT_ERROR						(-2)
+#define VFB_I2C_RESULT_TIMEOUT						(-1)
+
+#define VFB_I2C_CONFIG(timing)						{ (timing) }
+
+extern void Vfb_I2c_Start(Vfb_I2cDriverType *drv, const Vfb_I2cConfigType *cfg);
+extern void Vfb_I2c_Stop(Vfb_I2cDriverType *drv);
+extern Vfb_I2cResultType Vfb_I2c_Exchange(Vfb_I2cDriverType *drv, const uint8_t addr, const uint8_t *tx, const uint32_t txLen, uint8_t *rx, const uint32_t rxLen);
+
+#else
+#error "Vfb: unknown backend"
+#endif
+
+/**@brief Specifies the states of an I2C transaction.
+ */
+typedef enum
+{
+	VFB_I2C_STATE_IDLE = 0u,				/**< Never submitted. */
+	VFB_I2C_STATE_BUSY,						/**< Queued or in execution. */
+	VFB_I2C_STATE_DONE,						/**< Executed, the device acknowledged it. */
+	VFB_I2C_STATE_ERROR						/**< Executed, the device did not answer or the bus failed. */
+} Vfb_I2cStateType;
+
+typedef struct Vfb_I2cTransactionTypeTag Vfb_I2cTransactionType;
+
+/**@brief Specifies the completion callback of an I2C transaction.
+ * @details Called from the I/O task, the transaction can be submitted again from the callback.
+ */
+typedef void (*Vfb_I2cNotifyType)(Vfb_I2cTransactionType *transaction);
+
+/**@struct Vfb_I2cTransactionType
+ * @brief Specifies a register read or write transaction, owned by the submitting driver.
+ * @details Queued transactions are executed earliest deadline first, equal deadlines by priority.
+ */
+struct Vfb_I2cTransactionTypeTag
+{
+	Vfb_I2cTransactionType *next;			/**< Next queued transaction (internal). */
+	Vfb_I2cDeviceType device;				/**< Addressed device. */
+	uint8_t reg;							/**< First register address. */
+	uint8_t isRead;							/**< TRUE for a register read, FALSE for a register write. */
+	uint8_t priority;						/**< Priority among the transactions with the same deadline, higher first. */
+	uint32_t deadline;						/**< System time (OS ticks) by which the transaction should be done. */
+	volatile Vfb_I2cStateType state;		/**< Transaction state. */
+	uint8_t *data;							/**< Read destination or write source. */
+	uint16_t length;						/**< Number of data bytes. */
+	Vfb_I2cNotifyType notify;				/**< Completion callback, can be NULL. */
+	void *context;							/**< User data of the completion callback. */
+};
+
+/**@struct Vfb_I2cStatsType
+ * @brief Specifies the bus usage accounting of one device.
+ */
+typedef struct Vfb_I2cStatsTypeTag
+{
+	uint32_t busTime;						/**< Bus time used by the device in real time counter cycles. */
+	uint32_t transactions;					/**< Number of executed transactions. */
+	uint32_t bursts;						/**< Number of bus exchanges (merged reads count once). */
+	uint32_t errors;						/**< Number of failed transactions. */
+	uint32_t timeouts;						/**< Number of timed out exchanges, each one followed by a bus recovery. */
+} Vfb_I2cStatsType;
+
+extern void Vfb_I2c_Init(void);
+extern void Vfb_I2c_Deinit(void);
+extern uint8_t Vfb_I2c_Submit(Vfb_I2cTransactionType *transaction);
+extern void Vfb_I2c_MainFunction(void);
+extern uint32_t Vfb_I2c_GetErrors(void);
+extern const Vfb_I2cStatsType *Vfb_I2c_GetStats(const Vfb_I2cDeviceType device);
+
 #endif /* VFB_I2C_H */
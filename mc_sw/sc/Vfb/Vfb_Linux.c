@@ -0,0 +1,291 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Vfb_Linux.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Vfb_Linux.c
+* @brief Implements the Linux pseudo terminal UART backend of the virtual function bus.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include "Vfb_Backend.h"
+
+#if (VFB_BACKEND == VFB_BACKEND_LINUX)
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "Vfb.h"
+
+/**@brief Defines the number of nanoseconds in a second.
+ */
+#define VFB_NS_PER_SECOND			(1000000000ull)
+
+static uint64_t getTime(void);
+static void serveUart(Vfb_UartDriverType *drv);
+
+/**@brief Simulated UART drivers.
+ */
+Vfb_UartDriverType Vfb_Uart_Usart1 = {.id = 1u, .fd = -1};
+Vfb_UartDriverType Vfb_Uart_Usart2 = {.id = 2u, .fd = -1};
+Vfb_UartDriverType Vfb_Uart_Lpuart1 = {.id = 3u, .fd = -1};
+
+/**@brief Used to iterate over the simulated UART drivers.
+ */
+static Vfb_UartDriverType * const Vfb_Uart_Driver[] =
+{
+	&Vfb_Uart_Usart1,
+	&Vfb_Uart_Usart2,
+	&Vfb_Uart_Lpuart1
+};
+
+/**@brief Used to start a simulated UART driver.
+ * @param[in]	drv		UART driver.
+ * @param[in]	cfg		UART driver configuration.
+ */
+void Vfb_Uart_Start(Vfb_UartDriverType *drv, const Vfb_UartConfigType *cfg)
+{
+	drv->config = cfg;
+	drv->rxBuffer = NULL;
+	drv->rxSize = 0u;
+	drv->rxPosition = 0u;
+	drv->rxPending = 0u;
+	drv->txPending = 0u;
+	drv->budgetTime = getTime();
+}
+
+/**@brief Used to stop a simulated UART driver.
+ * @param[in]	drv		UART driver.
+ */
+void Vfb_Uart_Stop(Vfb_UartDriverType *drv)
+{
+	drv->config = NULL;
+}
+
+/**@brief Used to start the emulated circular receive DMA of a simulated UART driver.
+ * @param[in]	drv		UART driver.
+ * @param[in]	buffer	Circular receive buffer.
+ * @param[in]	size	Size of the circular receive buffer in bytes (even).
+ */
+void Vfb_Uart_StartCircularRx(Vfb_UartDriverType *drv, uint8_t *buffer, const uint32_t size)
+{
+	drv->rxBuffer = buffer;
+	drv->rxSize = size;
+	drv->rxPosition = 0u;
+	drv->rxPending = 0u;
+}
+
+/**@brief Used to transmit data on a simulated UART driver.
+ * @details The data is written at once, the transmission end is reported by the next Vfb_Uart_LinuxServe().
+ * @param[in]	drv		UART driver.
+ * @param[in]	length	Number of bytes to transmit.
+ * @param[in]	data	Data to transmit.
+ */
+void Vfb_Uart_Start_Send_I(Vfb_UartDriverType *drv, const uint32_t length, const void *data)
+{
+	const uint8_t *bytes = (const uint8_t *)data;
+	uint32_t sent = 0u;
+
+	while ((drv->fd >= 0) && (sent < length))
+	{
+		const ssize_t count = write(drv->fd, &bytes[sent], length - sent);
+
+		if (count > 0)
+		{
+			sent += (uint32_t)count;
+		}
+		else if ((count < 0) && (errno != EAGAIN) && (errno != EINTR))
+		{
+			break;
+		}
+	}
+	drv->txBytes += sent;
+	drv->txPending = 1u;
+}
+
+/**@brief Used to back a simulated UART driver with a new pseudo terminal.
+ * @details A replay tool (or a terminal) opens the slave side to feed recorded byte streams.
+ * @param[in]	drv			UART driver.
+ * @param[out]	name		Path of the pseudo terminal slave.
+ * @param[in]	nameSize	Size of the name buffer.
+ * @return	File descriptor of the master side, -1 on error.
+ */
+int Vfb_Uart_LinuxOpenPty(Vfb_UartDriverType *drv, char *name, const uint32_t nameSize)
+{
+	int fd = posix_openpt(O_RDWR | O_NOCTTY);
+
+	if (fd >= 0)
+	{
+		struct termios tio;
+
+		if ((grantpt(fd) != 0) || (unlockpt(fd) != 0) || (ptsname_r(fd, name, nameSize) != 0) || (tcgetattr(fd, &tio) != 0))
+		{
+			close(fd);
+			fd = -1;
+		}
+		else
+		{
+			cfmakeraw(&tio);
+			(void)tcsetattr(fd, TCSANOW, &tio);
+			Vfb_Uart_LinuxAttach(drv, fd);
+		}
+	}
+
+	return fd;
+}
+
+/**@brief Used to back a simulated UART driver with an existing file descriptor (e.g. one end of a socketpair).
+ * @param[in]	drv		UART driver.
+ * @param[in]	fd		File descriptor, switched to non blocking mode.
+ */
+void Vfb_Uart_LinuxAttach(Vfb_UartDriverType *drv, const int fd)
+{
+	(void)fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+	drv->fd = fd;
+}
+
+/**@brief Used to limit the receive rate of a simulated UART driver.
+ * @param[in]	drv				UART driver.
+ * @param[in]	bytesPerSecond	Maximum number of received bytes per second, 0 for unlimited.
+ */
+void Vfb_Uart_LinuxSetRate(Vfb_UartDriverType *drv, const uint32_t bytesPerSecond)
+{
+	drv->bytesPerSecond = bytesPerSecond;
+	drv->budgetTime = getTime();
+}
+
+/**@brief Used to serve all of the simulated UART drivers.
+ * @details Must be called periodically from the simulated interrupt context, the driver callbacks
+ * are invoked from here exactly as the DMA and USART interrupts invoke them on the target.
+ */
+void Vfb_Uart_LinuxServe(void)
+{
+	uint32_t idx = 0u;
+
+	for (idx = 0u; idx < (sizeof(Vfb_Uart_Driver) / sizeof(Vfb_Uart_Driver[0u])); idx++)
+	{
+		if (Vfb_Uart_Driver[idx]->config != NULL)
+		{
+			serveUart(Vfb_Uart_Driver[idx]);
+		}
+	}
+}
+
+/**@brief Used to get the monotonic time.
+ * @return	Time in nanoseconds.
+ */
+static uint64_t getTime(void)
+{
+	struct timespec ts;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * VFB_NS_PER_SECOND) + (uint64_t)ts.tv_nsec;
+}
+
+/**@brief Used to serve one simulated UART driver.
+ * @details Reads at most the byte rate budget, never across a half buffer boundary, so the half
+ * transfer and transfer complete events are raised at the same positions as by the DMA. If no byte
+ * arrives and the last event left bytes unpublished, an idle line event is raised.
+ * @param[in]	drv		UART driver.
+ */
+static void serveUart(Vfb_UartDriverType *drv)
+{
+	if (drv->txPending != 0u)
+	{
+		drv->txPending = 0u;
+		if (drv->config->txend1_cb != NULL)
+		{
+			drv->config->txend1_cb(drv);
+		}
+	}
+
+	if ((drv->fd >= 0) && (drv->rxBuffer != NULL) && (drv->rxSize >= 2u))
+	{
+		const uint32_t half = drv->rxSize / 2u;
+		uint64_t budget = half;
+		uint32_t received = 0u;
+
+		if (drv->bytesPerSecond != 0u)
+		{
+			const uint64_t now = getTime();
+
+			budget = ((now - drv->budgetTime) * drv->bytesPerSecond) / VFB_NS_PER_SECOND;
+			drv->budgetTime += (budget * VFB_NS_PER_SECOND) / drv->bytesPerSecond;
+		}
+
+		while (budget > 0u)
+		{
+			const uint32_t boundary = ((drv->rxPosition / half) + 1u) * half;
+			uint32_t chunk = boundary - drv->rxPosition;
+			ssize_t count;
+
+			if (chunk > budget)
+			{
+				chunk = (uint32_t)budget;
+			}
+			count = read(drv->fd, &drv->rxBuffer[drv->rxPosition], chunk);
+			if (count <= 0)
+			{
+				break;
+			}
+
+			budget -= (uint64_t)count;
+			received += (uint32_t)count;
+			drv->rxBytes += (uint64_t)count;
+			drv->rxPending += (uint32_t)count;
+			drv->rxPosition = (drv->rxPosition + (uint32_t)count) % drv->rxSize;
+			if ((drv->rxPosition % half) == 0u)
+			{
+				drv->rxPending = 0u;
+				if (drv->config->rxchar_cb != NULL)
+				{
+					drv->config->rxchar_cb(drv, 0u);
+				}
+			}
+		}
+
+		if ((received == 0u) && (drv->rxPending != 0u))
+		{
+			drv->rxPending = 0u;
+			if (drv->config->timeout_cb != NULL)
+			{
+				drv->config->timeout_cb(drv);
+			}
+		}
+	}
+}
+
+#endif /* VFB_BACKEND == VFB_BACKEND_LINUX */
@@ -0,0 +1,239 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Vfb_Mock.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Vfb_Mock.c
+* @brief Implements the recording mock backend of the virtual function bus.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include "Vfb_Backend.h"
+
+#if (VFB_BACKEND == VFB_BACKEND_MOCK)
+
+#include "Vfb.h"
+
+/**@struct Vfb_MockDataType
+ * @brief Specifies the trace of the recording mock.
+ */
+typedef struct Vfb_MockDataTypeTag
+{
+	Vfb_MockRecordType trace[VFB_MOCK_TRACE_SIZE];	/**< Recorded HW accesses, in order. */
+	uint32_t count;									/**< Number of recorded HW accesses. */
+	uint32_t dropped;								/**< Number of HW accesses not recorded (trace full). */
+	uint64_t time;									/**< Virtual time in nanoseconds, set by the host test. */
+} Vfb_MockDataType;
+
+/**@brief Mock UART drivers.
+ */
+Vfb_UartDriverType Vfb_Uart_Usart1 = {.id = 1u, .fd = -1};
+Vfb_UartDriverType Vfb_Uart_Usart2 = {.id = 2u, .fd = -1};
+Vfb_UartDriverType Vfb_Uart_Lpuart1 = {.id = 3u, .fd = -1};
+
+/**@brief Stores the trace of the recording mock.
+ */
+static Vfb_MockDataType Vfb_Mock_Data;
+
+/**@brief Used to clear the trace and the virtual time.
+ */
+void Vfb_Mock_Reset(void)
+{
+	Vfb_Mock_Data.count = 0u;
+	Vfb_Mock_Data.dropped = 0u;
+	Vfb_Mock_Data.time = 0u;
+}
+
+/**@brief Used by the host test to set the virtual time stamped on the next records.
+ * @param[in]	time	Virtual time in nanoseconds.
+ */
+void Vfb_Mock_SetTime(const uint64_t time)
+{
+	Vfb_Mock_Data.time = time;
+}
+
+/**@brief Used to append a HW access to the trace.
+ * @param[in]	event	Access type.
+ * @param[in]	id		Accessed port, line or driver.
+ * @param[in]	arg0	First access argument.
+ * @param[in]	arg1	Second access argument.
+ */
+void Vfb_Mock_Record(const Vfb_MockEventType event, const uint32_t id, const uint32_t arg0, const uint32_t arg1)
+{
+	if (Vfb_Mock_Data.count < VFB_MOCK_TRACE_SIZE)
+	{
+		Vfb_MockRecordType *record = &Vfb_Mock_Data.trace[Vfb_Mock_Data.count];
+
+		record->time = Vfb_Mock_Data.time;
+		record->event = event;
+		record->id = id;
+		record->arg0 = arg0;
+		record->arg1 = arg1;
+		Vfb_Mock_Data.count++;
+	}
+	else
+	{
+		Vfb_Mock_Data.dropped++;
+	}
+}
+
+/**@brief Used to get the recorded HW accesses.
+ * @param[out]	count	Number of records.
+ * @return	Records, in order.
+ */
+const Vfb_MockRecordType *Vfb_Mock_GetTrace(uint32_t *count)
+{
+	*count = Vfb_Mock_Data.count;
+
+	return Vfb_Mock_Data.trace;
+}
+
+/**@brief Used to get the number of HW accesses not recorded because the trace was full.
+ * @return	Number of dropped records.
+ */
+uint32_t Vfb_Mock_GetDropped(void)
+{
+	return Vfb_Mock_Data.dropped;
+}
+
+/**@brief Used to start a mock UART driver.
+ * @param[in]	drv		UART driver.
+ * @param[in]	cfg		UART driver configuration.
+ */
+void Vfb_Uart_Start(Vfb_UartDriverType *drv, const Vfb_UartConfigType *cfg)
+{
+	drv->config = cfg;
+	drv->rxBuffer = NULL;
+	drv->rxSize = 0u;
+	drv->rxPosition = 0u;
+	drv->rxPending = 0u;
+	drv->txPending = 0u;
+	Vfb_Mock_Record(VFB_MOCK_EVENT_UART_START, drv->id, cfg->speed, 0u);
+}
+
+/**@brief Used to stop a mock UART driver.
+ * @param[in]	drv		UART driver.
+ */
+void Vfb_Uart_Stop(Vfb_UartDriverType *drv)
+{
+	drv->config = NULL;
+	Vfb_Mock_Record(VFB_MOCK_EVENT_UART_STOP, drv->id, 0u, 0u);
+}
+
+/**@brief Used to start the emulated circular receive DMA of a mock UART driver.
+ * @param[in]	drv		UART driver.
+ * @param[in]	buffer	Circular receive buffer.
+ * @param[in]	size	Size of the circular receive buffer in bytes (even).
+ */
+void Vfb_Uart_StartCircularRx(Vfb_UartDriverType *drv, uint8_t *buffer, const uint32_t size)
+{
+	drv->rxBuffer = buffer;
+	drv->rxSize = size;
+	drv->rxPosition = 0u;
+	drv->rxPending = 0u;
+}
+
+/**@brief Used to transmit data on a mock UART driver.
+ * @details The transmission ends when the host test calls Vfb_Mock_UartTxEnd().
+ * @param[in]	drv		UART driver.
+ * @param[in]	length	Number of bytes to transmit.
+ * @param[in]	data	Data to transmit.
+ */
+void Vfb_Uart_Start_Send_I(Vfb_UartDriverType *drv, const uint32_t length, const void *data)
+{
+	(void)data;
+	drv->txBytes += length;
+	drv->txPending = 1u;
+	Vfb_Mock_Record(VFB_MOCK_EVENT_UART_SEND, drv->id, length, 0u);
+}
+
+/**@brief Used by the host test to receive bytes on a mock UART driver.
+ * @details The bytes are written into the circular receive buffer with the same half transfer and
+ * transfer complete events as the DMA raises, the remaining bytes are reported as an idle line.
+ * Must be called from the simulated interrupt context.
+ * @param[in]	drv		UART driver.
+ * @param[in]	data	Received bytes.
+ * @param[in]	length	Number of received bytes.
+ */
+void Vfb_Mock_UartReceive(Vfb_UartDriverType *drv, const uint8_t *data, const uint32_t length)
+{
+	uint32_t idx = 0u;
+
+	if ((drv->config != NULL) && (drv->rxBuffer != NULL) && (drv->rxSize >= 2u))
+	{
+		const uint32_t half = drv->rxSize / 2u;
+
+		Vfb_Mock_Record(VFB_MOCK_EVENT_UART_RECEIVE, drv->id, length, 0u);
+		for (idx = 0u; idx < length; idx++)
+		{
+			drv->rxBuffer[drv->rxPosition] = data[idx];
+			drv->rxPosition = (drv->rxPosition + 1u) % drv->rxSize;
+			drv->rxPending++;
+			drv->rxBytes++;
+			if ((drv->rxPosition % half) == 0u)
+			{
+				drv->rxPending = 0u;
+				if (drv->config->rxchar_cb != NULL)
+				{
+					drv->config->rxchar_cb(drv, 0u);
+				}
+			}
+		}
+
+		if (drv->rxPending != 0u)
+		{
+			drv->rxPending = 0u;
+			if (drv->config->timeout_cb != NULL)
+			{
+				drv->config->timeout_cb(drv);
+			}
+		}
+	}
+}
+
+/**@brief Used by the host test to end the pending transmission of a mock UART driver.
+ * @details Must be called from the simulated interrupt context.
+ * @param[in]	drv		UART driver.
+ */
+void Vfb_Mock_UartTxEnd(Vfb_UartDriverType *drv)
+{
+	if ((drv->config != NULL) && (drv->txPending != 0u))
+	{
+		drv->txPending = 0u;
+		if (drv->config->txend1_cb != NULL)
+		{
+			drv->config->txend1_cb(drv);
+		}
+	}
+}
+
+#endif /* VFB_BACKEND == VFB_BACKEND_MOCK */
@@ -0,0 +1,96 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Vfb_Mock.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Vfb_Mock.h
+* @brief Implements the header of the recording mock backend of the virtual function bus.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#if !defined(VFB_MOCK_H)
+#define VFB_MOCK_H
+
+#include <stdint.h>
+#include "Vfb_Uart.h"
+
+/**@brief Defines the number of records kept in the trace, later accesses are counted as dropped.
+ */
+#define VFB_MOCK_TRACE_SIZE				(1024u)
+
+/**@brief Specifies the recorded HW accesses.
+ */
+typedef enum
+{
+	VFB_MOCK_EVENT_PORT_MODE = 0u,		/**< id: line, arg0: mode. */
+	VFB_MOCK_EVENT_PORT_WRITE,			/**< id: port, arg0: mask, arg1: value. */
+	VFB_MOCK_EVENT_PORT_READ,			/**< id: port, arg0: input register. */
+	VFB_MOCK_EVENT_UART_START,			/**< id: driver, arg0: baud rate. */
+	VFB_MOCK_EVENT_UART_STOP,			/**< id: driver. */
+	VFB_MOCK_EVENT_UART_SEND,			/**< id: driver, arg0: length. */
+	VFB_MOCK_EVENT_UART_RECEIVE,		/**< id: driver, arg0: length. */
+	VFB_MOCK_EVENT_I2C_START,			/**< id: driver. */
+	VFB_MOCK_EVENT_I2C_STOP,			/**< id: driver. */
+	VFB_MOCK_EVENT_I2C_EXCHANGE,		/**< id: driver, arg0: address, arg1: write length << 16 | read length. */
+	VFB_MOCK_EVENT_SPI_START,			/**< id: driver, arg0: control register. */
+	VFB_MOCK_EVENT_SPI_STOP,			/**< id: driver. */
+	VFB_MOCK_EVENT_SPI_SELECT,			/**< id: driver. */
+	VFB_MOCK_EVENT_SPI_UNSELECT,		/**< id: driver. */
+	VFB_MOCK_EVENT_SPI_TRANSFER,		/**< id: driver, arg0: length, arg1: first sent byte (0xFF if none). */
+	VFB_MOCK_EVENT_ADC_START,			/**< id: driver, arg0: scans in the buffer (0 if only the driver is started). */
+	VFB_MOCK_EVENT_ADC_STOP,			/**< id: driver, arg0: 1 if only the scans are stopped. */
+	VFB_MOCK_EVENT_ADC_TIMER,			/**< id: timer, arg0: trigger period in timer counts (0 if stopped). */
+	VFB_MOCK_EVENT_RTC_SET,				/**< id: driver, arg0: year << 16 | month << 8 | day, arg1: milliseconds. */
+	VFB_MOCK_EVENT_UNKNOWN
+} Vfb_MockEventType;
+
+/**@struct Vfb_MockRecordType
+ * @brief Specifies one recorded HW access.
+ */
+typedef struct Vfb_MockRecordTypeTag
+{
+	uint64_t time;						/**< Virtual time of the access in nanoseconds. */
+	Vfb_MockEventType event;			/**< Access type. */
+	uint32_t id;						/**< Accessed port, line or driver. */
+	uint32_t arg0;						/**< First access argument. */
+	uint32_t arg1;						/**< Second access argument. */
+} Vfb_MockRecordType;
+
+extern void Vfb_Mock_Reset(void);
+extern void Vfb_Mock_SetTime(const uint64_t time);
+extern void Vfb_Mock_Record(const Vfb_MockEventType event, const uint32_t id, const uint32_t arg0, const uint32_t arg1);
+extern const Vfb_MockRecordType *Vfb_Mock_GetTrace(uint32_t *count);
+extern uint32_t Vfb_Mock_GetDropped(void);
+extern void Vfb_Mock_UartReceive(Vfb_UartDriverType *drv, const uint8_t *data, const uint32_t length);
+extern void Vfb_Mock_UartTxEnd(Vfb_UartDriverType *drv);
+
+#endif /* VFB_MOCK_H */
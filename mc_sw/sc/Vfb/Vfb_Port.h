@@ -40,7 +40,8 @@
 #if !defined(VFB_PORT_H)
 #define VFB_PORT_H
 
-#include "hal.h"
+#include <stdint.h>
+#include "Vfb_Backend.h"
 
 /**@brief Defines the LOW logic level.
  */
@@ -50,6 +51,38 @@
  */
 #define STD_HIGH	(1u)
 
+#if (VFB_BACKEND == VFB_BACKEND_HAL)
+
+#include "hal.h"
+
+/**@brief Defines the virtual function bus type of a port identifier.
+ */
+typedef ioportid_t Vfb_PortIdType;
+
+/**@brief Defines the virtual function bus type of a port mask.
+ */
+typedef ioportmask_t Vfb_PortMaskType;
+
+/**@brief Defines the virtual function bus type of a pin identifier.
+ */
+typedef ioline_t Vfb_LineType;
+
+/**@brief Defines the virtual function bus type of a pin function.
+ */
+typedef iomode_t Vfb_PortModeType;
+
+/**@brief Defines the pin function of a push pull output.
+ */
+#define VFB_PORT_MODE_OUTPUT						(PAL_MODE_OUTPUT_PUSHPULL)
+
+/**@brief Defines the pin function of an input with pull up.
+ */
+#define VFB_PORT_MODE_INPUT_PULLUP					(PAL_MODE_INPUT_PULLUP)
+
+/**@brief Defines the pin function of an input with pull down.
+ */
+#define VFB_PORT_MODE_INPUT_PULLDOWN				(PAL_MODE_INPUT_PULLDOWN)
+
 /**@brief Defines the virtual function bus macro used to set the mode of a HW pin.
  * @param[in]	line	Pin identifier
  * @param[in]	mode	Pin function
@@ -68,5 +101,117 @@
  */
 #define Vfb_Read_Port_Line_Value(line)				palReadLine(line)
 
+/**@brief Defines the virtual function bus macro used to get the logic values of all of the pins of a port.
+ * @param[in]	port	Port identifier
+ * @return Input data register of the port, read with a single access.
+ */
+#define Vfb_Read_Port_Value(port)					palReadPort(port)
+
+/**@brief Defines the virtual function bus macro used to get the port to which a HW pin belongs.
+ * @param[in]	line	Pin identifier
+ * @return Port identifier of the requested pin.
+ */
+#define Vfb_Get_Port_Line_Port(line)				PAL_PORT(line)
+
+/**@brief Defines the virtual function bus macro used to get the port mask of a HW pin.
+ * @param[in]	line	Pin identifier
+ * @return Port mask with only the bit of the requested pin set.
+ */
+#define Vfb_Get_Port_Line_Mask(line)				PAL_PORT_BIT(PAL_PAD(line))
+
+/**@brief Defines the virtual function bus macro used to set the logic value of a group of HW pins on one port.
+ * @details The write is done through a single atomic access of the set/reset register.
+ * @param[in]	port	Port identifier
+ * @param[in]	mask	Mask of the pins to be written
+ * @param[in]	value	Logic values of the masked pins
+ */
+#define Vfb_Write_Port_Group_Value(port, mask, value)	palWriteGroup(port, mask, 0u, value)
+
+/**@brief Defines the virtual function bus macro used to get the index of the port of a HW pin (GPIOA is 0).
+ * @param[in]	line	Pin identifier
+ * @return Port index, used to route the pin to its EXTI line.
+ */
+#define Vfb_Get_Port_Line_Index(line)				((uint32_t)(((uintptr_t)PAL_PORT(line) - (uintptr_t)GPIOA) / ((uintptr_t)GPIOB - (uintptr_t)GPIOA)))
+
+/**@brief Defines the virtual function bus macro used to enable the edge interrupt of a HW pin.
+ * @details The pin must be registered with Vfb_Port_EnableLineEvent(), I-class.
+ * @param[in]	line	Pin identifier
+ */
+#define Vfb_Enable_Port_Line_Event_I(line)			extChannelEnableI(&EXTD1, PAL_PAD(line))
+
+/**@brief Defines the virtual function bus macro used to disable the edge interrupt of a HW pin.
+ * @details Edges on the pin are ignored until it is enabled again, I-class.
+ * @param[in]	line	Pin identifier
+ */
+#define Vfb_Disable_Port_Line_Event_I(line)			extChannelDisableI(&EXTD1, PAL_PAD(line))
+
+#elif (VFB_BACKEND == VFB_BACKEND_LINUX) || (VFB_BACKEND == VFB_BACKEND_MOCK)
+
+#include "board.h"
+
+typedef uint32_t Vfb_PortIdType;
+typedef uint32_t Vfb_PortMaskType;
+typedef uint32_t Vfb_LineType;
+typedef uint32_t Vfb_PortModeType;
+
+/**@brief Defines the simulated ports, the pin identifiers of board.h are built on them.
+ */
+#define GPIOA										(0u)
+#define GPIOB										(1u)
+#define GPIOC										(2u)
+#define VFB_PORT_NUMBER								(3u)
+#define PAL_LINE(port, pad)							((Vfb_LineType)(((uint32_t)(port) << 4u) | (uint32_t)(pad)))
+
+#define VFB_PORT_MODE_OUTPUT						(1u)
+#define VFB_PORT_MODE_INPUT_PULLUP					(2u)
+#define VFB_PORT_MODE_INPUT_PULLDOWN				(3u)
+
+/**@struct Vfb_PortSimType
+ * @brief Specifies a simulated port, inputs are driven by the host test through the input register.
+ */
+typedef struct Vfb_PortSimTypeTag
+{
+	Vfb_PortMaskType odr;					/**< Output register. */
+	Vfb_PortMaskType idr;					/**< Input register (pin levels). */
+	Vfb_PortModeType mode[16u];				/**< Pin functions. */
+} Vfb_PortSimType;
+
+extern Vfb_PortSimType Vfb_Port_Sim[VFB_PORT_NUMBER];
+
+#define Vfb_Get_Port_Line_Port(line)				((Vfb_PortIdType)((line) >> 4u))
+#define Vfb_Get_Port_Line_Mask(line)				((Vfb_PortMaskType)(1u << ((line) & 0xFu)))
+#define Vfb_Write_Port_Line_Value(line, value) \
+	Vfb_Write_Port_Group_Value(Vfb_Get_Port_Line_Port(line), Vfb_Get_Port_Line_Mask(line), ((value) != 0u) ? Vfb_Get_Port_Line_Mask(line) : 0u)
+#define Vfb_Read_Port_Line_Value(line) \
+	(((Vfb_Read_Port_Value(Vfb_Get_Port_Line_Port(line)) & Vfb_Get_Port_Line_Mask(line)) != 0u) ? STD_HIGH : STD_LOW)
+
+extern void Vfb_Write_Port_Line_Mode(const Vfb_LineType line, const Vfb_PortModeType mode);
+extern void Vfb_Write_Port_Group_Value(const Vfb_PortIdType port, const Vfb_PortMaskType mask, const Vfb_PortMaskType value);
+extern Vfb_PortMaskType Vfb_Read_Port_Value(const Vfb_PortIdType port);
+extern void Vfb_Port_SimSetInput(const Vfb_LineType line, const uint8_t value);
+extern void Vfb_Enable_Port_Line_Event_I(const Vfb_LineType line);
+extern void Vfb_Disable_Port_Line_Event_I(const Vfb_LineType line);
+
+#else
+#error "Vfb: unknown backend"
+#endif
+
+/**@struct Vfb_PortBatchType
+ * @brief Container used to collect the pin changes of one port before they are committed.
+ */
+typedef struct Vfb_PortBatchTypeTag
+{
+	Vfb_PortIdType port;		/**< Port to which the collected pins belong. */
+	Vfb_PortMaskType mask;		/**< Mask of the collected pins. */
+	Vfb_PortMaskType value;		/**< Logic values of the collected pins. */
+} Vfb_PortBatchType;
+
+/**@brief Defines the callback of a pin edge interrupt, called from the ISR context.
+ */
+typedef void (*Vfb_PortEventCallbackType)(const Vfb_LineType line);
+
+extern uint32_t Vfb_Port_BatchAdd(Vfb_PortBatchType *batch, const uint32_t size, const Vfb_LineType line, const uint8_t value);
+extern void Vfb_Port_BatchCommit(const Vfb_PortBatchType *batch, const uint32_t size);
+extern void Vfb_Port_EnableLineEvent(const Vfb_LineType line, const Vfb_PortEventCallbackType callback);
 
 #endif /* VFB_PORT_H */
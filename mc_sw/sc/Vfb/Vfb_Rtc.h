@@ -0,0 +1,116 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Vfb_Rtc.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Vfb_Rtc.h
+* @brief Implements the virtual function bus interface of the real time clock.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#if !defined(VFB_RTC_H)
+#define VFB_RTC_H
+
+#include <stdint.h>
+#include "Vfb_Backend.h"
+
+#if (VFB_BACKEND == VFB_BACKEND_HAL)
+
+#include "hal.h"
+
+/**@brief Defines the virtual function bus type of a RTC driver.
+ */
+typedef RTCDriver Vfb_RtcDriverType;
+
+/**@brief Defines the virtual function bus type of a calendar date and time.
+ */
+typedef RTCDateTime Vfb_RtcDateTimeType;
+
+/**@brief Defines the virtual function bus RTC drivers.
+ */
+#define VFB_RTC_RTC1								(&RTCD1)
+
+/**@brief Defines the year counted as 0 in Vfb_RtcDateTimeType.
+ */
+#define VFB_RTC_BASE_YEAR							(RTC_BASE_YEAR)
+
+/**@brief Defines the virtual function bus macro used to set the calendar.
+ * @details The calendar runs in the backup domain, it keeps counting through resets and, with a
+ * backup supply, through power loss. The milliseconds are truncated, the sub-second counter restarts.
+ * @param[in]	drv			RTC driver
+ * @param[in]	timespec	Date and time
+ */
+#define Vfb_Rtc_Set_Time(drv, timespec)				rtcSetTime(drv, timespec)
+
+/**@brief Defines the virtual function bus macro used to read the calendar.
+ * @param[in]	drv			RTC driver
+ * @param[out]	timespec	Date and time, with milliseconds
+ */
+#define Vfb_Rtc_Get_Time(drv, timespec)				rtcGetTime(drv, timespec)
+
+#elif (VFB_BACKEND == VFB_BACKEND_LINUX) || (VFB_BACKEND == VFB_BACKEND_MOCK)
+
+/**@struct Vfb_RtcDateTimeType
+ * @brief Specifies a simulated calendar date and time, laid out like the HAL one.
+ */
+typedef struct Vfb_RtcDateTimeTypeTag
+{
+	uint32_t year: 8;						/**< Years since VFB_RTC_BASE_YEAR. */
+	uint32_t month: 4;						/**< Month, 1 to 12. */
+	uint32_t dstflag: 1;					/**< Daylight saving time flag (unused). */
+	uint32_t dayofweek: 3;					/**< Day of week, 1 (Monday) to 7. */
+	uint32_t day: 5;						/**< Day of month, 1 to 31. */
+	uint32_t millisecond: 27;				/**< Milliseconds since midnight. */
+} Vfb_RtcDateTimeType;
+
+/**@struct Vfb_RtcDriverType
+ * @brief Specifies a simulated RTC driver, the calendar holds the last set value.
+ */
+typedef struct Vfb_RtcDriverTypeTag
+{
+	uint32_t id;							/**< Driver index in the traces. */
+	Vfb_RtcDateTimeType time;				/**< Calendar. */
+} Vfb_RtcDriverType;
+
+extern Vfb_RtcDriverType Vfb_Rtc_Rtc1;
+
+#define VFB_RTC_RTC1								(&Vfb_Rtc_Rtc1)
+#define VFB_RTC_BASE_YEAR							(1980u)
+
+extern void Vfb_Rtc_Set_Time(Vfb_RtcDriverType *drv, const Vfb_RtcDateTimeType *timespec);
+extern void Vfb_Rtc_Get_Time(Vfb_RtcDriverType *drv, Vfb_RtcDateTimeType *timespec);
+
+#else
+#error "Vfb: unknown backend"
+#endif
+
+#endif /* VFB_RTC_H */
@@ -0,0 +1,510 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Vfb_Sim.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Vfb_Sim.c
+* @brief Implements the simulated ports and buses of the host backends.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include "Vfb_Backend.h"
+
+#if (VFB_BACKEND == VFB_BACKEND_LINUX) || (VFB_BACKEND == VFB_BACKEND_MOCK)
+
+#include <string.h>
+#include "Vfb.h"
+
+/**@brief Defines the size of the scripted device answer buffer.
+ */
+#define VFB_SIM_RESPONSE_SIZE		(256u)
+
+/**@struct Vfb_SimDataType
+ * @brief Specifies the scripted device answers of the simulated buses.
+ */
+typedef struct Vfb_SimDataTypeTag
+{
+	uint8_t response[VFB_SIM_RESPONSE_SIZE];								/**< Bytes returned by the next reads. */
+	uint32_t responseLength;												/**< Number of scripted bytes. */
+	uint32_t responsePosition;												/**< Number of scripted bytes already returned. */
+	uint8_t isI2cAck;														/**< The I2C devices acknowledge the exchanges. */
+	uint8_t isI2cStuck;														/**< The I2C exchanges time out (bus held low). */
+	Vfb_PortMaskType eventMask[VFB_PORT_NUMBER];							/**< Pins with an enabled edge interrupt. */
+	Vfb_PortEventCallbackType eventCallback[VFB_PORT_NUMBER][16u];			/**< Edge interrupt callback of each pin. */
+} Vfb_SimDataType;
+
+static void readResponse(uint8_t *data, const uint32_t length);
+
+/**@brief Simulated ports.
+ */
+Vfb_PortSimType Vfb_Port_Sim[VFB_PORT_NUMBER];
+
+/**@brief Simulated I2C drivers.
+ */
+Vfb_I2cDriverType Vfb_I2c_I2c3 = {.id = 3u, .config = NULL};
+
+/**@brief Simulated SPI drivers.
+ */
+Vfb_SpiDriverType Vfb_Spi_Spi1 = {.id = 1u, .config = NULL};
+
+/**@brief Simulated ADC drivers and trigger timers.
+ */
+Vfb_AdcDriverType Vfb_Adc_Adc1 = {.id = 1u, .config = NULL, .group = NULL};
+Vfb_AdcTimerType Vfb_Adc_Tim6 = {.id = 6u, .interval = 0u};
+
+/**@brief Simulated RTC drivers.
+ */
+Vfb_RtcDriverType Vfb_Rtc_Rtc1 = {.id = 1u};
+
+/**@brief Stores the scripted device answers.
+ */
+static Vfb_SimDataType Vfb_Sim_Data;
+
+/**@brief Used to set the pin function of a simulated pin.
+ * @param[in]	line	Pin identifier.
+ * @param[in]	mode	Pin function.
+ */
+void Vfb_Write_Port_Line_Mode(const Vfb_LineType line, const Vfb_PortModeType mode)
+{
+	const Vfb_PortIdType port = Vfb_Get_Port_Line_Port(line);
+
+	if (port < VFB_PORT_NUMBER)
+	{
+		Vfb_Port_Sim[port].mode[line & 0xFu] = mode;
+		if (mode == VFB_PORT_MODE_INPUT_PULLUP)
+		{
+			Vfb_Port_Sim[port].idr |= Vfb_Get_Port_Line_Mask(line);
+		}
+		else if (mode == VFB_PORT_MODE_INPUT_PULLDOWN)
+		{
+			Vfb_Port_Sim[port].idr &= ~Vfb_Get_Port_Line_Mask(line);
+		}
+	}
+	VFB_SIM_RECORD(VFB_MOCK_EVENT_PORT_MODE, line, mode, 0u);
+}
+
+/**@brief Used to write a group of simulated pins on one port.
+ * @details The pin levels follow the written values, as read back through the input register.
+ * @param[in]	port	Port identifier.
+ * @param[in]	mask	Mask of the pins to be written.
+ * @param[in]	value	Logic values of the masked pins.
+ */
+void Vfb_Write_Port_Group_Value(const Vfb_PortIdType port, const Vfb_PortMaskType mask, const Vfb_PortMaskType value)
+{
+	if (port < VFB_PORT_NUMBER)
+	{
+		Vfb_Port_Sim[port].odr = (Vfb_Port_Sim[port].odr & ~mask) | (value & mask);
+		Vfb_Port_Sim[port].idr = (Vfb_Port_Sim[port].idr & ~mask) | (value & mask);
+	}
+	VFB_SIM_RECORD(VFB_MOCK_EVENT_PORT_WRITE, port, mask, value & mask);
+}
+
+/**@brief Used to read the input register of a simulated port.
+ * @param[in]	port	Port identifier.
+ * @return	Pin levels of the port.
+ */
+Vfb_PortMaskType Vfb_Read_Port_Value(const Vfb_PortIdType port)
+{
+	Vfb_PortMaskType retVal = 0u;
+
+	if (port < VFB_PORT_NUMBER)
+	{
+		retVal = Vfb_Port_Sim[port].idr;
+	}
+	VFB_SIM_RECORD(VFB_MOCK_EVENT_PORT_READ, port, retVal, 0u);
+
+	return retVal;
+}
+
+/**@brief Used by the host test to drive the level of a simulated input pin.
+ * @details A level change raises the edge interrupt of the pin if it is enabled, so the
+ * function must be called from the simulated interrupt context.
+ * @param[in]	line	Pin identifier.
+ * @param[in]	value	STD_HIGH or STD_LOW.
+ */
+void Vfb_Port_SimSetInput(const Vfb_LineType line, const uint8_t value)
+{
+	const Vfb_PortIdType port = Vfb_Get_Port_Line_Port(line);
+	const Vfb_PortMaskType mask = Vfb_Get_Port_Line_Mask(line);
+	Vfb_PortMaskType idr = 0u;
+
+	if (port < VFB_PORT_NUMBER)
+	{
+		idr = Vfb_Port_Sim[port].idr;
+		if (value != STD_LOW)
+		{
+			Vfb_Port_Sim[port].idr |= mask;
+		}
+		else
+		{
+			Vfb_Port_Sim[port].idr &= ~mask;
+		}
+
+		if (((idr ^ Vfb_Port_Sim[port].idr) & Vfb_Sim_Data.eventMask[port]) != 0u)
+		{
+			Vfb_Sim_Data.eventCallback[port][line & 0xFu](line);
+		}
+	}
+}
+
+/**@brief Used to enable the interrupt on both edges of a simulated pin.
+ * @param[in]	line		Pin identifier.
+ * @param[in]	callback	Called from Vfb_Port_SimSetInput() on each edge.
+ */
+void Vfb_Port_EnableLineEvent(const Vfb_LineType line, const Vfb_PortEventCallbackType callback)
+{
+	const Vfb_PortIdType port = Vfb_Get_Port_Line_Port(line);
+
+	if (port < VFB_PORT_NUMBER)
+	{
+		Vfb_Sim_Data.eventCallback[port][line & 0xFu] = callback;
+		Vfb_Enable_Port_Line_Event_I(line);
+	}
+}
+
+/**@brief Used to enable the edge interrupt of a registered simulated pin.
+ * @param[in]	line	Pin identifier.
+ */
+void Vfb_Enable_Port_Line_Event_I(const Vfb_LineType line)
+{
+	const Vfb_PortIdType port = Vfb_Get_Port_Line_Port(line);
+
+	if ((port < VFB_PORT_NUMBER) && (Vfb_Sim_Data.eventCallback[port][line & 0xFu] != NULL))
+	{
+		Vfb_Sim_Data.eventMask[port] |= Vfb_Get_Port_Line_Mask(line);
+	}
+}
+
+/**@brief Used to disable the edge interrupt of a simulated pin.
+ * @param[in]	line	Pin identifier.
+ */
+void Vfb_Disable_Port_Line_Event_I(const Vfb_LineType line)
+{
+	const Vfb_PortIdType port = Vfb_Get_Port_Line_Port(line);
+
+	if (port < VFB_PORT_NUMBER)
+	{
+		Vfb_Sim_Data.eventMask[port] &= ~Vfb_Get_Port_Line_Mask(line);
+	}
+}
+
+/**@brief Used by the host test to script the bytes returned by the next bus reads.
+ * @details Reads past the scripted bytes return 0xFF (floating bus).
+ * @param[in]	data	Scripted bytes.
+ * @param[in]	length	Number of scripted bytes, limited to the answer buffer size.
+ */
+void Vfb_Sim_SetResponse(const uint8_t *data, const uint32_t length)
+{
+	Vfb_Sim_Data.responseLength = (length < VFB_SIM_RESPONSE_SIZE) ? length : VFB_SIM_RESPONSE_SIZE;
+	Vfb_Sim_Data.responsePosition = 0u;
+	(void)memcpy(Vfb_Sim_Data.response, data, Vfb_Sim_Data.responseLength);
+}
+
+/**@brief Used by the host test to select if the simulated I2C devices acknowledge the exchanges.
+ * @param[in]	isAck	TRUE to acknowledge, FALSE (default) to answer with a NACK.
+ */
+void Vfb_Sim_SetI2cAck(const uint8_t isAck)
+{
+	Vfb_Sim_Data.isI2cAck = isAck;
+}
+
+/**@brief Used by the host test to let the simulated I2C exchanges time out, as with a device holding the bus.
+ * @param[in]	isStuck	TRUE to time out, FALSE (default) to answer.
+ */
+void Vfb_Sim_SetI2cStuck(const uint8_t isStuck)
+{
+	Vfb_Sim_Data.isI2cStuck = isStuck;
+}
+
+/**@brief Used to start a simulated I2C driver.
+ * @param[in]	drv		I2C driver.
+ * @param[in]	cfg		I2C driver configuration.
+ */
+void Vfb_I2c_Start(Vfb_I2cDriverType *drv, const Vfb_I2cConfigType *cfg)
+{
+	drv->config = cfg;
+	VFB_SIM_RECORD(VFB_MOCK_EVENT_I2C_START, drv->id, 0u, 0u);
+}
+
+/**@brief Used to stop a simulated I2C driver.
+ * @param[in]	drv		I2C driver.
+ */
+void Vfb_I2c_Stop(Vfb_I2cDriverType *drv)
+{
+	drv->config = NULL;
+	VFB_SIM_RECORD(VFB_MOCK_EVENT_I2C_STOP, drv->id, 0u, 0u);
+}
+
+/**@brief Used to do a write/read exchange on a simulated I2C driver.
+ * @param[in]	drv		I2C driver.
+ * @param[in]	addr	7 bit device address.
+ * @param[in]	tx		Data to write.
+ * @param[in]	txLen	Number of bytes to write.
+ * @param[out]	rx		Buffer for the read data (scripted answer).
+ * @param[in]	rxLen	Number of bytes to read.
+ * @return	VFB_I2C_RESULT_OK if the simulated devices acknowledge, VFB_I2C_RESULT_TIMEOUT if the bus is
+ * stuck, VFB_I2C_RESULT_ERROR otherwise.
+ */
+Vfb_I2cResultType Vfb_I2c_Exchange(Vfb_I2cDriverType *drv, const uint8_t addr, const uint8_t *tx, const uint32_t txLen, uint8_t *rx, const uint32_t rxLen)
+{
+	Vfb_I2cResultType retVal = VFB_I2C_RESULT_ERROR;
+
+	(void)tx;
+	VFB_SIM_RECORD(VFB_MOCK_EVENT_I2C_EXCHANGE, drv->id, addr, (txLen << 16u) | rxLen);
+	if (Vfb_Sim_Data.isI2cStuck)
+	{
+		retVal = VFB_I2C_RESULT_TIMEOUT;
+	}
+	else
+	{
+		readResponse(rx, rxLen);
+		retVal = (Vfb_Sim_Data.isI2cAck) ? VFB_I2C_RESULT_OK : VFB_I2C_RESULT_ERROR;
+	}
+
+	return retVal;
+}
+
+/**@brief Used to start (or reconfigure) a simulated SPI driver.
+ * @param[in]	drv		SPI driver.
+ * @param[in]	cfg		SPI driver configuration.
+ */
+void Vfb_Spi_Start(Vfb_SpiDriverType *drv, const Vfb_SpiConfigType *cfg)
+{
+	drv->config = cfg;
+	VFB_SIM_RECORD(VFB_MOCK_EVENT_SPI_START, drv->id, cfg->cr1, 0u);
+}
+
+/**@brief Used to stop a simulated SPI driver.
+ * @param[in]	drv		SPI driver.
+ */
+void Vfb_Spi_Stop(Vfb_SpiDriverType *drv)
+{
+	drv->config = NULL;
+	VFB_SIM_RECORD(VFB_MOCK_EVENT_SPI_STOP, drv->id, 0u, 0u);
+}
+
+/**@brief Used to assert the chip select of the configured device of a simulated SPI driver.
+ * @param[in]	drv		SPI driver.
+ */
+void Vfb_Spi_Select(Vfb_SpiDriverType *drv)
+{
+	drv->isSelected = TRUE;
+	VFB_SIM_RECORD(VFB_MOCK_EVENT_SPI_SELECT, drv->id, 0u, 0u);
+}
+
+/**@brief Used to release the chip select of the configured device of a simulated SPI driver.
+ * @param[in]	drv		SPI driver.
+ */
+void Vfb_Spi_Unselect(Vfb_SpiDriverType *drv)
+{
+	drv->isSelected = FALSE;
+	VFB_SIM_RECORD(VFB_MOCK_EVENT_SPI_UNSELECT, drv->id, 0u, 0u);
+}
+
+/**@brief Used to do a full duplex transfer on a simulated SPI driver.
+ * @param[in]	drv		SPI driver.
+ * @param[in]	n		Number of bytes.
+ * @param[in]	tx		Data to send.
+ * @param[out]	rx		Received data (scripted answer).
+ */
+void Vfb_Spi_Exchange(Vfb_SpiDriverType *drv, const uint32_t n, const void *tx, void *rx)
+{
+	readResponse((uint8_t *)rx, n);
+	VFB_SIM_RECORD(VFB_MOCK_EVENT_SPI_TRANSFER, drv->id, n, (n != 0u) ? ((const uint8_t *)tx)[0u] : 0xFFu);
+}
+
+/**@brief Used to do a send only transfer on a simulated SPI driver.
+ * @param[in]	drv		SPI driver.
+ * @param[in]	n		Number of bytes.
+ * @param[in]	tx		Data to send.
+ */
+void Vfb_Spi_Send(Vfb_SpiDriverType *drv, const uint32_t n, const void *tx)
+{
+	VFB_SIM_RECORD(VFB_MOCK_EVENT_SPI_TRANSFER, drv->id, n, (n != 0u) ? ((const uint8_t *)tx)[0u] : 0xFFu);
+}
+
+/**@brief Used to do a receive only transfer on a simulated SPI driver.
+ * @param[in]	drv		SPI driver.
+ * @param[in]	n		Number of bytes.
+ * @param[out]	rx		Received data (scripted answer).
+ */
+void Vfb_Spi_Receive(Vfb_SpiDriverType *drv, const uint32_t n, void *rx)
+{
+	readResponse((uint8_t *)rx, n);
+	VFB_SIM_RECORD(VFB_MOCK_EVENT_SPI_TRANSFER, drv->id, n, 0xFFu);
+}
+
+/**@brief Used to clock dummy bytes on a simulated SPI driver.
+ * @param[in]	drv		SPI driver.
+ * @param[in]	n		Number of bytes.
+ */
+void Vfb_Spi_Ignore(Vfb_SpiDriverType *drv, const uint32_t n)
+{
+	VFB_SIM_RECORD(VFB_MOCK_EVENT_SPI_TRANSFER, drv->id, n, 0xFFu);
+}
+
+/**@brief Used to start a simulated ADC driver.
+ * @param[in]	drv		ADC driver.
+ * @param[in]	cfg		ADC driver configuration.
+ */
+void Vfb_Adc_Start(Vfb_AdcDriverType *drv, const Vfb_AdcConfigType *cfg)
+{
+	drv->config = cfg;
+	VFB_SIM_RECORD(VFB_MOCK_EVENT_ADC_START, drv->id, 0u, 0u);
+}
+
+/**@brief Used to stop a simulated ADC driver.
+ * @param[in]	drv		ADC driver.
+ */
+void Vfb_Adc_Stop(Vfb_AdcDriverType *drv)
+{
+	drv->config = NULL;
+	drv->group = NULL;
+	VFB_SIM_RECORD(VFB_MOCK_EVENT_ADC_STOP, drv->id, 0u, 0u);
+}
+
+/**@brief Used to start the circular scans of a simulated ADC driver.
+ * @param[in]	drv		ADC driver.
+ * @param[in]	group	Scan.
+ * @param[out]	buffer	Circular sample buffer.
+ * @param[in]	depth	Number of scans in the buffer (even).
+ */
+void Vfb_Adc_Start_Conversion(Vfb_AdcDriverType *drv, const Vfb_AdcGroupType *group, Vfb_AdcSampleType *buffer, const uint32_t depth)
+{
+	drv->group = group;
+	drv->buffer = buffer;
+	drv->depth = depth;
+	drv->position = 0u;
+	VFB_SIM_RECORD(VFB_MOCK_EVENT_ADC_START, drv->id, depth, 0u);
+}
+
+/**@brief Used to stop the circular scans of a simulated ADC driver.
+ * @param[in]	drv		ADC driver.
+ */
+void Vfb_Adc_Stop_Conversion(Vfb_AdcDriverType *drv)
+{
+	drv->group = NULL;
+	VFB_SIM_RECORD(VFB_MOCK_EVENT_ADC_STOP, drv->id, 1u, 0u);
+}
+
+/**@brief Used to start a simulated trigger timer.
+ * @param[in]	tim			Timer.
+ * @param[in]	cfg			Timer configuration.
+ * @param[in]	interval	Trigger period in timer counts.
+ */
+void Vfb_Adc_Timer_Start(Vfb_AdcTimerType *tim, const Vfb_AdcTimerConfigType *cfg, const uint32_t interval)
+{
+	(void)cfg;
+	tim->interval = interval;
+	VFB_SIM_RECORD(VFB_MOCK_EVENT_ADC_TIMER, tim->id, interval, 0u);
+}
+
+/**@brief Used to stop a simulated trigger timer.
+ * @param[in]	tim			Timer.
+ */
+void Vfb_Adc_Timer_Stop(Vfb_AdcTimerType *tim)
+{
+	tim->interval = 0u;
+	VFB_SIM_RECORD(VFB_MOCK_EVENT_ADC_TIMER, tim->id, 0u, 0u);
+}
+
+/**@brief Used to set the calendar of a simulated RTC driver.
+ * @details The calendar does not run, the host test sets the value read back at boot.
+ * @param[in]	drv			RTC driver.
+ * @param[in]	timespec	Date and time.
+ */
+void Vfb_Rtc_Set_Time(Vfb_RtcDriverType *drv, const Vfb_RtcDateTimeType *timespec)
+{
+	drv->time = *timespec;
+	drv->time.millisecond = (timespec->millisecond / 1000u) * 1000u;
+	VFB_SIM_RECORD(VFB_MOCK_EVENT_RTC_SET, drv->id, ((uint32_t)timespec->year << 16u) | ((uint32_t)timespec->month << 8u) | timespec->day,
+				   drv->time.millisecond);
+}
+
+/**@brief Used to read the calendar of a simulated RTC driver.
+ * @param[in]	drv			RTC driver.
+ * @param[out]	timespec	Date and time.
+ */
+void Vfb_Rtc_Get_Time(Vfb_RtcDriverType *drv, Vfb_RtcDateTimeType *timespec)
+{
+	*timespec = drv->time;
+}
+
+/**@brief Used by the host test to deliver one scan to a simulated ADC driver, as the DMA would.
+ * @details The scan callback is called at half and full buffer, so the function must be called
+ * from the simulated interrupt context.
+ * @param[in]	drv		ADC driver.
+ * @param[in]	samples	One sample for each channel of the scan.
+ */
+void Vfb_Adc_SimScan(Vfb_AdcDriverType *drv, const Vfb_AdcSampleType *samples)
+{
+	const Vfb_AdcGroupType *group = drv->group;
+
+	if ((group != NULL) && (drv->depth >= 2u))
+	{
+		const uint32_t half = drv->depth / 2u;
+
+		(void)memcpy(&drv->buffer[drv->position * group->num_channels], samples, group->num_channels * sizeof(Vfb_AdcSampleType));
+		drv->position = (drv->position + 1u) % drv->depth;
+
+		if (((drv->position % half) == 0u) && (group->end_cb != NULL))
+		{
+			const uint32_t first = (drv->position == 0u) ? half : 0u;
+
+			group->end_cb(drv, &drv->buffer[first * group->num_channels], half);
+		}
+	}
+}
+
+/**@brief Used to copy the next scripted answer bytes, 0xFF past the end of the script.
+ * @param[out]	data	Destination, can be NULL if length is 0.
+ * @param[in]	length	Number of bytes.
+ */
+static void readResponse(uint8_t *data, const uint32_t length)
+{
+	uint32_t idx = 0u;
+
+	for (idx = 0u; idx < length; idx++)
+	{
+		if (Vfb_Sim_Data.responsePosition < Vfb_Sim_Data.responseLength)
+		{
+			data[idx] = Vfb_Sim_Data.response[Vfb_Sim_Data.responsePosition];
+			Vfb_Sim_Data.responsePosition++;
+		}
+		else
+		{
+			data[idx] = 0xFFu;
+		}
+	}
+}
+
+#endif /* VFB_BACKEND == VFB_BACKEND_LINUX || VFB_BACKEND == VFB_BACKEND_MOCK */
@@ -0,0 +1,64 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Vfb_Sim.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Vfb_Sim.h
+* @brief Implements the header of the simulated ports and buses of the host backends.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#if !defined(VFB_SIM_H)
+#define VFB_SIM_H
+
+#include <stdint.h>
+#include "Vfb_Backend.h"
+
+#if (VFB_BACKEND == VFB_BACKEND_MOCK)
+
+#include "Vfb_Mock.h"
+
+/**@brief Defines the macro used to record a simulated HW access in the mock trace.
+ */
+#define VFB_SIM_RECORD(event, id, arg0, arg1)		Vfb_Mock_Record(event, id, arg0, arg1)
+
+#else
+
+#define VFB_SIM_RECORD(event, id, arg0, arg1)		((void)(id), (void)(arg0), (void)(arg1))
+
+#endif
+
+extern void Vfb_Sim_SetResponse(const uint8_t *data, const uint32_t length);
+extern void Vfb_Sim_SetI2cAck(const uint8_t isAck);
+extern void Vfb_Sim_SetI2cStuck(const uint8_t isStuck);
+
+#endif /* VFB_SIM_H */
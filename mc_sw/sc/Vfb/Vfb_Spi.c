@@ -0,0 +1,268 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Vfb_Spi.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Vfb_Spi.c
+* @brief Implements the virtual function bus SPI transaction queue.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include "Vfb.h"
+#include "Os.h"
+
+/**@struct Vfb_SpiDataType
+ * @brief Specifies the runtime data of the SPI transaction queue.
+ */
+typedef struct Vfb_SpiDataTypeTag
+{
+	Vfb_SpiTransactionType *head;					/**< Queued transactions, in execution order. */
+	Vfb_SpiDeviceType device;						/**< Device for which the driver is configured. */
+	Vfb_SpiStatsType stats[VFB_SPI_DEVICE_UNKNOWN];	/**< Bus usage accounting of each device. */
+} Vfb_SpiDataType;
+
+static void executeTransaction(Vfb_SpiTransactionType *transaction);
+
+/**@brief Stores the runtime data of the SPI transaction queue.
+ */
+static Vfb_SpiDataType Vfb_Spi_Data;
+
+/**@brief Initialization function of the SPI transaction queue.
+ */
+void Vfb_Spi_Init(void)
+{
+	uint32_t device = 0u;
+
+#if (VFB_BACKEND == VFB_BACKEND_HAL)
+	Vfb_Write_Port_Line_Mode(VFB_SPI_SCK_LINE, VFB_SPI_PIN_MODE);
+	Vfb_Write_Port_Line_Mode(VFB_SPI_MISO_LINE, VFB_SPI_PIN_MODE);
+	Vfb_Write_Port_Line_Mode(VFB_SPI_MOSI_LINE, VFB_SPI_PIN_MODE);
+	for (device = 0u; device < (uint32_t)VFB_SPI_DEVICE_UNKNOWN; device++)
+	{
+		const Vfb_LineType csLine = PAL_LINE(Vfb_Spi_DeviceConfig[device].ssport, Vfb_Spi_DeviceConfig[device].sspad);
+
+		Vfb_Write_Port_Line_Value(csLine, STD_HIGH);
+		Vfb_Write_Port_Line_Mode(csLine, VFB_SPI_CS_MODE);
+	}
+#endif
+	Vfb_Spi_Data.head = NULL;
+	for (device = 0u; device < (uint32_t)VFB_SPI_DEVICE_UNKNOWN; device++)
+	{
+		Vfb_Spi_Data.stats[device].busTime = 0u;
+		Vfb_Spi_Data.stats[device].transactions = 0u;
+		Vfb_Spi_Data.stats[device].bytes = 0u;
+	}
+	Vfb_Spi_Data.device = VFB_SPI_DEVICE_IMU;
+	Vfb_Spi_Start(VFB_SPI_BUS, &Vfb_Spi_DeviceConfig[VFB_SPI_DEVICE_IMU]);
+}
+
+/**@brief Deinitialization function of the SPI transaction queue.
+ * @details Transactions still queued are dropped without notification.
+ */
+void Vfb_Spi_Deinit(void)
+{
+	chSysLock();
+	Vfb_Spi_Data.head = NULL;
+	chSysUnlock();
+	Vfb_Spi_Stop(VFB_SPI_BUS);
+}
+
+/**@brief Used to queue a SPI transaction without waiting for it.
+ * @details The transaction is inserted by its deadline and priority and executed by the SPI task.
+ * The completion callback is called afterwards. The transaction must stay valid until then.
+ * @param[in,out]	transaction		Transaction to queue.
+ * @return	TRUE if the transaction was queued, FALSE if it is invalid or still busy.
+ */
+uint8_t Vfb_Spi_Submit(Vfb_SpiTransactionType *transaction)
+{
+	uint8_t retVal = FALSE;
+
+	if ((transaction->device < VFB_SPI_DEVICE_UNKNOWN) && (transaction->commandLength <= VFB_SPI_COMMAND_SIZE)
+	&& ((transaction->commandLength != 0u) || (transaction->length != 0u)))
+	{
+		chSysLock();
+		if (transaction->state != VFB_SPI_STATE_BUSY)
+		{
+			Vfb_SpiTransactionType **link = &Vfb_Spi_Data.head;
+
+			while ((*link != NULL) && (Vfb_Is_Scheduled_Before(transaction, *link) == FALSE))
+			{
+				link = &(*link)->next;
+			}
+			transaction->state = VFB_SPI_STATE_BUSY;
+			transaction->next = *link;
+			*link = transaction;
+			retVal = TRUE;
+		}
+		chSysUnlock();
+	}
+
+	if (retVal != FALSE)
+	{
+		Os_SetEvent(OS_TASK_ID_SPI, OS_EVENT_SPI);
+	}
+
+	return retVal;
+}
+
+/**@brief Main function of the SPI transaction queue, executes all of the queued transactions.
+ * @details Runs in the SPI task when activated by Vfb_Spi_Submit().
+ */
+void Vfb_Spi_MainFunction(void)
+{
+	Vfb_SpiTransactionType *transaction = NULL;
+
+	do
+	{
+		chSysLock();
+		transaction = Vfb_Spi_Data.head;
+		if (transaction != NULL)
+		{
+			Vfb_Spi_Data.head = transaction->next;
+		}
+		chSysUnlock();
+
+		if (transaction != NULL)
+		{
+			executeTransaction(transaction);
+		}
+	} while (transaction != NULL);
+}
+
+/**@brief Used to get the last completed burst and start reading the next one into the other buffer.
+ * @details Called once per processing cycle (e.g. every 20 ms with the FIFO level as length).
+ * If the previous burst is still running nothing is started and no data is returned.
+ * @param[in,out]	burst	Burst reader.
+ * @param[in]		length	Number of bytes of the next burst, limited to the buffer size, 0 to only collect.
+ * @param[out]		data	Data of the completed burst, valid until the next call.
+ * @return	Number of bytes of the completed burst, 0 if there is none.
+ */
+uint32_t Vfb_Spi_BurstRead(Vfb_SpiBurstType *burst, const uint32_t length, const uint8_t **data)
+{
+	Vfb_SpiTransactionType *transaction = &burst->transaction;
+	uint32_t retVal = 0u;
+
+	if (transaction->state != VFB_SPI_STATE_BUSY)
+	{
+		if (transaction->state == VFB_SPI_STATE_DONE)
+		{
+			*data = burst->buffer[burst->filling];
+			burst->timestamp = transaction->timestamp;
+			retVal = transaction->length;
+			transaction->state = VFB_SPI_STATE_IDLE;
+			burst->filling ^= 1u;
+		}
+
+		if (length != 0u)
+		{
+			transaction->txData = NULL;
+			transaction->rxData = burst->buffer[burst->filling];
+			transaction->length = (uint16_t)((length < burst->size) ? length : burst->size);
+			transaction->deadline = (uint32_t)chVTGetSystemTimeX() + burst->deadlineTime;
+			(void)Vfb_Spi_Submit(transaction);
+		}
+	}
+
+	return retVal;
+}
+
+/**@brief Used to get the bus usage accounting of a device.
+ * @param[in]	device	Device on the SPI bus.
+ * @return	Bus usage accounting, NULL if the device is not configured.
+ */
+const Vfb_SpiStatsType *Vfb_Spi_GetStats(const Vfb_SpiDeviceType device)
+{
+	const Vfb_SpiStatsType *retVal = NULL;
+
+	if (device < VFB_SPI_DEVICE_UNKNOWN)
+	{
+		retVal = &Vfb_Spi_Data.stats[device];
+	}
+
+	return retVal;
+}
+
+/**@brief Used to execute one transaction and notify its owner.
+ * @details The driver is reconfigured only if the device changed since the previous transaction.
+ * @param[in,out]	transaction		Transaction to execute.
+ */
+static void executeTransaction(Vfb_SpiTransactionType *transaction)
+{
+	Vfb_SpiStatsType *stats = &Vfb_Spi_Data.stats[transaction->device];
+
+	if (Vfb_Spi_Data.device != transaction->device)
+	{
+		Vfb_Spi_Data.device = transaction->device;
+		Vfb_Spi_Start(VFB_SPI_BUS, &Vfb_Spi_DeviceConfig[transaction->device]);
+	}
+
+	Vfb_Spi_Select(VFB_SPI_BUS);
+	transaction->timestamp = chSysGetRealtimeCounterX();
+
+	if (transaction->commandLength != 0u)
+	{
+		Vfb_Spi_Send(VFB_SPI_BUS, transaction->commandLength, transaction->command);
+	}
+
+	if (transaction->length != 0u)
+	{
+		if ((transaction->txData != NULL) && (transaction->rxData != NULL))
+		{
+			Vfb_Spi_Exchange(VFB_SPI_BUS, transaction->length, transaction->txData, transaction->rxData);
+		}
+		else if (transaction->rxData != NULL)
+		{
+			Vfb_Spi_Receive(VFB_SPI_BUS, transaction->length, transaction->rxData);
+		}
+		else if (transaction->txData != NULL)
+		{
+			Vfb_Spi_Send(VFB_SPI_BUS, transaction->length, transaction->txData);
+		}
+		else
+		{
+			/* Clock only, nothing to send or keep. */
+			Vfb_Spi_Ignore(VFB_SPI_BUS, transaction->length);
+		}
+	}
+
+	Vfb_Spi_Unselect(VFB_SPI_BUS);
+
+	stats->busTime += (uint32_t)(chSysGetRealtimeCounterX() - transaction->timestamp);
+	stats->transactions++;
+	stats->bytes += (uint32_t)transaction->commandLength + transaction->length;
+
+	transaction->state = VFB_SPI_STATE_DONE;
+	if (transaction->notify != NULL)
+	{
+		transaction->notify(transaction);
+	}
+}
@@ -40,4 +40,213 @@
 #if !defined(VFB_SPI_H)
 #define VFB_SPI_H
 
+#include <stdint.h>
+#include "Vfb_Backend.h"
+#include "Vfb_Cfg.h"
+
+#if (VFB_BACKEND == VFB_BACKEND_HAL)
+
+#include "hal.h"
+
+/**@brief Defines the virtual function bus type of a SPI driver.
+ */
+typedef SPIDriver Vfb_SpiDriverType;
+
+/**@brief Defines the virtual function bus type of a SPI driver configuration.
+ */
+typedef SPIConfig Vfb_SpiConfigType;
+
+/**@brief Defines the virtual function bus SPI drivers.
+ */
+#define VFB_SPI_SPI1								(&SPID1)
+
+/**@brief Defines the pin function of the SPI1 clock and data lines.
+ */
+#define VFB_SPI_PIN_MODE							(PAL_MODE_ALTERNATE(5u) | PAL_STM32_OSPEED_HIGHEST)
+
+/**@brief Defines the pin function of a chip select line.
+ */
+#define VFB_SPI_CS_MODE								(PAL_MODE_OUTPUT_PUSHPULL | PAL_STM32_OSPEED_HIGHEST)
+
+/**@brief Defines the virtual function bus initializer of a SPI driver configuration (8 bit frames, MSB first).
+ * @param[in]	csLine		Chip select line
+ * @param[in]	prescaler	Clock prescaler exponent, the bus clock is the peripheral clock divided by 2^(prescaler + 1)
+ * @param[in]	mode		SPI mode (CPOL << 1 | CPHA)
+ */
+#define VFB_SPI_CONFIG(csLine, prescaler, mode) \
+	{ \
+		.end_cb = NULL, \
+		.ssport = PAL_PORT(csLine), \
+		.sspad = PAL_PAD(csLine), \
+		.cr1 = (uint16_t)(((prescaler) << 3u) | (mode)), \
+		.cr2 = SPI_CR2_DS_2 | SPI_CR2_DS_1 | SPI_CR2_DS_0 \
+	}
+
+/**@brief Defines the virtual function bus macro used to start (or reconfigure) a SPI driver.
+ * @param[in]	drv		SPI driver
+ * @param[in]	cfg		SPI driver configuration
+ */
+#define Vfb_Spi_Start(drv, cfg)						spiStart(drv, cfg)
+
+/**@brief Defines the virtual function bus macro used to stop a SPI driver.
+ * @param[in]	drv		SPI driver
+ */
+#define Vfb_Spi_Stop(drv)							spiStop(drv)
+
+/**@brief Defines the virtual function bus macro used to assert the chip select of the configured device.
+ * @param[in]	drv		SPI driver
+ */
+#define Vfb_Spi_Select(drv)							spiSelect(drv)
+
+/**@brief Defines the virtual function bus macro used to release the chip select of the configured device.
+ * @param[in]	drv		SPI driver
+ */
+#define Vfb_Spi_Unselect(drv)						spiUnselect(drv)
+
+/**@brief Defines the virtual function bus macro used to do a full duplex DMA transfer.
+ * @details The calling thread sleeps until the DMA transfer ends, the CPU is free meanwhile.
+ * @param[in]	drv		SPI driver
+ * @param[in]	n		Number of bytes
+ * @param[in]	tx		Data to send
+ * @param[out]	rx		Received data
+ */
+#define Vfb_Spi_Exchange(drv, n, tx, rx)			spiExchange(drv, n, tx, rx)
+
+/**@brief Defines the virtual function bus macro used to do a send only DMA transfer.
+ * @param[in]	drv		SPI driver
+ * @param[in]	n		Number of bytes
+ * @param[in]	tx		Data to send
+ */
+#define Vfb_Spi_Send(drv, n, tx)					spiSend(drv, n, tx)
+
+/**@brief Defines the virtual function bus macro used to do a receive only DMA transfer (dummy bytes are sent).
+ * @param[in]	drv		SPI driver
+ * @param[in]	n		Number of bytes
+ * @param[out]	rx		Received data
+ */
+#define Vfb_Spi_Receive(drv, n, rx)					spiReceive(drv, n, rx)
+
+/**@brief Defines the virtual function bus macro used to clock dummy bytes without keeping the received data.
+ * @param[in]	drv		SPI driver
+ * @param[in]	n		Number of bytes
+ */
+#define Vfb_Spi_Ignore(drv, n)						spiIgnore(drv, n)
+
+#elif (VFB_BACKEND == VFB_BACKEND_LINUX) || (VFB_BACKEND == VFB_BACKEND_MOCK)
+
+#include <stddef.h>
+#include "ch.h"
+
+/**@struct Vfb_SpiConfigType
+ * @brief Specifies the configuration of a simulated SPI driver.
+ */
+typedef struct Vfb_SpiConfigTypeTag
+{
+	uint32_t csLine;						/**< Chip select line (unused). */
+	uint16_t cr1;							/**< Control register value (unused). */
+} Vfb_SpiConfigType;
+
+/**@struct Vfb_SpiDriverType
+ * @brief Specifies a simulated SPI driver, the device answers are scripted by the host test.
+ */
+typedef struct Vfb_SpiDriverTypeTag
+{
+	uint32_t id;							/**< Driver index in the traces. */
+	const Vfb_SpiConfigType *config;		/**< Driver configuration, NULL if stopped. */
+	uint8_t isSelected;						/**< TRUE while the chip select is asserted. */
+} Vfb_SpiDriverType;
+
+extern Vfb_SpiDriverType Vfb_Spi_Spi1;
+
+#define VFB_SPI_SPI1								(&Vfb_Spi_Spi1)
+
+#define VFB_SPI_CONFIG(csLine, prescaler, mode)		{ (uint32_t)(csLine), (uint16_t)(((prescaler) << 3u) | (mode)) }
+
+extern void Vfb_Spi_Start(Vfb_SpiDriverType *drv, const Vfb_SpiConfigType *cfg);
+extern void Vfb_Spi_Stop(Vfb_SpiDriverType *drv);
+extern void Vfb_Spi_Select(Vfb_SpiDriverType *drv);
+extern void Vfb_Spi_Unselect(Vfb_SpiDriverType *drv);
+extern void Vfb_Spi_Exchange(Vfb_SpiDriverType *drv, const uint32_t n, const void *tx, void *rx);
+extern void Vfb_Spi_Send(Vfb_SpiDriverType *drv, const uint32_t n, const void *tx);
+extern void Vfb_Spi_Receive(Vfb_SpiDriverType *drv, const uint32_t n, void *rx);
+extern void Vfb_Spi_Ignore(Vfb_SpiDriverType *drv, const uint32_t n);
+
+#else
+#error "Vfb: unknown backend"
+#endif
+
+/**@brief Specifies the states of a SPI transaction.
+ */
+typedef enum
+{
+	VFB_SPI_STATE_IDLE = 0u,				/**< Never submitted. */
+	VFB_SPI_STATE_BUSY,						/**< Queued or in execution. */
+	VFB_SPI_STATE_DONE						/**< Executed. */
+} Vfb_SpiStateType;
+
+typedef struct Vfb_SpiTransactionTypeTag Vfb_SpiTransactionType;
+
+/**@brief Specifies the completion callback of a SPI transaction.
+ * @details Called from the SPI task, the transaction can be submitted again from the callback.
+ */
+typedef void (*Vfb_SpiNotifyType)(Vfb_SpiTransactionType *transaction);
+
+/**@struct Vfb_SpiTransactionType
+ * @brief Specifies a SPI transaction (command phase then data phase), owned by the submitting driver.
+ * @details The command is sent first, then the data phase is a full duplex transfer if both data
+ * pointers are set, a receive if only rxData is set, a send if only txData is set and dummy clocks
+ * if none is set.
+ * Queued transactions are executed earliest deadline first, equal deadlines by priority.
+ */
+struct Vfb_SpiTransactionTypeTag
+{
+	Vfb_SpiTransactionType *next;				/**< Next queued transaction (internal). */
+	Vfb_SpiDeviceType device;					/**< Addressed device. */
+	uint8_t priority;							/**< Priority among the transactions with the same deadline, higher first. */
+	uint8_t commandLength;						/**< Number of command bytes, can be 0. */
+	uint8_t command[VFB_SPI_COMMAND_SIZE];		/**< Command bytes (e.g. register address with the read bit). */
+	uint32_t deadline;							/**< System time (OS ticks) by which the transaction should be done. */
+	volatile Vfb_SpiStateType state;			/**< Transaction state. */
+	const uint8_t *txData;						/**< Data to send, NULL to send dummy bytes. */
+	uint8_t *rxData;							/**< Buffer for the received data, NULL to drop it. */
+	uint16_t length;							/**< Number of data bytes. */
+	rtcnt_t timestamp;							/**< Real time counter at chip select assertion. */
+	Vfb_SpiNotifyType notify;					/**< Completion callback, can be NULL. */
+	void *context;								/**< User data of the completion callback. */
+};
+
+/**@struct Vfb_SpiBurstType
+ * @brief Specifies a double buffered burst reader (e.g. of a sensor FIFO).
+ * @details While the data of one buffer is processed the next burst is read into the other one.
+ * The caller fills in the transaction device, priority and command once.
+ */
+typedef struct Vfb_SpiBurstTypeTag
+{
+	Vfb_SpiTransactionType transaction;			/**< Read into the buffer being filled. */
+	uint8_t *buffer[2u];						/**< Burst buffers. */
+	uint16_t size;								/**< Size of each burst buffer. */
+	uint8_t filling;							/**< Index of the buffer being filled. */
+	uint32_t deadlineTime;						/**< Deadline of each burst relative to its request, in OS ticks. */
+	rtcnt_t timestamp;							/**< Chip select assertion time of the last returned burst. */
+} Vfb_SpiBurstType;
+
+/**@struct Vfb_SpiStatsType
+ * @brief Specifies the bus usage accounting of one device.
+ */
+typedef struct Vfb_SpiStatsTypeTag
+{
+	uint32_t busTime;							/**< Bus time used by the device in real time counter cycles. */
+	uint32_t transactions;						/**< Number of executed transactions. */
+	uint32_t bytes;								/**< Number of transferred bytes (command and data). */
+} Vfb_SpiStatsType;
+
+extern const Vfb_SpiConfigType Vfb_Spi_DeviceConfig[VFB_SPI_DEVICE_UNKNOWN];
+
+extern void Vfb_Spi_Init(void);
+extern void Vfb_Spi_Deinit(void);
+extern uint8_t Vfb_Spi_Submit(Vfb_SpiTransactionType *transaction);
+extern void Vfb_Spi_MainFunction(void);
+extern uint32_t Vfb_Spi_BurstRead(Vfb_SpiBurstType *burst, const uint32_t length, const uint8_t **data);
+extern const Vfb_SpiStatsType *Vfb_Spi_GetStats(const Vfb_SpiDeviceType device);
+
 #endif /* VFB_SPI_H */
@@ -40,4 +40,160 @@
 #if !defined(VFB_UART_H)
 #define VFB_UART_H
 
+#include "Vfb_Backend.h"
+
+#if (VFB_BACKEND == VFB_BACKEND_HAL)
+
+#include "hal.h"
+
+/**@brief Defines the virtual function bus type of a UART driver.
+ */
+typedef UARTDriver Vfb_UartDriverType;
+
+/**@brief Defines the virtual function bus type of a UART driver configuration.
+ */
+typedef UARTConfig Vfb_UartConfigType;
+
+/**@brief Defines the virtual function bus type of the UART receive error flags.
+ */
+typedef uartflags_t Vfb_UartFlagsType;
+
+/**@brief Defines the virtual function bus UART drivers.
+ */
+#define VFB_UART_USART1								(&UARTD1)
+#define VFB_UART_USART2								(&UARTD2)
+#define VFB_UART_LPUART1							(&LPUARTD1)
+
+/**@brief Defines the virtual function bus pin function of a UART transmit or receive pin.
+ * @param[in]	af		Alternate function number
+ */
+#define VFB_UART_PIN_MODE(af)						(PAL_MODE_ALTERNATE(af) | PAL_STM32_OSPEED_HIGHEST)
+
+/**@brief Defines the virtual function bus initializer of a UART driver configuration (8N1, idle line detection).
+ * @param[in]	txEnd		Transmit DMA end callback
+ * @param[in]	rxEvent		Receive DMA half transfer and transfer complete callback
+ * @param[in]	rxIdle		Receive idle line callback
+ * @param[in]	rxError		Receive error callback
+ * @param[in]	baud		Baud rate
+ */
+#define VFB_UART_CONFIG(txEnd, rxEvent, rxIdle, rxError, baud) \
+	{ \
+		.txend1_cb = (txEnd), \
+		.txend2_cb = NULL, \
+		.rxend_cb = NULL, \
+		.rxchar_cb = (rxEvent), \
+		.rxerr_cb = (rxError), \
+		.timeout_cb = (rxIdle), \
+		.speed = (baud), \
+		.cr1 = USART_CR1_IDLEIE, \
+		.cr2 = USART_CR2_STOP1_BITS, \
+		.cr3 = 0u \
+	}
+
+/**@brief Defines the virtual function bus macro used to start a UART driver.
+ * @param[in]	drv		UART driver
+ * @param[in]	cfg		UART driver configuration
+ */
+#define Vfb_Uart_Start(drv, cfg)					uartStart(drv, cfg)
+
+/**@brief Defines the virtual function bus macro used to stop a UART driver.
+ * @param[in]	drv		UART driver
+ */
+#define Vfb_Uart_Stop(drv)							uartStop(drv)
+
+/**@brief Defines the virtual function bus macro used to get the write position of the circular receive DMA.
+ * @param[in]	drv		UART driver
+ * @param[in]	size	Size of the circular receive buffer
+ * @return Index inside the receive buffer at which the next byte will be written.
+ */
+#define Vfb_Uart_Get_Rx_Position(drv, size)		((uint32_t)(size) - (uint32_t)dmaStreamGetTransactionSize((drv)->dmarx))
+
+/**@brief Defines the virtual function bus macro used to start a DMA transmission from the ISR context.
+ * @param[in]	drv		UART driver
+ * @param[in]	length	Number of bytes to transmit (at most 65535)
+ * @param[in]	data	Data to transmit, must stay valid until the transmission ends
+ */
+#define Vfb_Uart_Start_Send_I(drv, length, data)	uartStartSendI(drv, length, data)
+
+extern void Vfb_Uart_StartCircularRx(Vfb_UartDriverType *drv, uint8_t *buffer, const uint32_t size);
+
+#elif (VFB_BACKEND == VFB_BACKEND_LINUX) || (VFB_BACKEND == VFB_BACKEND_MOCK)
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**@brief Defines the virtual function bus type of the UART receive error flags.
+ */
+typedef uint32_t Vfb_UartFlagsType;
+
+typedef struct Vfb_UartDriverTypeTag Vfb_UartDriverType;
+
+/**@struct Vfb_UartConfigType
+ * @brief Specifies the configuration of a simulated UART driver (same callbacks as the HAL driver).
+ */
+typedef struct Vfb_UartConfigTypeTag
+{
+	void (*txend1_cb)(Vfb_UartDriverType *uartp);							/**< Transmission end. */
+	void (*rxchar_cb)(Vfb_UartDriverType *uartp, uint16_t c);				/**< Receive half transfer and transfer complete. */
+	void (*timeout_cb)(Vfb_UartDriverType *uartp);							/**< Receive idle line. */
+	void (*rxerr_cb)(Vfb_UartDriverType *uartp, Vfb_UartFlagsType e);		/**< Receive error. */
+	uint32_t speed;															/**< Baud rate. */
+} Vfb_UartConfigType;
+
+/**@struct Vfb_UartDriverType
+ * @brief Specifies a simulated UART driver backed by a pseudo terminal or a socket (Linux backend)
+ * or fed by the host test (mock backend).
+ * @details The receive side emulates the circular DMA: bytes are read from the file descriptor
+ * into the receive buffer and the same half transfer, transfer complete and idle line events as on
+ * the target are raised. The consumption is limited to the configured byte rate.
+ */
+struct Vfb_UartDriverTypeTag
+{
+	uint32_t id;							/**< Driver index in the traces. */
+	int fd;									/**< Pseudo terminal master or socket, -1 if not attached. */
+	const Vfb_UartConfigType *config;		/**< Driver configuration, NULL if stopped. */
+	uint8_t *rxBuffer;						/**< Circular receive buffer. */
+	uint32_t rxSize;						/**< Size of the circular receive buffer. */
+	volatile uint32_t rxPosition;			/**< Emulated DMA write position. */
+	uint32_t rxPending;						/**< Bytes received since the last receive event. */
+	uint32_t txPending;						/**< A transmission end has to be reported. */
+	uint32_t bytesPerSecond;				/**< Byte rate limit, 0 for unlimited. */
+	uint64_t budgetTime;					/**< Time stamp (ns) of the last byte rate budget update. */
+	uint64_t rxBytes;						/**< Total number of received bytes. */
+	uint64_t txBytes;						/**< Total number of transmitted bytes. */
+};
+
+extern Vfb_UartDriverType Vfb_Uart_Usart1;
+extern Vfb_UartDriverType Vfb_Uart_Usart2;
+extern Vfb_UartDriverType Vfb_Uart_Lpuart1;
+
+#define VFB_UART_USART1								(&Vfb_Uart_Usart1)
+#define VFB_UART_USART2								(&Vfb_Uart_Usart2)
+#define VFB_UART_LPUART1							(&Vfb_Uart_Lpuart1)
+
+#define VFB_UART_CONFIG(txEnd, rxEvent, rxIdle, rxError, baud) \
+	{ (txEnd), (rxEvent), (rxIdle), (rxError), (baud) }
+
+/**@brief Defines the simulated pin function of a UART pin, recorded with the alternate function number.
+ */
+#define VFB_UART_PIN_MODE(af)						(0x100u | (uint32_t)(af))
+
+#define Vfb_Uart_Get_Rx_Position(drv, size)		((drv)->rxPosition)
+
+extern void Vfb_Uart_Start(Vfb_UartDriverType *drv, const Vfb_UartConfigType *cfg);
+extern void Vfb_Uart_Stop(Vfb_UartDriverType *drv);
+extern void Vfb_Uart_StartCircularRx(Vfb_UartDriverType *drv, uint8_t *buffer, const uint32_t size);
+extern void Vfb_Uart_Start_Send_I(Vfb_UartDriverType *drv, const uint32_t length, const void *data);
+
+#if (VFB_BACKEND == VFB_BACKEND_LINUX)
+extern int Vfb_Uart_LinuxOpenPty(Vfb_UartDriverType *drv, char *name, const uint32_t nameSize);
+extern void Vfb_Uart_LinuxAttach(Vfb_UartDriverType *drv, const int fd);
+extern void Vfb_Uart_LinuxSetRate(Vfb_UartDriverType *drv, const uint32_t bytesPerSecond);
+extern void Vfb_Uart_LinuxServe(void);
+#endif
+
+#else
+#error "Vfb: unknown backend"
+#endif
+
 #endif /* VFB_UART_H */
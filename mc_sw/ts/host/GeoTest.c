@@ -0,0 +1,411 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: GeoTest.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file GeoTest.c
+* @brief Implements the host test of the geodetic error bounds.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include <math.h>
+#include <stdio.h>
+#include "Geo.h"
+
+/* Host test, built and run by "make test" in this directory. It checks the error bounds documented
+ * in Geo.h against double precision references: Vincenty on the WGS84 ellipsoid for the distances,
+ * the bearing and the local frame, and the haversine on the mean earth sphere for
+ * Geo_DistanceHaversine(). Random pairs up to 80 and up to 60 degrees latitude are drawn at distances
+ * up to 100 m, 1 km, 10 km and 100 km. The worst error of each kernel is printed as a fraction of its
+ * bound, a value above 1 fails the test. */
+
+/**@brief Defines the number of random pairs per latitude limit and distance range.
+ */
+#define GEOTEST_PAIRS					(20000u)
+
+/**@brief Defines the number of distance ranges.
+ */
+#define GEOTEST_RANGES					(4u)
+
+/**@brief Defines the limit in millimeters of the short distance bounds.
+ */
+#define GEOTEST_SHORT					(10000000.0)
+
+/**@brief Defines the limit in millimeters of the long distance bounds.
+ */
+#define GEOTEST_LONG					(100000000.0)
+
+/**@brief Defines the shortest distance in millimeters at which the bearing is checked, below it the
+ * 1e-7 degrees resolution of the positions dominates.
+ */
+#define GEOTEST_BEARING_MIN				(100000.0)
+
+/**@brief Defines the absolute rounding error in millimeters of the distance results.
+ */
+#define GEOTEST_ROUNDING				(0.5)
+
+/**@brief Defines the WGS84 semi-major axis and flattening.
+ */
+#define GEOTEST_WGS84_A					(6378137000.0)
+#define GEOTEST_WGS84_F					(1.0 / 298.257223563)
+
+/**@brief Defines the mean earth radius in millimeters.
+ */
+#define GEOTEST_EARTH_RADIUS			(6371008800.0)
+
+/**@brief Defines the number of radians per degree.
+ */
+#define GEOTEST_RAD						(M_PI / 180.0)
+
+/**@enum GeoTest_KernelTypeTag
+ * @brief Specifies the checked error bounds.
+ */
+typedef enum GeoTest_KernelTypeTag
+{
+	GEOTEST_DISTANCE_SHORT = 0u,	/**< Geo_Distance below 10 km against Vincenty. */
+	GEOTEST_DISTANCE_LONG,			/**< Geo_Distance below 100 km against Vincenty. */
+	GEOTEST_HAVERSINE,				/**< Geo_DistanceHaversine against the double precision haversine. */
+	GEOTEST_SPHERE,					/**< Geo_DistanceHaversine against Vincenty. */
+	GEOTEST_BEARING,				/**< Geo_Bearing below 10 km against the initial geodesic bearing. */
+	GEOTEST_ENU,					/**< Geo_ToEnu horizontal length below 10 km against Vincenty. */
+	GEOTEST_ROUNDTRIP_SHORT,		/**< Geo_FromEnu of Geo_ToEnu below 10 km. */
+	GEOTEST_ROUNDTRIP_LONG,			/**< Geo_FromEnu of Geo_ToEnu below 100 km. */
+	GEOTEST_KERNELS					/**< Guard value. */
+} GeoTest_KernelType;
+
+/**@struct GeoTest_LimitType
+ * @brief Specifies the error bounds documented in Geo.h for a latitude limit.
+ */
+typedef struct GeoTest_LimitTypeTag
+{
+	double latitude;					/**< Latitude limit in degrees. */
+	double bound[GEOTEST_KERNELS];		/**< Relative error, degrees or 1e-7 degrees per kernel. */
+} GeoTest_LimitType;
+
+/**@struct GeoTest_DataType
+ * @brief Container used to store the relevant data of the test.
+ */
+typedef struct GeoTest_DataTypeTag
+{
+	uint64_t seed;						/**< State of the random generator. */
+	double azimuth;						/**< Initial bearing in degrees of the last Vincenty distance. */
+	double worst[GEOTEST_KERNELS];		/**< Worst error as a fraction of the bound. */
+	uint32_t altitudeErrors;			/**< Number of pairs with a wrong up offset or altitude. */
+	uint32_t checks;					/**< Number of checks. */
+	uint32_t failures;					/**< Number of failed checks. */
+} GeoTest_DataType;
+
+static void testLimit(const GeoTest_LimitType *limit);
+static void testPair(const GeoTest_LimitType *limit, const Geo_PointType *from, const Geo_PointType *to);
+static void testSpecial(void);
+static void record(const GeoTest_KernelType kernel, const double error, const double bound);
+static double getVincenty(const double lat1, const double lon1, const double lat2, const double lon2);
+static double getHaversine(const double lat1, const double lon1, const double lat2, const double lon2);
+static double getRandom(void);
+static void check(const int condition, const char *name);
+
+/**@brief Defines the error bounds documented in Geo.h.
+ */
+static const GeoTest_LimitType GeoTest_Limit[] =
+{
+	{ 80.0, { 4e-6, 4e-4, 2e-6, 6e-3, 0.25, 1.7e-3, 1.0, 5.0 } },
+	{ 60.0, { 7e-7, 4e-5, 2e-6, 6e-3, 0.08, 5.2e-4, 1.0, 5.0 } }
+};
+
+/**@brief Defines the names of the checked error bounds.
+ */
+static const char * const GeoTest_Name[GEOTEST_KERNELS] =
+{
+	"distance < 10 km", "distance < 100 km", "haversine", "sphere", "bearing", "enu", "round trip < 10 km", "round trip < 100 km"
+};
+
+/**@brief Defines the distance ranges in meters.
+ */
+static const double GeoTest_Range[GEOTEST_RANGES] = { 100.0, 1000.0, 10000.0, 100000.0 };
+
+/**@brief Stores the test data.
+ */
+static GeoTest_DataType GeoTest_Data = { .seed = 1u };
+
+/**@brief Entry point of the test.
+ * @return	0 if all checks passed, 1 otherwise.
+ */
+int main(void)
+{
+	uint32_t idx = 0u;
+
+	for (idx = 0u; idx < (sizeof(GeoTest_Limit) / sizeof(GeoTest_Limit[0])); idx++)
+	{
+		testLimit(&GeoTest_Limit[idx]);
+	}
+	testSpecial();
+
+	printf("GeoTest: %u checks, %u failed\n", GeoTest_Data.checks, GeoTest_Data.failures);
+
+	return (GeoTest_Data.failures == 0u) ? 0 : 1;
+}
+
+/**@brief Used to check the bounds of a latitude limit over random pairs.
+ * @param[in]	limit	Latitude limit and bounds.
+ */
+static void testLimit(const GeoTest_LimitType *limit)
+{
+	uint32_t range = 0u;
+	uint32_t kernel = 0u;
+
+	for (kernel = 0u; kernel < GEOTEST_KERNELS; kernel++)
+	{
+		GeoTest_Data.worst[kernel] = 0.0;
+	}
+	GeoTest_Data.altitudeErrors = 0u;
+
+	for (range = 0u; range < GEOTEST_RANGES; range++)
+	{
+		uint32_t pair = 0u;
+
+		for (pair = 0u; pair < GEOTEST_PAIRS; pair++)
+		{
+			const double lat1 = limit->latitude * ((2.0 * getRandom()) - 1.0);
+			const double lon1 = 360.0 * (getRandom() - 0.5);
+			const double distance = GeoTest_Range[range] * getRandom();
+			const double azimuth = 2.0 * M_PI * getRandom();
+			const double lat2 = lat1 + ((distance * cos(azimuth)) / 111000.0);
+			double lon2 = lon1 + ((distance * sin(azimuth)) / (111000.0 * cos(lat1 * GEOTEST_RAD)));
+			Geo_PointType from;
+			Geo_PointType to;
+
+			lon2 += (lon2 > 180.0) ? -360.0 : ((lon2 < -180.0) ? 360.0 : 0.0);
+			from.latitude = (int32_t)lround(lat1 * 1e7);
+			from.longitude = (int32_t)lround(lon1 * 1e7);
+			to.latitude = (int32_t)lround(lat2 * 1e7);
+			to.longitude = (int32_t)lround(lon2 * 1e7);
+			testPair(limit, &from, &to);
+		}
+	}
+
+	printf("GeoTest: up to %.0f degrees latitude, worst error / bound:\n", limit->latitude);
+	for (kernel = 0u; kernel < GEOTEST_KERNELS; kernel++)
+	{
+		printf("  %-20s %.3f\n", GeoTest_Name[kernel], GeoTest_Data.worst[kernel]);
+		check(GeoTest_Data.worst[kernel] <= 1.0, GeoTest_Name[kernel]);
+	}
+	check(GeoTest_Data.altitudeErrors == 0u, "enu altitude");
+}
+
+/**@brief Used to record the errors of all kernels for a pair.
+ * @param[in]	limit	Latitude limit and bounds.
+ * @param[in]	from	First position.
+ * @param[in]	to		Second position.
+ */
+static void testPair(const GeoTest_LimitType *limit, const Geo_PointType *from, const Geo_PointType *to)
+{
+	const double lat1 = from->latitude / 1e7;
+	const double lon1 = from->longitude / 1e7;
+	const double lat2 = to->latitude / 1e7;
+	const double lon2 = to->longitude / 1e7;
+	const double ellipsoid = getVincenty(lat1, lon1, lat2, lon2);
+	const double azimuth = GeoTest_Data.azimuth;
+	const double sphere = getHaversine(lat1, lon1, lat2, lon2);
+	const double distance = (double)Geo_Distance(from, to);
+	const double haversine = (double)Geo_DistanceHaversine(from, to);
+	const double *bound = limit->bound;
+	Geo_FrameType frame;
+	Geo_EnuType enu;
+	Geo_PointType back;
+	int32_t altitude = 0;
+	double roundTrip = 0.0;
+
+	Geo_FrameInit(&frame, from, 1000);
+	Geo_ToEnu(&frame, to, 2500, &enu);
+	Geo_FromEnu(&frame, &enu, &back, &altitude);
+	roundTrip = fmax(fabs((double)back.latitude - to->latitude), fabs((double)back.longitude - to->longitude));
+	GeoTest_Data.altitudeErrors += ((enu.up == 1500) && (altitude == 2500)) ? 0u : 1u;
+
+	record(GEOTEST_HAVERSINE, fabs(haversine - sphere), GEOTEST_ROUNDING + (bound[GEOTEST_HAVERSINE] * sphere));
+	record(GEOTEST_SPHERE, fabs(haversine - ellipsoid), GEOTEST_ROUNDING + (bound[GEOTEST_SPHERE] * ellipsoid));
+	if (ellipsoid < GEOTEST_SHORT)
+	{
+		const double length = sqrt(((double)enu.east * enu.east) + ((double)enu.north * enu.north));
+
+		record(GEOTEST_DISTANCE_SHORT, fabs(distance - ellipsoid), GEOTEST_ROUNDING + (bound[GEOTEST_DISTANCE_SHORT] * ellipsoid));
+		record(GEOTEST_ENU, fabs(length - ellipsoid), (2.0 * GEOTEST_ROUNDING) + (bound[GEOTEST_ENU] * ellipsoid));
+		record(GEOTEST_ROUNDTRIP_SHORT, roundTrip, bound[GEOTEST_ROUNDTRIP_SHORT]);
+		if (ellipsoid >= GEOTEST_BEARING_MIN)
+		{
+			double error = fabs((Geo_Bearing(from, to) / 100.0) - azimuth);
+
+			record(GEOTEST_BEARING, (error > 180.0) ? (360.0 - error) : error, bound[GEOTEST_BEARING]);
+		}
+	}
+	if (ellipsoid < GEOTEST_LONG)
+	{
+		record(GEOTEST_DISTANCE_LONG, fabs(distance - ellipsoid), GEOTEST_ROUNDING + (bound[GEOTEST_DISTANCE_LONG] * ellipsoid));
+		record(GEOTEST_ROUNDTRIP_LONG, roundTrip, bound[GEOTEST_ROUNDTRIP_LONG]);
+	}
+}
+
+/**@brief Used to check the antimeridian, a zero distance and the saturation.
+ */
+static void testSpecial(void)
+{
+	const Geo_PointType west = { 470000000, 1799999000 };
+	const Geo_PointType east = { 470000000, -1799999000 };
+	const Geo_PointType origin = { 0, 0 };
+	const Geo_PointType quarter = { 0, 900000000 };
+	const double ellipsoid = getVincenty(47.0, 179.9999, 47.0, -179.9999);
+
+	check(fabs(Geo_Distance(&west, &east) - ellipsoid) <= (GEOTEST_ROUNDING + (GeoTest_Limit[0].bound[GEOTEST_DISTANCE_SHORT] * ellipsoid)),
+		  "antimeridian distance");
+	check(Geo_Bearing(&west, &east) == 9000u, "antimeridian bearing");
+	check((Geo_Distance(&west, &west) == 0u) && (Geo_DistanceHaversine(&west, &west) == 0u), "zero distance");
+	check(Geo_DistanceHaversine(&origin, &quarter) == GEO_DISTANCE_MAX, "haversine saturation");
+}
+
+/**@brief Used to record an error as a fraction of its bound.
+ * @param[in]	kernel	Checked bound.
+ * @param[in]	error	Error.
+ * @param[in]	bound	Bound of the error.
+ */
+static void record(const GeoTest_KernelType kernel, const double error, const double bound)
+{
+	const double ratio = error / bound;
+
+	GeoTest_Data.worst[kernel] = (ratio > GeoTest_Data.worst[kernel]) ? ratio : GeoTest_Data.worst[kernel];
+}
+
+/**@brief Used to get the geodesic distance on the WGS84 ellipsoid (Vincenty inverse).
+ * @details The initial bearing is stored in GeoTest_Data.azimuth.
+ * @param[in]	lat1	Latitude of the first position in degrees.
+ * @param[in]	lon1	Longitude of the first position in degrees.
+ * @param[in]	lat2	Latitude of the second position in degrees.
+ * @param[in]	lon2	Longitude of the second position in degrees.
+ * @return	Distance in millimeters.
+ */
+static double getVincenty(const double lat1, const double lon1, const double lat2, const double lon2)
+{
+	const double b = GEOTEST_WGS84_A * (1.0 - GEOTEST_WGS84_F);
+	const double l = (lon2 - lon1) * GEOTEST_RAD;
+	const double u1 = atan((1.0 - GEOTEST_WGS84_F) * tan(lat1 * GEOTEST_RAD));
+	const double u2 = atan((1.0 - GEOTEST_WGS84_F) * tan(lat2 * GEOTEST_RAD));
+	const double sinU1 = sin(u1);
+	const double cosU1 = cos(u1);
+	const double sinU2 = sin(u2);
+	const double cosU2 = cos(u2);
+	double lambda = l;
+	double previous = 0.0;
+	double sinSigma = 0.0;
+	double cosSigma = 0.0;
+	double sigma = 0.0;
+	double cos2Alpha = 0.0;
+	double cos2Sigma = 0.0;
+	double retVal = 0.0;
+	uint32_t iteration = 0u;
+
+	GeoTest_Data.azimuth = 0.0;
+	do
+	{
+		const double sinLambda = sin(lambda);
+		const double cosLambda = cos(lambda);
+		const double y = (cosU1 * sinU2) - (sinU1 * cosU2 * cosLambda);
+		double sinAlpha = 0.0;
+		double c = 0.0;
+
+		sinSigma = sqrt(((cosU2 * sinLambda) * (cosU2 * sinLambda)) + (y * y));
+		if (sinSigma == 0.0)
+		{
+			return 0.0;
+		}
+		cosSigma = (sinU1 * sinU2) + (cosU1 * cosU2 * cosLambda);
+		sigma = atan2(sinSigma, cosSigma);
+		sinAlpha = (cosU1 * cosU2 * sinLambda) / sinSigma;
+		cos2Alpha = 1.0 - (sinAlpha * sinAlpha);
+		cos2Sigma = (cos2Alpha != 0.0) ? (cosSigma - ((2.0 * sinU1 * sinU2) / cos2Alpha)) : 0.0;
+		c = (GEOTEST_WGS84_F / 16.0) * cos2Alpha * (4.0 + (GEOTEST_WGS84_F * (4.0 - (3.0 * cos2Alpha))));
+		previous = lambda;
+		lambda = l + ((1.0 - c) * GEOTEST_WGS84_F * sinAlpha *
+					  (sigma + (c * sinSigma * (cos2Sigma + (c * cosSigma * (-1.0 + (2.0 * cos2Sigma * cos2Sigma)))))));
+		iteration++;
+	} while ((fabs(lambda - previous) > 1e-13) && (iteration < 200u));
+
+	{
+		const double u = (cos2Alpha * ((GEOTEST_WGS84_A * GEOTEST_WGS84_A) - (b * b))) / (b * b);
+		const double a = 1.0 + ((u / 16384.0) * (4096.0 + (u * (-768.0 + (u * (320.0 - (175.0 * u)))))));
+		const double k = (u / 1024.0) * (256.0 + (u * (-128.0 + (u * (74.0 - (47.0 * u))))));
+		const double deltaSigma = k * sinSigma * (cos2Sigma + ((k / 4.0) * ((cosSigma * (-1.0 + (2.0 * cos2Sigma * cos2Sigma))) -
+								  ((k / 6.0) * cos2Sigma * (-3.0 + (4.0 * sinSigma * sinSigma)) * (-3.0 + (4.0 * cos2Sigma * cos2Sigma))))));
+
+		retVal = b * a * (sigma - deltaSigma);
+		GeoTest_Data.azimuth = atan2(cosU2 * sin(lambda), (cosU1 * sinU2) - (sinU1 * cosU2 * cos(lambda))) / GEOTEST_RAD;
+		GeoTest_Data.azimuth += (GeoTest_Data.azimuth < 0.0) ? 360.0 : 0.0;
+	}
+
+	return retVal;
+}
+
+/**@brief Used to get the great circle distance on the mean earth sphere.
+ * @param[in]	lat1	Latitude of the first position in degrees.
+ * @param[in]	lon1	Longitude of the first position in degrees.
+ * @param[in]	lat2	Latitude of the second position in degrees.
+ * @param[in]	lon2	Longitude of the second position in degrees.
+ * @return	Distance in millimeters.
+ */
+static double getHaversine(const double lat1, const double lon1, const double lat2, const double lon2)
+{
+	const double sinLat = sin(((lat2 - lat1) * GEOTEST_RAD) / 2.0);
+	const double sinLon = sin(((lon2 - lon1) * GEOTEST_RAD) / 2.0);
+	const double h = (sinLat * sinLat) + (cos(lat1 * GEOTEST_RAD) * cos(lat2 * GEOTEST_RAD) * sinLon * sinLon);
+
+	return 2.0 * GEOTEST_EARTH_RADIUS * asin(sqrt(h));
+}
+
+/**@brief Used to get a reproducible random number.
+ * @return	Random number in [0, 1).
+ */
+static double getRandom(void)
+{
+	GeoTest_Data.seed = (GeoTest_Data.seed * 6364136223846793005ull) + 1442695040888963407ull;
+	return (double)(GeoTest_Data.seed >> 11u) / 9007199254740992.0;
+}
+
+/**@brief Used to record the result of a check.
+ * @param[in]	condition	Result of the check, 0 if it failed.
+ * @param[in]	name		Name of the check.
+ */
+static void check(const int condition, const char *name)
+{
+	GeoTest_Data.checks++;
+	if (condition == 0)
+	{
+		GeoTest_Data.failures++;
+		printf("GeoTest: FAILED %s\n", name);
+	}
+}
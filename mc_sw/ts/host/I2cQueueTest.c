@@ -0,0 +1,231 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: I2cQueueTest.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file I2cQueueTest.c
+* @brief Implements the host test of the I2C transaction queue.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include <stdio.h>
+#include <string.h>
+#include "Vfb.h"
+
+/* Host test, built and run by "make test" in this directory with -DVFB_BACKEND=VFB_BACKEND_MOCK.
+ * Transactions are queued with the same deadline and priority and executed by Vfb_I2c_MainFunction().
+ * The recorded bus exchanges, the order of the completion callbacks and the data delivered from the
+ * scripted device answers show which reads were merged and in which order the device saw them. */
+
+/**@brief Defines the largest number of transactions of a case.
+ */
+#define I2CQUEUETEST_TRANSACTIONS		(3u)
+
+/**@struct I2cQueueTest_DataType
+ * @brief Container used to store the relevant data of the test.
+ */
+typedef struct I2cQueueTest_DataTypeTag
+{
+	Vfb_I2cTransactionType transaction[I2CQUEUETEST_TRANSACTIONS];	/**< Queued transactions. */
+	uint8_t data[I2CQUEUETEST_TRANSACTIONS][2u];					/**< Data of each transaction. */
+	uint32_t done[I2CQUEUETEST_TRANSACTIONS];						/**< Transaction indices in completion order. */
+	uint32_t doneCount;												/**< Number of completed transactions. */
+	uint32_t checks;												/**< Number of checks. */
+	uint32_t failures;												/**< Number of failed checks. */
+} I2cQueueTest_DataType;
+
+static void testReadWriteRead(void);
+static void testMerge(void);
+static void testOtherDevice(void);
+static void prepare(const uint32_t idx, const Vfb_I2cDeviceType device, const uint8_t reg, const uint8_t isRead);
+static void execute(const uint32_t count);
+static uint8_t isExchange(const uint32_t idx, const uint32_t address, const uint32_t txLen, const uint32_t rxLen);
+static void notify(Vfb_I2cTransactionType *transaction);
+static void check(const int condition, const char *name);
+
+/**@brief Stores the test data.
+ */
+static I2cQueueTest_DataType I2cQueueTest_Data;
+
+/**@brief Defines the scripted device answer, one distinct byte per read byte.
+ */
+static const uint8_t I2cQueueTest_Response[4u] = { 0xA1u, 0xA2u, 0xB1u, 0xB2u };
+
+/**@brief Entry point of the test.
+ * @return	0 if all checks passed, 1 otherwise.
+ */
+int main(void)
+{
+	Vfb_Sim_SetI2cAck(TRUE);
+	Vfb_I2c_Init();
+
+	testReadWriteRead();
+	testMerge();
+	testOtherDevice();
+
+	printf("I2cQueueTest: %u checks, %u failed\n", I2cQueueTest_Data.checks, I2cQueueTest_Data.failures);
+
+	return (I2cQueueTest_Data.failures == 0u) ? 0 : 1;
+}
+
+/**@brief Checks that a read queued after a write to the same device is not merged in front of it.
+ */
+static void testReadWriteRead(void)
+{
+	prepare(0u, VFB_I2C_DEVICE_BAROMETER, 0x10u, TRUE);
+	prepare(1u, VFB_I2C_DEVICE_BAROMETER, 0x12u, FALSE);
+	prepare(2u, VFB_I2C_DEVICE_BAROMETER, 0x12u, TRUE);
+	execute(3u);
+
+	check(isExchange(0u, 0x76u, 1u, 2u) && isExchange(1u, 0x76u, 3u, 0u) && isExchange(2u, 0x76u, 1u, 2u), "read write read exchanges");
+	check((I2cQueueTest_Data.doneCount == 3u) && (I2cQueueTest_Data.done[0u] == 0u) && (I2cQueueTest_Data.done[1u] == 1u) &&
+		  (I2cQueueTest_Data.done[2u] == 2u), "read write read order");
+	check((I2cQueueTest_Data.data[0u][0u] == 0xA1u) && (I2cQueueTest_Data.data[2u][0u] == 0xB1u), "read write read data");
+}
+
+/**@brief Checks that consecutive register reads of a device are merged into one exchange.
+ */
+static void testMerge(void)
+{
+	prepare(0u, VFB_I2C_DEVICE_BAROMETER, 0x10u, TRUE);
+	prepare(1u, VFB_I2C_DEVICE_BAROMETER, 0x12u, TRUE);
+	execute(2u);
+
+	check(isExchange(0u, 0x76u, 1u, 4u) && isExchange(1u, 0u, 0u, 0u), "merged exchange");
+	check((I2cQueueTest_Data.data[0u][1u] == 0xA2u) && (I2cQueueTest_Data.data[1u][0u] == 0xB1u), "merged data");
+}
+
+/**@brief Checks that a transaction of another device does not stop the merge.
+ */
+static void testOtherDevice(void)
+{
+	prepare(0u, VFB_I2C_DEVICE_BAROMETER, 0x10u, TRUE);
+	prepare(1u, VFB_I2C_DEVICE_MAGNETOMETER, 0x20u, FALSE);
+	prepare(2u, VFB_I2C_DEVICE_BAROMETER, 0x12u, TRUE);
+	execute(3u);
+
+	check(isExchange(0u, 0x76u, 1u, 4u) && isExchange(1u, 0x1Cu, 3u, 0u) && isExchange(2u, 0u, 0u, 0u), "other device exchanges");
+	check((I2cQueueTest_Data.done[0u] == 0u) && (I2cQueueTest_Data.done[1u] == 2u) && (I2cQueueTest_Data.done[2u] == 1u),
+		  "other device order");
+}
+
+/**@brief Used to prepare a transaction of two data bytes.
+ * @param[in]	idx		Transaction index.
+ * @param[in]	device	Addressed device.
+ * @param[in]	reg		First register address.
+ * @param[in]	isRead	TRUE for a register read.
+ */
+static void prepare(const uint32_t idx, const Vfb_I2cDeviceType device, const uint8_t reg, const uint8_t isRead)
+{
+	Vfb_I2cTransactionType *transaction = &I2cQueueTest_Data.transaction[idx];
+
+	(void)memset(transaction, 0, sizeof(*transaction));
+	(void)memset(I2cQueueTest_Data.data[idx], 0, sizeof(I2cQueueTest_Data.data[idx]));
+	transaction->device = device;
+	transaction->reg = reg;
+	transaction->isRead = isRead;
+	transaction->data = I2cQueueTest_Data.data[idx];
+	transaction->length = 2u;
+	transaction->notify = notify;
+}
+
+/**@brief Used to queue the prepared transactions in index order and to execute them.
+ * @param[in]	count	Number of transactions.
+ */
+static void execute(const uint32_t count)
+{
+	uint32_t idx = 0u;
+
+	Vfb_Mock_Reset();
+	Vfb_Sim_SetResponse(I2cQueueTest_Response, sizeof(I2cQueueTest_Response));
+	I2cQueueTest_Data.doneCount = 0u;
+	for (idx = 0u; idx < count; idx++)
+	{
+		check(Vfb_I2c_Submit(&I2cQueueTest_Data.transaction[idx]) != FALSE, "submit");
+	}
+	Vfb_I2c_MainFunction();
+}
+
+/**@brief Used to check a recorded bus exchange.
+ * @param[in]	idx		Index of the exchange in the trace.
+ * @param[in]	address	Expected device address, 0 if no exchange is expected.
+ * @param[in]	txLen	Expected number of written bytes.
+ * @param[in]	rxLen	Expected number of read bytes.
+ * @return	TRUE if the exchange matches.
+ */
+static uint8_t isExchange(const uint32_t idx, const uint32_t address, const uint32_t txLen, const uint32_t rxLen)
+{
+	uint32_t count = 0u;
+	const Vfb_MockRecordType *trace = Vfb_Mock_GetTrace(&count);
+	uint8_t retVal = FALSE;
+
+	if (idx >= count)
+	{
+		retVal = (address == 0u) ? TRUE : FALSE;
+	}
+	else
+	{
+		retVal = ((trace[idx].event == VFB_MOCK_EVENT_I2C_EXCHANGE) && (trace[idx].arg0 == address) &&
+				  (trace[idx].arg1 == ((txLen << 16u) | rxLen))) ? TRUE : FALSE;
+	}
+
+	return retVal;
+}
+
+/**@brief Completion callback, records the completion order.
+ * @param[in]	transaction		Completed transaction.
+ */
+static void notify(Vfb_I2cTransactionType *transaction)
+{
+	const uint32_t idx = (uint32_t)(transaction - I2cQueueTest_Data.transaction);
+
+	check(transaction->state == VFB_I2C_STATE_DONE, "transaction done");
+	if (I2cQueueTest_Data.doneCount < I2CQUEUETEST_TRANSACTIONS)
+	{
+		I2cQueueTest_Data.done[I2cQueueTest_Data.doneCount] = idx;
+		I2cQueueTest_Data.doneCount++;
+	}
+}
+
+/**@brief Used to record the result of a check.
+ * @param[in]	condition	Result of the check, 0 if it failed.
+ * @param[in]	name		Name of the check.
+ */
+static void check(const int condition, const char *name)
+{
+	I2cQueueTest_Data.checks++;
+	if (condition == 0)
+	{
+		I2cQueueTest_Data.failures++;
+		printf("I2cQueueTest: FAILED %s\n", name);
+	}
+}
@@ -0,0 +1,200 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: LedTest.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file LedTest.c
+* @brief Implements the host test of the LED driver.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include <stdio.h>
+#include "Led.h"
+#include "Vfb.h"
+
+/* Host test, built and run by "make test" in this directory with -DVFB_BACKEND=VFB_BACKEND_MOCK.
+ * The LED driver is run with a 10 ms MainFunction recurrence, the virtual time of the mock is moved
+ * before each call, so the recorded pin writes carry the time at which the pattern switched the LED. */
+
+/**@brief Defines the MainFunction recurrence in milliseconds.
+ */
+#define LEDTEST_RECURRENCE			(10u)
+
+/**@brief Defines the number of nanoseconds per millisecond.
+ */
+#define LEDTEST_NS_PER_MS			(1000000u)
+
+/**@struct LedTest_WriteType
+ * @brief Specifies an expected write of the LED pin.
+ */
+typedef struct LedTest_WriteTypeTag
+{
+	uint32_t time;		/**< Time of the write in milliseconds. */
+	uint8_t isOn;		/**< TRUE if the LED is switched on. */
+} LedTest_WriteType;
+
+/**@struct LedTest_DataType
+ * @brief Container used to store the relevant data of the test.
+ */
+typedef struct LedTest_DataTypeTag
+{
+	uint32_t checks;	/**< Number of checks. */
+	uint32_t failures;	/**< Number of failed checks. */
+} LedTest_DataType;
+
+static void testHeartBeat(void);
+static void testSetOnOff(void);
+static void run(const uint32_t first, const uint32_t last);
+static void checkTrace(const LedTest_WriteType *expected, const uint32_t number, const char *name);
+static void check(const int condition, const char *name);
+
+/**@brief Stores the test data.
+ */
+static LedTest_DataType LedTest_Data;
+
+/**@brief Defines the pin writes of a heart beat of two 100 ms pulses every 500 ms idle time.
+ */
+static const LedTest_WriteType LedTest_HeartBeat[] =
+{
+	{0u, FALSE}, {10u, TRUE}, {110u, FALSE}, {210u, TRUE}, {310u, FALSE}, {810u, TRUE}
+};
+
+/**@brief Defines the pin writes of the direct switching of the LED.
+ */
+static const LedTest_WriteType LedTest_SetOnOff[] =
+{
+	{0u, FALSE}, {20u, TRUE}, {50u, FALSE}, {70u, FALSE}
+};
+
+/**@brief Entry point of the test.
+ * @return	0 if all checks passed, 1 otherwise.
+ */
+int main(void)
+{
+	testHeartBeat();
+	testSetOnOff();
+
+	printf("LedTest: %u checks, %u failed\n", LedTest_Data.checks, LedTest_Data.failures);
+
+	return (LedTest_Data.failures == 0u) ? 0 : 1;
+}
+
+/**@brief Checks the pin writes and their times of the heart beat pattern.
+ * @details The MainFunction cycles without a change of the LED must not access the pin.
+ */
+static void testHeartBeat(void)
+{
+	Vfb_Mock_Reset();
+	Led_Init(LEDTEST_RECURRENCE);
+	Led_HeartBeat(LED_ID_USER0, 100u, 2u, 500u);
+	run(1u, 85u);
+
+	checkTrace(LedTest_HeartBeat, sizeof(LedTest_HeartBeat) / sizeof(LedTest_HeartBeat[0u]), "heart beat");
+	check(Led_GetState(LED_ID_USER0) == LED_STATE_ON, "heart beat state");
+	check(Vfb_Mock_GetDropped() == 0u, "heart beat dropped");
+}
+
+/**@brief Checks the pin writes of the direct switching and of the deinitialization.
+ */
+static void testSetOnOff(void)
+{
+	Vfb_Mock_Reset();
+	Led_Init(LEDTEST_RECURRENCE);
+	Vfb_Mock_SetTime(20u * LEDTEST_NS_PER_MS);
+	Led_SetOn(LED_ID_USER0);
+	check(Led_GetState(LED_ID_USER0) == LED_STATE_ON, "set on state");
+	Vfb_Mock_SetTime(50u * LEDTEST_NS_PER_MS);
+	Led_SetOff(LED_ID_USER0);
+	check(Led_GetState(LED_ID_USER0) == LED_STATE_OFF, "set off state");
+	Vfb_Mock_SetTime(70u * LEDTEST_NS_PER_MS);
+	Led_Deinit();
+
+	checkTrace(LedTest_SetOnOff, sizeof(LedTest_SetOnOff) / sizeof(LedTest_SetOnOff[0u]), "set on off");
+}
+
+/**@brief Used to call the MainFunction once per recurrence with the virtual time of the call.
+ * @param[in]	first	First cycle.
+ * @param[in]	last	Last cycle.
+ */
+static void run(const uint32_t first, const uint32_t last)
+{
+	uint32_t cycle = 0u;
+
+	for (cycle = first; cycle <= last; cycle++)
+	{
+		Vfb_Mock_SetTime((uint64_t)cycle * LEDTEST_RECURRENCE * LEDTEST_NS_PER_MS);
+		Led_MainFunction();
+	}
+}
+
+/**@brief Used to compare the recorded trace with the expected pin writes.
+ * @param[in]	expected	Expected pin writes, in order.
+ * @param[in]	number		Number of expected pin writes.
+ * @param[in]	name		Name of the check.
+ */
+static void checkTrace(const LedTest_WriteType *expected, const uint32_t number, const char *name)
+{
+	const uint32_t port = Vfb_Get_Port_Line_Port(LINE_LED_GREEN);
+	const uint32_t mask = Vfb_Get_Port_Line_Mask(LINE_LED_GREEN);
+	uint32_t count = 0u;
+	const Vfb_MockRecordType *trace = Vfb_Mock_GetTrace(&count);
+	uint32_t idx = 0u;
+	uint32_t mismatches = 0u;
+
+	check(count == number, name);
+	for (idx = 0u; (idx < count) && (idx < number); idx++)
+	{
+		if ((trace[idx].event != VFB_MOCK_EVENT_PORT_WRITE) || (trace[idx].id != port) || (trace[idx].arg0 != mask) ||
+			(trace[idx].arg1 != ((expected[idx].isOn != FALSE) ? mask : 0u)) ||
+			(trace[idx].time != ((uint64_t)expected[idx].time * LEDTEST_NS_PER_MS)))
+		{
+			printf("LedTest: %s record %u: event %u, port %u, mask 0x%X, value 0x%X at %llu ns\n", name, idx,
+				   (uint32_t)trace[idx].event, trace[idx].id, trace[idx].arg0, trace[idx].arg1, (unsigned long long)trace[idx].time);
+			mismatches++;
+		}
+	}
+	check(mismatches == 0u, name);
+}
+
+/**@brief Used to record the result of a check.
+ * @param[in]	condition	Result of the check, 0 if it failed.
+ * @param[in]	name		Name of the check.
+ */
+static void check(const int condition, const char *name)
+{
+	LedTest_Data.checks++;
+	if (condition == 0)
+	{
+		LedTest_Data.failures++;
+		printf("LedTest: FAILED %s\n", name);
+	}
+}
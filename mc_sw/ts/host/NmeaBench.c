@@ -0,0 +1,295 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: NmeaBench.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file NmeaBench.c
+* @brief Implements the host benchmark of the NMEA decoder.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "GpsNmea.h"
+#include "NmeaGen.h"
+
+/* Host benchmark, built and run by "make bench" in this directory.
+ *
+ * Usage: NmeaBench [-m megabytes]
+ *
+ * A stream of 10 Hz multi-constellation epochs (NmeaGen.c, GSV at 1 Hz) is fed to GpsNmea_Decode()
+ * in chunks of 1 to 256 bytes, as the GPS task takes them from the receive ring, until about
+ * "megabytes" (default 64) were decoded. Every NMEABENCH_CORRUPT_PERIOD-th sentence is corrupted,
+ * alternately by a flipped bit (checksum error) and by cutting it in half (the next '$' arrives
+ * before the checksum). The parse error counter has to match the number of corrupted sentences and
+ * every other sentence has to be decoded, else the exit code is 1.
+ *
+ * Reported are the decoded bytes per host cycle (time stamp counter, x86 only) and the nanoseconds
+ * per byte. The target figure is given by the "gnss" shell command, which divides the bytes by the
+ * realtime counter cycles spent in the decoder. */
+
+/**@brief Defines the number of epochs of the stream (one minute at 10 Hz).
+ */
+#define NMEABENCH_EPOCHS				(600u)
+
+/**@brief Defines the measurement period of the stream in milliseconds.
+ */
+#define NMEABENCH_PERIOD				(100u)
+
+/**@brief Defines the period in sentences of the corrupted sentences.
+ */
+#define NMEABENCH_CORRUPT_PERIOD		(37u)
+
+/**@brief Defines the default amount of decoded data in megabytes.
+ */
+#define NMEABENCH_MEGABYTES				(64u)
+
+/**@brief Defines the maximum size of a chunk fed to the decoder.
+ */
+#define NMEABENCH_CHUNK_SIZE			(256u)
+
+/**@struct NmeaBench_DataType
+ * @brief Container used to store the relevant data of the benchmark.
+ */
+typedef struct NmeaBench_DataTypeTag
+{
+	uint8_t *stream;					/**< NMEA stream. */
+	uint32_t length;					/**< Number of bytes of the stream. */
+	uint32_t sentences;					/**< Number of intact sentences of the stream. */
+	uint32_t corrupted;					/**< Number of corrupted sentences of the stream. */
+	uint64_t decoded;					/**< Number of decoded sentences. */
+	uint64_t errors;					/**< Parse error counter. */
+} NmeaBench_DataType;
+
+static void buildStream(void);
+static uint32_t appendSentence(const char *sentence, const uint32_t length);
+static void decodeStream(void);
+static uint64_t getTime(void);
+static uint64_t getCycles(void);
+
+/**@brief Stores the benchmark data.
+ */
+static NmeaBench_DataType NmeaBench_Data;
+
+/**@brief Entry point of the benchmark.
+ * @param[in]	argc	Number of arguments.
+ * @param[in]	argv	Arguments.
+ * @return	0 if the counters match the stream, 1 otherwise, 2 on an error.
+ */
+int main(int argc, char *argv[])
+{
+	uint32_t megabytes = NMEABENCH_MEGABYTES;
+	uint32_t passes = 0u;
+	uint32_t pass = 0u;
+	uint64_t startTime;
+	uint64_t startCycles;
+	uint64_t cycles;
+	uint64_t time;
+	double bytes;
+	int retVal = 0;
+
+	if ((argc == 3) && (strcmp(argv[1], "-m") == 0))
+	{
+		megabytes = (uint32_t)strtoul(argv[2], NULL, 10);
+	}
+	else if (argc != 1)
+	{
+		fprintf(stderr, "usage: NmeaBench [-m megabytes]\n");
+		retVal = 2;
+	}
+	else
+	{
+		/* Nothing to do. */
+	}
+
+	if (retVal == 0)
+	{
+		buildStream();
+		passes = (uint32_t)((((uint64_t)megabytes << 20u) + NmeaBench_Data.length - 1u) / NmeaBench_Data.length);
+		passes = (passes == 0u) ? 1u : passes;
+
+		startTime = getTime();
+		startCycles = getCycles();
+		for (pass = 0u; pass < passes; pass++)
+		{
+			decodeStream();
+		}
+		cycles = getCycles() - startCycles;
+		time = getTime() - startTime;
+		bytes = (double)NmeaBench_Data.length * (double)passes;
+
+		printf("NmeaBench: %.0f bytes, %llu sentences, %llu parse errors (%llu corrupted)\n", bytes,
+			   (unsigned long long)NmeaBench_Data.decoded, (unsigned long long)NmeaBench_Data.errors,
+			   (unsigned long long)NmeaBench_Data.corrupted * passes);
+		if (cycles != 0u)
+		{
+			printf("  host:       %.3f bytes/cycle (%.1f cycles/byte), %.2f ns/byte, %.1f Mbytes/s\n",
+				   bytes / (double)cycles, (double)cycles / bytes, (double)time / bytes, bytes * 1000.0 / (double)time);
+		}
+		else
+		{
+			printf("  host:       %.2f ns/byte, %.1f Mbytes/s\n", (double)time / bytes, bytes * 1000.0 / (double)time);
+		}
+
+		if ((NmeaBench_Data.errors != ((uint64_t)NmeaBench_Data.corrupted * passes)) ||
+			(NmeaBench_Data.decoded != ((uint64_t)NmeaBench_Data.sentences * passes)))
+		{
+			printf("NmeaBench: counters do not match the stream\n");
+			retVal = 1;
+		}
+	}
+
+	return retVal;
+}
+
+/**@brief Used to build the stream, corrupting every NMEABENCH_CORRUPT_PERIOD-th sentence.
+ */
+static void buildStream(void)
+{
+	char epochBuffer[NMEAGEN_EPOCH_SIZE];
+	uint32_t epoch = 0u;
+
+	NmeaBench_Data.stream = malloc((size_t)NMEABENCH_EPOCHS * NMEAGEN_EPOCH_SIZE);
+	for (epoch = 0u; (NmeaBench_Data.stream != NULL) && (epoch < NMEABENCH_EPOCHS); epoch++)
+	{
+		const uint32_t size = NmeaGen_Epoch(epochBuffer, epoch, NMEABENCH_PERIOD, ((epoch % (1000u / NMEABENCH_PERIOD)) == 0u) ? 1u : 0u);
+		uint32_t start = 0u;
+
+		while (start < size)
+		{
+			const char *end = memchr(&epochBuffer[start], '\n', size - start);
+			const uint32_t length = (uint32_t)(end - &epochBuffer[start]) + 1u;
+
+			NmeaBench_Data.length += appendSentence(&epochBuffer[start], length);
+			start += length;
+		}
+	}
+}
+
+/**@brief Used to append one sentence to the stream, corrupted if it is its turn.
+ * @param[in]	sentence	Sentence including the checksum and CRLF.
+ * @param[in]	length		Number of characters of the sentence.
+ * @return	Number of bytes appended.
+ */
+static uint32_t appendSentence(const char *sentence, const uint32_t length)
+{
+	uint8_t *out = &NmeaBench_Data.stream[NmeaBench_Data.length];
+	const uint32_t count = NmeaBench_Data.sentences + NmeaBench_Data.corrupted + 1u;
+	uint32_t retVal = length;
+
+	memcpy(out, sentence, length);
+	if ((count % NMEABENCH_CORRUPT_PERIOD) != 0u)
+	{
+		NmeaBench_Data.sentences++;
+	}
+	else if (((count / NMEABENCH_CORRUPT_PERIOD) & 1u) != 0u)
+	{
+		out[length / 2u] ^= 0x01u;
+		NmeaBench_Data.corrupted++;
+	}
+	else
+	{
+		retVal = length / 2u;
+		NmeaBench_Data.corrupted++;
+	}
+
+	return retVal;
+}
+
+/**@brief Used to feed the stream to the decoder in chunks of varying size and count the results.
+ */
+static void decodeStream(void)
+{
+	static GpsNmea_DecoderType decoder;
+	const uint8_t *data = NmeaBench_Data.stream;
+	uint32_t remaining = NmeaBench_Data.length;
+	uint32_t seed = 1u;
+
+	GpsNmea_DecoderInit(&decoder);
+	while (remaining > 0u)
+	{
+		uint32_t chunk = 0u;
+
+		seed = (seed * 1103515245u) + 12345u;
+		chunk = ((seed >> 16u) % NMEABENCH_CHUNK_SIZE) + 1u;
+		chunk = (chunk > remaining) ? remaining : chunk;
+		remaining -= chunk;
+		while (chunk > 0u)
+		{
+			uint32_t consumed = 0u;
+			const GpsNmea_StatusType status = GpsNmea_Decode(&decoder, data, chunk, &consumed);
+
+			if (status == GPSNMEA_STATUS_SENTENCE)
+			{
+				NmeaBench_Data.decoded++;
+			}
+			else if (status == GPSNMEA_STATUS_ERROR)
+			{
+				NmeaBench_Data.errors++;
+			}
+			else
+			{
+				/* Nothing to do. */
+			}
+			data += consumed;
+			chunk -= consumed;
+		}
+	}
+}
+
+/**@brief Used to get the monotonic time.
+ * @return	Time in nanoseconds.
+ */
+static uint64_t getTime(void)
+{
+	struct timespec ts;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
+}
+
+/**@brief Used to get the host cycle counter.
+ * @return	Time stamp counter, 0 if the host has none.
+ */
+static uint64_t getCycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return 0u;
+#endif
+}
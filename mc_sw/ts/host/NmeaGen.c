@@ -0,0 +1,158 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: NmeaGen.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file NmeaGen.c
+* @brief Implements the NMEA stream generator of the host benchmarks.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include <stdarg.h>
+#include <stdio.h>
+#include "NmeaGen.h"
+
+/* Generates the output of a multi-constellation receiver (GPS, GLONASS, Galileo, BeiDou) walking
+ * north-east at 1 m/s: GNRMC, GNGGA, one GNGSA per constellation and GNVTG every epoch, and, with
+ * isSky, the GSV sentences of the 24 tracked satellites, as a receiver outputs them once per second.
+ * The sentences follow NMEA 0183 4.10 and carry valid checksums. */
+
+/**@brief Defines the number of tracked satellites per constellation.
+ */
+#define NMEAGEN_SATELLITES				(6u)
+
+/**@brief Defines the number of satellites of a GSV sentence.
+ */
+#define NMEAGEN_GSV_SATELLITES			(4u)
+
+/**@brief Defines the start position in 1e-5 minutes (48 deg 08.22000 N, 11 deg 34.50000 E).
+ */
+#define NMEAGEN_LATITUDE				(288822000u)
+#define NMEAGEN_LONGITUDE				(69450000u)
+
+/**@brief Defines the displacement per second in 1e-5 minutes (0.7 m north and east).
+ */
+#define NMEAGEN_STEP_LATITUDE			(38u)
+#define NMEAGEN_STEP_LONGITUDE			(57u)
+
+/**@brief Talker identifiers and NMEA system identifiers of the constellations.
+ */
+static const char * const NmeaGen_Talker[4u] = { "GP", "GL", "GA", "GB" };
+
+static uint32_t appendSentence(char *buffer, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+/**@brief Used to generate the sentences of one epoch.
+ * @param[out]	buffer	Sentences, at least NMEAGEN_EPOCH_SIZE bytes.
+ * @param[in]	epoch	Epoch index, the first epoch is at 12:00:00 UTC.
+ * @param[in]	period	Measurement period in milliseconds.
+ * @param[in]	isSky	The GSV sentences are added.
+ * @return	Number of bytes.
+ */
+uint32_t NmeaGen_Epoch(char *buffer, const uint32_t epoch, const uint32_t period, const uint8_t isSky)
+{
+	const uint32_t time = (43200000u + (epoch * period)) % 86400000u;
+	const uint32_t hours = time / 3600000u;
+	const uint32_t minutes = (time / 60000u) % 60u;
+	const uint32_t seconds = (time / 1000u) % 60u;
+	const uint32_t hundredths = (time / 10u) % 100u;
+	const uint32_t latitude = NMEAGEN_LATITUDE + ((epoch * period * NMEAGEN_STEP_LATITUDE) / 1000u);
+	const uint32_t longitude = NMEAGEN_LONGITUDE + ((epoch * period * NMEAGEN_STEP_LONGITUDE) / 1000u);
+	char utc[16u];
+	char position[48u];
+	uint32_t length = 0u;
+	uint32_t system = 0u;
+
+	(void)snprintf(utc, sizeof(utc), "%02u%02u%02u.%02u", hours, minutes, seconds, hundredths);
+	(void)snprintf(position, sizeof(position), "%02u%02u.%05u,N,%03u%02u.%05u,E",
+				   latitude / 6000000u, (latitude / 100000u) % 60u, latitude % 100000u,
+				   longitude / 6000000u, (longitude / 100000u) % 60u, longitude % 100000u);
+
+	length += appendSentence(&buffer[length], "GNRMC,%s,A,%s,1.944,45.00,181026,,,A,V", utc, position);
+	length += appendSentence(&buffer[length], "GNGGA,%s,%s,1,%02u,0.9,520.0,M,47.0,M,,", utc, position, 4u * NMEAGEN_SATELLITES);
+	for (system = 0u; system < 4u; system++)
+	{
+		const uint32_t prn = (system * 32u) + 1u;
+
+		length += appendSentence(&buffer[length], "GNGSA,A,3,%02u,%02u,%02u,%02u,%02u,%02u,,,,,,,1.6,0.9,1.3,%u",
+								 prn, prn + 2u, prn + 5u, prn + 7u, prn + 10u, prn + 13u, system + 1u);
+	}
+	length += appendSentence(&buffer[length], "GNVTG,45.00,T,,M,1.944,N,3.600,K,A");
+
+	for (system = 0u; isSky && (system < 4u); system++)
+	{
+		const uint32_t messages = (NMEAGEN_SATELLITES + NMEAGEN_GSV_SATELLITES - 1u) / NMEAGEN_GSV_SATELLITES;
+		uint32_t message = 0u;
+
+		for (message = 0u; message < messages; message++)
+		{
+			char satellites[80u];
+			uint32_t used = 0u;
+			uint32_t idx = 0u;
+
+			for (idx = message * NMEAGEN_GSV_SATELLITES; (idx < NMEAGEN_SATELLITES) && (idx < ((message + 1u) * NMEAGEN_GSV_SATELLITES)); idx++)
+			{
+				used += (uint32_t)snprintf(&satellites[used], sizeof(satellites) - used, ",%02u,%02u,%03u,%02u",
+										   (system * 32u) + 1u + (idx * 2u), 15u + (idx * 11u), (idx * 61u) % 360u, 30u + ((epoch + idx) % 20u));
+			}
+			length += appendSentence(&buffer[length], "%sGSV,%u,%u,%02u%s,1", NmeaGen_Talker[system],
+									 messages, message + 1u, NMEAGEN_SATELLITES, satellites);
+		}
+	}
+
+	return length;
+}
+
+/**@brief Used to append a sentence with its start delimiter, checksum and line end.
+ * @param[out]	buffer	Sentence.
+ * @param[in]	fmt		printf style format of the sentence body.
+ * @return	Number of bytes.
+ */
+static uint32_t appendSentence(char *buffer, const char *fmt, ...)
+{
+	va_list args;
+	uint32_t length = 1u;
+	uint8_t checksum = 0u;
+	uint32_t idx = 0u;
+
+	buffer[0u] = '$';
+	va_start(args, fmt);
+	length += (uint32_t)vsnprintf(&buffer[1u], NMEAGEN_EPOCH_SIZE / 8u, fmt, args);
+	va_end(args);
+
+	for (idx = 1u; idx < length; idx++)
+	{
+		checksum ^= (uint8_t)buffer[idx];
+	}
+	length += (uint32_t)snprintf(&buffer[length], 6u, "*%02X\r\n", checksum);
+
+	return length;
+}
@@ -0,0 +1,360 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: RouteBench.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file RouteBench.c
+* @brief Implements the host benchmark of the route monitor on a 10000 point route.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+#include "Route.h"
+
+/* Host benchmark, built and run by "make bench" in this directory. The route table is generated by
+ * RouteGen.c with 10000 points (about 225 km with out and back legs) and compiled with
+ * -DROUTE_POINT_NUMBER=10000u instead of cfg/gen/Route_Cfg.c. Fusion.c is not linked, the fused
+ * state is provided by the benchmark.
+ *
+ * - Find: random positions up to about 600 m beside random route points are searched in the grid
+ *   (Route_Find()) and compared with a double precision search over all of the segments. A missed or
+ *   wrong match fails the benchmark.
+ * - Walk: the whole route is walked with one fix every 5 m and 3 m of noise, with a 150 m detour
+ *   of 400 m after 40 km (Route_MainFunction()). The detour has to raise exactly one alert.
+ *
+ * Reported are the host time per fix of the grid search, of the cursor tracking and of the linear
+ * scan, the number of grid searches and the size of the route table and of the grid. */
+
+/**@brief Defines the number of searched random positions.
+ */
+#define ROUTEBENCH_QUERIES				(20000u)
+
+/**@brief Defines the number of random positions searched by the linear scan.
+ */
+#define ROUTEBENCH_SCANS				(400u)
+
+/**@brief Defines the largest offset of a random position from its route point in 1e-7 degrees.
+ */
+#define ROUTEBENCH_SPREAD				(55000)
+
+/**@brief Defines the distance between two fixes of the walk in millimeters.
+ */
+#define ROUTEBENCH_STEP					(5000.0)
+
+/**@brief Defines the noise (one axis) of a fix of the walk in millimeters.
+ */
+#define ROUTEBENCH_NOISE				(3000)
+
+/**@brief Defines the route distance, length and offset of the detour of the walk in millimeters.
+ */
+#define ROUTEBENCH_DETOUR_START			(40000000.0)
+#define ROUTEBENCH_DETOUR_LENGTH		(400000.0)
+#define ROUTEBENCH_DETOUR_OFFSET		(150000.0)
+
+/**@brief Defines the tolerance of a matched distance against the reference, relative and in millimeters.
+ */
+#define ROUTEBENCH_TOLERANCE			(0.002)
+#define ROUTEBENCH_TOLERANCE_MIN		(20.0)
+
+/**@struct RouteBench_DataType
+ * @brief Container used to store the relevant data of the benchmark.
+ */
+typedef struct RouteBench_DataTypeTag
+{
+	uint32_t seed;									/**< State of the random generator. */
+	Fusion_StateType state;							/**< Fused state read by the route monitor. */
+	Fusion_StatisticsType stats;					/**< Filter statistics read by the route monitor. */
+	Geo_PointType query[ROUTEBENCH_QUERIES];		/**< Random positions. */
+	uint32_t failures;								/**< Number of failed checks. */
+} RouteBench_DataType;
+
+static void benchFind(void);
+static void benchWalk(void);
+static double searchAll(const Geo_PointType *point);
+static void getPoint(const uint32_t idx, Geo_PointType *point);
+static int32_t getRandom(const int32_t range);
+static uint64_t getTime(void);
+
+/**@brief Stores the benchmark data.
+ */
+static RouteBench_DataType RouteBench_Data = { .seed = 5u };
+
+/**@brief Entry point of the benchmark.
+ * @return	0 if all of the checks passed, 1 otherwise.
+ */
+int main(void)
+{
+	Route_StatusType status;
+
+	Route_Init();
+	Route_GetStatus(&status);
+	printf("RouteBench: %u points, %.1f km, table %u bytes, grid %u references\n", ROUTE_POINT_NUMBER, status.length / 1e6,
+		   (uint32_t)(sizeof(Route_Block) + sizeof(Route_Point)), status.indexed);
+	if ((status.isValid == FALSE) || (status.indexed == 0u))
+	{
+		printf("RouteBench: route invalid or grid too small\n");
+		RouteBench_Data.failures++;
+	}
+	else
+	{
+		benchFind();
+		benchWalk();
+	}
+
+	return (RouteBench_Data.failures == 0u) ? 0 : 1;
+}
+
+/**@brief Used to provide the fused state to the route monitor.
+ * @param[out]	state	Fused state.
+ */
+void Fusion_GetState(Fusion_StateType *state)
+{
+	*state = RouteBench_Data.state;
+}
+
+/**@brief Used to provide the filter statistics to the route monitor.
+ * @param[out]	stats	Filter statistics.
+ */
+void Fusion_GetStatistics(Fusion_StatisticsType *stats)
+{
+	*stats = RouteBench_Data.stats;
+}
+
+/**@brief Used to compare and time the grid search against the linear scan of all of the segments.
+ */
+static void benchFind(void)
+{
+	Route_MatchType match;
+	uint32_t missed = 0u;
+	uint32_t wrong = 0u;
+	double worst = 0.0;
+	uint64_t start;
+	uint64_t findTime;
+	uint64_t scanTime;
+	volatile double sink = 0.0;
+	uint32_t idx = 0u;
+
+	for (idx = 0u; idx < ROUTEBENCH_QUERIES; idx++)
+	{
+		getPoint((uint32_t)getRandom(ROUTE_POINT_NUMBER), &RouteBench_Data.query[idx]);
+		RouteBench_Data.query[idx].latitude += getRandom(2 * ROUTEBENCH_SPREAD) - ROUTEBENCH_SPREAD;
+		RouteBench_Data.query[idx].longitude += getRandom(2 * ROUTEBENCH_SPREAD) - ROUTEBENCH_SPREAD;
+	}
+
+	for (idx = 0u; idx < ROUTEBENCH_QUERIES; idx++)
+	{
+		const double reference = searchAll(&RouteBench_Data.query[idx]);
+
+		Route_Find(&RouteBench_Data.query[idx], &match);
+		if (reference < (ROUTE_SEARCH_RADIUS * (1.0 - ROUTEBENCH_TOLERANCE)))
+		{
+			const double error = fabs((double)match.offset - reference);
+
+			missed += (match.offset == GEO_DISTANCE_MAX) ? 1u : 0u;
+			wrong += ((match.offset != GEO_DISTANCE_MAX) && (error > ((ROUTEBENCH_TOLERANCE * reference) + ROUTEBENCH_TOLERANCE_MIN))) ? 1u : 0u;
+			worst = ((match.offset != GEO_DISTANCE_MAX) && (error > worst)) ? error : worst;
+		}
+		else if (reference > (ROUTE_SEARCH_RADIUS * (1.0 + ROUTEBENCH_TOLERANCE)))
+		{
+			wrong += (match.offset != GEO_DISTANCE_MAX) ? 1u : 0u;
+		}
+		else
+		{
+			/* Nothing to do. */
+		}
+	}
+
+	start = getTime();
+	for (idx = 0u; idx < ROUTEBENCH_QUERIES; idx++)
+	{
+		Route_Find(&RouteBench_Data.query[idx], &match);
+	}
+	findTime = getTime() - start;
+	start = getTime();
+	for (idx = 0u; idx < ROUTEBENCH_SCANS; idx++)
+	{
+		sink += searchAll(&RouteBench_Data.query[idx]);
+	}
+	scanTime = getTime() - start;
+
+	printf("  find:       %u positions, %u missed, %u wrong, worst distance error %.0f mm\n", ROUTEBENCH_QUERIES, missed, wrong, worst);
+	printf("              grid %.2f us/fix, linear scan (double) %.2f us/fix\n",
+		   (double)findTime / (ROUTEBENCH_QUERIES * 1e3), (double)scanTime / (ROUTEBENCH_SCANS * 1e3));
+	if ((missed != 0u) || (wrong != 0u))
+	{
+		RouteBench_Data.failures++;
+	}
+}
+
+/**@brief Used to walk the whole route with a detour and to time the cursor tracking.
+ */
+static void benchWalk(void)
+{
+	Route_StatusType status;
+	Geo_FrameType frame;
+	Geo_PointType from;
+	Geo_PointType to;
+	Geo_EnuType enu;
+	Geo_EnuType end;
+	double along = 0.0;
+	double position = 0.0;
+	double normalEast = 0.0;
+	double normalNorth = 0.0;
+	uint64_t walkTime = 0u;
+	uint32_t segment = 0u;
+	int32_t altitude = 0;
+
+	RouteBench_Data.state.isValid = TRUE;
+	RouteBench_Data.state.accuracy = ROUTEBENCH_NOISE;
+	while ((segment + 1u) < ROUTE_POINT_NUMBER)
+	{
+		double length = 0.0;
+
+		getPoint(segment, &from);
+		getPoint(segment + 1u, &to);
+		Geo_FrameInit(&frame, &from, 0);
+		Geo_ToEnu(&frame, &to, 0, &end);
+		length = hypot((double)end.east, (double)end.north);
+		if (along >= length)
+		{
+			along -= length;
+			segment++;
+		}
+		else
+		{
+			const double detour = ((position >= ROUTEBENCH_DETOUR_START) && (position < (ROUTEBENCH_DETOUR_START + ROUTEBENCH_DETOUR_LENGTH))) ?
+								  ROUTEBENCH_DETOUR_OFFSET : 0.0;
+			const double ratio = along / length;
+			uint64_t start;
+
+			if (detour == 0.0)
+			{
+				normalEast = end.north / length;
+				normalNorth = -end.east / length;
+			}
+			enu.east = (int32_t)lround((ratio * end.east) + (detour * normalEast)) + getRandom(2 * ROUTEBENCH_NOISE) - ROUTEBENCH_NOISE;
+			enu.north = (int32_t)lround((ratio * end.north) + (detour * normalNorth)) + getRandom(2 * ROUTEBENCH_NOISE) - ROUTEBENCH_NOISE;
+			enu.up = 0;
+			Geo_FromEnu(&frame, &enu, &RouteBench_Data.state.position, &altitude);
+			RouteBench_Data.stats.updates++;
+
+			start = getTime();
+			Route_MainFunction();
+			walkTime += getTime() - start;
+
+			along += ROUTEBENCH_STEP;
+			position += ROUTEBENCH_STEP;
+		}
+	}
+
+	Route_GetStatus(&status);
+	printf("  walk:       %u fixes, %.2f us/fix, %u grid searches, %u cursor jumps, %u alerts\n", status.fixes,
+		   (double)walkTime / (status.fixes * 1e3), status.searches, status.jumps, status.alerts);
+	printf("              progress %.1f of %.1f km\n", status.match.progress / 1e6, status.length / 1e6);
+	if (status.alerts != 1u)
+	{
+		RouteBench_Data.failures++;
+	}
+}
+
+/**@brief Used to get the distance to the route by a double precision search over all of the segments.
+ * @param[in]	point	Position.
+ * @return	Distance to the nearest segment in millimeters.
+ */
+static double searchAll(const Geo_PointType *point)
+{
+	const double east = 111319.5e-4 * cos(point->latitude * (M_PI / 180e7));
+	const double north = 111132.9e-4;
+	double retVal = HUGE_VAL;
+	Geo_PointType from;
+	Geo_PointType to;
+	uint32_t idx = 0u;
+
+	getPoint(0u, &to);
+	for (idx = 1u; idx < ROUTE_POINT_NUMBER; idx++)
+	{
+		double fromEast = 0.0;
+		double fromNorth = 0.0;
+		double deltaEast = 0.0;
+		double deltaNorth = 0.0;
+		double squared = 0.0;
+		double ratio = 0.0;
+
+		from = to;
+		getPoint(idx, &to);
+		fromEast = (double)(from.longitude - point->longitude) * east;
+		fromNorth = (double)(from.latitude - point->latitude) * north;
+		deltaEast = (double)(to.longitude - from.longitude) * east;
+		deltaNorth = (double)(to.latitude - from.latitude) * north;
+		squared = (deltaEast * deltaEast) + (deltaNorth * deltaNorth);
+		ratio = (squared > 0.0) ? -((fromEast * deltaEast) + (fromNorth * deltaNorth)) / squared : 0.0;
+		ratio = (ratio < 0.0) ? 0.0 : ((ratio > 1.0) ? 1.0 : ratio);
+		retVal = fmin(retVal, hypot(fromEast + (ratio * deltaEast), fromNorth + (ratio * deltaNorth)));
+	}
+
+	return retVal;
+}
+
+/**@brief Used to decode a route point.
+ * @param[in]	idx		Index of the point.
+ * @param[out]	point	Position of the point.
+ */
+static void getPoint(const uint32_t idx, Geo_PointType *point)
+{
+	const Route_BlockType *block = &Route_Block[idx / ROUTE_BLOCK_SIZE];
+
+	point->latitude = block->anchor.latitude + ((int32_t)Route_Point[idx].latitude * 10);
+	point->longitude = block->anchor.longitude + ((int32_t)Route_Point[idx].longitude * 10);
+}
+
+/**@brief Used to get a reproducible random number.
+ * @param[in]	range	Number of values.
+ * @return	Random number in [0, range).
+ */
+static int32_t getRandom(const int32_t range)
+{
+	RouteBench_Data.seed = (RouteBench_Data.seed * 1103515245u) + 12345u;
+	return (int32_t)(((uint64_t)(RouteBench_Data.seed >> 8u) * (uint64_t)range) >> 24u);
+}
+
+/**@brief Used to get the monotonic time.
+ * @return	Time in nanoseconds.
+ */
+static uint64_t getTime(void)
+{
+	struct timespec ts;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
+}
@@ -0,0 +1,196 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: RouteGen.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file RouteGen.c
+* @brief Implements the host generator of a long route table.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "Route.h"
+
+/* Host tool, run by the host Makefile to build the route table of RouteBench.
+ *
+ * Usage: RouteGen points > Route_Cfg.c
+ *
+ * Writes a route table in the format of cfg/gen/Route_Cfg.c, to be compiled with
+ * -DROUTE_POINT_NUMBER=<points>u. The route is a reproducible random walk from 47.3 N 10.9 E with
+ * 5 to 40 m between the points and a slowly turning heading. Every ROUTEGEN_TURN_PERIOD points it
+ * turns back, so that the out and back legs cross and overlap like a real trail. The points are
+ * quantized like the generator of the target table; the bounding boxes and the distances (Geo_Distance)
+ * are computed from the quantized points. */
+
+/**@brief Defines the maximum number of points.
+ */
+#define ROUTEGEN_MAX_POINTS				(60000u)
+
+/**@brief Defines the period in points of the turns back.
+ */
+#define ROUTEGEN_TURN_PERIOD			(2500u)
+
+/**@brief Defines the meters per degree of latitude used to place the points.
+ */
+#define ROUTEGEN_METERS_PER_DEGREE		(111000.0)
+
+/**@struct RouteGen_DataType
+ * @brief Container used to store the relevant data of the generator.
+ */
+typedef struct RouteGen_DataTypeTag
+{
+	uint32_t seed;									/**< State of the random generator. */
+	Geo_PointType point[ROUTEGEN_MAX_POINTS];		/**< Quantized points. */
+	Route_PointType offset[ROUTEGEN_MAX_POINTS];	/**< Point offsets from the anchor of their block. */
+} RouteGen_DataType;
+
+static void generate(const uint32_t points);
+static void writeTable(const uint32_t points);
+static double getRandom(const double min, const double max);
+
+/**@brief Stores the generator data.
+ */
+static RouteGen_DataType RouteGen_Data = { .seed = 11u };
+
+/**@brief Entry point of the generator.
+ * @param[in]	argc	Number of arguments.
+ * @param[in]	argv	Arguments.
+ * @return	0 on success, 2 on an error.
+ */
+int main(int argc, char *argv[])
+{
+	const uint32_t points = (argc == 2) ? (uint32_t)strtoul(argv[1], NULL, 10) : 0u;
+	int retVal = 0;
+
+	if ((points < 2u) || (points > ROUTEGEN_MAX_POINTS))
+	{
+		fprintf(stderr, "usage: RouteGen points (2..%u) > Route_Cfg.c\n", ROUTEGEN_MAX_POINTS);
+		retVal = 2;
+	}
+	else
+	{
+		generate(points);
+		writeTable(points);
+	}
+
+	return retVal;
+}
+
+/**@brief Used to generate the random walk and to quantize the points.
+ * @param[in]	points	Number of points.
+ */
+static void generate(const uint32_t points)
+{
+	double latitude = 47.3;
+	double longitude = 10.9;
+	double heading = 0.3;
+	uint32_t idx = 0u;
+
+	for (idx = 0u; idx < points; idx++)
+	{
+		const Geo_PointType *anchor = &RouteGen_Data.point[idx - (idx % ROUTE_BLOCK_SIZE)];
+		double step = 0.0;
+
+		if ((idx % ROUTE_BLOCK_SIZE) == 0u)
+		{
+			RouteGen_Data.point[idx].latitude = (int32_t)lround(latitude * 1e7);
+			RouteGen_Data.point[idx].longitude = (int32_t)lround(longitude * 1e7);
+		}
+		RouteGen_Data.offset[idx].latitude = (int16_t)lround(((latitude * 1e7) - anchor->latitude) / 10.0);
+		RouteGen_Data.offset[idx].longitude = (int16_t)lround(((longitude * 1e7) - anchor->longitude) / 10.0);
+		RouteGen_Data.point[idx].latitude = anchor->latitude + ((int32_t)RouteGen_Data.offset[idx].latitude * 10);
+		RouteGen_Data.point[idx].longitude = anchor->longitude + ((int32_t)RouteGen_Data.offset[idx].longitude * 10);
+
+		heading += getRandom(-0.35, 0.35);
+		heading += ((idx % ROUTEGEN_TURN_PERIOD) == (ROUTEGEN_TURN_PERIOD / 2u)) ? M_PI : 0.0;
+		step = getRandom(5.0, 40.0);
+		latitude += (step * cos(heading)) / ROUTEGEN_METERS_PER_DEGREE;
+		longitude += (step * sin(heading)) / (ROUTEGEN_METERS_PER_DEGREE * cos(latitude * (M_PI / 180.0)));
+	}
+}
+
+/**@brief Used to write the route table.
+ * @param[in]	points	Number of points.
+ */
+static void writeTable(const uint32_t points)
+{
+	const uint32_t blocks = (points + ROUTE_BLOCK_SIZE - 1u) / ROUTE_BLOCK_SIZE;
+	uint32_t distance = 0u;
+	uint32_t block = 0u;
+	uint32_t idx = 0u;
+
+	printf("/* Generated by ts/host/RouteGen.c: %u points, compile with -DROUTE_POINT_NUMBER=%uu. */\n", points, points);
+	printf("#include \"Route.h\"\n\n");
+	printf("const Route_BlockType Route_Block[ROUTE_BLOCK_NUMBER] =\n{\n");
+	for (block = 0u; block < blocks; block++)
+	{
+		const uint32_t first = block * ROUTE_BLOCK_SIZE;
+		const uint32_t last = ((first + ROUTE_BLOCK_SIZE) < points) ? (first + ROUTE_BLOCK_SIZE) : (points - 1u);
+		Geo_PointType min = RouteGen_Data.point[first];
+		Geo_PointType max = RouteGen_Data.point[first];
+
+		for (idx = first + 1u; idx <= last; idx++)
+		{
+			const Geo_PointType *point = &RouteGen_Data.point[idx];
+
+			min.latitude = (point->latitude < min.latitude) ? point->latitude : min.latitude;
+			min.longitude = (point->longitude < min.longitude) ? point->longitude : min.longitude;
+			max.latitude = (point->latitude > max.latitude) ? point->latitude : max.latitude;
+			max.longitude = (point->longitude > max.longitude) ? point->longitude : max.longitude;
+		}
+		printf("\t{\t{%d, %d},\t{%d, %d},\t{%d, %d},\t%uu\t}%s\n", RouteGen_Data.point[first].latitude, RouteGen_Data.point[first].longitude,
+			   min.latitude, min.longitude, max.latitude, max.longitude, distance, ((block + 1u) < blocks) ? "," : "");
+		for (idx = first; (idx < (first + ROUTE_BLOCK_SIZE)) && ((idx + 1u) < points); idx++)
+		{
+			distance += Geo_Distance(&RouteGen_Data.point[idx], &RouteGen_Data.point[idx + 1u]);
+		}
+	}
+	printf("};\n\nconst Route_PointType Route_Point[ROUTE_POINT_NUMBER] =\n{\n");
+	for (idx = 0u; idx < points; idx++)
+	{
+		printf("\t{%d, %d}%s\n", RouteGen_Data.offset[idx].latitude, RouteGen_Data.offset[idx].longitude, ((idx + 1u) < points) ? "," : "");
+	}
+	printf("};\n");
+}
+
+/**@brief Used to get a reproducible random number.
+ * @param[in]	min		Lower limit.
+ * @param[in]	max		Upper limit.
+ * @return	Random number in [min, max).
+ */
+static double getRandom(const double min, const double max)
+{
+	RouteGen_Data.seed = (RouteGen_Data.seed * 1103515245u) + 12345u;
+	return min + (((max - min) * (double)(RouteGen_Data.seed >> 8u)) / 16777216.0);
+}
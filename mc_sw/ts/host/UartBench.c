@@ -0,0 +1,377 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: UartBench.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file UartBench.c
+* @brief Implements the host benchmark of the GPS receive and parse path on the pseudo terminal UART backend.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "Gps.h"
+#include "NmeaGen.h"
+
+/* Host benchmark, built and run by "make bench" in this directory with -DVFB_BACKEND=VFB_BACKEND_LINUX
+ * and -DGPS_PROTOCOL=GPS_PROTOCOL_NMEA.
+ *
+ * Usage: UartBench [-k cycles_per_ns] [-r bytes_per_s] [-s seconds] [stream.nmea]
+ *
+ * A child process writes the NMEA stream to the pseudo terminal of the GPS channel, the benchmark
+ * serves the emulated DMA (receive: Vfb_Uart_LinuxServe() and the UART handler events) and runs
+ * Gps_MainFunction() (parse: ring access, decoder and merge) in a loop until all of the bytes were
+ * parsed. Only the calls which received or parsed bytes are timed, idle polling is not a cost. Without a stream file, "seconds" (default 60) of 10 Hz multi-constellation output with the
+ * GSV sentences at 1 Hz are generated (NmeaGen.c).
+ *
+ * Reported are the throughput of the whole path, the host nanoseconds per byte of each stage and
+ * the byte rate of the stream against the capacity of the GPS line. With -k (target realtime counter
+ * cycles per host nanosecond, calibrated once from Gps_GetStatistics() of a target run) the target
+ * cycles per byte and the CPU load at the stream rate are estimated. With -r the reception is
+ * limited to the given byte rate, e.g. the line rate, and the load is measured against wall time;
+ * the receive cost then holds one system call per few bytes, the unlimited run gives the per-byte cost.
+ * The exit code is 1 if a sentence was corrupted or the ring overran. */
+
+/**@brief Defines the measurement period of the generated stream in milliseconds (10 Hz).
+ */
+#define UARTBENCH_PERIOD				(100u)
+
+/**@brief Defines the default duration of the generated stream in seconds.
+ */
+#define UARTBENCH_SECONDS				(60u)
+
+/**@brief Defines the target core frequency in MHz.
+ */
+#define UARTBENCH_CORE_MHZ				(80u)
+
+/**@brief Defines the time without received bytes after which the writer is considered stalled, in nanoseconds.
+ */
+#define UARTBENCH_STALL_TIME			(2000000000ull)
+
+/**@struct UartBench_DataType
+ * @brief Container used to store the relevant data of the benchmark.
+ */
+typedef struct UartBench_DataTypeTag
+{
+	char *stream;						/**< NMEA stream. */
+	uint32_t length;					/**< Number of bytes of the stream. */
+	uint32_t duration;					/**< Duration of the stream in seconds. */
+	double cyclesPerNs;					/**< Target cycles per host nanosecond, 0 if unknown. */
+	uint32_t rate;						/**< Reception byte rate limit, 0 for unlimited. */
+	uint64_t receiveTime;				/**< Host nanoseconds in the receive stage. */
+	uint64_t parseTime;					/**< Host nanoseconds in the parse stage. */
+	uint64_t wallTime;					/**< Host nanoseconds of the whole run. */
+} UartBench_DataType;
+
+static int loadStream(const char *name);
+static void generateStream(const uint32_t seconds);
+static void writeStream(const char *name);
+static void run(void);
+static int report(void);
+static uint64_t getTime(void);
+
+/**@brief Stores the benchmark data.
+ */
+static UartBench_DataType UartBench_Data;
+
+/**@brief Entry point of the benchmark.
+ * @param[in]	argc	Number of arguments.
+ * @param[in]	argv	Arguments.
+ * @return	0 if the stream was received and parsed without loss, 1 otherwise, 2 on an error.
+ */
+int main(int argc, char *argv[])
+{
+	const char *streamName = NULL;
+	uint32_t seconds = UARTBENCH_SECONDS;
+	char ptyName[64u];
+	pid_t writer;
+	int retVal = 0;
+	int idx = 0;
+
+	for (idx = 1; (idx < argc) && (retVal == 0); idx++)
+	{
+		if ((strcmp(argv[idx], "-k") == 0) && ((idx + 1) < argc))
+		{
+			UartBench_Data.cyclesPerNs = strtod(argv[++idx], NULL);
+		}
+		else if ((strcmp(argv[idx], "-r") == 0) && ((idx + 1) < argc))
+		{
+			UartBench_Data.rate = (uint32_t)strtoul(argv[++idx], NULL, 10);
+		}
+		else if ((strcmp(argv[idx], "-s") == 0) && ((idx + 1) < argc))
+		{
+			seconds = (uint32_t)strtoul(argv[++idx], NULL, 10);
+		}
+		else if ((argv[idx][0] != '-') && (streamName == NULL))
+		{
+			streamName = argv[idx];
+		}
+		else
+		{
+			fprintf(stderr, "usage: UartBench [-k cycles_per_ns] [-r bytes_per_s] [-s seconds] [stream.nmea]\n");
+			retVal = 2;
+		}
+	}
+
+	if (retVal == 0)
+	{
+		if (streamName != NULL)
+		{
+			retVal = loadStream(streamName);
+		}
+		else
+		{
+			generateStream(seconds);
+		}
+	}
+
+	if ((retVal == 0) && (Vfb_Uart_LinuxOpenPty(UartHndlr_Config[GPS_CHANNEL].driver, ptyName, sizeof(ptyName)) < 0))
+	{
+		perror("UartBench: pty");
+		retVal = 2;
+	}
+
+	if (retVal == 0)
+	{
+		Vfb_Dio_Init();
+		UartHndlr_Init();
+		Gps_Init(20u);
+		Vfb_Uart_LinuxSetRate(UartHndlr_Config[GPS_CHANNEL].driver, UartBench_Data.rate);
+
+		writer = fork();
+		if (writer == 0)
+		{
+			writeStream(ptyName);
+		}
+		else if (writer < 0)
+		{
+			perror("UartBench: fork");
+			retVal = 2;
+		}
+		else
+		{
+			run();
+			(void)waitpid(writer, NULL, 0);
+			retVal = report();
+		}
+	}
+
+	return retVal;
+}
+
+/**@brief Used to load a recorded stream.
+ * @param[in]	name	Path of the stream.
+ * @return	0 on success, 2 on an error.
+ */
+static int loadStream(const char *name)
+{
+	FILE *file = fopen(name, "rb");
+	int retVal = 2;
+
+	if ((file != NULL) && (fseek(file, 0, SEEK_END) == 0))
+	{
+		const long size = ftell(file);
+
+		if ((size > 0) && (fseek(file, 0, SEEK_SET) == 0))
+		{
+			UartBench_Data.stream = malloc((size_t)size);
+			if ((UartBench_Data.stream != NULL) && (fread(UartBench_Data.stream, 1u, (size_t)size, file) == (size_t)size))
+			{
+				UartBench_Data.length = (uint32_t)size;
+				retVal = 0;
+			}
+		}
+	}
+
+	if (file != NULL)
+	{
+		(void)fclose(file);
+	}
+	if (retVal != 0)
+	{
+		fprintf(stderr, "UartBench: can not load %s\n", name);
+	}
+
+	return retVal;
+}
+
+/**@brief Used to generate the stream of a 10 Hz multi-constellation receiver.
+ * @param[in]	seconds	Duration of the stream.
+ */
+static void generateStream(const uint32_t seconds)
+{
+	const uint32_t epochs = seconds * (1000u / UARTBENCH_PERIOD);
+	uint32_t epoch = 0u;
+
+	UartBench_Data.stream = malloc((size_t)epochs * NMEAGEN_EPOCH_SIZE);
+	UartBench_Data.duration = seconds;
+	for (epoch = 0u; (UartBench_Data.stream != NULL) && (epoch < epochs); epoch++)
+	{
+		UartBench_Data.length += NmeaGen_Epoch(&UartBench_Data.stream[UartBench_Data.length], epoch, UARTBENCH_PERIOD,
+											   ((epoch % (1000u / UARTBENCH_PERIOD)) == 0u) ? 1u : 0u);
+	}
+}
+
+/**@brief Writer process: sends the stream through the slave side of the pseudo terminal.
+ * @param[in]	name	Path of the pseudo terminal slave.
+ */
+static void writeStream(const char *name)
+{
+	const int fd = open(name, O_WRONLY | O_NOCTTY);
+	uint32_t sent = 0u;
+
+	if (fd >= 0)
+	{
+		struct termios tio;
+
+		if (tcgetattr(fd, &tio) == 0)
+		{
+			cfmakeraw(&tio);
+			(void)tcsetattr(fd, TCSANOW, &tio);
+		}
+		while (sent < UartBench_Data.length)
+		{
+			const ssize_t count = write(fd, &UartBench_Data.stream[sent], UartBench_Data.length - sent);
+
+			if (count <= 0)
+			{
+				break;
+			}
+			sent += (uint32_t)count;
+		}
+		(void)tcdrain(fd);
+		(void)close(fd);
+	}
+	_exit((sent == UartBench_Data.length) ? 0 : 2);
+}
+
+/**@brief Used to receive and parse the stream, timing each stage.
+ */
+static void run(void)
+{
+	const Vfb_UartDriverType *drv = UartHndlr_Config[GPS_CHANNEL].driver;
+	Gps_StatisticsType stats;
+	const uint64_t start = getTime();
+	uint64_t progressTime = start;
+
+	do
+	{
+		const uint64_t received = drv->rxBytes;
+		const uint64_t serveStart = getTime();
+		uint64_t parseStart;
+		uint32_t parsed;
+
+		Vfb_Uart_LinuxServe();
+		parseStart = getTime();
+		if (drv->rxBytes != received)
+		{
+			UartBench_Data.receiveTime += parseStart - serveStart;
+			progressTime = parseStart;
+		}
+		Gps_GetStatistics(&stats);
+		parsed = stats.bytes;
+		parseStart = getTime();
+		Gps_MainFunction();
+		Gps_GetStatistics(&stats);
+		if (stats.bytes != parsed)
+		{
+			UartBench_Data.parseTime += getTime() - parseStart;
+		}
+	} while ((stats.bytes < UartBench_Data.length) && ((getTime() - progressTime) < UARTBENCH_STALL_TIME));
+
+	UartBench_Data.wallTime = getTime() - start;
+}
+
+/**@brief Used to print the results.
+ * @return	0 if the stream was received and parsed without loss, 1 otherwise.
+ */
+static int report(void)
+{
+	const uint32_t line = UARTHNDLR_GPS_BAUDRATE / 10u;
+	const uint32_t overruns = UartHndlr_GetRxOverruns(GPS_CHANNEL);
+	Gps_StatisticsType stats;
+	double receivePerByte;
+	double parsePerByte;
+	double decodePerByte;
+
+	Gps_GetStatistics(&stats);
+	receivePerByte = (double)UartBench_Data.receiveTime / (double)UartBench_Data.length;
+	parsePerByte = (double)UartBench_Data.parseTime / (double)UartBench_Data.length;
+	decodePerByte = ((double)stats.parseTime * 1000.0 / (double)(HOSTOS_REALTIME_FREQUENCY / 1000000u)) / (double)UartBench_Data.length;
+
+	printf("UartBench: %u bytes, %u sentences, %u parse errors, %u overruns\n", stats.bytes, stats.messages, stats.errors, overruns);
+	if (UartBench_Data.duration != 0u)
+	{
+		const uint32_t rate = UartBench_Data.length / UartBench_Data.duration;
+
+		printf("  stream:     %u bytes/s at 10 Hz, %.1f %% of the GPS line (%u bytes/s)\n", rate, (100.0 * rate) / line, line);
+	}
+	printf("  throughput: %.2f Mbytes/s (receive and parse, %.3f s wall time)\n",
+		   (double)UartBench_Data.length * 1000.0 / (double)UartBench_Data.wallTime, (double)UartBench_Data.wallTime / 1e9);
+	printf("  host:       receive %.2f ns/byte, parse %.2f ns/byte (decoder %.2f ns/byte)\n", receivePerByte, parsePerByte, decodePerByte);
+	if (UartBench_Data.rate != 0u)
+	{
+		printf("  load:       %.2f %% of the host core at %u bytes/s\n",
+			   100.0 * (double)(UartBench_Data.receiveTime + UartBench_Data.parseTime) / (double)UartBench_Data.wallTime, UartBench_Data.rate);
+	}
+	if (UartBench_Data.cyclesPerNs > 0.0)
+	{
+		const double cycles = (receivePerByte + parsePerByte) * UartBench_Data.cyclesPerNs;
+
+		printf("  target:     receive %.1f cycles/byte, parse %.1f cycles/byte", receivePerByte * UartBench_Data.cyclesPerNs, parsePerByte * UartBench_Data.cyclesPerNs);
+		if (UartBench_Data.duration != 0u)
+		{
+			printf(", %.2f %% of %u MHz at the stream rate", cycles * (double)(UartBench_Data.length / UartBench_Data.duration) / (UARTBENCH_CORE_MHZ * 1e4), UARTBENCH_CORE_MHZ);
+		}
+		printf("\n");
+	}
+
+	return ((stats.bytes == UartBench_Data.length) && (stats.errors == 0u) && (overruns == 0u)) ? 0 : 1;
+}
+
+/**@brief Used to get the monotonic time.
+ * @return	Time in nanoseconds.
+ */
+static uint64_t getTime(void)
+{
+	struct timespec ts;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
+}
@@ -0,0 +1,345 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: UartLoopback.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file UartLoopback.c
+* @brief Implements the host loopback test of the UART handler on the Linux backend.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "UartHndlr.h"
+
+/* Host test, built and run by "make test" in this directory with -DVFB_BACKEND=VFB_BACKEND_LINUX.
+ * The GPS channel driver is attached to one end of a socketpair, the test plays the receiver on the
+ * other end. The received stream is checked byte by byte across many wraps of the circular buffer,
+ * an overrun has to be counted and the stream has to resume cleanly after it, and a scatter-gather
+ * transmit request has to arrive in order, with backpressure while the descriptor pool is full and
+ * the split of a transfer longer than one DMA transmission. */
+
+/**@brief Defines the channel under test.
+ */
+#define UARTLOOPBACK_CHANNEL			(UARTHNDLR_CHANNEL_GPS)
+
+/**@brief Defines the number of bytes streamed by the receive test.
+ */
+#define UARTLOOPBACK_STREAM_SIZE		(65536u)
+
+/**@brief Defines the largest chunk written at once by the receive test.
+ */
+#define UARTLOOPBACK_CHUNK_SIZE			(300u)
+
+/**@brief Defines the size of the scatter-gather transmit request (three segments).
+ */
+#define UARTLOOPBACK_SEGMENTS_SIZE		(801u)
+
+/**@brief Defines the size of the long transmit segment, split in two DMA transmissions.
+ */
+#define UARTLOOPBACK_LONG_SIZE			(70000u)
+
+/**@brief Defines the maximum number of serve calls waiting for an event.
+ */
+#define UARTLOOPBACK_SERVE_LIMIT		(100000u)
+
+/**@struct UartLoopback_DataType
+ * @brief Container used to store the relevant data of the test.
+ */
+typedef struct UartLoopback_DataTypeTag
+{
+	int peer;								/**< Receiver end of the socketpair. */
+	uint32_t written;						/**< Stream bytes written to the channel. */
+	uint32_t expected;						/**< Stream index of the next byte to be received. */
+	uint32_t mismatches;					/**< Received bytes differing from the stream. */
+	uint32_t txDone;						/**< Number of completed transmit requests. */
+	uint32_t checks;						/**< Number of checks. */
+	uint32_t failures;						/**< Number of failed checks. */
+	uint8_t buffer[UARTLOOPBACK_LONG_SIZE];	/**< Transmit data. */
+	uint8_t received[UARTLOOPBACK_LONG_SIZE];	/**< Data received by the peer. */
+} UartLoopback_DataType;
+
+static void testReceive(void);
+static void testOverrun(void);
+static void testTransmit(void);
+static void writeStream(const uint32_t length);
+static void serveUntilReceived(const uint8_t isDrained);
+static void drain(void);
+static uint32_t readPeer(uint8_t *data, const uint32_t length);
+static void txDone(const UartHndlr_ChannelType channel, void *context);
+static void check(const int condition, const char *name);
+
+/**@brief Stores the test data.
+ */
+static UartLoopback_DataType UartLoopback_Data;
+
+/**@brief Defines the stream pattern, a byte sequence which does not repeat with any buffer size.
+ * @param[in]	n	Stream index.
+ */
+#define UARTLOOPBACK_PATTERN(n)			((uint8_t)(((n) * 31u) + ((n) >> 8u)))
+
+/**@brief Entry point of the test.
+ * @return	0 if all checks passed, 1 otherwise.
+ */
+int main(void)
+{
+	int fds[2];
+
+	if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+	{
+		perror("socketpair");
+		return 1;
+	}
+	UartLoopback_Data.peer = fds[1];
+	Vfb_Uart_LinuxAttach(UartHndlr_Config[UARTLOOPBACK_CHANNEL].driver, fds[0]);
+	UartHndlr_Init();
+
+	testReceive();
+	testOverrun();
+	testTransmit();
+
+	UartHndlr_Deinit();
+	printf("UartLoopback: %u checks, %u failed\n", UartLoopback_Data.checks, UartLoopback_Data.failures);
+
+	return (UartLoopback_Data.failures == 0u) ? 0 : 1;
+}
+
+/**@brief Streams data in chunks of varying length, drained after each serve like by the GPS task.
+ */
+static void testReceive(void)
+{
+	const uint32_t size = UartHndlr_Config[UARTLOOPBACK_CHANNEL].rxBufferSize;
+	uint32_t seed = 1u;
+
+	while (UartLoopback_Data.written < UARTLOOPBACK_STREAM_SIZE)
+	{
+		seed = (seed * 1103515245u) + 12345u;
+		writeStream(1u + ((seed >> 16u) % UARTLOOPBACK_CHUNK_SIZE));
+		serveUntilReceived(TRUE);
+	}
+
+	check(UartLoopback_Data.expected == UartLoopback_Data.written, "receive: all bytes received");
+	check(UartLoopback_Data.mismatches == 0u, "receive: no corrupted byte");
+	check(UartHndlr_GetRxOverruns(UARTLOOPBACK_CHANNEL) == 0u, "receive: no overrun");
+	check((UartLoopback_Data.written / size) >= 32u, "receive: buffer wrapped");
+}
+
+/**@brief Lets the DMA overtake the consumer, then checks that the stream resumes after the overrun.
+ */
+static void testOverrun(void)
+{
+	const uint32_t size = UartHndlr_Config[UARTLOOPBACK_CHANNEL].rxBufferSize;
+	const uint8_t *data = NULL;
+
+	writeStream(3u * size);
+	serveUntilReceived(FALSE);
+	check(UartHndlr_GetRxData(UARTLOOPBACK_CHANNEL, &data) == 0u, "overrun: pending data dropped");
+	check(UartHndlr_GetRxOverruns(UARTLOOPBACK_CHANNEL) == 1u, "overrun: counted once");
+
+	UartLoopback_Data.expected = UartLoopback_Data.written;
+	writeStream(size + (size / 3u));
+	serveUntilReceived(TRUE);
+	check(UartLoopback_Data.expected == UartLoopback_Data.written, "overrun: stream resumed");
+	check(UartLoopback_Data.mismatches == 0u, "overrun: no corrupted byte after resume");
+}
+
+/**@brief Sends a scatter-gather request and a long request and checks them on the peer.
+ */
+static void testTransmit(void)
+{
+	const uint32_t pool = UartHndlr_Config[UARTLOOPBACK_CHANNEL].txPoolSize;
+	const UartHndlr_TxSegmentType segments[3] =
+	{
+		{ &UartLoopback_Data.buffer[0u], 1u },
+		{ &UartLoopback_Data.buffer[1u], 100u },
+		{ &UartLoopback_Data.buffer[101u], 700u }
+	};
+	const UartHndlr_TxSegmentType empty = { UartLoopback_Data.buffer, 0u };
+	const UartHndlr_TxSegmentType longSegment = { UartLoopback_Data.buffer, UARTLOOPBACK_LONG_SIZE };
+	uint32_t count = 0u;
+	uint32_t idx = 0u;
+
+	for (idx = 0u; idx < UARTLOOPBACK_LONG_SIZE; idx++)
+	{
+		UartLoopback_Data.buffer[idx] = UARTLOOPBACK_PATTERN(idx);
+	}
+
+	check(UartHndlr_Transmit(UARTLOOPBACK_CHANNEL, &empty, 1u, NULL, NULL) == FALSE, "transmit: empty segment rejected");
+	check(UartHndlr_Transmit(UARTLOOPBACK_CHANNEL, segments, 3u, txDone, NULL) == TRUE, "transmit: request queued");
+	check(UartHndlr_GetTxFree(UARTLOOPBACK_CHANNEL) == (pool - 3u), "transmit: descriptors taken");
+	check(UartHndlr_Transmit(UARTLOOPBACK_CHANNEL, segments, pool - 2u, NULL, NULL) == FALSE, "transmit: backpressure");
+
+	for (idx = 0u; (idx < UARTLOOPBACK_SERVE_LIMIT) && (UartLoopback_Data.txDone == 0u); idx++)
+	{
+		Vfb_Uart_LinuxServe();
+	}
+	count = readPeer(UartLoopback_Data.received, UARTLOOPBACK_SEGMENTS_SIZE);
+	check(UartLoopback_Data.txDone == 1u, "transmit: request completed");
+	check(UartHndlr_GetTxFree(UARTLOOPBACK_CHANNEL) == pool, "transmit: descriptors released");
+	check((count == UARTLOOPBACK_SEGMENTS_SIZE) && (memcmp(UartLoopback_Data.received, UartLoopback_Data.buffer, count) == 0), "transmit: segments in order");
+
+	check(UartHndlr_Transmit(UARTLOOPBACK_CHANNEL, &longSegment, 1u, txDone, NULL) == TRUE, "transmit: long request queued");
+	count = 0u;
+	for (idx = 0u; (idx < UARTLOOPBACK_SERVE_LIMIT) && (UartLoopback_Data.txDone == 1u); idx++)
+	{
+		Vfb_Uart_LinuxServe();
+		count += readPeer(&UartLoopback_Data.received[count], UARTLOOPBACK_LONG_SIZE - count);
+	}
+	count += readPeer(&UartLoopback_Data.received[count], UARTLOOPBACK_LONG_SIZE - count);
+	check(UartLoopback_Data.txDone == 2u, "transmit: long request completed");
+	check(count == UARTLOOPBACK_LONG_SIZE, "transmit: long request length");
+	check(memcmp(UartLoopback_Data.received, UartLoopback_Data.buffer, UARTLOOPBACK_LONG_SIZE) == 0, "transmit: long request content");
+}
+
+/**@brief Used to write the next bytes of the stream to the channel.
+ * @param[in]	length	Number of bytes.
+ */
+static void writeStream(const uint32_t length)
+{
+	uint8_t chunk[4096u];
+	uint32_t done = 0u;
+
+	while (done < length)
+	{
+		uint32_t part = length - done;
+		uint32_t idx = 0u;
+
+		if (part > sizeof(chunk))
+		{
+			part = sizeof(chunk);
+		}
+		for (idx = 0u; idx < part; idx++)
+		{
+			chunk[idx] = UARTLOOPBACK_PATTERN(UartLoopback_Data.written + idx);
+		}
+		if (write(UartLoopback_Data.peer, chunk, part) != (ssize_t)part)
+		{
+			perror("write");
+			break;
+		}
+		UartLoopback_Data.written += part;
+		done += part;
+	}
+}
+
+/**@brief Used to serve the driver until all of the written bytes were received by the emulated DMA.
+ * @details One more serve raises the idle line event of the last block.
+ * @param[in]	isDrained	The received data is consumed after each serve.
+ */
+static void serveUntilReceived(const uint8_t isDrained)
+{
+	const Vfb_UartDriverType *drv = UartHndlr_Config[UARTLOOPBACK_CHANNEL].driver;
+	uint32_t idx = 0u;
+
+	for (idx = 0u; (idx < UARTLOOPBACK_SERVE_LIMIT) && (drv->rxBytes < (uint64_t)UartLoopback_Data.written); idx++)
+	{
+		Vfb_Uart_LinuxServe();
+		if (isDrained)
+		{
+			drain();
+		}
+	}
+
+	Vfb_Uart_LinuxServe();
+	if (isDrained)
+	{
+		drain();
+	}
+}
+
+/**@brief Used to consume the received data of the channel and compare it with the stream.
+ */
+static void drain(void)
+{
+	const uint8_t *data = NULL;
+	uint32_t length = 0u;
+
+	while ((length = UartHndlr_GetRxData(UARTLOOPBACK_CHANNEL, &data)) > 0u)
+	{
+		uint32_t idx = 0u;
+
+		for (idx = 0u; idx < length; idx++)
+		{
+			if (data[idx] != UARTLOOPBACK_PATTERN(UartLoopback_Data.expected))
+			{
+				UartLoopback_Data.mismatches++;
+			}
+			UartLoopback_Data.expected++;
+		}
+		UartHndlr_ReleaseRxData(UARTLOOPBACK_CHANNEL, length);
+	}
+}
+
+/**@brief Used to read the bytes transmitted by the channel without blocking.
+ * @param[out]	data	Received bytes.
+ * @param[in]	length	Maximum number of bytes.
+ * @return	Number of bytes read.
+ */
+static uint32_t readPeer(uint8_t *data, const uint32_t length)
+{
+	uint32_t retVal = 0u;
+	ssize_t count = 0;
+
+	while ((retVal < length) && ((count = recv(UartLoopback_Data.peer, &data[retVal], length - retVal, MSG_DONTWAIT)) > 0))
+	{
+		retVal += (uint32_t)count;
+	}
+
+	return retVal;
+}
+
+/**@brief Transmit request notification.
+ * @param[in]	channel	UART channel identifier.
+ * @param[in]	context	Request context.
+ */
+static void txDone(const UartHndlr_ChannelType channel, void *context)
+{
+	(void)channel;
+	(void)context;
+	UartLoopback_Data.txDone++;
+}
+
+/**@brief Used to record the result of a check.
+ * @param[in]	condition	Check result.
+ * @param[in]	name		Check name, printed on a failure.
+ */
+static void check(const int condition, const char *name)
+{
+	UartLoopback_Data.checks++;
+	if (condition == 0)
+	{
+		UartLoopback_Data.failures++;
+		printf("UartLoopback: FAILED %s\n", name);
+	}
+}
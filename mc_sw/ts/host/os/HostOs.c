@@ -0,0 +1,292 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: HostOs.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file HostOs.c
+* @brief Implements the host kernel services used by the host programs.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#define _POSIX_C_SOURCE 199309L
+#include <time.h>
+#include "ch.h"
+#include "Log.h"
+#include "Os.h"
+
+/**@brief Defines the number of nanoseconds in a second.
+ */
+#define HOSTOS_NS_PER_SECOND			(1000000000ull)
+
+/**@struct HostOs_DataType
+ * @brief Container used to store the state of the host kernel services.
+ */
+typedef struct HostOs_DataTypeTag
+{
+	systime_t time;										/**< Virtual system time in ticks. */
+	virtual_timer_t *timer[HOSTOS_TIMER_NUMBER];		/**< Armed virtual timers. */
+	eventmask_t events[OS_THREAD_NUMBER];				/**< Events signaled to each task and not yet read. */
+	thread_t task[OS_THREAD_NUMBER];					/**< Thread fields read by the modules. */
+	uint32_t logRecords;								/**< Number of log records written. */
+} HostOs_DataType;
+
+/**@brief Stores the state of the host kernel services.
+ */
+static HostOs_DataType HostOs_Data;
+
+void chSysLock(void)
+{
+	/* Nothing to do. */
+}
+
+void chSysUnlock(void)
+{
+	/* Nothing to do. */
+}
+
+void chSysLockFromISR(void)
+{
+	/* Nothing to do. */
+}
+
+void chSysUnlockFromISR(void)
+{
+	/* Nothing to do. */
+}
+
+/**@brief Used to get the realtime counter.
+ * @return	Host monotonic time in cycles of the target core clock.
+ */
+rtcnt_t chSysGetRealtimeCounterX(void)
+{
+	struct timespec ts;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (rtcnt_t)((((uint64_t)ts.tv_sec * HOSTOS_NS_PER_SECOND) + (uint64_t)ts.tv_nsec) * (HOSTOS_REALTIME_FREQUENCY / 1000000u) / 1000u);
+}
+
+/**@brief Used to busy wait, the bus timing does not matter on the host.
+ * @param[in]	cycles	Number of realtime counter cycles.
+ */
+void chSysPolledDelayX(rtcnt_t cycles)
+{
+	(void)cycles;
+}
+
+/**@brief Used to get the virtual system time.
+ * @return	System time in ticks.
+ */
+systime_t chVTGetSystemTimeX(void)
+{
+	return HostOs_Data.time;
+}
+
+/**@brief Used to initialize a virtual timer.
+ * @param[in]	vtp		Virtual timer.
+ */
+void chVTObjectInit(virtual_timer_t *vtp)
+{
+	vtp->func = NULL;
+	vtp->par = NULL;
+	vtp->when = 0u;
+}
+
+/**@brief Used to arm a virtual timer, an armed timer is rearmed.
+ * @param[in]	vtp		Virtual timer.
+ * @param[in]	delay	Delay in ticks.
+ * @param[in]	vtfunc	Callback.
+ * @param[in]	par		Callback argument.
+ */
+void chVTSetI(virtual_timer_t *vtp, systime_t delay, vtfunc_t vtfunc, void *par)
+{
+	uint32_t idx = 0u;
+	uint32_t slot = HOSTOS_TIMER_NUMBER;
+
+	for (idx = 0u; idx < HOSTOS_TIMER_NUMBER; idx++)
+	{
+		if ((HostOs_Data.timer[idx] == vtp) || ((HostOs_Data.timer[idx] == NULL) && (slot == HOSTOS_TIMER_NUMBER)))
+		{
+			slot = idx;
+		}
+	}
+
+	if (slot < HOSTOS_TIMER_NUMBER)
+	{
+		vtp->func = vtfunc;
+		vtp->par = par;
+		vtp->when = HostOs_Data.time + delay;
+		HostOs_Data.timer[slot] = vtp;
+	}
+}
+
+/**@brief Used to disarm a virtual timer.
+ * @param[in]	vtp		Virtual timer.
+ */
+void chVTResetI(virtual_timer_t *vtp)
+{
+	uint32_t idx = 0u;
+
+	for (idx = 0u; idx < HOSTOS_TIMER_NUMBER; idx++)
+	{
+		if (HostOs_Data.timer[idx] == vtp)
+		{
+			HostOs_Data.timer[idx] = NULL;
+		}
+	}
+	vtp->func = NULL;
+}
+
+void chMtxObjectInit(mutex_t *mp)
+{
+	mp->depth = 0u;
+}
+
+void chMtxLock(mutex_t *mp)
+{
+	mp->depth++;
+}
+
+void chMtxUnlock(mutex_t *mp)
+{
+	mp->depth--;
+}
+
+/**@brief Used to sleep, advances the virtual system time instead.
+ * @param[in]	msec	Time in milliseconds.
+ */
+void chThdSleepMilliseconds(uint32_t msec)
+{
+	HostOs_Advance(msec);
+}
+
+/**@brief Used to advance the virtual system time one tick at a time, firing the expired virtual timers.
+ * @param[in]	msec	Time in milliseconds.
+ */
+void HostOs_Advance(const uint32_t msec)
+{
+	uint32_t tick = 0u;
+
+	for (tick = 0u; tick < MS2ST(msec); tick++)
+	{
+		uint32_t idx = 0u;
+
+		HostOs_Data.time++;
+		for (idx = 0u; idx < HOSTOS_TIMER_NUMBER; idx++)
+		{
+			virtual_timer_t *vtp = HostOs_Data.timer[idx];
+
+			if ((vtp != NULL) && ((systime_t)(HostOs_Data.time - vtp->when) < (systime_t)0x80000000u))
+			{
+				const vtfunc_t func = vtp->func;
+
+				HostOs_Data.timer[idx] = NULL;
+				vtp->func = NULL;
+				func(vtp->par);
+			}
+		}
+	}
+}
+
+/**@brief Used to get a task, no thread runs on the host so its fields stay zero.
+ * @param[in]	id	Task index.
+ * @return	Thread, NULL for an unknown task.
+ */
+thread_t *Os_GetTask(const uint32_t id)
+{
+	thread_t *retVal = NULL;
+
+	if (id < OS_THREAD_NUMBER)
+	{
+		retVal = &HostOs_Data.task[id];
+	}
+
+	return retVal;
+}
+
+/**@brief Used to signal events to a task.
+ * @param[in]	id		Task index.
+ * @param[in]	events	Events to signal.
+ */
+void Os_SetEvent(const uint32_t id, const eventmask_t events)
+{
+	if (id < OS_THREAD_NUMBER)
+	{
+		HostOs_Data.events[id] |= events;
+	}
+}
+
+/**@brief Used to signal events to a task from the ISR context.
+ * @param[in]	id		Task index.
+ * @param[in]	events	Events to signal.
+ */
+void Os_SetEventI(const uint32_t id, const eventmask_t events)
+{
+	Os_SetEvent(id, events);
+}
+
+/**@brief Used to read and clear the events signaled to a task.
+ * @param[in]	id	Task index.
+ * @return	Signaled events.
+ */
+eventmask_t HostOs_GetEvents(const uint32_t id)
+{
+	eventmask_t retVal = 0u;
+
+	if (id < OS_THREAD_NUMBER)
+	{
+		retVal = HostOs_Data.events[id];
+		HostOs_Data.events[id] = 0u;
+	}
+
+	return retVal;
+}
+
+/**@brief Log sink of the host programs, the records are only counted.
+ * @param[in]	site	Log site identifier and level.
+ * @param[in]	args	Raw arguments.
+ * @param[in]	count	Number of arguments.
+ */
+void Log_Write(const uint32_t site, const uint32_t *args, const uint32_t count)
+{
+	(void)site;
+	(void)args;
+	(void)count;
+	HostOs_Data.logRecords++;
+}
+
+/**@brief Used to get the number of log records written by the modules.
+ * @return	Number of log records.
+ */
+uint32_t HostOs_GetLogRecords(void)
+{
+	return HostOs_Data.logRecords;
+}
@@ -0,0 +1,137 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: ch.h $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file ch.h
+* @brief Implements the subset of the ChibiOS kernel API used by the modules, for the host programs.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#if !defined(CH_H)
+#define CH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Host replacement of the kernel header, the modules are compiled unchanged against it. The host
+ * programs are single threaded: the locks do nothing, the system time is a virtual millisecond
+ * counter advanced by the program (HostOs_Advance() or chThdSleepMilliseconds()) and the virtual
+ * timers fire from there. The events of the OS wrapper (Os_SetEvent()) are collected per task and
+ * read by the program with HostOs_GetEvents(), no thread is created. The realtime counter runs from the host monotonic clock at the target
+ * core frequency, so the cycle statistics of the modules keep their unit. */
+
+#if !defined(FALSE)
+#define FALSE							(0)
+#endif
+
+#if !defined(TRUE)
+#define TRUE							(!FALSE)
+#endif
+
+/**@brief Defines the system tick frequency, same as the target configuration (chconf.h).
+ */
+#define CH_CFG_ST_FREQUENCY				(1000u)
+
+/**@brief Defines the frequency of the realtime counter, the target core clock.
+ */
+#define HOSTOS_REALTIME_FREQUENCY		(80000000u)
+
+/**@brief Defines the maximum number of armed virtual timers.
+ */
+#define HOSTOS_TIMER_NUMBER				(16u)
+
+#define NORMALPRIO						(128u)
+#define MSG_OK							((msg_t)0)
+#define MSG_TIMEOUT						((msg_t)-1)
+#define MSG_RESET						((msg_t)-2)
+#define EVENT_MASK(eid)					((eventmask_t)1 << (eventmask_t)(eid))
+#define ALL_EVENTS						((eventmask_t)-1)
+#define MS2ST(msec)						((systime_t)(msec))
+#define ST2MS(n)						((uint32_t)(n))
+
+typedef uint32_t systime_t;
+typedef uint32_t rtcnt_t;
+typedef uint32_t eventmask_t;
+typedef uint32_t tprio_t;
+typedef int32_t msg_t;
+typedef void (*vtfunc_t)(void *p);
+typedef void (*tfunc_t)(void *p);
+typedef uint64_t stkalign_t;
+
+/**@struct mutex_t
+ * @brief Specifies a mutex, only the lock depth is kept.
+ */
+typedef struct ch_mutex
+{
+	uint32_t depth;						/**< Number of nested locks. */
+} mutex_t;
+
+/**@struct virtual_timer_t
+ * @brief Specifies a one shot virtual timer.
+ */
+typedef struct ch_virtual_timer
+{
+	vtfunc_t func;						/**< Callback, NULL if the timer is not armed. */
+	void *par;							/**< Callback argument. */
+	systime_t when;						/**< System time at which the timer fires. */
+} virtual_timer_t;
+
+/**@struct thread_t
+ * @brief Specifies the thread fields read by the modules.
+ */
+typedef struct ch_thread
+{
+	tprio_t prio;						/**< Thread priority. */
+	uint32_t state;						/**< Thread state. */
+} thread_t;
+
+extern void chSysLock(void);
+extern void chSysUnlock(void);
+extern void chSysLockFromISR(void);
+extern void chSysUnlockFromISR(void);
+extern rtcnt_t chSysGetRealtimeCounterX(void);
+extern void chSysPolledDelayX(rtcnt_t cycles);
+extern systime_t chVTGetSystemTimeX(void);
+extern void chVTObjectInit(virtual_timer_t *vtp);
+extern void chVTSetI(virtual_timer_t *vtp, systime_t delay, vtfunc_t vtfunc, void *par);
+extern void chVTResetI(virtual_timer_t *vtp);
+extern void chMtxObjectInit(mutex_t *mp);
+extern void chMtxLock(mutex_t *mp);
+extern void chMtxUnlock(mutex_t *mp);
+extern void chThdSleepMilliseconds(uint32_t msec);
+
+extern void HostOs_Advance(const uint32_t msec);
+extern eventmask_t HostOs_GetEvents(const uint32_t id);
+extern uint32_t HostOs_GetLogRecords(void);
+
+#endif /* CH_H */
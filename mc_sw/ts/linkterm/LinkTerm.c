@@ -0,0 +1,709 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: LinkTerm.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file LinkTerm.c
+* @brief Implements the host terminal of the link protocol (log decoder and shell client).
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#define _DEFAULT_SOURCE
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "LinkCodec.h"
+
+/* Host tool, not part of the target build. Built by "make" in ts/host from this file and
+ * appl/com/link/LinkCodec.c, the same protocol code as the target.
+ *
+ * Usage: linkterm [-b baud] [-l table.logstr] device|capture
+ *
+ * Decodes the frames received from the debug UART (a serial device, or a capture file which is read
+ * to its end). LINKCODEC_MSG_ID_LOG frames are printed as text: the format string of each record is
+ * looked up in the log string table of the image (the .logstr section, extracted next to the ELF
+ * file by the "logstr" target of the target build, see ../buildopt) and formatted with the raw
+ * arguments of the record. Without a table the site identifiers and arguments are printed raw.
+ *
+ * On a serial device the tool is also the client of the command shell: every line read from stdin
+ * is sent as one reliable LINKCODEC_MSG_ID_SHELL frame (the shell takes one line at a time) and the
+ * LINKCODEC_MSG_ID_SHELL frames of the target are printed as they are. The reliable frames of the
+ * target are acknowledged, the host frame is retransmitted until acknowledged, as by the link on the
+ * target (go-back-N with one frame in flight). The next line is sent once the reply is complete: no
+ * shell frame for LINKTERM_REPLY_GAP, or LINKTERM_REPLY_TIME after the acknowledge. When stdin ends
+ * the tool exits after the last reply, so commands can be piped: echo log | linkterm /dev/ttyACM0 */
+
+#if !defined(FALSE)
+#define FALSE							(0u)
+#endif
+
+#if !defined(TRUE)
+#define TRUE							(1u)
+#endif
+
+/**@brief Defines the default baud rate of the debug UART (UARTHNDLR_DEBUG_BAUDRATE).
+ */
+#define LINKTERM_BAUDRATE				(115200u)
+
+/**@brief Defines the retransmission time of an unacknowledged shell line in milliseconds (LINK_RETRANSMIT_TIME).
+ */
+#define LINKTERM_RETRANSMIT_TIME		(200u)
+
+/**@brief Defines the time after the acknowledge of a shell line after which the reply is complete, in milliseconds.
+ */
+#define LINKTERM_REPLY_TIME				(1000u)
+
+/**@brief Defines the silence after a shell frame after which the reply is complete, in milliseconds.
+ * @details The background task of the shell runs every 50 ms.
+ */
+#define LINKTERM_REPLY_GAP				(150u)
+
+/**@brief Defines the poll period of the serial device and stdin in milliseconds.
+ */
+#define LINKTERM_POLL_TIME				(20u)
+
+/**@brief Defines the mask of the site identifier (string offset) in a record header word.
+ */
+#define LINKTERM_SITE_MASK				(0x00FFFFFFu)
+
+/**@brief Defines the position of the log level in a record header word.
+ */
+#define LINKTERM_LEVEL_SHIFT			(24u)
+
+/**@brief Defines the position of the argument count in a record header word.
+ */
+#define LINKTERM_NARGS_SHIFT			(28u)
+
+/**@brief Defines the number of words of a record without arguments (header and time stamp).
+ */
+#define LINKTERM_RECORD_OVERHEAD		(2u)
+
+/**@brief Defines the size of the buffer of a formatted log line.
+ */
+#define LINKTERM_LINE_SIZE				(256u)
+
+/**@struct LinkTerm_DataType
+ * @brief Container used to store the relevant data of the terminal.
+ */
+typedef struct LinkTerm_DataTypeTag
+{
+	int fd;								/**< Serial device or capture file. */
+	uint8_t isDevice;					/**< The input is a serial device, not a capture file. */
+	char *table;						/**< Log string table, NULL if none. */
+	uint32_t tableSize;					/**< Size of the log string table in bytes. */
+	LinkCodec_DecoderType decoder;		/**< Frame decoder. */
+	uint32_t frames;					/**< Number of received frames. */
+	uint32_t errors;					/**< Number of dropped corrupted frames. */
+	uint32_t records;					/**< Number of printed log records. */
+	uint8_t expectedSeq;				/**< Sequence number of the next reliable frame of the target. */
+	uint8_t isSynced;					/**< expectedSeq was taken from the first reliable frame of the target. */
+	uint8_t txSeq;						/**< Sequence number of the shell line in flight. */
+	uint8_t isLinePending;				/**< A shell line is waiting for its acknowledge. */
+	uint8_t isReplyPending;				/**< The reply to the last shell line is not complete. */
+	uint8_t isInputEnd;					/**< stdin is closed. */
+	uint8_t line[LINKCODEC_MAX_PAYLOAD];	/**< Shell line in flight. */
+	uint32_t lineLength;				/**< Number of bytes of the shell line. */
+	uint8_t frame[LINKCODEC_MAX_FRAME_SIZE];	/**< Encoded shell line in flight. */
+	uint32_t frameLength;				/**< Number of bytes of the encoded shell line. */
+	uint64_t sentTime;					/**< Time of the last transmission of the shell line in milliseconds. */
+	uint64_t replyTime;					/**< Time at which the pending reply is complete in milliseconds. */
+	char input[LINKCODEC_MAX_PAYLOAD];	/**< Input read from stdin and not yet sent. */
+	uint32_t inputLength;				/**< Number of bytes of input. */
+} LinkTerm_DataType;
+
+static int openInput(const char *name, const uint32_t baud);
+static int loadTable(const char *name);
+static void runShell(void);
+static void readInput(void);
+static void sendLine(const uint64_t now);
+static void sendFrame(const LinkCodec_MsgIdType msgId, const uint8_t flags, const uint8_t seq, const uint8_t *payload,
+					  const uint32_t length, uint8_t *frame, uint32_t *frameLength);
+static void receive(const uint8_t *data, const uint32_t length);
+static void handleFrame(void);
+static void printLog(const uint8_t *payload, const uint32_t length);
+static void formatRecord(char *line, const uint32_t size, const char *fmt, const uint32_t *args, const uint32_t count);
+static uint64_t getTime(void);
+
+/**@brief Names of the log levels.
+ */
+static const char LinkTerm_Level[4u] = { 'E', 'W', 'I', 'D' };
+
+/**@brief Stores the terminal data.
+ */
+static LinkTerm_DataType LinkTerm_Data;
+
+/**@brief Entry point of the terminal.
+ * @param[in]	argc	Number of arguments.
+ * @param[in]	argv	Arguments.
+ * @return	0 on success, 2 on an error.
+ */
+int main(int argc, char *argv[])
+{
+	const char *inputName = NULL;
+	uint32_t baud = LINKTERM_BAUDRATE;
+	int retVal = 0;
+	int idx = 0;
+
+	for (idx = 1; (idx < argc) && (retVal == 0); idx++)
+	{
+		if ((strcmp(argv[idx], "-b") == 0) && ((idx + 1) < argc))
+		{
+			baud = (uint32_t)strtoul(argv[++idx], NULL, 10);
+		}
+		else if ((strcmp(argv[idx], "-l") == 0) && ((idx + 1) < argc))
+		{
+			retVal = loadTable(argv[++idx]);
+		}
+		else if ((argv[idx][0] != '-') && (inputName == NULL))
+		{
+			inputName = argv[idx];
+		}
+		else
+		{
+			retVal = 2;
+		}
+	}
+
+	if ((retVal == 0) && (inputName != NULL))
+	{
+		retVal = openInput(inputName, baud);
+	}
+	else
+	{
+		fprintf(stderr, "usage: linkterm [-b baud] [-l table.logstr] device|capture\n");
+		retVal = 2;
+	}
+
+	if (retVal == 0)
+	{
+		LinkCodec_DecoderInit(&LinkTerm_Data.decoder);
+		if (LinkTerm_Data.isDevice)
+		{
+			runShell();
+		}
+		else
+		{
+			uint8_t buffer[256u];
+			ssize_t count = 0;
+
+			while ((count = read(LinkTerm_Data.fd, buffer, sizeof(buffer))) > 0)
+			{
+				receive(buffer, (uint32_t)count);
+			}
+		}
+		fprintf(stderr, "linkterm: %u frames, %u log records, %u corrupted frames\n",
+				LinkTerm_Data.frames, LinkTerm_Data.records, LinkTerm_Data.errors);
+	}
+
+	return retVal;
+}
+
+/**@brief Used to open the serial device (raw mode at the given baud rate) or the capture file.
+ * @param[in]	name	Path of the device or file.
+ * @param[in]	baud	Baud rate of a serial device.
+ * @return	0 on success, 2 on an error.
+ */
+static int openInput(const char *name, const uint32_t baud)
+{
+	int retVal = 0;
+
+	LinkTerm_Data.fd = open(name, O_RDWR | O_NOCTTY);
+	if (LinkTerm_Data.fd < 0)
+	{
+		LinkTerm_Data.fd = open(name, O_RDONLY);
+	}
+
+	if (LinkTerm_Data.fd < 0)
+	{
+		perror(name);
+		retVal = 2;
+	}
+	else if (isatty(LinkTerm_Data.fd))
+	{
+		struct termios tio;
+
+		LinkTerm_Data.isDevice = TRUE;
+		if ((tcgetattr(LinkTerm_Data.fd, &tio) != 0) || (cfsetspeed(&tio, (speed_t)baud) != 0))
+		{
+			fprintf(stderr, "linkterm: %s: can not set %u baud\n", name, baud);
+			retVal = 2;
+		}
+		else
+		{
+			cfmakeraw(&tio);
+			(void)tcsetattr(LinkTerm_Data.fd, TCSANOW, &tio);
+		}
+	}
+	else
+	{
+		/* Nothing to do. */
+	}
+
+	return retVal;
+}
+
+/**@brief Used to load the log string table.
+ * @param[in]	name	Path of the table (raw .logstr section).
+ * @return	0 on success, 2 on an error.
+ */
+static int loadTable(const char *name)
+{
+	FILE *file = fopen(name, "rb");
+	int retVal = 2;
+
+	if ((file != NULL) && (fseek(file, 0, SEEK_END) == 0))
+	{
+		const long size = ftell(file);
+
+		if ((size >= 0) && (fseek(file, 0, SEEK_SET) == 0))
+		{
+			/* Zero terminated, so a corrupted offset can not run past the end. */
+			LinkTerm_Data.table = calloc((size_t)size + 1u, 1u);
+			if ((LinkTerm_Data.table != NULL) && (fread(LinkTerm_Data.table, 1u, (size_t)size, file) == (size_t)size))
+			{
+				LinkTerm_Data.tableSize = (uint32_t)size;
+				retVal = 0;
+			}
+		}
+	}
+
+	if (file != NULL)
+	{
+		(void)fclose(file);
+	}
+	if (retVal != 0)
+	{
+		fprintf(stderr, "linkterm: can not load the log string table %s\n", name);
+	}
+
+	return retVal;
+}
+
+/**@brief Used to serve the serial device and the shell input until stdin ends and the last reply is complete.
+ */
+static void runShell(void)
+{
+	uint8_t isRunning = TRUE;
+
+	while (isRunning)
+	{
+		struct pollfd fds[2] = { { LinkTerm_Data.fd, POLLIN, 0 }, { STDIN_FILENO, POLLIN, 0 } };
+		const uint8_t isInputPolled = ((LinkTerm_Data.isInputEnd == FALSE) && (LinkTerm_Data.inputLength < sizeof(LinkTerm_Data.input))) ? TRUE : FALSE;
+		uint64_t now;
+
+		(void)poll(fds, isInputPolled ? 2u : 1u, (int)LINKTERM_POLL_TIME);
+		if ((fds[0].revents & (POLLIN | POLLHUP | POLLERR)) != 0)
+		{
+			uint8_t buffer[256u];
+			const ssize_t count = read(LinkTerm_Data.fd, buffer, sizeof(buffer));
+
+			if (count > 0)
+			{
+				receive(buffer, (uint32_t)count);
+			}
+			else
+			{
+				isRunning = FALSE;
+			}
+		}
+		if (isInputPolled && ((fds[1].revents & (POLLIN | POLLHUP | POLLERR)) != 0))
+		{
+			readInput();
+		}
+
+		now = getTime();
+		if (LinkTerm_Data.isLinePending)
+		{
+			if ((now - LinkTerm_Data.sentTime) >= LINKTERM_RETRANSMIT_TIME)
+			{
+				(void)write(LinkTerm_Data.fd, LinkTerm_Data.frame, LinkTerm_Data.frameLength);
+				LinkTerm_Data.sentTime = now;
+			}
+		}
+		else if (LinkTerm_Data.isReplyPending)
+		{
+			if (now >= LinkTerm_Data.replyTime)
+			{
+				LinkTerm_Data.isReplyPending = FALSE;
+			}
+		}
+		else
+		{
+			sendLine(now);
+			if ((LinkTerm_Data.isLinePending == FALSE) && LinkTerm_Data.isInputEnd)
+			{
+				isRunning = FALSE;
+			}
+		}
+	}
+}
+
+/**@brief Used to read the available input of stdin.
+ */
+static void readInput(void)
+{
+	const ssize_t count = read(STDIN_FILENO, &LinkTerm_Data.input[LinkTerm_Data.inputLength],
+							   sizeof(LinkTerm_Data.input) - LinkTerm_Data.inputLength);
+
+	if (count > 0)
+	{
+		LinkTerm_Data.inputLength += (uint32_t)count;
+	}
+	else
+	{
+		LinkTerm_Data.isInputEnd = TRUE;
+	}
+}
+
+/**@brief Used to send the next complete input line as a reliable shell frame.
+ * @details A line longer than a frame payload is sent in parts, a line end is added to the last
+ * line of the input if it has none.
+ * @param[in]	now		Current time in milliseconds.
+ */
+static void sendLine(const uint64_t now)
+{
+	const char *end = memchr(LinkTerm_Data.input, '\n', LinkTerm_Data.inputLength);
+	uint32_t length = 0u;
+
+	if (end != NULL)
+	{
+		length = (uint32_t)(end - LinkTerm_Data.input) + 1u;
+	}
+	else if (LinkTerm_Data.inputLength == sizeof(LinkTerm_Data.input))
+	{
+		length = LinkTerm_Data.inputLength;
+	}
+	else if (LinkTerm_Data.isInputEnd && (LinkTerm_Data.inputLength > 0u))
+	{
+		LinkTerm_Data.input[LinkTerm_Data.inputLength] = '\n';
+		LinkTerm_Data.inputLength++;
+		length = LinkTerm_Data.inputLength;
+	}
+	else
+	{
+		/* Nothing to do. */
+	}
+
+	if (length > 0u)
+	{
+		memcpy(LinkTerm_Data.line, LinkTerm_Data.input, length);
+		LinkTerm_Data.lineLength = length;
+		sendFrame(LINKCODEC_MSG_ID_SHELL, LINKCODEC_FLAG_ACK_REQUEST, LinkTerm_Data.txSeq, LinkTerm_Data.line,
+				  length, LinkTerm_Data.frame, &LinkTerm_Data.frameLength);
+		memmove(LinkTerm_Data.input, &LinkTerm_Data.input[length], LinkTerm_Data.inputLength - length);
+		LinkTerm_Data.inputLength -= length;
+		LinkTerm_Data.isLinePending = TRUE;
+		LinkTerm_Data.isReplyPending = TRUE;
+		LinkTerm_Data.sentTime = now;
+	}
+}
+
+/**@brief Used to encode and send a frame to the target, carrying the acknowledge of the target frames.
+ * @param[in]	msgId		Message identifier.
+ * @param[in]	flags		Frame flags besides LINKCODEC_FLAG_ACK.
+ * @param[in]	seq			Sequence number of a reliable frame.
+ * @param[in]	payload		Payload.
+ * @param[in]	length		Number of payload bytes.
+ * @param[out]	frame		Encoded frame.
+ * @param[out]	frameLength	Number of bytes of the encoded frame.
+ */
+static void sendFrame(const LinkCodec_MsgIdType msgId, const uint8_t flags, const uint8_t seq, const uint8_t *payload,
+					  const uint32_t length, uint8_t *frame, uint32_t *frameLength)
+{
+	const LinkCodec_HeaderType header = { (uint8_t)msgId, (uint8_t)(flags | LINKCODEC_FLAG_ACK), seq, (uint8_t)(LinkTerm_Data.expectedSeq - 1u) };
+
+	*frameLength = LinkCodec_Encode(&header, payload, length, frame);
+	if (write(LinkTerm_Data.fd, frame, *frameLength) != (ssize_t)*frameLength)
+	{
+		perror("linkterm: write");
+	}
+}
+
+/**@brief Used to feed received bytes to the frame decoder.
+ * @param[in]	data	Received bytes.
+ * @param[in]	length	Number of bytes.
+ */
+static void receive(const uint8_t *data, const uint32_t length)
+{
+	uint32_t offset = 0u;
+
+	while (offset < length)
+	{
+		uint32_t consumed = 0u;
+		const LinkCodec_StatusType status = LinkCodec_Decode(&LinkTerm_Data.decoder, &data[offset], length - offset, &consumed);
+
+		offset += consumed;
+		if (status == LINKCODEC_STATUS_FRAME)
+		{
+			LinkTerm_Data.frames++;
+			handleFrame();
+		}
+		else if (status == LINKCODEC_STATUS_ERROR)
+		{
+			LinkTerm_Data.errors++;
+		}
+		else
+		{
+			/* Nothing to do. */
+		}
+	}
+}
+
+/**@brief Used to process the frame held by the decoder.
+ */
+static void handleFrame(void)
+{
+	LinkCodec_HeaderType header;
+	const uint8_t *payload;
+	uint32_t length;
+
+	uint8_t isDeliver = TRUE;
+
+	LinkCodec_GetFrame(&LinkTerm_Data.decoder, &header, &payload, &length);
+
+	/* The ack field is the last host frame the target received in order, so the sequence numbers
+	 * follow the target across restarts of either side. */
+	if (((header.flags & LINKCODEC_FLAG_ACK) != 0u) && LinkTerm_Data.isDevice)
+	{
+		if (LinkTerm_Data.isLinePending == FALSE)
+		{
+			LinkTerm_Data.txSeq = (uint8_t)(header.ack + 1u);
+		}
+		else if (header.ack == LinkTerm_Data.txSeq)
+		{
+			LinkTerm_Data.isLinePending = FALSE;
+			LinkTerm_Data.txSeq++;
+			LinkTerm_Data.replyTime = getTime() + LINKTERM_REPLY_TIME;
+		}
+		else if ((uint8_t)(header.ack + 1u) != LinkTerm_Data.txSeq)
+		{
+			LinkTerm_Data.txSeq = (uint8_t)(header.ack + 1u);
+			sendFrame(LINKCODEC_MSG_ID_SHELL, LINKCODEC_FLAG_ACK_REQUEST, LinkTerm_Data.txSeq, LinkTerm_Data.line,
+					  LinkTerm_Data.lineLength, LinkTerm_Data.frame, &LinkTerm_Data.frameLength);
+			LinkTerm_Data.sentTime = getTime();
+		}
+		else
+		{
+			/* Nothing to do. */
+		}
+	}
+
+	if (((header.flags & LINKCODEC_FLAG_ACK_REQUEST) != 0u) && LinkTerm_Data.isDevice)
+	{
+		uint8_t frame[LINKCODEC_MAX_FRAME_SIZE];
+		uint32_t frameLength = 0u;
+
+		/* Go-back-N as on the target: only the next frame in order is delivered, every frame is acknowledged. */
+		if (LinkTerm_Data.isSynced == FALSE)
+		{
+			LinkTerm_Data.expectedSeq = header.seq;
+			LinkTerm_Data.isSynced = TRUE;
+		}
+		if (header.seq == LinkTerm_Data.expectedSeq)
+		{
+			LinkTerm_Data.expectedSeq++;
+		}
+		else
+		{
+			isDeliver = FALSE;
+		}
+		sendFrame(LINKCODEC_MSG_ID_ACK, 0u, 0u, NULL, 0u, frame, &frameLength);
+	}
+
+	if (isDeliver && (header.msgId == LINKCODEC_MSG_ID_LOG))
+	{
+		printLog(payload, length);
+	}
+	else if (isDeliver && (header.msgId == LINKCODEC_MSG_ID_SHELL))
+	{
+		(void)fwrite(payload, 1u, length, stdout);
+		fflush(stdout);
+		LinkTerm_Data.replyTime = getTime() + LINKTERM_REPLY_GAP;
+	}
+	else
+	{
+		/* Nothing to do. */
+	}
+}
+
+/**@brief Used to print the records of a log frame.
+ * @details The payload holds whole records of little endian words: header (argument count, level
+ * and site identifier), time stamp (low word of the clock time in microseconds) and arguments.
+ * @param[in]	payload	Frame payload.
+ * @param[in]	length	Number of payload bytes.
+ */
+static void printLog(const uint8_t *payload, const uint32_t length)
+{
+	uint32_t words[LINKCODEC_MAX_PAYLOAD / sizeof(uint32_t)];
+	const uint32_t count = length / sizeof(uint32_t);
+	uint32_t idx = 0u;
+
+	for (idx = 0u; idx < count; idx++)
+	{
+		words[idx] = (uint32_t)payload[4u * idx] | ((uint32_t)payload[(4u * idx) + 1u] << 8u) |
+					 ((uint32_t)payload[(4u * idx) + 2u] << 16u) | ((uint32_t)payload[(4u * idx) + 3u] << 24u);
+	}
+
+	idx = 0u;
+	while ((idx + LINKTERM_RECORD_OVERHEAD) <= count)
+	{
+		const uint32_t header = words[idx];
+		const uint32_t site = header & LINKTERM_SITE_MASK;
+		const uint32_t level = (header >> LINKTERM_LEVEL_SHIFT) & 0x3u;
+		const uint32_t nargs = (header >> LINKTERM_NARGS_SHIFT) & 0x7u;
+		const uint32_t time = words[idx + 1u];
+		char line[LINKTERM_LINE_SIZE];
+
+		if ((idx + LINKTERM_RECORD_OVERHEAD + nargs) > count)
+		{
+			break;
+		}
+
+		if (site < LinkTerm_Data.tableSize)
+		{
+			formatRecord(line, sizeof(line), &LinkTerm_Data.table[site], &words[idx + LINKTERM_RECORD_OVERHEAD], nargs);
+		}
+		else
+		{
+			uint32_t arg = 0u;
+			int used = snprintf(line, sizeof(line), "site 0x%06x", site);
+
+			for (arg = 0u; (arg < nargs) && (used > 0) && ((uint32_t)used < sizeof(line)); arg++)
+			{
+				used += snprintf(&line[used], sizeof(line) - (uint32_t)used, " 0x%08x", words[idx + LINKTERM_RECORD_OVERHEAD + arg]);
+			}
+		}
+		printf("%5u.%06u %c %s\n", time / 1000000u, time % 1000000u, LinkTerm_Level[level], line);
+		LinkTerm_Data.records++;
+		idx += LINKTERM_RECORD_OVERHEAD + nargs;
+	}
+	fflush(stdout);
+}
+
+/**@brief Used to format a log record with its format string.
+ * @details Every conversion is formatted on its own with one 32 bit argument, the length modifiers
+ * are dropped since the target records all of the arguments as 32 bit words. Conversions other than
+ * the integer and character ones (the target can not log strings or floats) and conversions without
+ * an argument are copied unchanged.
+ * @param[out]	line	Formatted text.
+ * @param[in]	size	Size of the text buffer.
+ * @param[in]	fmt		Format string.
+ * @param[in]	args	Raw arguments.
+ * @param[in]	count	Number of arguments.
+ */
+static void formatRecord(char *line, const uint32_t size, const char *fmt, const uint32_t *args, const uint32_t count)
+{
+	uint32_t used = 0u;
+	uint32_t arg = 0u;
+
+	while ((*fmt != '\0') && ((used + 1u) < size))
+	{
+		if ((fmt[0] == '%') && (fmt[1] == '%'))
+		{
+			line[used++] = '%';
+			fmt += 2;
+		}
+		else if (fmt[0] == '%')
+		{
+			char spec[16u];
+			uint32_t length = 0u;
+			const char *end = fmt + 1;
+			int written = 0;
+
+			spec[length++] = '%';
+			while ((*end != '\0') && (strchr("-+ #0123456789.hlzjt", *end) != NULL))
+			{
+				if ((strchr("hlzjt", *end) == NULL) && (length < (sizeof(spec) - 2u)))
+				{
+					spec[length++] = *end;
+				}
+				end++;
+			}
+
+			if ((*end != '\0') && (strchr("diuxXoc", *end) != NULL) && (arg < count))
+			{
+				spec[length++] = *end;
+				spec[length] = '\0';
+				if ((*end == 'd') || (*end == 'i'))
+				{
+					written = snprintf(&line[used], size - used, spec, (int32_t)args[arg]);
+				}
+				else
+				{
+					written = snprintf(&line[used], size - used, spec, args[arg]);
+				}
+				arg++;
+				end++;
+			}
+			else
+			{
+				if (*end != '\0')
+				{
+					end++;
+				}
+				written = snprintf(&line[used], size - used, "%.*s", (int)(end - fmt), fmt);
+			}
+
+			if (written > 0)
+			{
+				used += (uint32_t)written;
+				if (used >= size)
+				{
+					used = size - 1u;
+				}
+			}
+			fmt = end;
+		}
+		else
+		{
+			line[used++] = *fmt;
+			fmt++;
+		}
+	}
+	line[used] = '\0';
+}
+
+/**@brief Used to get the monotonic time.
+ * @return	Time in milliseconds.
+ */
+static uint64_t getTime(void)
+{
+	struct timespec ts;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * 1000u) + ((uint64_t)ts.tv_nsec / 1000000u);
+}
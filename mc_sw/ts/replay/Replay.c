@@ -0,0 +1,517 @@
+/*============================================================================*/
+/*                        					                                  */
+/*============================================================================*/
+/*                        OBJECT SPECIFICATION                                */
+/*============================================================================*
+* $Source: Replay.c $
+* $Revision: $
+* Author: MoMoTech
+* $Date: $
+*/
+/*============================================================================*/
+/* FUNCTION COMMENT :                                                         */
+/**
+* @file Replay.c
+* @brief Implements the host replay of recorded GNSS and IMU logs through the positioning chain.
+*/
+/*============================================================================*/
+/* MIT License
+ *
+ * Copyright (c) 2017 MoMo.Tech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.																  */
+/*============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "UartHndlr.h"
+#include "Gps.h"
+#include "Fusion.h"
+#include "Vfb.h"
+
+/* Host tool, not part of the target build. It is built by ts/host/Makefile against the host kernel
+ * shim (ts/host/os) with -DVFB_BACKEND=VFB_BACKEND_MOCK and -DGPS_PROTOCOL=GPS_PROTOCOL_NMEA, and
+ * "make test" there replays data/gnss.log and data/imu.csv (a synthetic 60 s walk, 1 Hz NMEA and
+ * 100 Hz IMU) against data/golden.csv.
+ *
+ * Usage: replay [-r] [-k cycles_per_ns] [-o output.csv] [-g golden.csv] [-t tolerance_mm] gnss.log [imu.csv]
+ *
+ * gnss.log holds the raw receiver bytes (NMEA or UBX, as selected by GPS_PROTOCOL). imu.csv holds
+ * level frame accelerations "time_ms,east_mm_s2,north_mm_s2", the time relative to the log start.
+ * The MainFunctions run in 20 ms steps of virtual time, as scheduled by Task_20ms. The bytes are
+ * received through the mock UART at the line rate of the GPS channel, but held back while the
+ * latest decoded fix time is ahead of the virtual time, so the log keeps its recorded timing.
+ * With -r every step is paced to the wall clock, otherwise the replay runs as fast as possible.
+ *
+ * For every new fix one line "time_ms,latitude,longitude,velocity_east,velocity_north,accuracy,valid"
+ * of the fused state is written. The output holds no timing and is stable across hosts, so it can be
+ * diffed against a golden file: a line with another time or a position further than the tolerance
+ * (default 100 mm) away, a missing line or an extra line is a mismatch and the exit code is 1.
+ *
+ * The host nanoseconds of each stage are reported. With -k (target realtime counter cycles per host
+ * nanosecond, calibrated once from Gps_GetStatistics() of a target run) target cycle estimates are
+ * printed as well. The chain ends at the fusion: the tree has no track compression and no storage
+ * module yet, their stages are to be added to Replay_StageType and Replay_Stage with them. */
+
+/**@brief Defines the recurrence of the replayed MainFunctions in milliseconds (Task_20ms).
+ */
+#define REPLAY_STEP						(20u)
+
+/**@brief Defines the number of bytes received per step at the line rate (10 bits per byte).
+ */
+#define REPLAY_STEP_BYTES				((UARTHNDLR_GPS_BAUDRATE / 10u) * REPLAY_STEP / 1000u)
+
+/**@brief Defines the length of a day in milliseconds, the period of the fix time.
+ */
+#define REPLAY_DAY						(86400000u)
+
+/**@brief Defines the default position tolerance of the golden file comparison in millimeters.
+ */
+#define REPLAY_TOLERANCE				(100u)
+
+/**@brief Defines the maximum length of a CSV line.
+ */
+#define REPLAY_LINE_SIZE				(128u)
+
+/**@enum Replay_StageTypeTag
+ * @brief Specifies the timed stages of the positioning chain.
+ */
+typedef enum Replay_StageTypeTag
+{
+	REPLAY_STAGE_RECEIVE = 0u,		/**< Mock DMA reception and UART handler events. */
+	REPLAY_STAGE_PARSE,				/**< Gps_MainFunction, decoding and merging. */
+	REPLAY_STAGE_FUSION,			/**< IMU samples and Fusion_MainFunction. */
+	REPLAY_STAGE_NUMBER				/**< Number of stages. */
+} Replay_StageType;
+
+/**@struct Replay_OutputType
+ * @brief Specifies one output line.
+ */
+typedef struct Replay_OutputTypeTag
+{
+	uint32_t time;					/**< Fix time of day in milliseconds. */
+	Geo_PointType position;			/**< Fused position. */
+	int32_t velocityEast;			/**< Fused east velocity in mm/s. */
+	int32_t velocityNorth;			/**< Fused north velocity in mm/s. */
+	uint32_t accuracy;				/**< Fused position accuracy in mm. */
+	uint32_t isValid;				/**< Fused state is valid. */
+} Replay_OutputType;
+
+/**@struct Replay_DataType
+ * @brief Container used to store the relevant data of the replay.
+ */
+typedef struct Replay_DataTypeTag
+{
+	uint8_t *gnss;								/**< GNSS log. */
+	uint32_t gnssLength;						/**< Number of bytes of the GNSS log. */
+	FILE *imu;									/**< IMU log, NULL if none. */
+	FILE *output;								/**< Output file, NULL if none. */
+	FILE *golden;								/**< Golden file, NULL if none. */
+	uint32_t tolerance;							/**< Position tolerance in millimeters. */
+	double cyclesPerNs;							/**< Target cycles per host nanosecond, 0 if unknown. */
+	uint8_t isRealTime;							/**< Steps are paced to the wall clock. */
+	uint64_t stageTime[REPLAY_STAGE_NUMBER];	/**< Host nanoseconds of each stage. */
+	uint32_t steps;								/**< Number of replayed steps. */
+	uint32_t imuSamples;						/**< Number of replayed IMU samples. */
+	uint32_t outputs;							/**< Number of output lines. */
+	uint32_t mismatches;						/**< Number of lines differing from the golden file. */
+	uint32_t maxDeviation;						/**< Largest position deviation from the golden file in mm. */
+	uint32_t firstMismatch;						/**< Output line of the first mismatch, starting at 1. */
+} Replay_DataType;
+
+static int loadGnss(const char *name);
+static void run(void);
+static void feedImu(const uint32_t time);
+static void writeOutput(const Replay_OutputType *output);
+static void compareOutput(const Replay_OutputType *output);
+static void compareEnd(void);
+static void report(const uint64_t wallTime);
+static uint64_t getTime(void);
+
+/**@brief Names of the timed stages.
+ */
+static const char * const Replay_Stage[REPLAY_STAGE_NUMBER] = { "receive", "parse", "fusion" };
+
+/**@brief Stores the replay data.
+ */
+static Replay_DataType Replay_Data;
+
+/**@brief Entry point of the replay tool.
+ * @param[in]	argc	Number of arguments.
+ * @param[in]	argv	Arguments.
+ * @return	0 if the output matches the golden file (or none was given), 1 on a mismatch, 2 on an error.
+ */
+int main(int argc, char *argv[])
+{
+	const char *gnssName = NULL;
+	const char *imuName = NULL;
+	uint64_t start;
+	int retVal = 0;
+	int idx = 0;
+
+	Replay_Data.tolerance = REPLAY_TOLERANCE;
+	for (idx = 1; (idx < argc) && (retVal == 0); idx++)
+	{
+		if ((strcmp(argv[idx], "-r") == 0))
+		{
+			Replay_Data.isRealTime = TRUE;
+		}
+		else if ((strcmp(argv[idx], "-k") == 0) && ((idx + 1) < argc))
+		{
+			Replay_Data.cyclesPerNs = strtod(argv[++idx], NULL);
+		}
+		else if ((strcmp(argv[idx], "-t") == 0) && ((idx + 1) < argc))
+		{
+			Replay_Data.tolerance = (uint32_t)strtoul(argv[++idx], NULL, 10);
+		}
+		else if ((strcmp(argv[idx], "-o") == 0) && ((idx + 1) < argc))
+		{
+			Replay_Data.output = fopen(argv[++idx], "w");
+			retVal = (Replay_Data.output == NULL) ? 2 : 0;
+		}
+		else if ((strcmp(argv[idx], "-g") == 0) && ((idx + 1) < argc))
+		{
+			Replay_Data.golden = fopen(argv[++idx], "r");
+			retVal = (Replay_Data.golden == NULL) ? 2 : 0;
+		}
+		else if ((argv[idx][0] != '-') && (gnssName == NULL))
+		{
+			gnssName = argv[idx];
+		}
+		else if ((argv[idx][0] != '-') && (imuName == NULL))
+		{
+			imuName = argv[idx];
+		}
+		else
+		{
+			retVal = 2;
+		}
+	}
+
+	if ((retVal == 0) && (gnssName != NULL) && (loadGnss(gnssName) == 0))
+	{
+		if (imuName != NULL)
+		{
+			Replay_Data.imu = fopen(imuName, "r");
+		}
+		if ((imuName == NULL) || (Replay_Data.imu != NULL))
+		{
+			Vfb_Mock_Reset();
+			Vfb_Dio_Init();
+			UartHndlr_Init();
+			Gps_Init(REPLAY_STEP);
+			Fusion_Init(REPLAY_STEP);
+
+			start = getTime();
+			run();
+			compareEnd();
+			report(getTime() - start);
+			retVal = (Replay_Data.mismatches != 0u) ? 1 : 0;
+		}
+		else
+		{
+			retVal = 2;
+		}
+	}
+	else
+	{
+		fprintf(stderr, "usage: replay [-r] [-k cycles_per_ns] [-o output.csv] [-g golden.csv] [-t tolerance_mm] gnss.log [imu.csv]\n");
+		retVal = 2;
+	}
+
+	return retVal;
+}
+
+/**@brief Used to load the GNSS log into memory.
+ * @param[in]	name	File name.
+ * @return	0 on success, -1 otherwise.
+ */
+static int loadGnss(const char *name)
+{
+	FILE *file = fopen(name, "rb");
+	int retVal = -1;
+
+	if (file != NULL)
+	{
+		long size;
+
+		(void)fseek(file, 0, SEEK_END);
+		size = ftell(file);
+		(void)fseek(file, 0, SEEK_SET);
+		if (size > 0)
+		{
+			Replay_Data.gnss = malloc((size_t)size);
+			if ((Replay_Data.gnss != NULL) && (fread(Replay_Data.gnss, 1u, (size_t)size, file) == (size_t)size))
+			{
+				Replay_Data.gnssLength = (uint32_t)size;
+				retVal = 0;
+			}
+		}
+		(void)fclose(file);
+	}
+
+	return retVal;
+}
+
+/**@brief Used to replay the logs step by step.
+ * @details Each step receives the bytes of one step at the line rate, completes the pending
+ * transmissions (receiver configuration) and runs the MainFunctions of Task_20ms. The virtual time
+ * is aligned to the fix time of the first decoded message.
+ */
+static void run(void)
+{
+	uint32_t position = 0u;
+	uint32_t fixUpdates = 0u;
+	uint32_t fixTime = 0xFFFFFFFFu;
+	uint32_t lastTime = 0u;
+	uint32_t offset = 0u;
+	uint8_t isAligned = FALSE;
+	uint64_t next = getTime();
+
+	while (position < Replay_Data.gnssLength)
+	{
+		const uint32_t time = Replay_Data.steps * REPLAY_STEP;
+		const int32_t ahead = (int32_t)((lastTime + REPLAY_DAY - ((time + offset) % REPLAY_DAY)) % REPLAY_DAY);
+		uint32_t length = ((Replay_Data.gnssLength - position) < REPLAY_STEP_BYTES) ? (Replay_Data.gnssLength - position) : REPLAY_STEP_BYTES;
+		uint64_t stamp = getTime();
+		uint64_t now;
+		Gps_FixType fix;
+
+		if ((isAligned) && (ahead > 0) && (ahead < (int32_t)(REPLAY_DAY / 2u)))
+		{
+			length = 0u;
+		}
+
+		Vfb_Mock_SetTime((uint64_t)time * 1000000u);
+		Vfb_Mock_UartReceive(UartHndlr_Config[GPS_CHANNEL].driver, &Replay_Data.gnss[position], length);
+		Vfb_Mock_UartTxEnd(UartHndlr_Config[GPS_CHANNEL].driver);
+		position += length;
+		now = getTime();
+		Replay_Data.stageTime[REPLAY_STAGE_RECEIVE] += now - stamp;
+
+		stamp = now;
+		Gps_MainFunction();
+		now = getTime();
+		Replay_Data.stageTime[REPLAY_STAGE_PARSE] += now - stamp;
+
+		stamp = now;
+		feedImu(time + REPLAY_STEP);
+		Fusion_MainFunction();
+		now = getTime();
+		Replay_Data.stageTime[REPLAY_STAGE_FUSION] += now - stamp;
+
+		Gps_GetFix(&fix);
+		if (fix.updates != fixUpdates)
+		{
+			lastTime = fix.time;
+			if (isAligned == FALSE)
+			{
+				offset = (fix.time + REPLAY_DAY - (time % REPLAY_DAY)) % REPLAY_DAY;
+				isAligned = TRUE;
+			}
+		}
+		if ((fix.updates != fixUpdates) && (fix.isValid) && (fix.time != fixTime))
+		{
+			Fusion_StateType state;
+			Replay_OutputType output;
+
+			Fusion_GetState(&state);
+			output.time = fix.time;
+			output.position = state.position;
+			output.velocityEast = state.velocityEast;
+			output.velocityNorth = state.velocityNorth;
+			output.accuracy = state.accuracy;
+			output.isValid = state.isValid;
+			writeOutput(&output);
+			compareOutput(&output);
+			fixTime = fix.time;
+		}
+		fixUpdates = fix.updates;
+		Replay_Data.steps++;
+
+		if (Replay_Data.isRealTime)
+		{
+			const struct timespec pause = {0, 0};
+			struct timespec remaining = pause;
+
+			next += (uint64_t)REPLAY_STEP * 1000000u;
+			now = getTime();
+			if (next > now)
+			{
+				remaining.tv_sec = (time_t)((next - now) / 1000000000u);
+				remaining.tv_nsec = (long)((next - now) % 1000000000u);
+				(void)nanosleep(&remaining, NULL);
+			}
+		}
+	}
+}
+
+/**@brief Used to pass the IMU samples up to a time to the fusion.
+ * @param[in]	time	End of the step in milliseconds, exclusive.
+ */
+static void feedImu(const uint32_t time)
+{
+	static char line[REPLAY_LINE_SIZE];
+	static uint8_t isPending = FALSE;
+	uint8_t isDone = (Replay_Data.imu == NULL) ? TRUE : FALSE;
+
+	while (isDone == FALSE)
+	{
+		unsigned long sampleTime;
+		long east;
+		long north;
+
+		if ((isPending == FALSE) && (fgets(line, sizeof(line), Replay_Data.imu) == NULL))
+		{
+			isDone = TRUE;
+		}
+		else if (sscanf(line, "%lu,%ld,%ld", &sampleTime, &east, &north) != 3)
+		{
+			isPending = FALSE;
+		}
+		else if (sampleTime >= time)
+		{
+			isPending = TRUE;
+			isDone = TRUE;
+		}
+		else
+		{
+			isPending = FALSE;
+			Fusion_AddAcceleration((int32_t)east, (int32_t)north);
+			Replay_Data.imuSamples++;
+		}
+	}
+}
+
+/**@brief Used to write an output line.
+ * @param[in]	output	Output line.
+ */
+static void writeOutput(const Replay_OutputType *output)
+{
+	Replay_Data.outputs++;
+	if (Replay_Data.output != NULL)
+	{
+		fprintf(Replay_Data.output, "%lu,%ld,%ld,%ld,%ld,%lu,%lu\n", (unsigned long)output->time,
+				(long)output->position.latitude, (long)output->position.longitude, (long)output->velocityEast,
+				(long)output->velocityNorth, (unsigned long)output->accuracy, (unsigned long)output->isValid);
+	}
+}
+
+/**@brief Used to compare an output line with the next golden file line.
+ * @param[in]	output	Output line.
+ */
+static void compareOutput(const Replay_OutputType *output)
+{
+	char line[REPLAY_LINE_SIZE];
+	unsigned long time;
+	long latitude;
+	long longitude;
+
+	if (Replay_Data.golden != NULL)
+	{
+		uint8_t isMatch = FALSE;
+
+		if ((fgets(line, sizeof(line), Replay_Data.golden) != NULL) &&
+			(sscanf(line, "%lu,%ld,%ld", &time, &latitude, &longitude) == 3) && (time == output->time))
+		{
+			const Geo_PointType expected = {(int32_t)latitude, (int32_t)longitude};
+			const uint32_t deviation = Geo_Distance(&expected, &output->position);
+
+			Replay_Data.maxDeviation = (deviation > Replay_Data.maxDeviation) ? deviation : Replay_Data.maxDeviation;
+			isMatch = (deviation <= Replay_Data.tolerance) ? TRUE : FALSE;
+		}
+		if (isMatch == FALSE)
+		{
+			Replay_Data.mismatches++;
+			if (Replay_Data.firstMismatch == 0u)
+			{
+				Replay_Data.firstMismatch = Replay_Data.outputs;
+			}
+		}
+	}
+}
+
+/**@brief Used to count the golden file lines left after the last output line as mismatches.
+ */
+static void compareEnd(void)
+{
+	char line[REPLAY_LINE_SIZE];
+
+	while ((Replay_Data.golden != NULL) && (fgets(line, sizeof(line), Replay_Data.golden) != NULL))
+	{
+		Replay_Data.mismatches++;
+		if (Replay_Data.firstMismatch == 0u)
+		{
+			Replay_Data.firstMismatch = Replay_Data.outputs + 1u;
+		}
+	}
+}
+
+/**@brief Used to print the throughput, the stage costs and the golden file comparison.
+ * @param[in]	wallTime	Host nanoseconds of the replay.
+ */
+static void report(const uint64_t wallTime)
+{
+	const double logTime = (double)Replay_Data.steps * (double)REPLAY_STEP * 1e-3;
+	Gps_StatisticsType gps;
+	Fusion_StatisticsType fusion;
+	uint32_t stage = 0u;
+
+	Gps_GetStatistics(&gps);
+	Fusion_GetStatistics(&fusion);
+
+	printf("replayed %.1f s of log in %.3f s (%.0f x real time), %lu bytes (%.2f MB/s), %lu IMU samples\n",
+			logTime, (double)wallTime * 1e-9, logTime / ((double)wallTime * 1e-9),
+			(unsigned long)Replay_Data.gnssLength, ((double)Replay_Data.gnssLength * 1e3) / (double)wallTime,
+			(unsigned long)Replay_Data.imuSamples);
+	printf("gps: %lu messages, %lu errors; fusion: %lu updates, %lu rejects, %lu resets\n",
+			(unsigned long)gps.messages, (unsigned long)gps.errors, (unsigned long)fusion.updates,
+			(unsigned long)fusion.rejects, (unsigned long)fusion.resets);
+	for (stage = 0u; stage < (uint32_t)REPLAY_STAGE_NUMBER; stage++)
+	{
+		const double perStep = (double)Replay_Data.stageTime[stage] / (double)((Replay_Data.steps != 0u) ? Replay_Data.steps : 1u);
+
+		printf("%-8s %10.0f ns/step", Replay_Stage[stage], perStep);
+		if (Replay_Data.cyclesPerNs > 0.0)
+		{
+			printf(" %10.0f target cycles/step", perStep * Replay_Data.cyclesPerNs);
+		}
+		printf("\n");
+	}
+	if (Replay_Data.golden != NULL)
+	{
+		printf("golden: %lu lines, %lu mismatches (first at line %lu), max deviation %lu mm, tolerance %lu mm\n",
+				(unsigned long)Replay_Data.outputs, (unsigned long)Replay_Data.mismatches,
+				(unsigned long)Replay_Data.firstMismatch, (unsigned long)Replay_Data.maxDeviation,
+				(unsigned long)Replay_Data.tolerance);
+	}
+}
+
+/**@brief Used to get the host monotonic time.
+ * @return	Time in nanoseconds.
+ */
+static uint64_t getTime(void)
+{
+	struct timespec now;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return ((uint64_t)now.tv_sec * 1000000000u) + (uint64_t)now.tv_nsec;
+}